@@ -702,14 +702,10 @@ public:
                 jassert (isPositiveAndBelow (channel, numChannels));
                 jassert (startSample >= 0 && numSamples >= 0 && startSample + numSamples <= size);
 
-                const auto increment = (endGain - startGain) / (float) numSamples;
+                const auto increment = (endGain - startGain) / (Type) numSamples;
                 auto* d = channels[channel] + startSample;
 
-                while (--numSamples >= 0)
-                {
-                    *d++ *= startGain;
-                    startGain += increment;
-                }
+                FloatVectorOperations::copyWithRamp (d, d, startGain, increment, numSamples);
             }
         }
     }
@@ -857,14 +853,10 @@ public:
             if (numSamples > 0)
             {
                 isClear = false;
-                const auto increment = (endGain - startGain) / numSamples;
+                const auto increment = (endGain - startGain) / (Type) numSamples;
                 auto* d = channels[destChannel] + destStartSample;
 
-                while (--numSamples >= 0)
-                {
-                    *d++ += startGain * *source++;
-                    startGain += increment;
-                }
+                FloatVectorOperations::addWithRamp (d, source, startGain, increment, numSamples);
             }
         }
     }
@@ -1013,14 +1005,10 @@ public:
             if (numSamples > 0)
             {
                 isClear = false;
-                const auto increment = (endGain - startGain) / numSamples;
+                const auto increment = (endGain - startGain) / (Type) numSamples;
                 auto* d = channels[destChannel] + destStartSample;
 
-                while (--numSamples >= 0)
-                {
-                    *d++ = startGain * *source++;
-                    startGain += increment;
-                }
+                FloatVectorOperations::copyWithRamp (d, source, startGain, increment, numSamples);
             }
         }
     }
@@ -1080,11 +1068,9 @@ public:
         auto* data = channels[channel] + startSample;
         double sum = 0.0;
 
-        for (int i = 0; i < numSamples; ++i)
-        {
-            auto sample = data[i];
-            sum += sample * sample;
-        }
+        // The partial sums are added in double precision, so that long regions don't lose accuracy
+        for (int i = 0; i < numSamples; i += 4096)
+            sum += (double) FloatVectorOperations::sumOfSquares (data + i, jmin (4096, numSamples - i));
 
         return static_cast<Type> (std::sqrt (sum / numSamples));
     }
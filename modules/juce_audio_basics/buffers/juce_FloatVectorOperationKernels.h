@@ -0,0 +1,507 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+/*  This file is deliberately included several times by juce_FloatVectorOperations.cpp,
+    once inside each namespace that defines a BasicOps32, BasicOps64 and ModeType for
+    a particular instruction set. The code is the same for each of them, but when the
+    file is included inside a region that targets a wider instruction set, the compiler
+    generates the kernels for that instruction set.
+*/
+
+template <typename Mode>
+struct Kernels
+{
+    using Type = typename Mode::Type;
+    using ParallelType = typename Mode::ParallelType;
+
+    static void fill (Type* dest, Type valueToFill, int num) noexcept
+    {
+        JUCE_PERFORM_VEC_OP_DEST (dest[i] = valueToFill, val, JUCE_LOAD_NONE,
+                                  const ParallelType val = Mode::load1 (valueToFill);)
+    }
+
+    static void copyWithMultiply (Type* dest, const Type* src, Type multiplier, int num) noexcept
+    {
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier, Mode::mul (mult, s),
+                                      JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
+                                      const ParallelType mult = Mode::load1 (multiplier);)
+    }
+
+    static void add (Type* dest, Type amount, int num) noexcept
+    {
+        JUCE_PERFORM_VEC_OP_DEST (dest[i] += amount, Mode::add (d, amountToAdd), JUCE_LOAD_DEST,
+                                  const ParallelType amountToAdd = Mode::load1 (amount);)
+    }
+
+    static void add (Type* dest, const Type* src, Type amount, int num) noexcept
+    {
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] + amount, Mode::add (am, s),
+                                      JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
+                                      const ParallelType am = Mode::load1 (amount);)
+    }
+
+    static void add (Type* dest, const Type* src, int num) noexcept
+    {
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i], Mode::add (d, s), JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST, )
+    }
+
+    static void add (Type* dest, const Type* src1, const Type* src2, int num) noexcept
+    {
+        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] + src2[i], Mode::add (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
+    }
+
+    static void subtract (Type* dest, const Type* src, int num) noexcept
+    {
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i], Mode::sub (d, s), JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST, )
+    }
+
+    static void subtract (Type* dest, const Type* src1, const Type* src2, int num) noexcept
+    {
+        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] - src2[i], Mode::sub (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
+    }
+
+    static void addWithMultiply (Type* dest, const Type* src, Type multiplier, int num) noexcept
+    {
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i] * multiplier, Mode::mulAdd (d, mult, s),
+                                      JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST,
+                                      const ParallelType mult = Mode::load1 (multiplier);)
+    }
+
+    static void addWithMultiply (Type* dest, const Type* src1, const Type* src2, int num) noexcept
+    {
+        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] += src1[i] * src2[i], Mode::mulAdd (d, s1, s2),
+                                                 JUCE_LOAD_SRC1_SRC2_DEST,
+                                                 JUCE_INCREMENT_SRC1_SRC2_DEST, )
+    }
+
+    static void subtractWithMultiply (Type* dest, const Type* src, Type multiplier, int num) noexcept
+    {
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i] * multiplier, Mode::mulSub (d, mult, s),
+                                      JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST,
+                                      const ParallelType mult = Mode::load1 (multiplier);)
+    }
+
+    static void subtractWithMultiply (Type* dest, const Type* src1, const Type* src2, int num) noexcept
+    {
+        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] -= src1[i] * src2[i], Mode::mulSub (d, s1, s2),
+                                                 JUCE_LOAD_SRC1_SRC2_DEST,
+                                                 JUCE_INCREMENT_SRC1_SRC2_DEST, )
+    }
+
+    static void multiply (Type* dest, const Type* src, int num) noexcept
+    {
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] *= src[i], Mode::mul (d, s), JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST, )
+    }
+
+    static void multiply (Type* dest, const Type* src1, const Type* src2, int num) noexcept
+    {
+        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] * src2[i], Mode::mul (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
+    }
+
+    static void multiply (Type* dest, Type multiplier, int num) noexcept
+    {
+        JUCE_PERFORM_VEC_OP_DEST (dest[i] *= multiplier, Mode::mul (d, mult), JUCE_LOAD_DEST,
+                                  const ParallelType mult = Mode::load1 (multiplier);)
+    }
+
+    static void abs (Type* dest, const Type* src, int num) noexcept
+    {
+        using IntegerType = typename std::conditional<sizeof (Type) == 4, uint32, uint64>::type;
+        union { Type f; IntegerType i; } signMask;
+        signMask.i = ((IntegerType) -1) >> 1;
+
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = std::abs (src[i]), Mode::bit_and (s, mask),
+                                      JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
+                                      const ParallelType mask = Mode::load1 (signMask.f);)
+
+        ignoreUnused (signMask);
+    }
+
+    static void convertFixedToFloat (float* dest, const int* src, float multiplier, int num) noexcept
+    {
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = (float) src[i] * multiplier, Mode::mul (mult, Mode::fromIntegers (src)),
+                                      JUCE_LOAD_NONE, JUCE_INCREMENT_SRC_DEST,
+                                      const ParallelType mult = Mode::load1 (multiplier);)
+    }
+
+    static void min (Type* dest, const Type* src, Type comp, int num) noexcept
+    {
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmin (src[i], comp), Mode::min (s, cmp),
+                                      JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
+                                      const ParallelType cmp = Mode::load1 (comp);)
+    }
+
+    static void min (Type* dest, const Type* src1, const Type* src2, int num) noexcept
+    {
+        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = jmin (src1[i], src2[i]), Mode::min (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
+    }
+
+    static void max (Type* dest, const Type* src, Type comp, int num) noexcept
+    {
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (src[i], comp), Mode::max (s, cmp),
+                                      JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
+                                      const ParallelType cmp = Mode::load1 (comp);)
+    }
+
+    static void max (Type* dest, const Type* src1, const Type* src2, int num) noexcept
+    {
+        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = jmax (src1[i], src2[i]), Mode::max (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
+    }
+
+    static void clip (Type* dest, const Type* src, Type low, Type high, int num) noexcept
+    {
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (jmin (src[i], high), low), Mode::max (Mode::min (s, hi), lo),
+                                      JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
+                                      const ParallelType lo = Mode::load1 (low); const ParallelType hi = Mode::load1 (high);)
+    }
+
+    //==============================================================================
+    static Type findMinOrMax (const Type* src, int num, const bool isMinimum) noexcept
+    {
+       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        int numLongOps = num / Mode::numParallel;
+
+        if (numLongOps > 1)
+        {
+            ParallelType val;
+
+           #if ! JUCE_USE_ARM_NEON
+            if (isAligned<Mode> (src))
+            {
+                val = Mode::loadA (src);
+
+                if (isMinimum)
+                {
+                    while (--numLongOps > 0)
+                    {
+                        src += Mode::numParallel;
+                        val = Mode::min (val, Mode::loadA (src));
+                    }
+                }
+                else
+                {
+                    while (--numLongOps > 0)
+                    {
+                        src += Mode::numParallel;
+                        val = Mode::max (val, Mode::loadA (src));
+                    }
+                }
+            }
+            else
+           #endif
+            {
+                val = Mode::loadU (src);
+
+                if (isMinimum)
+                {
+                    while (--numLongOps > 0)
+                    {
+                        src += Mode::numParallel;
+                        val = Mode::min (val, Mode::loadU (src));
+                    }
+                }
+                else
+                {
+                    while (--numLongOps > 0)
+                    {
+                        src += Mode::numParallel;
+                        val = Mode::max (val, Mode::loadU (src));
+                    }
+                }
+            }
+
+            Type result = isMinimum ? Mode::min (val)
+                                    : Mode::max (val);
+
+            num &= (Mode::numParallel - 1);
+            src += Mode::numParallel;
+
+            for (int i = 0; i < num; ++i)
+                result = isMinimum ? jmin (result, src[i])
+                                   : jmax (result, src[i]);
+
+            return result;
+        }
+       #endif
+
+        return isMinimum ? juce::findMinimum (src, num)
+                         : juce::findMaximum (src, num);
+    }
+
+    static Range<Type> findMinAndMax (const Type* src, int num) noexcept
+    {
+       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        int numLongOps = num / Mode::numParallel;
+
+        if (numLongOps > 1)
+        {
+            ParallelType mn, mx;
+
+           #if ! JUCE_USE_ARM_NEON
+            if (isAligned<Mode> (src))
+            {
+                mn = Mode::loadA (src);
+                mx = mn;
+
+                while (--numLongOps > 0)
+                {
+                    src += Mode::numParallel;
+                    const ParallelType v = Mode::loadA (src);
+                    mn = Mode::min (mn, v);
+                    mx = Mode::max (mx, v);
+                }
+            }
+            else
+           #endif
+            {
+                mn = Mode::loadU (src);
+                mx = mn;
+
+                while (--numLongOps > 0)
+                {
+                    src += Mode::numParallel;
+                    const ParallelType v = Mode::loadU (src);
+                    mn = Mode::min (mn, v);
+                    mx = Mode::max (mx, v);
+                }
+            }
+
+            Range<Type> result (Mode::min (mn),
+                                Mode::max (mx));
+
+            num &= (Mode::numParallel - 1);
+            src += Mode::numParallel;
+
+            for (int i = 0; i < num; ++i)
+                result = result.getUnionWith (src[i]);
+
+            return result;
+        }
+       #endif
+
+        return Range<Type>::findMinAndMax (src, num);
+    }
+
+    //==============================================================================
+    static Type sum (const Type* src, int num) noexcept
+    {
+        Type result = 0;
+
+       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        if (const auto numLongOps = num / Mode::numParallel)
+        {
+            auto total = Mode::load1 ((Type) 0);
+
+            for (int i = 0; i < numLongOps; ++i, src += Mode::numParallel)
+                total = Mode::add (total, Mode::loadU (src));
+
+            result = addLanes (total);
+            num &= (Mode::numParallel - 1);
+        }
+       #endif
+
+        for (int i = 0; i < num; ++i)
+            result += src[i];
+
+        return result;
+    }
+
+    static Type sumOfSquares (const Type* src, int num) noexcept
+    {
+        return dotProduct (src, src, num);
+    }
+
+    static Type dotProduct (const Type* src1, const Type* src2, int num) noexcept
+    {
+        Type result = 0;
+
+       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        if (const auto numLongOps = num / Mode::numParallel)
+        {
+            auto total = Mode::load1 ((Type) 0);
+
+            for (int i = 0; i < numLongOps; ++i, src1 += Mode::numParallel, src2 += Mode::numParallel)
+                total = Mode::mulAdd (total, Mode::loadU (src1), Mode::loadU (src2));
+
+            result = addLanes (total);
+            num &= (Mode::numParallel - 1);
+        }
+       #endif
+
+        for (int i = 0; i < num; ++i)
+            result += src1[i] * src2[i];
+
+        return result;
+    }
+
+    //==============================================================================
+    static void copyWithRamp (Type* dest, const Type* src, Type startMultiplier, Type increment, int num) noexcept
+    {
+       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        if (const auto numLongOps = num / Mode::numParallel)
+        {
+            // The gains are calculated from the sample indexes rather than accumulated, so that
+            // rounding errors don't build up over long ramps
+            auto indices = getIndices();
+            const auto start = Mode::load1 (startMultiplier), inc = Mode::load1 (increment);
+            const auto step = Mode::load1 ((Type) Mode::numParallel);
+
+            for (int i = 0; i < numLongOps; ++i, dest += Mode::numParallel, src += Mode::numParallel)
+            {
+                Mode::storeU (dest, Mode::mul (Mode::loadU (src), Mode::mulAdd (start, indices, inc)));
+                indices = Mode::add (indices, step);
+            }
+
+            startMultiplier += increment * (Type) (numLongOps * Mode::numParallel);
+            num &= (Mode::numParallel - 1);
+        }
+       #endif
+
+        for (int i = 0; i < num; ++i)
+            dest[i] = src[i] * (startMultiplier + increment * (Type) i);
+    }
+
+    static void addWithRamp (Type* dest, const Type* src, Type startMultiplier, Type increment, int num) noexcept
+    {
+       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        if (const auto numLongOps = num / Mode::numParallel)
+        {
+            // The gains are calculated from the sample indexes rather than accumulated, so that
+            // rounding errors don't build up over long ramps
+            auto indices = getIndices();
+            const auto start = Mode::load1 (startMultiplier), inc = Mode::load1 (increment);
+            const auto step = Mode::load1 ((Type) Mode::numParallel);
+
+            for (int i = 0; i < numLongOps; ++i, dest += Mode::numParallel, src += Mode::numParallel)
+            {
+                Mode::storeU (dest, Mode::mulAdd (Mode::loadU (dest), Mode::loadU (src), Mode::mulAdd (start, indices, inc)));
+                indices = Mode::add (indices, step);
+            }
+
+            startMultiplier += increment * (Type) (numLongOps * Mode::numParallel);
+            num &= (Mode::numParallel - 1);
+        }
+       #endif
+
+        for (int i = 0; i < num; ++i)
+            dest[i] += src[i] * (startMultiplier + increment * (Type) i);
+    }
+
+    static void multiplyAdd (Type* dest, const Type* src1, const Type* src2, const Type* src3, int num) noexcept
+    {
+       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        if (const auto numLongOps = num / Mode::numParallel)
+        {
+            for (int i = 0; i < numLongOps; ++i)
+            {
+                Mode::storeU (dest, Mode::mulAdd (Mode::loadU (src3), Mode::loadU (src1), Mode::loadU (src2)));
+                dest += Mode::numParallel;
+                src1 += Mode::numParallel;
+                src2 += Mode::numParallel;
+                src3 += Mode::numParallel;
+            }
+
+            num &= (Mode::numParallel - 1);
+        }
+       #endif
+
+        for (int i = 0; i < num; ++i)
+            dest[i] = src1[i] * src2[i] + src3[i];
+    }
+
+    //==============================================================================
+    static void interleave (Type* dest, const Type* const* src, int numChannels, int num) noexcept
+    {
+        int start = 0;
+
+       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        if (numChannels == 2)
+        {
+            for (; start + Mode::numParallel <= num; start += Mode::numParallel)
+                Mode::interleave2 (dest + 2 * start, Mode::loadU (src[0] + start), Mode::loadU (src[1] + start));
+        }
+       #endif
+
+        for (int chan = 0; chan < numChannels; ++chan)
+        {
+            auto* s = src[chan];
+
+            for (int i = start; i < num; ++i)
+                dest[i * numChannels + chan] = s[i];
+        }
+    }
+
+    static void deinterleave (Type* const* dest, const Type* src, int numChannels, int num) noexcept
+    {
+        int start = 0;
+
+       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        if (numChannels == 2)
+        {
+            for (; start + Mode::numParallel <= num; start += Mode::numParallel)
+            {
+                ParallelType a, b;
+                Mode::deinterleave2 (src + 2 * start, a, b);
+                Mode::storeU (dest[0] + start, a);
+                Mode::storeU (dest[1] + start, b);
+            }
+        }
+       #endif
+
+        for (int chan = 0; chan < numChannels; ++chan)
+        {
+            auto* d = dest[chan];
+
+            for (int i = start; i < num; ++i)
+                d[i] = src[i * numChannels + chan];
+        }
+    }
+
+private:
+   #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+    static forcedinline Type addLanes (ParallelType v) noexcept
+    {
+        Type lanes[Mode::numParallel];
+        Mode::storeU (lanes, v);
+
+        Type result = 0;
+
+        for (auto lane : lanes)
+            result += lane;
+
+        return result;
+    }
+
+    static forcedinline ParallelType getIndices() noexcept
+    {
+        Type indices[Mode::numParallel];
+
+        for (int i = 0; i < Mode::numParallel; ++i)
+            indices[i] = (Type) i;
+
+        return Mode::loadU (indices);
+    }
+   #endif
+};
+
+template <typename Type>
+using KernelsFor = Kernels<typename ModeType<sizeof (Type)>::Mode>;
@@ -25,14 +25,15 @@ namespace juce
 
 namespace FloatVectorHelpers
 {
-    #define JUCE_INCREMENT_SRC_DEST         dest += (16 / sizeof (*dest)); src += (16 / sizeof (*dest));
-    #define JUCE_INCREMENT_SRC1_SRC2_DEST   dest += (16 / sizeof (*dest)); src1 += (16 / sizeof (*dest)); src2 += (16 / sizeof (*dest));
-    #define JUCE_INCREMENT_DEST             dest += (16 / sizeof (*dest));
+    #define JUCE_INCREMENT_SRC_DEST         dest += Mode::numParallel; src += Mode::numParallel;
+    #define JUCE_INCREMENT_SRC1_SRC2_DEST   dest += Mode::numParallel; src1 += Mode::numParallel; src2 += Mode::numParallel;
+    #define JUCE_INCREMENT_DEST             dest += Mode::numParallel;
 
    #if JUCE_USE_SSE_INTRINSICS
+    template <typename Mode>
     static bool isAligned (const void* p) noexcept
     {
-        return (((pointer_sized_int) p) & 15) == 0;
+        return (((pointer_sized_int) p) & (pointer_sized_int) (sizeof (typename Mode::ParallelType) - 1)) == 0;
     }
 
     struct BasicOps32
@@ -52,17 +53,35 @@ namespace FloatVectorHelpers
         static forcedinline void storeA (Type* dest, ParallelType a) noexcept           { _mm_store_ps (dest, a); }
         static forcedinline void storeU (Type* dest, ParallelType a) noexcept           { _mm_storeu_ps (dest, a); }
 
+        static forcedinline ParallelType fromIntegers (const int* v) noexcept           { return _mm_cvtepi32_ps (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (v))); }
+
         static forcedinline ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm_add_ps (a, b); }
         static forcedinline ParallelType sub (ParallelType a, ParallelType b) noexcept  { return _mm_sub_ps (a, b); }
         static forcedinline ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm_mul_ps (a, b); }
         static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm_max_ps (a, b); }
         static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm_min_ps (a, b); }
 
+        static forcedinline ParallelType mulAdd (ParallelType a, ParallelType b, ParallelType c) noexcept  { return _mm_add_ps (a, _mm_mul_ps (b, c)); }
+        static forcedinline ParallelType mulSub (ParallelType a, ParallelType b, ParallelType c) noexcept  { return _mm_sub_ps (a, _mm_mul_ps (b, c)); }
+
         static forcedinline ParallelType bit_and (ParallelType a, ParallelType b) noexcept  { return _mm_and_ps (a, b); }
         static forcedinline ParallelType bit_not (ParallelType a, ParallelType b) noexcept  { return _mm_andnot_ps (a, b); }
         static forcedinline ParallelType bit_or  (ParallelType a, ParallelType b) noexcept  { return _mm_or_ps (a, b); }
         static forcedinline ParallelType bit_xor (ParallelType a, ParallelType b) noexcept  { return _mm_xor_ps (a, b); }
 
+        static forcedinline void interleave2 (Type* dest, ParallelType a, ParallelType b) noexcept
+        {
+            storeU (dest,     _mm_unpacklo_ps (a, b));
+            storeU (dest + 4, _mm_unpackhi_ps (a, b));
+        }
+
+        static forcedinline void deinterleave2 (const Type* src, ParallelType& a, ParallelType& b) noexcept
+        {
+            auto x = loadU (src), y = loadU (src + 4);
+            a = _mm_shuffle_ps (x, y, _MM_SHUFFLE (2, 0, 2, 0));
+            b = _mm_shuffle_ps (x, y, _MM_SHUFFLE (3, 1, 3, 1));
+        }
+
         static forcedinline Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmax (v[0], v[1], v[2], v[3]); }
         static forcedinline Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmin (v[0], v[1], v[2], v[3]); }
     };
@@ -90,11 +109,27 @@ namespace FloatVectorHelpers
         static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm_max_pd (a, b); }
         static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm_min_pd (a, b); }
 
+        static forcedinline ParallelType mulAdd (ParallelType a, ParallelType b, ParallelType c) noexcept  { return _mm_add_pd (a, _mm_mul_pd (b, c)); }
+        static forcedinline ParallelType mulSub (ParallelType a, ParallelType b, ParallelType c) noexcept  { return _mm_sub_pd (a, _mm_mul_pd (b, c)); }
+
         static forcedinline ParallelType bit_and (ParallelType a, ParallelType b) noexcept  { return _mm_and_pd (a, b); }
         static forcedinline ParallelType bit_not (ParallelType a, ParallelType b) noexcept  { return _mm_andnot_pd (a, b); }
         static forcedinline ParallelType bit_or  (ParallelType a, ParallelType b) noexcept  { return _mm_or_pd (a, b); }
         static forcedinline ParallelType bit_xor (ParallelType a, ParallelType b) noexcept  { return _mm_xor_pd (a, b); }
 
+        static forcedinline void interleave2 (Type* dest, ParallelType a, ParallelType b) noexcept
+        {
+            storeU (dest,     _mm_unpacklo_pd (a, b));
+            storeU (dest + 2, _mm_unpackhi_pd (a, b));
+        }
+
+        static forcedinline void deinterleave2 (const Type* src, ParallelType& a, ParallelType& b) noexcept
+        {
+            auto x = loadU (src), y = loadU (src + 2);
+            a = _mm_unpacklo_pd (x, y);
+            b = _mm_unpackhi_pd (x, y);
+        }
+
         static forcedinline Type max (ParallelType a) noexcept  { Type v[numParallel]; storeU (v, a); return jmax (v[0], v[1]); }
         static forcedinline Type min (ParallelType a) noexcept  { Type v[numParallel]; storeU (v, a); return jmin (v[0], v[1]); }
     };
@@ -102,7 +137,6 @@ namespace FloatVectorHelpers
 
 
     #define JUCE_BEGIN_VEC_OP \
-        using Mode = FloatVectorHelpers::ModeType<sizeof(*dest)>::Mode; \
         { \
             const int numLongOps = num / Mode::numParallel;
 
@@ -115,52 +149,52 @@ namespace FloatVectorHelpers
     #define JUCE_PERFORM_VEC_OP_DEST(normalOp, vecOp, locals, setupOp) \
         JUCE_BEGIN_VEC_OP \
         setupOp \
-        if (FloatVectorHelpers::isAligned (dest))   JUCE_VEC_LOOP (vecOp, dummy, Mode::loadA, Mode::storeA, locals, JUCE_INCREMENT_DEST) \
-        else                                        JUCE_VEC_LOOP (vecOp, dummy, Mode::loadU, Mode::storeU, locals, JUCE_INCREMENT_DEST) \
+        if (FloatVectorHelpers::isAligned<Mode> (dest))   JUCE_VEC_LOOP (vecOp, dummy, Mode::loadA, Mode::storeA, locals, JUCE_INCREMENT_DEST) \
+        else                                              JUCE_VEC_LOOP (vecOp, dummy, Mode::loadU, Mode::storeU, locals, JUCE_INCREMENT_DEST) \
         JUCE_FINISH_VEC_OP (normalOp)
 
     #define JUCE_PERFORM_VEC_OP_SRC_DEST(normalOp, vecOp, locals, increment, setupOp) \
         JUCE_BEGIN_VEC_OP \
         setupOp \
-        if (FloatVectorHelpers::isAligned (dest)) \
+        if (FloatVectorHelpers::isAligned<Mode> (dest)) \
         { \
-            if (FloatVectorHelpers::isAligned (src)) JUCE_VEC_LOOP (vecOp, Mode::loadA, Mode::loadA, Mode::storeA, locals, increment) \
-            else                                     JUCE_VEC_LOOP (vecOp, Mode::loadU, Mode::loadA, Mode::storeA, locals, increment) \
+            if (FloatVectorHelpers::isAligned<Mode> (src)) JUCE_VEC_LOOP (vecOp, Mode::loadA, Mode::loadA, Mode::storeA, locals, increment) \
+            else                                           JUCE_VEC_LOOP (vecOp, Mode::loadU, Mode::loadA, Mode::storeA, locals, increment) \
         }\
         else \
         { \
-            if (FloatVectorHelpers::isAligned (src)) JUCE_VEC_LOOP (vecOp, Mode::loadA, Mode::loadU, Mode::storeU, locals, increment) \
-            else                                     JUCE_VEC_LOOP (vecOp, Mode::loadU, Mode::loadU, Mode::storeU, locals, increment) \
+            if (FloatVectorHelpers::isAligned<Mode> (src)) JUCE_VEC_LOOP (vecOp, Mode::loadA, Mode::loadU, Mode::storeU, locals, increment) \
+            else                                           JUCE_VEC_LOOP (vecOp, Mode::loadU, Mode::loadU, Mode::storeU, locals, increment) \
         } \
         JUCE_FINISH_VEC_OP (normalOp)
 
     #define JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST(normalOp, vecOp, locals, increment, setupOp) \
         JUCE_BEGIN_VEC_OP \
         setupOp \
-        if (FloatVectorHelpers::isAligned (dest)) \
+        if (FloatVectorHelpers::isAligned<Mode> (dest)) \
         { \
-            if (FloatVectorHelpers::isAligned (src1)) \
+            if (FloatVectorHelpers::isAligned<Mode> (src1)) \
             { \
-                if (FloatVectorHelpers::isAligned (src2))   JUCE_VEC_LOOP_TWO_SOURCES (vecOp, Mode::loadA, Mode::loadA, Mode::storeA, locals, increment) \
-                else                                        JUCE_VEC_LOOP_TWO_SOURCES (vecOp, Mode::loadA, Mode::loadU, Mode::storeA, locals, increment) \
+                if (FloatVectorHelpers::isAligned<Mode> (src2))   JUCE_VEC_LOOP_TWO_SOURCES (vecOp, Mode::loadA, Mode::loadA, Mode::storeA, locals, increment) \
+                else                                              JUCE_VEC_LOOP_TWO_SOURCES (vecOp, Mode::loadA, Mode::loadU, Mode::storeA, locals, increment) \
             } \
             else \
             { \
-                if (FloatVectorHelpers::isAligned (src2))   JUCE_VEC_LOOP_TWO_SOURCES (vecOp, Mode::loadU, Mode::loadA, Mode::storeA, locals, increment) \
-                else                                        JUCE_VEC_LOOP_TWO_SOURCES (vecOp, Mode::loadU, Mode::loadU, Mode::storeA, locals, increment) \
+                if (FloatVectorHelpers::isAligned<Mode> (src2))   JUCE_VEC_LOOP_TWO_SOURCES (vecOp, Mode::loadU, Mode::loadA, Mode::storeA, locals, increment) \
+                else                                              JUCE_VEC_LOOP_TWO_SOURCES (vecOp, Mode::loadU, Mode::loadU, Mode::storeA, locals, increment) \
             } \
         } \
         else \
         { \
-            if (FloatVectorHelpers::isAligned (src1)) \
+            if (FloatVectorHelpers::isAligned<Mode> (src1)) \
             { \
-                if (FloatVectorHelpers::isAligned (src2))   JUCE_VEC_LOOP_TWO_SOURCES (vecOp, Mode::loadA, Mode::loadA, Mode::storeU, locals, increment) \
-                else                                        JUCE_VEC_LOOP_TWO_SOURCES (vecOp, Mode::loadA, Mode::loadU, Mode::storeU, locals, increment) \
+                if (FloatVectorHelpers::isAligned<Mode> (src2))   JUCE_VEC_LOOP_TWO_SOURCES (vecOp, Mode::loadA, Mode::loadA, Mode::storeU, locals, increment) \
+                else                                              JUCE_VEC_LOOP_TWO_SOURCES (vecOp, Mode::loadA, Mode::loadU, Mode::storeU, locals, increment) \
             } \
             else \
             { \
-                if (FloatVectorHelpers::isAligned (src2))   JUCE_VEC_LOOP_TWO_SOURCES (vecOp, Mode::loadU, Mode::loadA, Mode::storeU, locals, increment) \
-                else                                        JUCE_VEC_LOOP_TWO_SOURCES (vecOp, Mode::loadU, Mode::loadU, Mode::storeU, locals, increment) \
+                if (FloatVectorHelpers::isAligned<Mode> (src2))   JUCE_VEC_LOOP_TWO_SOURCES (vecOp, Mode::loadU, Mode::loadA, Mode::storeU, locals, increment) \
+                else                                              JUCE_VEC_LOOP_TWO_SOURCES (vecOp, Mode::loadU, Mode::loadU, Mode::storeU, locals, increment) \
             } \
         } \
         JUCE_FINISH_VEC_OP (normalOp)
@@ -168,30 +202,30 @@ namespace FloatVectorHelpers
     #define JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST(normalOp, vecOp, locals, increment, setupOp) \
         JUCE_BEGIN_VEC_OP \
         setupOp \
-        if (FloatVectorHelpers::isAligned (dest)) \
+        if (FloatVectorHelpers::isAligned<Mode> (dest)) \
         { \
-            if (FloatVectorHelpers::isAligned (src1)) \
+            if (FloatVectorHelpers::isAligned<Mode> (src1)) \
             { \
-                if (FloatVectorHelpers::isAligned (src2))   JUCE_VEC_LOOP_TWO_SOURCES_WITH_DEST_LOAD (vecOp, Mode::loadA, Mode::loadA, Mode::loadA, Mode::storeA, locals, increment) \
-                else                                        JUCE_VEC_LOOP_TWO_SOURCES_WITH_DEST_LOAD (vecOp, Mode::loadA, Mode::loadU, Mode::loadA, Mode::storeA, locals, increment) \
+                if (FloatVectorHelpers::isAligned<Mode> (src2))   JUCE_VEC_LOOP_TWO_SOURCES_WITH_DEST_LOAD (vecOp, Mode::loadA, Mode::loadA, Mode::loadA, Mode::storeA, locals, increment) \
+                else                                              JUCE_VEC_LOOP_TWO_SOURCES_WITH_DEST_LOAD (vecOp, Mode::loadA, Mode::loadU, Mode::loadA, Mode::storeA, locals, increment) \
             } \
             else \
             { \
-                if (FloatVectorHelpers::isAligned (src2))   JUCE_VEC_LOOP_TWO_SOURCES_WITH_DEST_LOAD (vecOp, Mode::loadU, Mode::loadA, Mode::loadA, Mode::storeA, locals, increment) \
-                else                                        JUCE_VEC_LOOP_TWO_SOURCES_WITH_DEST_LOAD (vecOp, Mode::loadU, Mode::loadU, Mode::loadA, Mode::storeA, locals, increment) \
+                if (FloatVectorHelpers::isAligned<Mode> (src2))   JUCE_VEC_LOOP_TWO_SOURCES_WITH_DEST_LOAD (vecOp, Mode::loadU, Mode::loadA, Mode::loadA, Mode::storeA, locals, increment) \
+                else                                              JUCE_VEC_LOOP_TWO_SOURCES_WITH_DEST_LOAD (vecOp, Mode::loadU, Mode::loadU, Mode::loadA, Mode::storeA, locals, increment) \
             } \
         } \
         else \
         { \
-            if (FloatVectorHelpers::isAligned (src1)) \
+            if (FloatVectorHelpers::isAligned<Mode> (src1)) \
             { \
-                if (FloatVectorHelpers::isAligned (src2))   JUCE_VEC_LOOP_TWO_SOURCES_WITH_DEST_LOAD (vecOp, Mode::loadA, Mode::loadA, Mode::loadU, Mode::storeU, locals, increment) \
-                else                                        JUCE_VEC_LOOP_TWO_SOURCES_WITH_DEST_LOAD (vecOp, Mode::loadA, Mode::loadU, Mode::loadU, Mode::storeU, locals, increment) \
+                if (FloatVectorHelpers::isAligned<Mode> (src2))   JUCE_VEC_LOOP_TWO_SOURCES_WITH_DEST_LOAD (vecOp, Mode::loadA, Mode::loadA, Mode::loadU, Mode::storeU, locals, increment) \
+                else                                              JUCE_VEC_LOOP_TWO_SOURCES_WITH_DEST_LOAD (vecOp, Mode::loadA, Mode::loadU, Mode::loadU, Mode::storeU, locals, increment) \
             } \
             else \
             { \
-                if (FloatVectorHelpers::isAligned (src2))   JUCE_VEC_LOOP_TWO_SOURCES_WITH_DEST_LOAD (vecOp, Mode::loadU, Mode::loadA, Mode::loadU, Mode::storeU, locals, increment) \
-                else                                        JUCE_VEC_LOOP_TWO_SOURCES_WITH_DEST_LOAD (vecOp, Mode::loadU, Mode::loadU, Mode::loadU, Mode::storeU, locals, increment) \
+                if (FloatVectorHelpers::isAligned<Mode> (src2))   JUCE_VEC_LOOP_TWO_SOURCES_WITH_DEST_LOAD (vecOp, Mode::loadU, Mode::loadA, Mode::loadU, Mode::storeU, locals, increment) \
+                else                                              JUCE_VEC_LOOP_TWO_SOURCES_WITH_DEST_LOAD (vecOp, Mode::loadU, Mode::loadU, Mode::loadU, Mode::storeU, locals, increment) \
             } \
         } \
         JUCE_FINISH_VEC_OP (normalOp)
@@ -217,17 +251,25 @@ namespace FloatVectorHelpers
         static forcedinline void storeA (Type* dest, ParallelType a) noexcept           { vst1q_f32 (dest, a); }
         static forcedinline void storeU (Type* dest, ParallelType a) noexcept           { vst1q_f32 (dest, a); }
 
+        static forcedinline ParallelType fromIntegers (const int* v) noexcept           { return vcvtq_f32_s32 (vld1q_s32 (v)); }
+
         static forcedinline ParallelType add (ParallelType a, ParallelType b) noexcept  { return vaddq_f32 (a, b); }
         static forcedinline ParallelType sub (ParallelType a, ParallelType b) noexcept  { return vsubq_f32 (a, b); }
         static forcedinline ParallelType mul (ParallelType a, ParallelType b) noexcept  { return vmulq_f32 (a, b); }
         static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept  { return vmaxq_f32 (a, b); }
         static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept  { return vminq_f32 (a, b); }
 
+        static forcedinline ParallelType mulAdd (ParallelType a, ParallelType b, ParallelType c) noexcept  { return vaddq_f32 (a, vmulq_f32 (b, c)); }
+        static forcedinline ParallelType mulSub (ParallelType a, ParallelType b, ParallelType c) noexcept  { return vsubq_f32 (a, vmulq_f32 (b, c)); }
+
         static forcedinline ParallelType bit_and (ParallelType a, ParallelType b) noexcept  {  return toflt (vandq_u32 (toint (a), toint (b))); }
         static forcedinline ParallelType bit_not (ParallelType a, ParallelType b) noexcept  {  return toflt (vbicq_u32 (toint (a), toint (b))); }
         static forcedinline ParallelType bit_or  (ParallelType a, ParallelType b) noexcept  {  return toflt (vorrq_u32 (toint (a), toint (b))); }
         static forcedinline ParallelType bit_xor (ParallelType a, ParallelType b) noexcept  {  return toflt (veorq_u32 (toint (a), toint (b))); }
 
+        static forcedinline void interleave2 (Type* dest, ParallelType a, ParallelType b) noexcept         { vst2q_f32 (dest, float32x4x2_t { { a, b } }); }
+        static forcedinline void deinterleave2 (const Type* src, ParallelType& a, ParallelType& b) noexcept { auto v = vld2q_f32 (src); a = v.val[0]; b = v.val[1]; }
+
         static forcedinline Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmax (v[0], v[1], v[2], v[3]); }
         static forcedinline Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmin (v[0], v[1], v[2], v[3]); }
     };
@@ -255,17 +297,22 @@ namespace FloatVectorHelpers
         static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept  { return jmax (a, b); }
         static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept  { return jmin (a, b); }
 
+        static forcedinline ParallelType mulAdd (ParallelType a, ParallelType b, ParallelType c) noexcept  { return a + b * c; }
+        static forcedinline ParallelType mulSub (ParallelType a, ParallelType b, ParallelType c) noexcept  { return a - b * c; }
+
         static forcedinline ParallelType bit_and (ParallelType a, ParallelType b) noexcept  {  return toflt (toint (a) & toint (b)); }
         static forcedinline ParallelType bit_not (ParallelType a, ParallelType b) noexcept  {  return toflt ((~toint (a)) & toint (b)); }
         static forcedinline ParallelType bit_or  (ParallelType a, ParallelType b) noexcept  {  return toflt (toint (a) | toint (b)); }
         static forcedinline ParallelType bit_xor (ParallelType a, ParallelType b) noexcept  {  return toflt (toint (a) ^ toint (b)); }
 
+        static forcedinline void interleave2 (Type* dest, ParallelType a, ParallelType b) noexcept         { dest[0] = a; dest[1] = b; }
+        static forcedinline void deinterleave2 (const Type* src, ParallelType& a, ParallelType& b) noexcept { a = src[0]; b = src[1]; }
+
         static forcedinline Type max (ParallelType a) noexcept  { return a; }
         static forcedinline Type min (ParallelType a) noexcept  { return a; }
     };
 
     #define JUCE_BEGIN_VEC_OP \
-        using Mode = FloatVectorHelpers::ModeType<sizeof(*dest)>::Mode; \
         if (Mode::numParallel > 1) \
         { \
             const int numLongOps = num / Mode::numParallel;
@@ -303,6 +350,16 @@ namespace FloatVectorHelpers
 
     //==============================================================================
    #else
+    template <typename FloatType>
+    struct BasicOpsScalar
+    {
+        using Type = FloatType;
+        using ParallelType = FloatType;
+    };
+
+    using BasicOps32 = BasicOpsScalar<float>;
+    using BasicOps64 = BasicOpsScalar<double>;
+
     #define JUCE_PERFORM_VEC_OP_DEST(normalOp, vecOp, locals, setupOp) \
         for (int i = 0; i < num; ++i) normalOp;
 
@@ -343,147 +400,333 @@ namespace FloatVectorHelpers
         }
 
     #define JUCE_LOAD_NONE(srcLoad, dstLoad)
-    #define JUCE_LOAD_DEST(srcLoad, dstLoad)                        const Mode::ParallelType d = dstLoad (dest);
-    #define JUCE_LOAD_SRC(srcLoad, dstLoad)                         const Mode::ParallelType s = srcLoad (src);
-    #define JUCE_LOAD_SRC1_SRC2(src1Load, src2Load)                 const Mode::ParallelType s1 = src1Load (src1), s2 = src2Load (src2);
-    #define JUCE_LOAD_SRC1_SRC2_DEST(src1Load, src2Load, dstLoad)   const Mode::ParallelType d = dstLoad (dest), s1 = src1Load (src1), s2 = src2Load (src2);
-    #define JUCE_LOAD_SRC_DEST(srcLoad, dstLoad)                    const Mode::ParallelType d = dstLoad (dest), s = srcLoad (src);
-
-    union signMask32 { float  f; uint32 i; };
-    union signMask64 { double d; uint64 i; };
+    #define JUCE_LOAD_DEST(srcLoad, dstLoad)                        const ParallelType d = dstLoad (dest);
+    #define JUCE_LOAD_SRC(srcLoad, dstLoad)                         const ParallelType s = srcLoad (src);
+    #define JUCE_LOAD_SRC1_SRC2(src1Load, src2Load)                 const ParallelType s1 = src1Load (src1), s2 = src2Load (src2);
+    #define JUCE_LOAD_SRC1_SRC2_DEST(src1Load, src2Load, dstLoad)   const ParallelType d = dstLoad (dest), s1 = src1Load (src1), s2 = src2Load (src2);
+    #define JUCE_LOAD_SRC_DEST(srcLoad, dstLoad)                    const ParallelType d = dstLoad (dest), s = srcLoad (src);
 
-   #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
     template <int typeSize> struct ModeType    { using Mode = BasicOps32; };
     template <>             struct ModeType<8> { using Mode = BasicOps64; };
 
-    template <typename Mode>
-    struct MinMax
-    {
-        using Type = typename Mode::Type;
-        using ParallelType = typename Mode::ParallelType;
+    #include "juce_FloatVectorOperationKernels.h"
 
-        static Type findMinOrMax (const Type* src, int num, const bool isMinimum) noexcept
+   #if JUCE_USE_FLOAT_VECTOR_DISPATCH
+    //==============================================================================
+    /*  The AVX2 and AVX-512 versions of the kernels are compiled for those instruction
+        sets regardless of the compiler flags used for the rest of the module, and
+        they're only ever called after checking that the CPU supports them.
+    */
+    namespace AVX2
+    {
+       #if JUCE_CLANG
+        #pragma clang attribute push (__attribute__ ((target ("avx2,fma"))), apply_to = function)
+       #elif JUCE_GCC
+        #pragma GCC push_options
+        #pragma GCC target ("avx2,fma")
+       #endif
+
+        struct BasicOps32
         {
-            int numLongOps = num / Mode::numParallel;
+            using Type = float;
+            using ParallelType = __m256;
+            using IntegerType  = __m256;
+            enum { numParallel = 8 };
+
+            static forcedinline IntegerType toint (ParallelType v) noexcept                 { return v; }
+            static forcedinline ParallelType toflt (IntegerType v) noexcept                 { return v; }
+
+            static forcedinline ParallelType load1 (Type v) noexcept                        { return _mm256_set1_ps (v); }
+            static forcedinline ParallelType loadA (const Type* v) noexcept                 { return _mm256_load_ps (v); }
+            static forcedinline ParallelType loadU (const Type* v) noexcept                 { return _mm256_loadu_ps (v); }
+            static forcedinline void storeA (Type* dest, ParallelType a) noexcept           { _mm256_store_ps (dest, a); }
+            static forcedinline void storeU (Type* dest, ParallelType a) noexcept           { _mm256_storeu_ps (dest, a); }
+
+            static forcedinline ParallelType fromIntegers (const int* v) noexcept           { return _mm256_cvtepi32_ps (_mm256_loadu_si256 (reinterpret_cast<const __m256i*> (v))); }
+
+            static forcedinline ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm256_add_ps (a, b); }
+            static forcedinline ParallelType sub (ParallelType a, ParallelType b) noexcept  { return _mm256_sub_ps (a, b); }
+            static forcedinline ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm256_mul_ps (a, b); }
+            static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm256_max_ps (a, b); }
+            static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm256_min_ps (a, b); }
 
-            if (numLongOps > 1)
+            static forcedinline ParallelType mulAdd (ParallelType a, ParallelType b, ParallelType c) noexcept  { return _mm256_fmadd_ps (b, c, a); }
+            static forcedinline ParallelType mulSub (ParallelType a, ParallelType b, ParallelType c) noexcept  { return _mm256_fnmadd_ps (b, c, a); }
+
+            static forcedinline ParallelType bit_and (ParallelType a, ParallelType b) noexcept  { return _mm256_and_ps (a, b); }
+            static forcedinline ParallelType bit_not (ParallelType a, ParallelType b) noexcept  { return _mm256_andnot_ps (a, b); }
+            static forcedinline ParallelType bit_or  (ParallelType a, ParallelType b) noexcept  { return _mm256_or_ps (a, b); }
+            static forcedinline ParallelType bit_xor (ParallelType a, ParallelType b) noexcept  { return _mm256_xor_ps (a, b); }
+
+            static forcedinline void interleave2 (Type* dest, ParallelType a, ParallelType b) noexcept
             {
-                ParallelType val;
-
-               #if ! JUCE_USE_ARM_NEON
-                if (isAligned (src))
-                {
-                    val = Mode::loadA (src);
-
-                    if (isMinimum)
-                    {
-                        while (--numLongOps > 0)
-                        {
-                            src += Mode::numParallel;
-                            val = Mode::min (val, Mode::loadA (src));
-                        }
-                    }
-                    else
-                    {
-                        while (--numLongOps > 0)
-                        {
-                            src += Mode::numParallel;
-                            val = Mode::max (val, Mode::loadA (src));
-                        }
-                    }
-                }
-                else
-               #endif
-                {
-                    val = Mode::loadU (src);
-
-                    if (isMinimum)
-                    {
-                        while (--numLongOps > 0)
-                        {
-                            src += Mode::numParallel;
-                            val = Mode::min (val, Mode::loadU (src));
-                        }
-                    }
-                    else
-                    {
-                        while (--numLongOps > 0)
-                        {
-                            src += Mode::numParallel;
-                            val = Mode::max (val, Mode::loadU (src));
-                        }
-                    }
-                }
-
-                Type result = isMinimum ? Mode::min (val)
-                                        : Mode::max (val);
-
-                num &= (Mode::numParallel - 1);
-                src += Mode::numParallel;
+                auto lo = _mm256_unpacklo_ps (a, b), hi = _mm256_unpackhi_ps (a, b);
+                storeU (dest,     _mm256_permute2f128_ps (lo, hi, 0x20));
+                storeU (dest + 8, _mm256_permute2f128_ps (lo, hi, 0x31));
+            }
 
-                for (int i = 0; i < num; ++i)
-                    result = isMinimum ? jmin (result, src[i])
-                                       : jmax (result, src[i]);
+            static forcedinline void deinterleave2 (const Type* src, ParallelType& a, ParallelType& b) noexcept
+            {
+                auto x = loadU (src), y = loadU (src + 8);
+                a = _mm256_castpd_ps (_mm256_permute4x64_pd (_mm256_castps_pd (_mm256_shuffle_ps (x, y, _MM_SHUFFLE (2, 0, 2, 0))), _MM_SHUFFLE (3, 1, 2, 0)));
+                b = _mm256_castpd_ps (_mm256_permute4x64_pd (_mm256_castps_pd (_mm256_shuffle_ps (x, y, _MM_SHUFFLE (3, 1, 3, 1))), _MM_SHUFFLE (3, 1, 2, 0)));
+            }
+
+            static forcedinline Type max (ParallelType a) noexcept { return FloatVectorHelpers::BasicOps32::max (_mm_max_ps (_mm256_castps256_ps128 (a), _mm256_extractf128_ps (a, 1))); }
+            static forcedinline Type min (ParallelType a) noexcept { return FloatVectorHelpers::BasicOps32::min (_mm_min_ps (_mm256_castps256_ps128 (a), _mm256_extractf128_ps (a, 1))); }
+        };
 
-                return result;
+        struct BasicOps64
+        {
+            using Type = double;
+            using ParallelType = __m256d;
+            using IntegerType  = __m256d;
+            enum { numParallel = 4 };
+
+            static forcedinline IntegerType toint (ParallelType v) noexcept                 { return v; }
+            static forcedinline ParallelType toflt (IntegerType v) noexcept                 { return v; }
+
+            static forcedinline ParallelType load1 (Type v) noexcept                        { return _mm256_set1_pd (v); }
+            static forcedinline ParallelType loadA (const Type* v) noexcept                 { return _mm256_load_pd (v); }
+            static forcedinline ParallelType loadU (const Type* v) noexcept                 { return _mm256_loadu_pd (v); }
+            static forcedinline void storeA (Type* dest, ParallelType a) noexcept           { _mm256_store_pd (dest, a); }
+            static forcedinline void storeU (Type* dest, ParallelType a) noexcept           { _mm256_storeu_pd (dest, a); }
+
+            static forcedinline ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm256_add_pd (a, b); }
+            static forcedinline ParallelType sub (ParallelType a, ParallelType b) noexcept  { return _mm256_sub_pd (a, b); }
+            static forcedinline ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm256_mul_pd (a, b); }
+            static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm256_max_pd (a, b); }
+            static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm256_min_pd (a, b); }
+
+            static forcedinline ParallelType mulAdd (ParallelType a, ParallelType b, ParallelType c) noexcept  { return _mm256_fmadd_pd (b, c, a); }
+            static forcedinline ParallelType mulSub (ParallelType a, ParallelType b, ParallelType c) noexcept  { return _mm256_fnmadd_pd (b, c, a); }
+
+            static forcedinline ParallelType bit_and (ParallelType a, ParallelType b) noexcept  { return _mm256_and_pd (a, b); }
+            static forcedinline ParallelType bit_not (ParallelType a, ParallelType b) noexcept  { return _mm256_andnot_pd (a, b); }
+            static forcedinline ParallelType bit_or  (ParallelType a, ParallelType b) noexcept  { return _mm256_or_pd (a, b); }
+            static forcedinline ParallelType bit_xor (ParallelType a, ParallelType b) noexcept  { return _mm256_xor_pd (a, b); }
+
+            static forcedinline void interleave2 (Type* dest, ParallelType a, ParallelType b) noexcept
+            {
+                auto lo = _mm256_unpacklo_pd (a, b), hi = _mm256_unpackhi_pd (a, b);
+                storeU (dest,     _mm256_permute2f128_pd (lo, hi, 0x20));
+                storeU (dest + 4, _mm256_permute2f128_pd (lo, hi, 0x31));
             }
 
-            return isMinimum ? juce::findMinimum (src, num)
-                             : juce::findMaximum (src, num);
-        }
+            static forcedinline void deinterleave2 (const Type* src, ParallelType& a, ParallelType& b) noexcept
+            {
+                auto x = loadU (src), y = loadU (src + 4);
+                a = _mm256_permute4x64_pd (_mm256_unpacklo_pd (x, y), _MM_SHUFFLE (3, 1, 2, 0));
+                b = _mm256_permute4x64_pd (_mm256_unpackhi_pd (x, y), _MM_SHUFFLE (3, 1, 2, 0));
+            }
+
+            static forcedinline Type max (ParallelType a) noexcept { return FloatVectorHelpers::BasicOps64::max (_mm_max_pd (_mm256_castpd256_pd128 (a), _mm256_extractf128_pd (a, 1))); }
+            static forcedinline Type min (ParallelType a) noexcept { return FloatVectorHelpers::BasicOps64::min (_mm_min_pd (_mm256_castpd256_pd128 (a), _mm256_extractf128_pd (a, 1))); }
+        };
+
+        template <int typeSize> struct ModeType    { using Mode = BasicOps32; };
+        template <>             struct ModeType<8> { using Mode = BasicOps64; };
+
+        #include "juce_FloatVectorOperationKernels.h"
+
+       #if JUCE_CLANG
+        #pragma clang attribute pop
+       #elif JUCE_GCC
+        #pragma GCC pop_options
+       #endif
+    }
 
-        static Range<Type> findMinAndMax (const Type* src, int num) noexcept
+    namespace AVX512
+    {
+        // Some versions of GCC give spurious warnings about the AVX-512 intrinsics
+        JUCE_BEGIN_IGNORE_WARNINGS_GCC_LIKE ("-Wmaybe-uninitialized")
+
+       #if JUCE_CLANG
+        #pragma clang attribute push (__attribute__ ((target ("avx512f,avx2,fma"))), apply_to = function)
+       #elif JUCE_GCC
+        #pragma GCC push_options
+        #pragma GCC target ("avx512f,avx2,fma")
+       #endif
+
+        // The bitwise operations on floating point registers need AVX-512DQ, so these
+        // use the integer versions instead, which only need AVX-512F
+        struct BasicOps32
         {
-            int numLongOps = num / Mode::numParallel;
+            using Type = float;
+            using ParallelType = __m512;
+            using IntegerType  = __m512i;
+            enum { numParallel = 16 };
+
+            static forcedinline IntegerType toint (ParallelType v) noexcept                 { return _mm512_castps_si512 (v); }
+            static forcedinline ParallelType toflt (IntegerType v) noexcept                 { return _mm512_castsi512_ps (v); }
+
+            static forcedinline ParallelType load1 (Type v) noexcept                        { return _mm512_set1_ps (v); }
+            static forcedinline ParallelType loadA (const Type* v) noexcept                 { return _mm512_load_ps (v); }
+            static forcedinline ParallelType loadU (const Type* v) noexcept                 { return _mm512_loadu_ps (v); }
+            static forcedinline void storeA (Type* dest, ParallelType a) noexcept           { _mm512_store_ps (dest, a); }
+            static forcedinline void storeU (Type* dest, ParallelType a) noexcept           { _mm512_storeu_ps (dest, a); }
+
+            static forcedinline ParallelType fromIntegers (const int* v) noexcept           { return _mm512_cvtepi32_ps (_mm512_loadu_si512 (v)); }
+
+            static forcedinline ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm512_add_ps (a, b); }
+            static forcedinline ParallelType sub (ParallelType a, ParallelType b) noexcept  { return _mm512_sub_ps (a, b); }
+            static forcedinline ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm512_mul_ps (a, b); }
+            static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm512_max_ps (a, b); }
+            static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm512_min_ps (a, b); }
+
+            static forcedinline ParallelType mulAdd (ParallelType a, ParallelType b, ParallelType c) noexcept  { return _mm512_fmadd_ps (b, c, a); }
+            static forcedinline ParallelType mulSub (ParallelType a, ParallelType b, ParallelType c) noexcept  { return _mm512_fnmadd_ps (b, c, a); }
+
+            static forcedinline ParallelType bit_and (ParallelType a, ParallelType b) noexcept  { return toflt (_mm512_and_si512 (toint (a), toint (b))); }
+            static forcedinline ParallelType bit_not (ParallelType a, ParallelType b) noexcept  { return toflt (_mm512_andnot_si512 (toint (a), toint (b))); }
+            static forcedinline ParallelType bit_or  (ParallelType a, ParallelType b) noexcept  { return toflt (_mm512_or_si512 (toint (a), toint (b))); }
+            static forcedinline ParallelType bit_xor (ParallelType a, ParallelType b) noexcept  { return toflt (_mm512_xor_si512 (toint (a), toint (b))); }
+
+            static forcedinline __m256 upperHalf (ParallelType a) noexcept  { return _mm256_castpd_ps (_mm512_extractf64x4_pd (_mm512_castps_pd (a), 1)); }
+
+            static forcedinline Type max (ParallelType a) noexcept { return AVX2::BasicOps32::max (_mm256_max_ps (_mm512_castps512_ps256 (a), upperHalf (a))); }
 
-            if (numLongOps > 1)
+            static forcedinline void interleave2 (Type* dest, ParallelType a, ParallelType b) noexcept
             {
-                ParallelType mn, mx;
-
-               #if ! JUCE_USE_ARM_NEON
-                if (isAligned (src))
-                {
-                    mn = Mode::loadA (src);
-                    mx = mn;
-
-                    while (--numLongOps > 0)
-                    {
-                        src += Mode::numParallel;
-                        const ParallelType v = Mode::loadA (src);
-                        mn = Mode::min (mn, v);
-                        mx = Mode::max (mx, v);
-                    }
-                }
-                else
-               #endif
-                {
-                    mn = Mode::loadU (src);
-                    mx = mn;
-
-                    while (--numLongOps > 0)
-                    {
-                        src += Mode::numParallel;
-                        const ParallelType v = Mode::loadU (src);
-                        mn = Mode::min (mn, v);
-                        mx = Mode::max (mx, v);
-                    }
-                }
-
-                Range<Type> result (Mode::min (mn),
-                                    Mode::max (mx));
-
-                num &= (Mode::numParallel - 1);
-                src += Mode::numParallel;
+                storeU (dest,      _mm512_permutex2var_ps (a, _mm512_setr_epi32 (0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23), b));
+                storeU (dest + 16, _mm512_permutex2var_ps (a, _mm512_setr_epi32 (8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31), b));
+            }
 
-                for (int i = 0; i < num; ++i)
-                    result = result.getUnionWith (src[i]);
+            static forcedinline void deinterleave2 (const Type* src, ParallelType& a, ParallelType& b) noexcept
+            {
+                auto x = loadU (src), y = loadU (src + 16);
+                a = _mm512_permutex2var_ps (x, _mm512_setr_epi32 (0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30), y);
+                b = _mm512_permutex2var_ps (x, _mm512_setr_epi32 (1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31), y);
+            }
+            static forcedinline Type min (ParallelType a) noexcept { return AVX2::BasicOps32::min (_mm256_min_ps (_mm512_castps512_ps256 (a), upperHalf (a))); }
+        };
+
+        struct BasicOps64
+        {
+            using Type = double;
+            using ParallelType = __m512d;
+            using IntegerType  = __m512i;
+            enum { numParallel = 8 };
+
+            static forcedinline IntegerType toint (ParallelType v) noexcept                 { return _mm512_castpd_si512 (v); }
+            static forcedinline ParallelType toflt (IntegerType v) noexcept                 { return _mm512_castsi512_pd (v); }
+
+            static forcedinline ParallelType load1 (Type v) noexcept                        { return _mm512_set1_pd (v); }
+            static forcedinline ParallelType loadA (const Type* v) noexcept                 { return _mm512_load_pd (v); }
+            static forcedinline ParallelType loadU (const Type* v) noexcept                 { return _mm512_loadu_pd (v); }
+            static forcedinline void storeA (Type* dest, ParallelType a) noexcept           { _mm512_store_pd (dest, a); }
+            static forcedinline void storeU (Type* dest, ParallelType a) noexcept           { _mm512_storeu_pd (dest, a); }
 
-                return result;
+            static forcedinline ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm512_add_pd (a, b); }
+            static forcedinline ParallelType sub (ParallelType a, ParallelType b) noexcept  { return _mm512_sub_pd (a, b); }
+            static forcedinline ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm512_mul_pd (a, b); }
+            static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm512_max_pd (a, b); }
+            static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm512_min_pd (a, b); }
+
+            static forcedinline ParallelType mulAdd (ParallelType a, ParallelType b, ParallelType c) noexcept  { return _mm512_fmadd_pd (b, c, a); }
+            static forcedinline ParallelType mulSub (ParallelType a, ParallelType b, ParallelType c) noexcept  { return _mm512_fnmadd_pd (b, c, a); }
+
+            static forcedinline ParallelType bit_and (ParallelType a, ParallelType b) noexcept  { return toflt (_mm512_and_si512 (toint (a), toint (b))); }
+            static forcedinline ParallelType bit_not (ParallelType a, ParallelType b) noexcept  { return toflt (_mm512_andnot_si512 (toint (a), toint (b))); }
+            static forcedinline ParallelType bit_or  (ParallelType a, ParallelType b) noexcept  { return toflt (_mm512_or_si512 (toint (a), toint (b))); }
+            static forcedinline ParallelType bit_xor (ParallelType a, ParallelType b) noexcept  { return toflt (_mm512_xor_si512 (toint (a), toint (b))); }
+
+            static forcedinline Type max (ParallelType a) noexcept { return AVX2::BasicOps64::max (_mm256_max_pd (_mm512_castpd512_pd256 (a), _mm512_extractf64x4_pd (a, 1))); }
+
+            static forcedinline void interleave2 (Type* dest, ParallelType a, ParallelType b) noexcept
+            {
+                storeU (dest,     _mm512_permutex2var_pd (a, _mm512_setr_epi64 (0, 8, 1, 9, 2, 10, 3, 11), b));
+                storeU (dest + 8, _mm512_permutex2var_pd (a, _mm512_setr_epi64 (4, 12, 5, 13, 6, 14, 7, 15), b));
             }
 
-            return Range<Type>::findMinAndMax (src, num);
-        }
+            static forcedinline void deinterleave2 (const Type* src, ParallelType& a, ParallelType& b) noexcept
+            {
+                auto x = loadU (src), y = loadU (src + 8);
+                a = _mm512_permutex2var_pd (x, _mm512_setr_epi64 (0, 2, 4, 6, 8, 10, 12, 14), y);
+                b = _mm512_permutex2var_pd (x, _mm512_setr_epi64 (1, 3, 5, 7, 9, 11, 13, 15), y);
+            }
+            static forcedinline Type min (ParallelType a) noexcept { return AVX2::BasicOps64::min (_mm256_min_pd (_mm512_castpd512_pd256 (a), _mm512_extractf64x4_pd (a, 1))); }
+        };
+
+        template <int typeSize> struct ModeType    { using Mode = BasicOps32; };
+        template <>             struct ModeType<8> { using Mode = BasicOps64; };
+
+        #include "juce_FloatVectorOperationKernels.h"
+
+       #if JUCE_CLANG
+        #pragma clang attribute pop
+       #elif JUCE_GCC
+        #pragma GCC pop_options
+       #endif
+
+        JUCE_END_IGNORE_WARNINGS_GCC_LIKE
+    }
+
+    //==============================================================================
+    enum class InstructionSet
+    {
+        sse,
+        avx2,
+        avx512
     };
+
+    // The CPUID feature flags only say what the CPU supports. The wider registers can only
+    // be used if the OS also saves them on a context switch, which it reports via OSXSAVE
+    // and the XCR0 register.
+    static bool isRegisterStateEnabledByOS (uint64 requiredStateMask) noexcept
+    {
+       #if JUCE_MSVC
+        int info[4];
+        __cpuid (info, 1);
+
+        if ((info[2] & (1 << 27)) == 0)
+            return false;
+
+        auto enabledState = (uint64) _xgetbv (0);
+       #else
+        unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+
+        if (__get_cpuid (1, &eax, &ebx, &ecx, &edx) == 0 || (ecx & (1u << 27)) == 0)
+            return false;
+
+        unsigned int low = 0, high = 0;
+        __asm__ __volatile__ ("xgetbv" : "=a" (low), "=d" (high) : "c" (0));
+        auto enabledState = (((uint64) high) << 32) | low;
+       #endif
+
+        return (enabledState & requiredStateMask) == requiredStateMask;
+    }
+
+    static InstructionSet findBestInstructionSet() noexcept
+    {
+        // AVX-512 needs the opmask and ZMM registers to be saved as well as XMM and YMM
+        if (SystemStats::hasAVX512F() && SystemStats::hasFMA3() && isRegisterStateEnabledByOS (0xe6))
+            return InstructionSet::avx512;
+
+        if (SystemStats::hasAVX2() && SystemStats::hasFMA3() && isRegisterStateEnabledByOS (0x6))
+            return InstructionSet::avx2;
+
+        return InstructionSet::sse;
+    }
+
+    static InstructionSet getInstructionSet() noexcept
+    {
+        static const auto instructionSet = findBestInstructionSet();
+        return instructionSet;
+    }
+
+    #define JUCE_DISPATCH_VEC_OP(Type, call) \
+        switch (FloatVectorHelpers::getInstructionSet()) \
+        { \
+            case FloatVectorHelpers::InstructionSet::avx512:  return FloatVectorHelpers::AVX512::KernelsFor<Type>::call; \
+            case FloatVectorHelpers::InstructionSet::avx2:    return FloatVectorHelpers::AVX2::KernelsFor<Type>::call; \
+            case FloatVectorHelpers::InstructionSet::sse:     break; \
+        } \
+        return FloatVectorHelpers::KernelsFor<Type>::call;
+
+   #else
+    #define JUCE_DISPATCH_VEC_OP(Type, call) \
+        return FloatVectorHelpers::KernelsFor<Type>::call;
    #endif
 }
 
@@ -522,8 +765,7 @@ void JUCE_CALLTYPE FloatVectorOperations::fill (float* dest, float valueToFill,
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vfill (&valueToFill, dest, 1, (size_t) num);
    #else
-    JUCE_PERFORM_VEC_OP_DEST (dest[i] = valueToFill, val, JUCE_LOAD_NONE,
-                              const Mode::ParallelType val = Mode::load1 (valueToFill);)
+    JUCE_DISPATCH_VEC_OP (float, fill (dest, valueToFill, num))
    #endif
 }
 
@@ -532,8 +774,7 @@ void JUCE_CALLTYPE FloatVectorOperations::fill (double* dest, double valueToFill
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vfillD (&valueToFill, dest, 1, (size_t) num);
    #else
-    JUCE_PERFORM_VEC_OP_DEST (dest[i] = valueToFill, val, JUCE_LOAD_NONE,
-                              const Mode::ParallelType val = Mode::load1 (valueToFill);)
+    JUCE_DISPATCH_VEC_OP (double, fill (dest, valueToFill, num))
    #endif
 }
 
@@ -552,9 +793,7 @@ void JUCE_CALLTYPE FloatVectorOperations::copyWithMultiply (float* dest, const f
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsmul (src, 1, &multiplier, dest, 1, (vDSP_Length) num);
    #else
-    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier, Mode::mul (mult, s),
-                                  JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
-                                  const Mode::ParallelType mult = Mode::load1 (multiplier);)
+    JUCE_DISPATCH_VEC_OP (float, copyWithMultiply (dest, src, multiplier, num))
    #endif
 }
 
@@ -563,9 +802,7 @@ void JUCE_CALLTYPE FloatVectorOperations::copyWithMultiply (double* dest, const
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsmulD (src, 1, &multiplier, dest, 1, (vDSP_Length) num);
    #else
-    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier, Mode::mul (mult, s),
-                                  JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
-                                  const Mode::ParallelType mult = Mode::load1 (multiplier);)
+    JUCE_DISPATCH_VEC_OP (double, copyWithMultiply (dest, src, multiplier, num))
    #endif
 }
 
@@ -574,15 +811,13 @@ void JUCE_CALLTYPE FloatVectorOperations::add (float* dest, float amount, int nu
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsadd (dest, 1, &amount, dest, 1, (vDSP_Length) num);
    #else
-    JUCE_PERFORM_VEC_OP_DEST (dest[i] += amount, Mode::add (d, amountToAdd), JUCE_LOAD_DEST,
-                              const Mode::ParallelType amountToAdd = Mode::load1 (amount);)
+    JUCE_DISPATCH_VEC_OP (float, add (dest, amount, num))
    #endif
 }
 
 void JUCE_CALLTYPE FloatVectorOperations::add (double* dest, double amount, int num) noexcept
 {
-    JUCE_PERFORM_VEC_OP_DEST (dest[i] += amount, Mode::add (d, amountToAdd), JUCE_LOAD_DEST,
-                              const Mode::ParallelType amountToAdd = Mode::load1 (amount);)
+    JUCE_DISPATCH_VEC_OP (double, add (dest, amount, num))
 }
 
 void JUCE_CALLTYPE FloatVectorOperations::add (float* dest, const float* src, float amount, int num) noexcept
@@ -590,9 +825,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (float* dest, const float* src, fl
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsadd (osx108sdkCompatibilityCast (src), 1, &amount, dest, 1, (vDSP_Length) num);
    #else
-    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] + amount, Mode::add (am, s),
-                                  JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
-                                  const Mode::ParallelType am = Mode::load1 (amount);)
+    JUCE_DISPATCH_VEC_OP (float, add (dest, src, amount, num))
    #endif
 }
 
@@ -601,9 +834,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (double* dest, const double* src,
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsaddD (osx108sdkCompatibilityCast (src), 1, &amount, dest, 1, (vDSP_Length) num);
    #else
-    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] + amount, Mode::add (am, s),
-                                  JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
-                                  const Mode::ParallelType am = Mode::load1 (amount);)
+    JUCE_DISPATCH_VEC_OP (double, add (dest, src, amount, num))
    #endif
 }
 
@@ -612,7 +843,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (float* dest, const float* src, in
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vadd (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
-    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i], Mode::add (d, s), JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST, )
+    JUCE_DISPATCH_VEC_OP (float, add (dest, src, num))
    #endif
 }
 
@@ -621,7 +852,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (double* dest, const double* src,
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vaddD (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
-    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i], Mode::add (d, s), JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST, )
+    JUCE_DISPATCH_VEC_OP (double, add (dest, src, num))
    #endif
 }
 
@@ -630,7 +861,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (float* dest, const float* src1, c
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vadd (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
    #else
-    JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] + src2[i], Mode::add (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
+    JUCE_DISPATCH_VEC_OP (float, add (dest, src1, src2, num))
    #endif
 }
 
@@ -639,7 +870,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (double* dest, const double* src1,
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vaddD (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
    #else
-    JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] + src2[i], Mode::add (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
+    JUCE_DISPATCH_VEC_OP (double, add (dest, src1, src2, num))
    #endif
 }
 
@@ -648,7 +879,7 @@ void JUCE_CALLTYPE FloatVectorOperations::subtract (float* dest, const float* sr
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsub (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
-    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i], Mode::sub (d, s), JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST, )
+    JUCE_DISPATCH_VEC_OP (float, subtract (dest, src, num))
    #endif
 }
 
@@ -657,7 +888,7 @@ void JUCE_CALLTYPE FloatVectorOperations::subtract (double* dest, const double*
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsubD (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
-    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i], Mode::sub (d, s), JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST, )
+    JUCE_DISPATCH_VEC_OP (double, subtract (dest, src, num))
    #endif
 }
 
@@ -666,7 +897,7 @@ void JUCE_CALLTYPE FloatVectorOperations::subtract (float* dest, const float* sr
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsub (src2, 1, src1, 1, dest, 1, (vDSP_Length) num);
    #else
-    JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] - src2[i], Mode::sub (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
+    JUCE_DISPATCH_VEC_OP (float, subtract (dest, src1, src2, num))
    #endif
 }
 
@@ -675,7 +906,7 @@ void JUCE_CALLTYPE FloatVectorOperations::subtract (double* dest, const double*
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsubD (src2, 1, src1, 1, dest, 1, (vDSP_Length) num);
    #else
-    JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] - src2[i], Mode::sub (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
+    JUCE_DISPATCH_VEC_OP (double, subtract (dest, src1, src2, num))
    #endif
 }
 
@@ -684,9 +915,7 @@ void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (float* dest, const fl
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsma (src, 1, &multiplier, dest, 1, dest, 1, (vDSP_Length) num);
    #else
-    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i] * multiplier, Mode::add (d, Mode::mul (mult, s)),
-                                  JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST,
-                                  const Mode::ParallelType mult = Mode::load1 (multiplier);)
+    JUCE_DISPATCH_VEC_OP (float, addWithMultiply (dest, src, multiplier, num))
    #endif
 }
 
@@ -695,9 +924,7 @@ void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (double* dest, const d
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsmaD (src, 1, &multiplier, dest, 1, dest, 1, (vDSP_Length) num);
    #else
-    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i] * multiplier, Mode::add (d, Mode::mul (mult, s)),
-                                  JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST,
-                                  const Mode::ParallelType mult = Mode::load1 (multiplier);)
+    JUCE_DISPATCH_VEC_OP (double, addWithMultiply (dest, src, multiplier, num))
    #endif
 }
 
@@ -706,9 +933,7 @@ void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (float* dest, const fl
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vma ((float*) src1, 1, (float*) src2, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
-    JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] += src1[i] * src2[i], Mode::add (d, Mode::mul (s1, s2)),
-                                             JUCE_LOAD_SRC1_SRC2_DEST,
-                                             JUCE_INCREMENT_SRC1_SRC2_DEST, )
+    JUCE_DISPATCH_VEC_OP (float, addWithMultiply (dest, src1, src2, num))
    #endif
 }
 
@@ -717,38 +942,28 @@ void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (double* dest, const d
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmaD ((double*) src1, 1, (double*) src2, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
-    JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] += src1[i] * src2[i], Mode::add (d, Mode::mul (s1, s2)),
-                                             JUCE_LOAD_SRC1_SRC2_DEST,
-                                             JUCE_INCREMENT_SRC1_SRC2_DEST, )
+    JUCE_DISPATCH_VEC_OP (double, addWithMultiply (dest, src1, src2, num))
    #endif
 }
 
 void JUCE_CALLTYPE FloatVectorOperations::subtractWithMultiply (float* dest, const float* src, float multiplier, int num) noexcept
 {
-    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i] * multiplier, Mode::sub (d, Mode::mul (mult, s)),
-                                  JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST,
-                                  const Mode::ParallelType mult = Mode::load1 (multiplier);)
+    JUCE_DISPATCH_VEC_OP (float, subtractWithMultiply (dest, src, multiplier, num))
 }
 
 void JUCE_CALLTYPE FloatVectorOperations::subtractWithMultiply (double* dest, const double* src, double multiplier, int num) noexcept
 {
-    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i] * multiplier, Mode::sub (d, Mode::mul (mult, s)),
-                                  JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST,
-                                  const Mode::ParallelType mult = Mode::load1 (multiplier);)
+    JUCE_DISPATCH_VEC_OP (double, subtractWithMultiply (dest, src, multiplier, num))
 }
 
 void JUCE_CALLTYPE FloatVectorOperations::subtractWithMultiply (float* dest, const float* src1, const float* src2, int num) noexcept
 {
-    JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] -= src1[i] * src2[i], Mode::sub (d, Mode::mul (s1, s2)),
-                                             JUCE_LOAD_SRC1_SRC2_DEST,
-                                             JUCE_INCREMENT_SRC1_SRC2_DEST, )
+    JUCE_DISPATCH_VEC_OP (float, subtractWithMultiply (dest, src1, src2, num))
 }
 
 void JUCE_CALLTYPE FloatVectorOperations::subtractWithMultiply (double* dest, const double* src1, const double* src2, int num) noexcept
 {
-    JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] -= src1[i] * src2[i], Mode::sub (d, Mode::mul (s1, s2)),
-                                             JUCE_LOAD_SRC1_SRC2_DEST,
-                                             JUCE_INCREMENT_SRC1_SRC2_DEST, )
+    JUCE_DISPATCH_VEC_OP (double, subtractWithMultiply (dest, src1, src2, num))
 }
 
 void JUCE_CALLTYPE FloatVectorOperations::multiply (float* dest, const float* src, int num) noexcept
@@ -756,7 +971,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (float* dest, const float* sr
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmul (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
-    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] *= src[i], Mode::mul (d, s), JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST, )
+    JUCE_DISPATCH_VEC_OP (float, multiply (dest, src, num))
    #endif
 }
 
@@ -765,7 +980,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (double* dest, const double*
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmulD (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
-    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] *= src[i], Mode::mul (d, s), JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST, )
+    JUCE_DISPATCH_VEC_OP (double, multiply (dest, src, num))
    #endif
 }
 
@@ -774,7 +989,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (float* dest, const float* sr
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmul (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
    #else
-    JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] * src2[i], Mode::mul (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
+    JUCE_DISPATCH_VEC_OP (float, multiply (dest, src1, src2, num))
    #endif
 }
 
@@ -783,7 +998,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (double* dest, const double*
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmulD (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
    #else
-    JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] * src2[i], Mode::mul (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
+    JUCE_DISPATCH_VEC_OP (double, multiply (dest, src1, src2, num))
    #endif
 }
 
@@ -792,8 +1007,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (float* dest, float multiplie
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsmul (dest, 1, &multiplier, dest, 1, (vDSP_Length) num);
    #else
-    JUCE_PERFORM_VEC_OP_DEST (dest[i] *= multiplier, Mode::mul (d, mult), JUCE_LOAD_DEST,
-                              const Mode::ParallelType mult = Mode::load1 (multiplier);)
+    JUCE_DISPATCH_VEC_OP (float, multiply (dest, multiplier, num))
    #endif
 }
 
@@ -802,23 +1016,18 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (double* dest, double multipl
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsmulD (dest, 1, &multiplier, dest, 1, (vDSP_Length) num);
    #else
-    JUCE_PERFORM_VEC_OP_DEST (dest[i] *= multiplier, Mode::mul (d, mult), JUCE_LOAD_DEST,
-                              const Mode::ParallelType mult = Mode::load1 (multiplier);)
+    JUCE_DISPATCH_VEC_OP (double, multiply (dest, multiplier, num))
    #endif
 }
 
 void JUCE_CALLTYPE FloatVectorOperations::multiply (float* dest, const float* src, float multiplier, int num) noexcept
 {
-    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier, Mode::mul (mult, s),
-                                  JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
-                                  const Mode::ParallelType mult = Mode::load1 (multiplier);)
+    JUCE_DISPATCH_VEC_OP (float, copyWithMultiply (dest, src, multiplier, num))
 }
 
 void JUCE_CALLTYPE FloatVectorOperations::multiply (double* dest, const double* src, double multiplier, int num) noexcept
 {
-    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier, Mode::mul (mult, s),
-                                  JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
-                                  const Mode::ParallelType mult = Mode::load1 (multiplier);)
+    JUCE_DISPATCH_VEC_OP (double, copyWithMultiply (dest, src, multiplier, num))
 }
 
 void FloatVectorOperations::negate (float* dest, const float* src, int num) noexcept
@@ -844,13 +1053,7 @@ void FloatVectorOperations::abs (float* dest, const float* src, int num) noexcep
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vabs ((float*) src, 1, dest, 1, (vDSP_Length) num);
    #else
-    FloatVectorHelpers::signMask32 signMask;
-    signMask.i = 0x7fffffffUL;
-    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = std::abs (src[i]), Mode::bit_and (s, mask),
-                                  JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
-                                  const Mode::ParallelType mask = Mode::load1 (signMask.f);)
-
-    ignoreUnused (signMask);
+    JUCE_DISPATCH_VEC_OP (float, abs (dest, src, num))
    #endif
 }
 
@@ -859,43 +1062,23 @@ void FloatVectorOperations::abs (double* dest, const double* src, int num) noexc
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vabsD ((double*) src, 1, dest, 1, (vDSP_Length) num);
    #else
-    FloatVectorHelpers::signMask64 signMask;
-    signMask.i = 0x7fffffffffffffffULL;
-
-    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = std::abs (src[i]), Mode::bit_and (s, mask),
-                                  JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
-                                  const Mode::ParallelType mask = Mode::load1 (signMask.d);)
-
-    ignoreUnused (signMask);
+    JUCE_DISPATCH_VEC_OP (double, abs (dest, src, num))
    #endif
 }
 
 void JUCE_CALLTYPE FloatVectorOperations::convertFixedToFloat (float* dest, const int* src, float multiplier, int num) noexcept
 {
-   #if JUCE_USE_ARM_NEON
-    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier,
-                                  vmulq_n_f32 (vcvtq_f32_s32 (vld1q_s32 (src)), multiplier),
-                                  JUCE_LOAD_NONE, JUCE_INCREMENT_SRC_DEST, )
-   #else
-    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = (float) src[i] * multiplier,
-                                  Mode::mul (mult, _mm_cvtepi32_ps (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (src)))),
-                                  JUCE_LOAD_NONE, JUCE_INCREMENT_SRC_DEST,
-                                  const Mode::ParallelType mult = Mode::load1 (multiplier);)
-   #endif
+    JUCE_DISPATCH_VEC_OP (float, convertFixedToFloat (dest, src, multiplier, num))
 }
 
 void JUCE_CALLTYPE FloatVectorOperations::min (float* dest, const float* src, float comp, int num) noexcept
 {
-    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmin (src[i], comp), Mode::min (s, cmp),
-                                  JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
-                                  const Mode::ParallelType cmp = Mode::load1 (comp);)
+    JUCE_DISPATCH_VEC_OP (float, min (dest, src, comp, num))
 }
 
 void JUCE_CALLTYPE FloatVectorOperations::min (double* dest, const double* src, double comp, int num) noexcept
 {
-    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmin (src[i], comp), Mode::min (s, cmp),
-                                  JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
-                                  const Mode::ParallelType cmp = Mode::load1 (comp);)
+    JUCE_DISPATCH_VEC_OP (double, min (dest, src, comp, num))
 }
 
 void JUCE_CALLTYPE FloatVectorOperations::min (float* dest, const float* src1, const float* src2, int num) noexcept
@@ -903,7 +1086,7 @@ void JUCE_CALLTYPE FloatVectorOperations::min (float* dest, const float* src1, c
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmin ((float*) src1, 1, (float*) src2, 1, dest, 1, (vDSP_Length) num);
    #else
-    JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = jmin (src1[i], src2[i]), Mode::min (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
+    JUCE_DISPATCH_VEC_OP (float, min (dest, src1, src2, num))
    #endif
 }
 
@@ -912,22 +1095,18 @@ void JUCE_CALLTYPE FloatVectorOperations::min (double* dest, const double* src1,
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vminD ((double*) src1, 1, (double*) src2, 1, dest, 1, (vDSP_Length) num);
    #else
-    JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = jmin (src1[i], src2[i]), Mode::min (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
+    JUCE_DISPATCH_VEC_OP (double, min (dest, src1, src2, num))
    #endif
 }
 
 void JUCE_CALLTYPE FloatVectorOperations::max (float* dest, const float* src, float comp, int num) noexcept
 {
-    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (src[i], comp), Mode::max (s, cmp),
-                                  JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
-                                  const Mode::ParallelType cmp = Mode::load1 (comp);)
+    JUCE_DISPATCH_VEC_OP (float, max (dest, src, comp, num))
 }
 
 void JUCE_CALLTYPE FloatVectorOperations::max (double* dest, const double* src, double comp, int num) noexcept
 {
-    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (src[i], comp), Mode::max (s, cmp),
-                                  JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
-                                  const Mode::ParallelType cmp = Mode::load1 (comp);)
+    JUCE_DISPATCH_VEC_OP (double, max (dest, src, comp, num))
 }
 
 void JUCE_CALLTYPE FloatVectorOperations::max (float* dest, const float* src1, const float* src2, int num) noexcept
@@ -935,7 +1114,7 @@ void JUCE_CALLTYPE FloatVectorOperations::max (float* dest, const float* src1, c
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmax ((float*) src1, 1, (float*) src2, 1, dest, 1, (vDSP_Length) num);
    #else
-    JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = jmax (src1[i], src2[i]), Mode::max (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
+    JUCE_DISPATCH_VEC_OP (float, max (dest, src1, src2, num))
    #endif
 }
 
@@ -944,7 +1123,7 @@ void JUCE_CALLTYPE FloatVectorOperations::max (double* dest, const double* src1,
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmaxD ((double*) src1, 1, (double*) src2, 1, dest, 1, (vDSP_Length) num);
    #else
-    JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = jmax (src1[i], src2[i]), Mode::max (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
+    JUCE_DISPATCH_VEC_OP (double, max (dest, src1, src2, num))
    #endif
 }
 
@@ -955,9 +1134,7 @@ void JUCE_CALLTYPE FloatVectorOperations::clip (float* dest, const float* src, f
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vclip ((float*) src, 1, &low, &high, dest, 1, (vDSP_Length) num);
    #else
-    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (jmin (src[i], high), low), Mode::max (Mode::min (s, hi), lo),
-                                  JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
-                                  const Mode::ParallelType lo = Mode::load1 (low); const Mode::ParallelType hi = Mode::load1 (high);)
+    JUCE_DISPATCH_VEC_OP (float, clip (dest, src, low, high, num))
    #endif
 }
 
@@ -968,66 +1145,180 @@ void JUCE_CALLTYPE FloatVectorOperations::clip (double* dest, const double* src,
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vclipD ((double*) src, 1, &low, &high, dest, 1, (vDSP_Length) num);
    #else
-    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (jmin (src[i], high), low), Mode::max (Mode::min (s, hi), lo),
-                                  JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
-                                  const Mode::ParallelType lo = Mode::load1 (low); const Mode::ParallelType hi = Mode::load1 (high);)
+    JUCE_DISPATCH_VEC_OP (double, clip (dest, src, low, high, num))
    #endif
 }
 
 Range<float> JUCE_CALLTYPE FloatVectorOperations::findMinAndMax (const float* src, int num) noexcept
 {
-   #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
-    return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps32>::findMinAndMax (src, num);
+    JUCE_DISPATCH_VEC_OP (float, findMinAndMax (src, num))
+}
+
+Range<double> JUCE_CALLTYPE FloatVectorOperations::findMinAndMax (const double* src, int num) noexcept
+{
+    JUCE_DISPATCH_VEC_OP (double, findMinAndMax (src, num))
+}
+
+float JUCE_CALLTYPE FloatVectorOperations::findMinimum (const float* src, int num) noexcept
+{
+    JUCE_DISPATCH_VEC_OP (float, findMinOrMax (src, num, true))
+}
+
+double JUCE_CALLTYPE FloatVectorOperations::findMinimum (const double* src, int num) noexcept
+{
+    JUCE_DISPATCH_VEC_OP (double, findMinOrMax (src, num, true))
+}
+
+float JUCE_CALLTYPE FloatVectorOperations::findMaximum (const float* src, int num) noexcept
+{
+    JUCE_DISPATCH_VEC_OP (float, findMinOrMax (src, num, false))
+}
+
+double JUCE_CALLTYPE FloatVectorOperations::findMaximum (const double* src, int num) noexcept
+{
+    JUCE_DISPATCH_VEC_OP (double, findMinOrMax (src, num, false))
+}
+
+float JUCE_CALLTYPE FloatVectorOperations::sum (const float* src, int num) noexcept
+{
+   #if JUCE_USE_VDSP_FRAMEWORK
+    float result = 0;
+    vDSP_sve (src, 1, &result, (vDSP_Length) num);
+    return result;
    #else
-    return Range<float>::findMinAndMax (src, num);
+    JUCE_DISPATCH_VEC_OP (float, sum (src, num))
    #endif
 }
 
-Range<double> JUCE_CALLTYPE FloatVectorOperations::findMinAndMax (const double* src, int num) noexcept
+double JUCE_CALLTYPE FloatVectorOperations::sum (const double* src, int num) noexcept
+{
+   #if JUCE_USE_VDSP_FRAMEWORK
+    double result = 0;
+    vDSP_sveD (src, 1, &result, (vDSP_Length) num);
+    return result;
+   #else
+    JUCE_DISPATCH_VEC_OP (double, sum (src, num))
+   #endif
+}
+
+float JUCE_CALLTYPE FloatVectorOperations::sumOfSquares (const float* src, int num) noexcept
 {
-   #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
-    return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps64>::findMinAndMax (src, num);
+   #if JUCE_USE_VDSP_FRAMEWORK
+    float result = 0;
+    vDSP_svesq (src, 1, &result, (vDSP_Length) num);
+    return result;
    #else
-    return Range<double>::findMinAndMax (src, num);
+    JUCE_DISPATCH_VEC_OP (float, sumOfSquares (src, num))
    #endif
 }
 
-float JUCE_CALLTYPE FloatVectorOperations::findMinimum (const float* src, int num) noexcept
+double JUCE_CALLTYPE FloatVectorOperations::sumOfSquares (const double* src, int num) noexcept
 {
-   #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
-    return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps32>::findMinOrMax (src, num, true);
+   #if JUCE_USE_VDSP_FRAMEWORK
+    double result = 0;
+    vDSP_svesqD (src, 1, &result, (vDSP_Length) num);
+    return result;
    #else
-    return juce::findMinimum (src, num);
+    JUCE_DISPATCH_VEC_OP (double, sumOfSquares (src, num))
    #endif
 }
 
-double JUCE_CALLTYPE FloatVectorOperations::findMinimum (const double* src, int num) noexcept
+float JUCE_CALLTYPE FloatVectorOperations::dotProduct (const float* src1, const float* src2, int num) noexcept
 {
-   #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
-    return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps64>::findMinOrMax (src, num, true);
+   #if JUCE_USE_VDSP_FRAMEWORK
+    float result = 0;
+    vDSP_dotpr (src1, 1, src2, 1, &result, (vDSP_Length) num);
+    return result;
    #else
-    return juce::findMinimum (src, num);
+    JUCE_DISPATCH_VEC_OP (float, dotProduct (src1, src2, num))
    #endif
 }
 
-float JUCE_CALLTYPE FloatVectorOperations::findMaximum (const float* src, int num) noexcept
+double JUCE_CALLTYPE FloatVectorOperations::dotProduct (const double* src1, const double* src2, int num) noexcept
 {
-   #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
-    return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps32>::findMinOrMax (src, num, false);
+   #if JUCE_USE_VDSP_FRAMEWORK
+    double result = 0;
+    vDSP_dotprD (src1, 1, src2, 1, &result, (vDSP_Length) num);
+    return result;
    #else
-    return juce::findMaximum (src, num);
+    JUCE_DISPATCH_VEC_OP (double, dotProduct (src1, src2, num))
    #endif
 }
 
-double JUCE_CALLTYPE FloatVectorOperations::findMaximum (const double* src, int num) noexcept
+void JUCE_CALLTYPE FloatVectorOperations::copyWithRamp (float* dest, const float* src, float startMultiplier, float increment, int num) noexcept
+{
+   #if JUCE_USE_VDSP_FRAMEWORK
+    vDSP_vrampmul (src, 1, &startMultiplier, &increment, dest, 1, (vDSP_Length) num);
+   #else
+    JUCE_DISPATCH_VEC_OP (float, copyWithRamp (dest, src, startMultiplier, increment, num))
+   #endif
+}
+
+void JUCE_CALLTYPE FloatVectorOperations::copyWithRamp (double* dest, const double* src, double startMultiplier, double increment, int num) noexcept
+{
+   #if JUCE_USE_VDSP_FRAMEWORK
+    vDSP_vrampmulD (src, 1, &startMultiplier, &increment, dest, 1, (vDSP_Length) num);
+   #else
+    JUCE_DISPATCH_VEC_OP (double, copyWithRamp (dest, src, startMultiplier, increment, num))
+   #endif
+}
+
+void JUCE_CALLTYPE FloatVectorOperations::addWithRamp (float* dest, const float* src, float startMultiplier, float increment, int num) noexcept
+{
+   #if JUCE_USE_VDSP_FRAMEWORK
+    vDSP_vrampmuladd (src, 1, &startMultiplier, &increment, dest, 1, (vDSP_Length) num);
+   #else
+    JUCE_DISPATCH_VEC_OP (float, addWithRamp (dest, src, startMultiplier, increment, num))
+   #endif
+}
+
+void JUCE_CALLTYPE FloatVectorOperations::addWithRamp (double* dest, const double* src, double startMultiplier, double increment, int num) noexcept
+{
+   #if JUCE_USE_VDSP_FRAMEWORK
+    vDSP_vrampmuladdD (src, 1, &startMultiplier, &increment, dest, 1, (vDSP_Length) num);
+   #else
+    JUCE_DISPATCH_VEC_OP (double, addWithRamp (dest, src, startMultiplier, increment, num))
+   #endif
+}
+
+void JUCE_CALLTYPE FloatVectorOperations::multiplyAdd (float* dest, const float* src1, const float* src2, const float* src3, int num) noexcept
 {
-   #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
-    return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps64>::findMinOrMax (src, num, false);
+   #if JUCE_USE_VDSP_FRAMEWORK
+    vDSP_vma (src1, 1, src2, 1, src3, 1, dest, 1, (vDSP_Length) num);
    #else
-    return juce::findMaximum (src, num);
+    JUCE_DISPATCH_VEC_OP (float, multiplyAdd (dest, src1, src2, src3, num))
    #endif
 }
 
+void JUCE_CALLTYPE FloatVectorOperations::multiplyAdd (double* dest, const double* src1, const double* src2, const double* src3, int num) noexcept
+{
+   #if JUCE_USE_VDSP_FRAMEWORK
+    vDSP_vmaD (src1, 1, src2, 1, src3, 1, dest, 1, (vDSP_Length) num);
+   #else
+    JUCE_DISPATCH_VEC_OP (double, multiplyAdd (dest, src1, src2, src3, num))
+   #endif
+}
+
+void JUCE_CALLTYPE FloatVectorOperations::interleave (float* dest, const float* const* src, int numChannels, int num) noexcept
+{
+    JUCE_DISPATCH_VEC_OP (float, interleave (dest, src, numChannels, num))
+}
+
+void JUCE_CALLTYPE FloatVectorOperations::interleave (double* dest, const double* const* src, int numChannels, int num) noexcept
+{
+    JUCE_DISPATCH_VEC_OP (double, interleave (dest, src, numChannels, num))
+}
+
+void JUCE_CALLTYPE FloatVectorOperations::deinterleave (float* const* dest, const float* src, int numChannels, int num) noexcept
+{
+    JUCE_DISPATCH_VEC_OP (float, deinterleave (dest, src, numChannels, num))
+}
+
+void JUCE_CALLTYPE FloatVectorOperations::deinterleave (double* const* dest, const double* src, int numChannels, int num) noexcept
+{
+    JUCE_DISPATCH_VEC_OP (double, deinterleave (dest, src, numChannels, num))
+}
+
 intptr_t JUCE_CALLTYPE FloatVectorOperations::getFpStatusRegister() noexcept
 {
     intptr_t fpsr = 0;
@@ -1233,6 +1524,92 @@ public:
             FloatVectorOperations::fill (data2, (ValueType) 3, num);
             FloatVectorOperations::addWithMultiply (data1, data1, data2, num);
             u.expect (areAllValuesEqual (data1, num, (ValueType) 8));
+
+            FloatVectorOperations::multiplyAdd (data2, data1, data2, data1, num);
+            u.expect (areAllValuesEqual (data2, num, (ValueType) 32));
+
+            fillRandomly (random, data1, num);
+            fillRandomly (random, data2, num);
+            doReductionTests (u, data1, data2, num);
+            doRampTests (u, random, data1, data2, num);
+            doInterleavingTests (u, random, num);
+        }
+
+        static void doReductionTests (UnitTest& u, const ValueType* data1, const ValueType* data2, int num)
+        {
+            double sum = 0, sumOfSquares = 0, dotProduct = 0;
+
+            for (int i = 0; i < num; ++i)
+            {
+                sum          += (double) data1[i];
+                sumOfSquares += (double) data1[i] * (double) data1[i];
+                dotProduct   += (double) data1[i] * (double) data2[i];
+            }
+
+            auto sumsMatch = [num] (ValueType actual, double expected)
+            {
+                // all the values are positive, so the error is relative to the result
+                return std::abs ((double) actual - expected) <= expected * num * std::numeric_limits<ValueType>::epsilon();
+            };
+
+            u.expect (sumsMatch (FloatVectorOperations::sum (data1, num), sum));
+            u.expect (sumsMatch (FloatVectorOperations::sumOfSquares (data1, num), sumOfSquares));
+            u.expect (sumsMatch (FloatVectorOperations::dotProduct (data1, data2, num), dotProduct));
+        }
+
+        static void doRampTests (UnitTest& u, Random& random, ValueType* data1, ValueType* data2, int num)
+        {
+            const auto start = (ValueType) random.nextDouble();
+            const auto increment = (ValueType) ((random.nextDouble() - 0.5) / num);
+
+            HeapBlock<ValueType> expected (num), tolerance (num);
+
+            // The gain can be calculated with a fused multiply-add, so the error is relative
+            // to the size of the terms rather than the size of the result
+            for (int i = 0; i < num; ++i)
+            {
+                expected[i] = data1[i] * (start + increment * (ValueType) i);
+                tolerance[i] = (ValueType) 4 * std::numeric_limits<ValueType>::epsilon()
+                                 * std::abs (data1[i]) * (std::abs (start) + std::abs (increment * (ValueType) i));
+            }
+
+            FloatVectorOperations::copyWithRamp (data2, data1, start, increment, num);
+            u.expect (buffersMatchWithin (data2, expected, tolerance, num));
+
+            for (int i = 0; i < num; ++i)
+            {
+                expected[i] += data2[i];
+                tolerance[i] += (ValueType) 2 * std::numeric_limits<ValueType>::epsilon() * std::abs (expected[i]);
+            }
+
+            FloatVectorOperations::addWithRamp (data2, data1, start, increment, num);
+            u.expect (buffersMatchWithin (data2, expected, tolerance, num));
+        }
+
+        static void doInterleavingTests (UnitTest& u, Random& random, int num)
+        {
+            const int numChannels = random.nextInt ({ 1, 6 });
+
+            AudioBuffer<ValueType> channels (numChannels, num), result (numChannels, num);
+            HeapBlock<ValueType> interleaved (num * numChannels);
+
+            for (int chan = 0; chan < numChannels; ++chan)
+                fillRandomly (random, channels.getWritePointer (chan), num);
+
+            FloatVectorOperations::interleave (interleaved, channels.getArrayOfReadPointers(), numChannels, num);
+
+            bool interleavedCorrectly = true;
+
+            for (int i = 0; i < num; ++i)
+                for (int chan = 0; chan < numChannels; ++chan)
+                    interleavedCorrectly = interleavedCorrectly && interleaved[i * numChannels + chan] == channels.getSample (chan, i);
+
+            u.expect (interleavedCorrectly);
+
+            FloatVectorOperations::deinterleave (result.getArrayOfWritePointers(), interleaved, numChannels, num);
+
+            for (int chan = 0; chan < numChannels; ++chan)
+                u.expect (areAllValuesEqual (result.getReadPointer (chan), channels.getReadPointer (chan), num));
         }
 
         static void doConversionTest (UnitTest& u, float* data1, float* data2, int* const int1, int num)
@@ -1271,6 +1648,15 @@ public:
             return true;
         }
 
+        static bool areAllValuesEqual (const ValueType* d1, const ValueType* d2, int num)
+        {
+            while (--num >= 0)
+                if (*d1++ != *d2++)
+                    return false;
+
+            return true;
+        }
+
         static bool buffersMatch (const ValueType* d1, const ValueType* d2, int num)
         {
             while (--num >= 0)
@@ -1280,12 +1666,105 @@ public:
             return true;
         }
 
+        static bool buffersMatchWithin (const ValueType* d1, const ValueType* d2, const ValueType* tolerance, int num)
+        {
+            while (--num >= 0)
+                if (std::abs (*d1++ - *d2++) > *tolerance++)
+                    return false;
+
+            return true;
+        }
+
         static bool valuesMatch (ValueType v1, ValueType v2)
         {
             return std::abs (v1 - v2) < std::numeric_limits<ValueType>::epsilon();
         }
     };
 
+   #if JUCE_USE_FLOAT_VECTOR_DISPATCH
+    template <typename ValueType, typename Kernels>
+    struct KernelComparison
+    {
+        static void runTest (UnitTest& u, Random random)
+        {
+            using Reference = FloatVectorHelpers::KernelsFor<ValueType>;
+
+            const int num = random.nextInt (random.nextBool() ? 500 : 40) + 1;
+
+            HeapBlock<ValueType> buffer1 (num + 16), buffer2 (num + 16), buffer3 (num + 16), buffer4 (num + 16);
+
+            // Offsetting by whole samples means that the aligned and unaligned paths both get used
+            ValueType* const src1     = buffer1 + random.nextInt (16);
+            ValueType* const src2     = buffer2 + random.nextInt (16);
+            ValueType* const expected = buffer3 + random.nextInt (16);
+            ValueType* const actual   = buffer4 + random.nextInt (16);
+
+            TestRunner<ValueType>::fillRandomly (random, src1, num);
+            TestRunner<ValueType>::fillRandomly (random, src2, num);
+            FloatVectorOperations::negate (src2, src2, num / 2);
+
+            auto check = [&] (auto&& operation)
+            {
+                FloatVectorOperations::copy (expected, src2, num);
+                FloatVectorOperations::copy (actual, src2, num);
+
+                operation (Reference(), expected);
+                operation (Kernels(), actual);
+
+                auto maxError = (ValueType) 0;
+
+                for (int i = 0; i < num; ++i)
+                    maxError = jmax (maxError, std::abs (expected[i] - actual[i]));
+
+                // the fused multiply-adds are allowed to round differently
+                u.expect (maxError <= (ValueType) 8 * std::numeric_limits<ValueType>::epsilon() * (ValueType) 1.0e6);
+            };
+
+            check ([&] (auto k, ValueType* d) { k.fill (d, (ValueType) 3, num); });
+            check ([&] (auto k, ValueType* d) { k.copyWithMultiply (d, src1, (ValueType) 0.5, num); });
+            check ([&] (auto k, ValueType* d) { k.add (d, (ValueType) 3, num); });
+            check ([&] (auto k, ValueType* d) { k.add (d, src1, (ValueType) 3, num); });
+            check ([&] (auto k, ValueType* d) { k.add (d, src1, num); });
+            check ([&] (auto k, ValueType* d) { k.add (d, src1, d, num); });
+            check ([&] (auto k, ValueType* d) { k.subtract (d, src1, num); });
+            check ([&] (auto k, ValueType* d) { k.subtract (d, src1, d, num); });
+            check ([&] (auto k, ValueType* d) { k.addWithMultiply (d, src1, (ValueType) -3, num); });
+            check ([&] (auto k, ValueType* d) { k.addWithMultiply (d, src1, src1, num); });
+            check ([&] (auto k, ValueType* d) { k.subtractWithMultiply (d, src1, (ValueType) 3, num); });
+            check ([&] (auto k, ValueType* d) { k.subtractWithMultiply (d, src1, src1, num); });
+            check ([&] (auto k, ValueType* d) { k.multiply (d, src1, num); });
+            check ([&] (auto k, ValueType* d) { k.multiply (d, src1, d, num); });
+            check ([&] (auto k, ValueType* d) { k.multiply (d, (ValueType) -2, num); });
+            check ([&] (auto k, ValueType* d) { k.abs (d, d, num); });
+            check ([&] (auto k, ValueType* d) { k.min (d, src1, (ValueType) 500, num); });
+            check ([&] (auto k, ValueType* d) { k.min (d, src1, d, num); });
+            check ([&] (auto k, ValueType* d) { k.max (d, src1, (ValueType) 500, num); });
+            check ([&] (auto k, ValueType* d) { k.max (d, src1, d, num); });
+            check ([&] (auto k, ValueType* d) { k.clip (d, d, (ValueType) -200, (ValueType) 300, num); });
+            check ([&] (auto k, ValueType* d) { k.copyWithRamp (d, src1, (ValueType) 0.25, (ValueType) 0.01, num); });
+            check ([&] (auto k, ValueType* d) { k.addWithRamp (d, src1, (ValueType) 1, (ValueType) -0.01, num); });
+            check ([&] (auto k, ValueType* d) { k.multiplyAdd (d, src1, d, src1, num); });
+            check ([&] (auto k, ValueType* d) { d[0] = k.sum (src1, num) * (ValueType) 1.0e-3; });
+            check ([&] (auto k, ValueType* d) { d[0] = k.sumOfSquares (src2, num) * (ValueType) 1.0e-6; });
+            check ([&] (auto k, ValueType* d) { d[0] = k.dotProduct (src1, src2, num) * (ValueType) 1.0e-6; });
+
+            u.expect (Kernels::findMinAndMax (src2, num) == Reference::findMinAndMax (src2, num));
+            u.expect (Kernels::findMinOrMax (src2, num, true)  == Reference::findMinOrMax (src2, num, true));
+            u.expect (Kernels::findMinOrMax (src2, num, false) == Reference::findMinOrMax (src2, num, false));
+        }
+    };
+
+    template <typename Kernels32, typename Kernels64>
+    void runKernelComparisons()
+    {
+        for (int i = 200; --i >= 0;)
+        {
+            KernelComparison<float,  Kernels32>::runTest (*this, getRandom());
+            KernelComparison<double, Kernels64>::runTest (*this, getRandom());
+        }
+    }
+   #endif
+
     void runTest() override
     {
         beginTest ("FloatVectorOperations");
@@ -1295,6 +1774,22 @@ public:
             TestRunner<float>::runTest (*this, getRandom());
             TestRunner<double>::runTest (*this, getRandom());
         }
+
+       #if JUCE_USE_FLOAT_VECTOR_DISPATCH
+        using namespace FloatVectorHelpers;
+
+        if (getInstructionSet() >= InstructionSet::avx2)
+        {
+            beginTest ("AVX2 implementations match the SSE implementations");
+            runKernelComparisons<AVX2::KernelsFor<float>, AVX2::KernelsFor<double>>();
+        }
+
+        if (getInstructionSet() >= InstructionSet::avx512)
+        {
+            beginTest ("AVX-512 implementations match the SSE implementations");
+            runKernelComparisons<AVX512::KernelsFor<float>, AVX512::KernelsFor<double>>();
+        }
+       #endif
     }
 };
 
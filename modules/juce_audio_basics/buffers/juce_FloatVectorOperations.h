@@ -37,6 +37,11 @@ class ScopedNoDenormals;
     A collection of simple vector operations on arrays of floats, accelerated with
     SIMD instructions where possible.
 
+    On Intel processors, the operations check the CPU at runtime and use AVX2 or
+    AVX-512 instructions when they're available, even if the rest of your code
+    has only been compiled for SSE. You can disable this by setting the
+    JUCE_USE_FLOAT_VECTOR_DISPATCH preprocessor flag to 0.
+
     @tags{Audio}
 */
 class JUCE_API  FloatVectorOperations
@@ -214,6 +219,74 @@ public:
     /** Finds the maximum value in the given array. */
     static double JUCE_CALLTYPE findMaximum (const double* src, int numValues) noexcept;
 
+    /** Returns the sum of the values in the given array. */
+    static float JUCE_CALLTYPE sum (const float* src, int numValues) noexcept;
+
+    /** Returns the sum of the values in the given array. */
+    static double JUCE_CALLTYPE sum (const double* src, int numValues) noexcept;
+
+    /** Returns the sum of the squares of the values in the given array. */
+    static float JUCE_CALLTYPE sumOfSquares (const float* src, int numValues) noexcept;
+
+    /** Returns the sum of the squares of the values in the given array. */
+    static double JUCE_CALLTYPE sumOfSquares (const double* src, int numValues) noexcept;
+
+    /** Returns the sum of the products of the corresponding values in two arrays. */
+    static float JUCE_CALLTYPE dotProduct (const float* src1, const float* src2, int numValues) noexcept;
+
+    /** Returns the sum of the products of the corresponding values in two arrays. */
+    static double JUCE_CALLTYPE dotProduct (const double* src1, const double* src2, int numValues) noexcept;
+
+    /** Multiplies each source value by a linearly changing gain, and stores the result in the destination array.
+        The gain applied to the n-th value is (startMultiplier + n * increment).
+    */
+    static void JUCE_CALLTYPE copyWithRamp (float* dest, const float* src, float startMultiplier, float increment, int numValues) noexcept;
+
+    /** Multiplies each source value by a linearly changing gain, and stores the result in the destination array.
+        The gain applied to the n-th value is (startMultiplier + n * increment).
+    */
+    static void JUCE_CALLTYPE copyWithRamp (double* dest, const double* src, double startMultiplier, double increment, int numValues) noexcept;
+
+    /** Multiplies each source value by a linearly changing gain, and adds the result to the destination array.
+        The gain applied to the n-th value is (startMultiplier + n * increment).
+    */
+    static void JUCE_CALLTYPE addWithRamp (float* dest, const float* src, float startMultiplier, float increment, int numValues) noexcept;
+
+    /** Multiplies each source value by a linearly changing gain, and adds the result to the destination array.
+        The gain applied to the n-th value is (startMultiplier + n * increment).
+    */
+    static void JUCE_CALLTYPE addWithRamp (double* dest, const double* src, double startMultiplier, double increment, int numValues) noexcept;
+
+    /** Multiplies each value in src1 by the corresponding value in src2, adds the corresponding value in src3,
+        and stores the result in the destination array.
+    */
+    static void JUCE_CALLTYPE multiplyAdd (float* dest, const float* src1, const float* src2, const float* src3, int numValues) noexcept;
+
+    /** Multiplies each value in src1 by the corresponding value in src2, adds the corresponding value in src3,
+        and stores the result in the destination array.
+    */
+    static void JUCE_CALLTYPE multiplyAdd (double* dest, const double* src1, const double* src2, const double* src3, int numValues) noexcept;
+
+    /** Interleaves a set of channels into a single array, so that dest[n * numChannels + c] = src[c][n].
+        The destination must have space for (numChannels * numValues) values.
+    */
+    static void JUCE_CALLTYPE interleave (float* dest, const float* const* src, int numChannels, int numValues) noexcept;
+
+    /** Interleaves a set of channels into a single array, so that dest[n * numChannels + c] = src[c][n].
+        The destination must have space for (numChannels * numValues) values.
+    */
+    static void JUCE_CALLTYPE interleave (double* dest, const double* const* src, int numChannels, int numValues) noexcept;
+
+    /** Splits an interleaved array into a set of channels, so that dest[c][n] = src[n * numChannels + c].
+        The source must contain (numChannels * numValues) values.
+    */
+    static void JUCE_CALLTYPE deinterleave (float* const* dest, const float* src, int numChannels, int numValues) noexcept;
+
+    /** Splits an interleaved array into a set of channels, so that dest[c][n] = src[n * numChannels + c].
+        The source must contain (numChannels * numValues) values.
+    */
+    static void JUCE_CALLTYPE deinterleave (double* const* dest, const double* src, int numChannels, int numValues) noexcept;
+
     /** This method enables or disables the SSE/NEON flush-to-zero mode. */
     static void JUCE_CALLTYPE enableFlushToZeroMode (bool shouldEnable) noexcept;
 
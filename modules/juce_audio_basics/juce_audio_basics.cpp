@@ -53,6 +53,23 @@
  #include <arm_neon.h>
 #endif
 
+#ifndef JUCE_USE_FLOAT_VECTOR_DISPATCH
+ #define JUCE_USE_FLOAT_VECTOR_DISPATCH 1
+#endif
+
+#if JUCE_USE_FLOAT_VECTOR_DISPATCH && JUCE_USE_SSE_INTRINSICS && ! JUCE_USE_VDSP_FRAMEWORK \
+     && ! JUCE_MINGW && (JUCE_MSVC || JUCE_GCC || (JUCE_CLANG && __clang_major__ >= 6))
+ #include <immintrin.h>
+
+ #if JUCE_MSVC
+  #include <intrin.h>
+ #else
+  #include <cpuid.h>
+ #endif
+#else
+ #undef JUCE_USE_FLOAT_VECTOR_DISPATCH
+#endif
+
 #include "buffers/juce_AudioDataConverters.cpp"
 #include "buffers/juce_FloatVectorOperations.cpp"
 #include "buffers/juce_AudioChannelSet.cpp"
@@ -62,6 +79,7 @@
 #include "utilities/juce_WindowedSincInterpolator.cpp"
 #include "utilities/juce_Interpolators.cpp"
 #include "utilities/juce_SmoothedValue.cpp"
+#include "utilities/juce_Reverb.cpp"
 #include "midi/juce_MidiBuffer.cpp"
 #include "midi/juce_MidiFile.cpp"
 #include "midi/juce_MidiKeyboardState.cpp"
@@ -85,4 +103,5 @@
 #include "sources/juce_ResamplingAudioSource.cpp"
 #include "sources/juce_ReverbAudioSource.cpp"
 #include "sources/juce_ToneGeneratorAudioSource.cpp"
+#include "synthesisers/juce_ParallelVoiceRenderer.cpp"
 #include "synthesisers/juce_Synthesiser.cpp"
@@ -77,6 +77,25 @@ namespace MidiBufferHelpers
 
         return d;
     }
+
+    static void writeEvent (uint8* d, const void* midiData, int numBytes, int samplePosition) noexcept
+    {
+        writeUnaligned<int32>  (d, samplePosition);
+        d += sizeof (int32);
+        writeUnaligned<uint16> (d, static_cast<uint16> (numBytes));
+        d += sizeof (uint16);
+        memcpy (d, midiData, (size_t) numBytes);
+    }
+
+    static void appendEvent (Array<uint8>& data, const void* midiData, int numBytes, int samplePosition)
+    {
+        auto offset = data.size();
+        data.insertMultiple (offset, 0, numBytes + (int) (sizeof (int32) + sizeof (uint16)));
+        writeEvent (data.begin() + offset, midiData, numBytes, samplePosition);
+    }
+
+    // The smallest amount of space that an event can take in a buffer
+    constexpr int minEventSize = (int) (sizeof (int32) + sizeof (uint16)) + 1;
 }
 
 //==============================================================================
@@ -106,8 +125,34 @@ MidiBuffer::MidiBuffer (const MidiMessage& message) noexcept
     addEvent (message, 0);
 }
 
-void MidiBuffer::swapWith (MidiBuffer& other) noexcept      { data.swapWith (other.data); }
-void MidiBuffer::clear() noexcept                           { data.clearQuick(); }
+MidiBuffer::MidiBuffer (const MidiBuffer& other)
+    : data (other.data),
+      lastEventOffset (other.lastEventOffset),
+      numDroppedEvents (other.numDroppedEvents)
+{
+    setFixedCapacity (other.fixedCapacity);
+}
+
+MidiBuffer& MidiBuffer::operator= (const MidiBuffer& other)
+{
+    data = other.data;
+    lastEventOffset = other.lastEventOffset;
+    numDroppedEvents = other.numDroppedEvents;
+    setFixedCapacity (other.fixedCapacity);
+    return *this;
+}
+
+void MidiBuffer::swapWith (MidiBuffer& other) noexcept
+{
+    data.swapWith (other.data);
+    scratchData.swapWith (other.scratchData);
+    sortKeys.swapWith (other.sortKeys);
+    std::swap (lastEventOffset, other.lastEventOffset);
+    std::swap (fixedCapacity, other.fixedCapacity);
+    std::swap (numDroppedEvents, other.numDroppedEvents);
+}
+
+void MidiBuffer::clear() noexcept                           { data.clearQuick(); lastEventOffset = -1; }
 void MidiBuffer::ensureSize (size_t minimumNumBytes)        { data.ensureStorageAllocated ((int) minimumNumBytes); }
 bool MidiBuffer::isEmpty() const noexcept                   { return data.size() == 0; }
 
@@ -116,46 +161,217 @@ void MidiBuffer::clear (int startSample, int numSamples)
     auto start = MidiBufferHelpers::findEventAfter (data.begin(), data.end(), startSample - 1);
     auto end   = MidiBufferHelpers::findEventAfter (start,        data.end(), startSample + numSamples - 1);
 
-    data.removeRange ((int) (start - data.begin()), (int) (end - start));
+    if (fixedCapacity > 0)
+    {
+        // removeRange() may shrink the array's storage, so the events are copied instead
+        scratchData.clearQuick();
+        scratchData.addArray (data.begin(), (int) (start - data.begin()));
+        scratchData.addArray (end, (int) (data.end() - end));
+        data.swapWith (scratchData);
+        scratchData.clearQuick();
+    }
+    else
+    {
+        data.removeRange ((int) (start - data.begin()), (int) (end - start));
+    }
+
+    lastEventOffset = -1;
 }
 
-void MidiBuffer::addEvent (const MidiMessage& m, int sampleNumber)
+void MidiBuffer::setFixedCapacity (int maxNumBytes)
 {
-    addEvent (m.getRawData(), m.getRawDataSize(), sampleNumber);
+    jassert (maxNumBytes >= 0);
+    fixedCapacity = jmax (0, maxNumBytes);
+
+    if (fixedCapacity > 0)
+    {
+        data.ensureStorageAllocated (fixedCapacity);
+        scratchData.ensureStorageAllocated (fixedCapacity);
+        sortKeys.ensureStorageAllocated (fixedCapacity / MidiBufferHelpers::minEventSize);
+    }
 }
 
-void MidiBuffer::addEvent (const void* newData, int maxBytes, int sampleNumber)
+bool MidiBuffer::canAdd (int numBytes) noexcept
+{
+    if (fixedCapacity > 0 && data.size() + numBytes > fixedCapacity)
+    {
+        ++numDroppedEvents;
+        return false;
+    }
+
+    return true;
+}
+
+// Returns the offset of the last event, which is cached so that events can be appended
+// without scanning the buffer
+int MidiBuffer::findLastEvent() noexcept
+{
+    auto size = data.size();
+
+    if (size == 0)
+        return -1;
+
+    constexpr auto headerSize = (int) (sizeof (int32) + sizeof (uint16));
+
+    if (lastEventOffset < 0 || lastEventOffset + headerSize > size
+         || lastEventOffset + MidiBufferHelpers::getEventTotalSize (data.begin() + lastEventOffset) != size)
+    {
+        lastEventOffset = 0;
+
+        for (auto offset = 0; offset < size; offset += MidiBufferHelpers::getEventTotalSize (data.begin() + offset))
+            lastEventOffset = offset;
+    }
+
+    return lastEventOffset;
+}
+
+bool MidiBuffer::addEvent (const MidiMessage& m, int sampleNumber)
+{
+    return insertEvent (m.getRawData(), m.getRawDataSize(), sampleNumber, true);
+}
+
+bool MidiBuffer::addEvent (const void* newData, int maxBytes, int sampleNumber)
+{
+    return insertEvent (newData, maxBytes, sampleNumber, true);
+}
+
+bool MidiBuffer::appendEvent (const MidiMessage& m, int sampleNumber)
+{
+    return insertEvent (m.getRawData(), m.getRawDataSize(), sampleNumber, false);
+}
+
+bool MidiBuffer::appendEvent (const void* newData, int maxBytes, int sampleNumber)
+{
+    return insertEvent (newData, maxBytes, sampleNumber, false);
+}
+
+bool MidiBuffer::insertEvent (const void* newData, int maxBytes, int sampleNumber, bool keepSorted)
 {
     auto numBytes = MidiBufferHelpers::findActualEventLength (static_cast<const uint8*> (newData), maxBytes);
 
-    if (numBytes > 0)
+    if (numBytes <= 0)
+        return false;
+
+    auto newItemSize = numBytes + (int) (sizeof (int32) + sizeof (uint16));
+
+    if (! canAdd (newItemSize))
+        return false;
+
+    auto lastEvent = findLastEvent();
+
+    if (! keepSorted || lastEvent < 0 || MidiBufferHelpers::getEventTime (data.begin() + lastEvent) <= sampleNumber)
     {
-        auto newItemSize = (size_t) numBytes + sizeof (int32) + sizeof (uint16);
-        auto offset = (int) (MidiBufferHelpers::findEventAfter (data.begin(), data.end(), sampleNumber) - data.begin());
+        lastEventOffset = data.size();
+        MidiBufferHelpers::appendEvent (data, newData, numBytes, sampleNumber);
+        return true;
+    }
 
-        data.insertMultiple (offset, 0, (int) newItemSize);
+    auto offset = (int) (MidiBufferHelpers::findEventAfter (data.begin(), data.end(), sampleNumber) - data.begin());
 
-        auto* d = data.begin() + offset;
-        writeUnaligned<int32>  (d, sampleNumber);
-        d += sizeof (int32);
-        writeUnaligned<uint16> (d, static_cast<uint16> (numBytes));
-        d += sizeof (uint16);
-        memcpy (d, newData, (size_t) numBytes);
+    data.insertMultiple (offset, 0, newItemSize);
+    MidiBufferHelpers::writeEvent (data.begin() + offset, newData, numBytes, sampleNumber);
+    lastEventOffset = lastEvent + newItemSize;
+    return true;
+}
+
+void MidiBuffer::sortEvents()
+{
+    auto* endData = data.end();
+    auto numEvents = 0;
+    auto isSorted = true;
+    auto previousTime = std::numeric_limits<int>::min();
+
+    for (auto* e = data.begin(); e < endData; e += MidiBufferHelpers::getEventTotalSize (e), ++numEvents)
+    {
+        auto time = MidiBufferHelpers::getEventTime (e);
+        isSorted = isSorted && time >= previousTime;
+        previousTime = time;
     }
+
+    if (isSorted)
+        return;
+
+    // Each key holds the time of an event followed by its offset, so sorting them keeps
+    // the events with the same time in their original order
+    sortKeys.clearQuick();
+    sortKeys.ensureStorageAllocated (numEvents);
+
+    for (auto* e = data.begin(); e < endData; e += MidiBufferHelpers::getEventTotalSize (e))
+        sortKeys.add ((int64) MidiBufferHelpers::getEventTime (e) * 0x100000000LL + (int64) (e - data.begin()));
+
+    std::sort (sortKeys.begin(), sortKeys.end());
+
+    scratchData.clearQuick();
+    scratchData.ensureStorageAllocated (data.size());
+
+    for (auto key : sortKeys)
+    {
+        auto* e = data.begin() + (key & 0xffffffff);
+        scratchData.addArray (e, MidiBufferHelpers::getEventTotalSize (e));
+    }
+
+    data.swapWith (scratchData);
+    scratchData.clearQuick();
+    lastEventOffset = -1;
 }
 
 void MidiBuffer::addEvents (const MidiBuffer& otherBuffer,
                             int startSample, int numSamples, int sampleDeltaToAdd)
 {
-    for (auto i = otherBuffer.findNextSamplePosition (startSample); i != otherBuffer.cend(); ++i)
+    auto first = otherBuffer.findNextSamplePosition (startSample);
+    auto last = otherBuffer.cend();
+
+    if (numSamples >= 0)
+        last = std::find_if (first, last, [&] (const MidiMessageMetadata& metadata) noexcept
+        {
+            return metadata.samplePosition >= startSample + numSamples;
+        });
+
+    if (first == last)
+        return;
+
+    auto lastEvent = findLastEvent();
+
+    // If the new events all come after the existing ones, they can just be appended..
+    if (lastEvent < 0 || MidiBufferHelpers::getEventTime (data.begin() + lastEvent) <= (*first).samplePosition + sampleDeltaToAdd)
+    {
+        for (auto i = first; i != last; ++i)
+        {
+            const auto metadata = *i;
+            addEvent (metadata.data, metadata.numBytes, metadata.samplePosition + sampleDeltaToAdd);
+        }
+
+        return;
+    }
+
+    // ..otherwise they're merged with the existing events into the scratch space
+    scratchData.clearQuick();
+    scratchData.ensureStorageAllocated (fixedCapacity > 0 ? fixedCapacity : data.size() + otherBuffer.data.size());
+
+    auto* d = data.begin();
+    auto* endData = data.end();
+
+    for (auto i = first; i != last; ++i)
     {
         const auto metadata = *i;
+        const auto time = metadata.samplePosition + sampleDeltaToAdd;
+        auto* next = MidiBufferHelpers::findEventAfter (d, endData, time);
 
-        if (metadata.samplePosition >= startSample + numSamples && numSamples >= 0)
-            break;
+        scratchData.addArray (d, (int) (next - d));
+        d = next;
 
-        addEvent (metadata.data, metadata.numBytes, metadata.samplePosition + sampleDeltaToAdd);
+        const auto newItemSize = metadata.numBytes + (int) (sizeof (int32) + sizeof (uint16));
+
+        if (fixedCapacity > 0 && scratchData.size() + newItemSize + (int) (endData - d) > fixedCapacity)
+            ++numDroppedEvents;
+        else
+            MidiBufferHelpers::appendEvent (scratchData, metadata.data, metadata.numBytes, time);
     }
+
+    scratchData.addArray (d, (int) (endData - d));
+    data.swapWith (scratchData);
+    scratchData.clearQuick();
+    lastEventOffset = -1;
 }
 
 int MidiBuffer::getNumEvents() const noexcept
@@ -298,6 +514,189 @@ struct MidiBufferTest  : public UnitTest
                 expectEquals (buffer.getNumEvents(), 1);
             }
         }
+
+        auto random = getRandom();
+
+        beginTest ("Add events in and out of order");
+        {
+            for (int repeat = 0; repeat < 20; ++repeat)
+            {
+                MidiBuffer buffer;
+                Events expected;
+
+                for (int i = 0; i < 100; ++i)
+                {
+                    // mostly in order, with some events going back in time
+                    auto time = random.nextInt (4) == 0 ? random.nextInt (i + 1) : i;
+                    auto message = createMessage (i);
+
+                    expect (buffer.addEvent (message, time));
+                    insertEvent (expected, message, time);
+                }
+
+                expectBufferContains (buffer, expected);
+            }
+        }
+
+        beginTest ("Append events then sort them");
+        {
+            for (int repeat = 0; repeat < 20; ++repeat)
+            {
+                MidiBuffer buffer;
+                Events expected;
+
+                for (int i = 0; i < 100; ++i)
+                {
+                    auto time = random.nextInt ({ -50, 50 });
+                    auto message = createMessage (i);
+
+                    expect (buffer.appendEvent (message, time));
+                    insertEvent (expected, message, time);
+                }
+
+                buffer.sortEvents();
+                expectBufferContains (buffer, expected);
+
+                expect (buffer.addEvent (createMessage (100), 10));
+                insertEvent (expected, createMessage (100), 10);
+                expectBufferContains (buffer, expected);
+            }
+        }
+
+        beginTest ("Merge buffers");
+        {
+            for (int repeat = 0; repeat < 50; ++repeat)
+            {
+                MidiBuffer buffer, other;
+                Events expected, otherEvents;
+
+                for (int i = 0; i < 50; ++i)
+                {
+                    auto time = random.nextInt (100);
+                    buffer.addEvent (createMessage (i), time);
+                    insertEvent (expected, createMessage (i), time);
+
+                    auto otherTime = random.nextInt (100);
+                    other.addEvent (createMessage (i + 50), otherTime);
+                    insertEvent (otherEvents, createMessage (i + 50), otherTime);
+                }
+
+                auto startSample = random.nextInt (100);
+                auto numSamples = random.nextInt ({ -1, 100 });
+                auto delta = random.nextBool() ? random.nextInt ({ -50, 50 }) : 100;
+
+                buffer.addEvents (other, startSample, numSamples, delta);
+
+                for (auto& e : otherEvents)
+                    if (e.first >= startSample && (numSamples < 0 || e.first < startSample + numSamples))
+                        insertEvent (expected, e.second, e.first + delta);
+
+                expectBufferContains (buffer, expected);
+            }
+        }
+
+        beginTest ("Fixed capacity");
+        {
+            const auto message = MidiMessage::noteOn (1, 64, 0.5f);
+            const auto eventSize = 9;
+
+            MidiBuffer buffer;
+            buffer.setFixedCapacity (10 * eventSize + 5);
+            expectEquals (buffer.getFixedCapacity(), 10 * eventSize + 5);
+
+            Array<const uint8*> storage { buffer.data.begin() };
+
+            for (int i = 0; i < 12; ++i)
+                expect (buffer.addEvent (message, 20 - i) == (i < 10));
+
+            expectEquals (buffer.getNumEvents(), 10);
+            expectEquals (buffer.getNumDroppedEvents(), 2);
+            expect (! buffer.appendEvent (message, 0));
+            expectEquals (buffer.getNumDroppedEvents(), 3);
+
+            buffer.resetNumDroppedEvents();
+            expectEquals (buffer.getNumDroppedEvents(), 0);
+
+            buffer.clear (11, 5);
+            storage.addIfNotAlreadyThere (buffer.data.begin());
+            expectEquals (buffer.getNumEvents(), 5);
+
+            for (int i = 0; i < 5; ++i)
+                expect (buffer.appendEvent (message, i * 7));
+
+            buffer.sortEvents();
+            storage.addIfNotAlreadyThere (buffer.data.begin());
+            expectEquals (buffer.getNumEvents(), 10);
+
+            MidiBuffer other;
+
+            for (int i = 0; i < 4; ++i)
+                other.addEvent (message, i * 3);
+
+            buffer.clear (0, 10);
+            expectEquals (buffer.getNumEvents(), 8);
+
+            buffer.addEvents (other, 0, -1, 0);
+            storage.addIfNotAlreadyThere (buffer.data.begin());
+            expectEquals (buffer.getNumEvents(), 10);
+            expectEquals (buffer.getNumDroppedEvents(), 2);
+
+            auto previousTime = 0;
+
+            for (const auto metadata : buffer)
+            {
+                expect (metadata.samplePosition >= previousTime);
+                previousTime = metadata.samplePosition;
+            }
+
+            // the buffer only ever swaps its storage with its preallocated scratch space
+            expectLessOrEqual (storage.size(), 2);
+
+            auto copy = buffer;
+            expectEquals (copy.getFixedCapacity(), buffer.getFixedCapacity());
+            expectEquals (copy.getNumEvents(), 10);
+
+            buffer.setFixedCapacity (0);
+            expect (buffer.addEvent (message, 0));
+            expectEquals (buffer.getNumEvents(), 11);
+        }
+    }
+
+private:
+    using Events = std::vector<std::pair<int, MidiMessage>>;
+
+    static MidiMessage createMessage (int index)
+    {
+        return MidiMessage::noteOn (1 + (index / 128) % 16, index % 128, (uint8) 100);
+    }
+
+    // Inserts an event after any existing events with the same time
+    static void insertEvent (Events& events, const MidiMessage& message, int time)
+    {
+        auto it = std::upper_bound (events.begin(), events.end(), time, [] (int t, const Events::value_type& e)
+        {
+            return t < e.first;
+        });
+
+        events.insert (it, { time, message });
+    }
+
+    void expectBufferContains (const MidiBuffer& buffer, const Events& expected)
+    {
+        expectEquals (buffer.getNumEvents(), (int) expected.size());
+
+        auto it = expected.begin();
+
+        for (const auto metadata : buffer)
+        {
+            if (it == expected.end())
+                break;
+
+            expectEquals (metadata.samplePosition, it->first);
+            expect (metadata.numBytes == it->second.getRawDataSize()
+                     && memcmp (metadata.data, it->second.getRawData(), (size_t) metadata.numBytes) == 0);
+            ++it;
+        }
     }
 };
 
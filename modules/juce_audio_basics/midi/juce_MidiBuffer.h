@@ -137,6 +137,14 @@ private:
     appropriate container. MidiBuffer is designed for lower-level streams of raw
     midi data.
 
+    Adding events in time order is fast, as they are appended to the end of the
+    buffer. If the events you add aren't in order, it can be quicker to append them
+    with appendEvent() and then sort them all at once with sortEvents().
+
+    To use a MidiBuffer on the audio thread without any risk of allocating memory,
+    give it a fixed capacity with setFixedCapacity(). Events which don't fit are
+    then dropped instead of making the buffer grow.
+
     @see MidiMessage
 
     @tags{Audio}
@@ -151,6 +159,18 @@ public:
     /** Creates a MidiBuffer containing a single midi message. */
     explicit MidiBuffer (const MidiMessage& message) noexcept;
 
+    /** Creates a copy of another buffer, which has the same fixed capacity. */
+    MidiBuffer (const MidiBuffer&);
+
+    /** Replaces the contents and fixed capacity of this buffer with those of another one. */
+    MidiBuffer& operator= (const MidiBuffer&);
+
+    /** Move constructor. */
+    MidiBuffer (MidiBuffer&&) noexcept = default;
+
+    /** Move assignment operator. */
+    MidiBuffer& operator= (MidiBuffer&&) noexcept = default;
+
     //==============================================================================
     /** Removes all events from the buffer. */
     void clear() noexcept;
@@ -183,10 +203,15 @@ public:
 
         If an event is added whose sample position is the same as one or more events
         already in the buffer, the new event will be placed after the existing ones.
+        Adding an event which isn't earlier than the last one in the buffer is a
+        constant-time operation.
 
         To retrieve events, use a MidiBufferIterator object
+
+        @returns    false if the event couldn't be added because the buffer has a fixed
+                    capacity which is full, or because the message was empty
     */
-    void addEvent (const MidiMessage& midiMessage, int sampleNumber);
+    bool addEvent (const MidiMessage& midiMessage, int sampleNumber);
 
     /** Adds an event to the buffer from raw midi data.
 
@@ -203,11 +228,43 @@ public:
         add an event at all.
 
         To retrieve events, use a MidiBufferIterator object
+
+        @returns    false if the event couldn't be added because the buffer has a fixed
+                    capacity which is full, or because the midi data was invalid
     */
-    void addEvent (const void* rawMidiData,
+    bool addEvent (const void* rawMidiData,
                    int maxBytesOfMidiData,
                    int sampleNumber);
 
+    /** Adds an event to the end of the buffer, regardless of its sample position.
+
+        This lets you add a batch of events which may be out of order without moving
+        the existing events each time. You must call sortEvents() afterwards, before
+        doing anything else with the buffer.
+
+        @returns    false if the event couldn't be added, see addEvent()
+        @see sortEvents
+    */
+    bool appendEvent (const MidiMessage& midiMessage, int sampleNumber);
+
+    /** Adds an event from raw midi data to the end of the buffer, regardless of its
+        sample position. You must call sortEvents() afterwards, before doing anything
+        else with the buffer.
+
+        @returns    false if the event couldn't be added, see addEvent()
+        @see sortEvents
+    */
+    bool appendEvent (const void* rawMidiData,
+                      int maxBytesOfMidiData,
+                      int sampleNumber);
+
+    /** Sorts the events which were added with appendEvent().
+
+        Events with the same sample position are kept in the order in which they were
+        added. This doesn't allocate any memory if the buffer has a fixed capacity.
+    */
+    void sortEvents();
+
     /** Adds some events from another buffer to this one.
 
         @param otherBuffer          the buffer containing the events you want to add
@@ -221,6 +278,10 @@ public:
                                     startSample will be taken.
         @param sampleDeltaToAdd     a value which will be added to the source timestamps of the events
                                     that are added to this buffer
+
+        The events are merged with the existing ones in a single pass, so this is much
+        quicker than adding them one at a time when they are interleaved with the events
+        already in the buffer.
     */
     void addEvents (const MidiBuffer& otherBuffer,
                     int startSample,
@@ -251,6 +312,32 @@ public:
     */
     void ensureSize (size_t minimumNumBytes);
 
+    //==============================================================================
+    /** Makes the buffer use a fixed amount of memory, so that it never reallocates.
+
+        This allocates the memory that the buffer needs to hold maxNumBytes of events,
+        after which adding, merging, sorting and clearing events won't allocate. Events
+        which don't fit in the buffer are dropped, and counted by getNumDroppedEvents().
+        Each event takes the size of its midi data, plus 6 bytes.
+
+        Pass 0 to let the buffer grow again.
+    */
+    void setFixedCapacity (int maxNumBytes);
+
+    /** Returns the fixed capacity of the buffer in bytes, or 0 if it can grow.
+        @see setFixedCapacity
+    */
+    int getFixedCapacity() const noexcept                   { return fixedCapacity; }
+
+    /** Returns the number of events which have been dropped because the buffer's fixed
+        capacity was full.
+        @see setFixedCapacity, resetNumDroppedEvents
+    */
+    int getNumDroppedEvents() const noexcept                { return numDroppedEvents; }
+
+    /** Resets the number of dropped events to 0. */
+    void resetNumDroppedEvents() noexcept                   { numDroppedEvents = 0; }
+
     /** Get a read-only iterator pointing to the beginning of this buffer. */
     MidiBufferIterator begin()  const noexcept { return cbegin(); }
 
@@ -340,6 +427,17 @@ public:
     Array<uint8> data;
 
 private:
+    //==============================================================================
+    int findLastEvent() noexcept;
+    bool canAdd (int numBytes) noexcept;
+    bool insertEvent (const void*, int, int, bool keepSorted);
+
+    // Space used when merging, sorting and clearing events
+    Array<uint8> scratchData;
+    Array<int64> sortKeys;
+
+    int lastEventOffset = -1, fixedCapacity = 0, numDroppedEvents = 0;
+
     JUCE_LEAK_DETECTOR (MidiBuffer)
 };
 
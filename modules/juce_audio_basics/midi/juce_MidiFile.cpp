@@ -260,6 +260,78 @@ namespace MidiFileHelpers
 
         return result;
     }
+
+    // Finds the extent of a message in the same way as the MidiMessage constructor that
+    // readTrack() uses, but without copying it. Returns the number of bytes used, or <= 0
+    // if there's no valid message.
+    static int findMessageExtent (const uint8* src, int sz, uint8 lastStatusByte,
+                                  uint8& status, const uint8*& body, int& bodySize) noexcept
+    {
+        auto byte = *src;
+        int numBytesUsed = 0;
+
+        if (byte < 0x80)
+        {
+            byte = lastStatusByte;
+            numBytesUsed = -1;
+
+            if (byte < 0x80)
+                return 0;
+        }
+        else
+        {
+            --sz;
+            ++src;
+        }
+
+        status = byte;
+        body = src;
+
+        if (byte == 0xf0)
+        {
+            auto d = src;
+            bool haveReadAllLengthBytes = false;
+
+            while (d < src + sz)
+            {
+                if (*d >= 0x80)
+                {
+                    if (*d == 0xf7)
+                    {
+                        ++d;
+                        break;
+                    }
+
+                    if (haveReadAllLengthBytes)
+                        break;
+
+                    ++body;
+                }
+                else if (! haveReadAllLengthBytes)
+                {
+                    haveReadAllLengthBytes = true;
+                    ++body;
+                }
+
+                ++d;
+            }
+
+            bodySize = (int) (d - body);
+            return numBytesUsed + (int) (d - src) + 1;
+        }
+
+        if (byte == 0xff)
+        {
+            const auto bytesLeft = MidiMessage::readVariableLengthValue (src + 1, sz - 1);
+            bodySize = jmin (sz + 1, bytesLeft.bytesUsed + 2 + bytesLeft.value) - 1;
+        }
+        else
+        {
+            bodySize = jmin (MidiMessage::getMessageLengthFromFirstByte (byte) - 1, sz);
+        }
+
+        return numBytesUsed + bodySize + 1;
+    }
 }
 
 //==============================================================================
@@ -356,7 +428,7 @@ double MidiFile::getLastTimestamp() const
 }
 
 //==============================================================================
-bool MidiFile::readFrom (InputStream& sourceStream, bool createMatchingNoteOffs)
+bool MidiFile::readFrom (InputStream& sourceStream, bool createMatchingNoteOffs, ThreadPool* threadPool)
 {
     clear();
     MemoryBlock data;
@@ -378,10 +450,54 @@ bool MidiFile::readFrom (InputStream& sourceStream, bool createMatchingNoteOffs)
     const auto header = optHeader.value;
     timeFormat = header.timeFormat;
 
-    d += header.bytesRead;
-    size -= (size_t) header.bytesRead;
+    Array<TrackChunk> chunks;
+    auto ok = findTrackChunks (d + header.bytesRead, size - (size_t) header.bytesRead,
+                               header.numberOfTracks, chunks);
+
+    const auto numChunks = chunks.size();
+    std::vector<MidiMessageSequence> sequences ((size_t) numChunks);
+    const auto numJobs = threadPool != nullptr ? jmin (threadPool->getNumThreads(), numChunks - 1) : 0;
+
+    if (numJobs > 0)
+    {
+        std::atomic<int> nextChunk { 0 }, numJobsRunning { numJobs };
+        WaitableEvent jobsFinished;
+
+        auto decodeChunks = [&]
+        {
+            for (int i; (i = nextChunk++) < numChunks;)
+                sequences[(size_t) i] = decodeTrack (chunks.getReference (i), createMatchingNoteOffs);
+        };
+
+        for (int i = 0; i < numJobs; ++i)
+        {
+            threadPool->addJob ([&]
+            {
+                decodeChunks();
+
+                if (--numJobsRunning == 0)
+                    jobsFinished.signal();
+            });
+        }
+
+        decodeChunks();
+        jobsFinished.wait();
+    }
+    else
+    {
+        for (int i = 0; i < numChunks; ++i)
+            sequences[(size_t) i] = decodeTrack (chunks.getReference (i), createMatchingNoteOffs);
+    }
+
+    for (auto& sequence : sequences)
+        tracks.add (new MidiMessageSequence (std::move (sequence)));
+
+    return ok;
+}
 
-    for (int track = 0; track < header.numberOfTracks; ++track)
+bool MidiFile::findTrackChunks (const uint8* d, size_t size, int numChunks, Array<TrackChunk>& chunks)
+{
+    for (int i = 0; i < numChunks; ++i)
     {
         const auto optChunkType = MidiFileHelpers::tryRead<uint32> (d, size);
 
@@ -399,7 +515,7 @@ bool MidiFile::readFrom (InputStream& sourceStream, bool createMatchingNoteOffs)
             return false;
 
         if (optChunkType.value == ByteOrder::bigEndianInt ("MTrk"))
-            readNextTrack (d, (int) chunkSize, createMatchingNoteOffs);
+            chunks.add ({ d, (int) chunkSize });
 
         size -= chunkSize;
         d += chunkSize;
@@ -408,9 +524,9 @@ bool MidiFile::readFrom (InputStream& sourceStream, bool createMatchingNoteOffs)
     return size == 0;
 }
 
-void MidiFile::readNextTrack (const uint8* data, int size, bool createMatchingNoteOffs)
+MidiMessageSequence MidiFile::decodeTrack (const TrackChunk& chunk, bool createMatchingNoteOffs)
 {
-    auto sequence = MidiFileHelpers::readTrack (data, size);
+    auto sequence = MidiFileHelpers::readTrack (chunk.data, chunk.size);
 
     // sort so that we put all the note-offs before note-ons that have the same time
     std::stable_sort (sequence.list.begin(), sequence.list.end(),
@@ -429,7 +545,109 @@ void MidiFile::readNextTrack (const uint8* data, int size, bool createMatchingNo
     if (createMatchingNoteOffs)
         sequence.updateMatchedPairs();
 
-    addTrack (sequence);
+    return sequence;
+}
+
+//==============================================================================
+MidiFile::EventReader::EventReader (const File& fileToRead)
+    : mappedFile (new MemoryMappedFile (fileToRead, MemoryMappedFile::readOnly))
+{
+    if (mappedFile->getData() != nullptr)
+        initialise (mappedFile->getData(), mappedFile->getSize());
+}
+
+MidiFile::EventReader::EventReader (const void* data, size_t numBytes)
+{
+    initialise (data, numBytes);
+}
+
+MidiFile::EventReader::~EventReader() {}
+
+void MidiFile::EventReader::initialise (const void* data, size_t numBytes)
+{
+    auto d = static_cast<const uint8*> (data);
+    const auto optHeader = MidiFileHelpers::parseMidiHeader (d, numBytes);
+
+    if (! optHeader.valid)
+        return;
+
+    const auto header = optHeader.value;
+    valid = true;
+    timeFormat = header.timeFormat;
+
+    // like readFrom(), this keeps any tracks found before a malformed chunk
+    findTrackChunks (d + header.bytesRead, numBytes - (size_t) header.bytesRead, header.numberOfTracks, tracks);
+    seekToTrack (0);
+}
+
+bool MidiFile::EventReader::seekToTrack (int trackIndex) noexcept
+{
+    currentTick = 0;
+    lastStatusByte = 0;
+
+    if (! isPositiveAndBelow (trackIndex, tracks.size()))
+    {
+        currentTrack = tracks.size();
+        position = nullptr;
+        remaining = 0;
+        return false;
+    }
+
+    auto& chunk = tracks.getReference (trackIndex);
+    currentTrack = trackIndex;
+    position = chunk.data;
+    remaining = chunk.size;
+    return true;
+}
+
+bool MidiFile::EventReader::readNextEvent (Event& result) noexcept
+{
+    while (currentTrack < tracks.size())
+    {
+        if (remaining > 0)
+        {
+            const auto delay = MidiMessage::readVariableLengthValue (position, remaining);
+
+            if (delay.isValid() && delay.bytesUsed < remaining)
+            {
+                auto src = position + delay.bytesUsed;
+                auto srcSize = remaining - delay.bytesUsed;
+
+                const auto numBytesUsed = MidiFileHelpers::findMessageExtent (src, srcSize, lastStatusByte, result.status,
+                                                                              result.data, result.dataSize);
+
+                if (numBytesUsed > 0)
+                {
+                    currentTick += delay.value;
+
+                    result.tick = currentTick;
+                    result.track = currentTrack;
+                    result.source = src;
+                    result.sourceSize = srcSize;
+                    result.lastStatusByte = lastStatusByte;
+
+                    if ((result.status & 0xf0) != 0xf0)
+                        lastStatusByte = result.status;
+
+                    position = src + numBytesUsed;
+                    remaining = srcSize - numBytesUsed;
+                    return true;
+                }
+            }
+        }
+
+        seekToTrack (currentTrack + 1);
+    }
+
+    return false;
+}
+
+MidiMessage MidiFile::EventReader::Event::getMessage() const
+{
+    jassert (source != nullptr);
+
+    int numBytesUsed = 0;
+    return MidiMessage (source, sourceSize, numBytesUsed, lastStatusByte, (double) tick);
 }
 
 //==============================================================================
@@ -747,6 +965,193 @@ struct MidiFileTest  : public UnitTest
                 expectEquals (track.getEventPointer (0)->message.getTimeStamp(), (double) 0x0f);
             }
         }
+
+        beginTest ("Parallel read matches serial read");
+        {
+            auto random = getRandom();
+            ThreadPool pool (3);
+
+            for (int i = 0; i < 20; ++i)
+            {
+                const auto data = createRandomFile (random, random.nextInt (8));
+
+                for (auto createMatchingNoteOffs : { false, true })
+                {
+                    MidiFile serial, parallel;
+                    MemoryInputStream serialStream (data, false), parallelStream (data, false);
+
+                    expect (serial.readFrom (serialStream, createMatchingNoteOffs));
+                    expect (parallel.readFrom (parallelStream, createMatchingNoteOffs, &pool));
+                    expectEquals (parallel.getNumTracks(), serial.getNumTracks());
+
+                    for (int t = 0; t < serial.getNumTracks(); ++t)
+                        expectSequencesEqual (*parallel.getTrack (t), *serial.getTrack (t));
+                }
+            }
+        }
+
+        beginTest ("EventReader reads the same events as readTrack");
+        {
+            auto random = getRandom();
+
+            for (int i = 0; i < 50; ++i)
+            {
+                auto data = createRandomFile (random, 1 + random.nextInt (4));
+                const auto chunks = findChunks (data);
+
+                // scribble over some of the events to check that malformed tracks end in the same place
+                if (i % 2 != 0)
+                {
+                    for (auto& chunk : chunks)
+                        for (int j = random.nextInt (4); --j >= 0;)
+                            data[chunk.getStart() + (size_t) random.nextInt ((int) chunk.getLength())] = (char) random.nextInt (256);
+                }
+
+                MidiFile::EventReader reader (data.getData(), data.getSize());
+                expect (reader.isValid());
+                expectEquals (reader.getTimeFormat(), (short) 960);
+                expectEquals (reader.getNumTracks(), chunks.size());
+
+                Array<MidiMessageSequence> sequences;
+                sequences.resize (chunks.size());
+                MidiFile::EventReader::Event e;
+
+                while (reader.readNextEvent (e))
+                {
+                    const auto m = e.getMessage();
+                    expect (m.getRawData()[0] == e.status);
+                    expect (e.dataSize < m.getRawDataSize());
+                    expect (memcmp (m.getRawData() + 1, e.data, (size_t) e.dataSize) == 0);
+                    sequences.getReference (e.track).addEvent (m);
+                }
+
+                for (int t = 0; t < chunks.size(); ++t)
+                {
+                    const auto expected = MidiFileHelpers::readTrack (static_cast<const uint8*> (data.getData()) + chunks[t].getStart(),
+                                                     (int) chunks[t].getLength());
+                    expectSequencesEqual (sequences.getReference (t), expected);
+
+                    expect (reader.seekToTrack (t));
+
+                    if (expected.getNumEvents() > 0)
+                    {
+                        expect (reader.readNextEvent (e));
+                        expectEquals (e.track, t);
+                        expectEquals (e.tick, (int64) expected.getEventTime (0));
+                    }
+                }
+
+                expect (! reader.seekToTrack (chunks.size()));
+                expect (! reader.readNextEvent (e));
+            }
+        }
+
+        beginTest ("EventReader can map a file");
+        {
+            auto random = getRandom();
+            const auto data = createRandomFile (random, 3);
+
+            TemporaryFile tempFile (".mid");
+            expect (tempFile.getFile().replaceWithData (data.getData(), data.getSize()));
+
+            MidiFile file;
+            MemoryInputStream stream (data, false);
+            expect (file.readFrom (stream, false));
+
+            MidiFile::EventReader reader (tempFile.getFile());
+            expect (reader.isValid());
+            expectEquals (reader.getNumTracks(), file.getNumTracks());
+
+            int numEvents = 0;
+            MidiFile::EventReader::Event e;
+
+            while (reader.readNextEvent (e))
+                ++numEvents;
+
+            int expectedNumEvents = 0;
+
+            for (int t = 0; t < file.getNumTracks(); ++t)
+                expectedNumEvents += file.getTrack (t)->getNumEvents();
+
+            expectEquals (numEvents, expectedNumEvents);
+            expect (! MidiFile::EventReader (tempFile.getFile().getSiblingFile ("doesNotExist.mid")).isValid());
+        }
+    }
+
+    static MemoryBlock createRandomFile (Random& random, int numTracks)
+    {
+        MidiFile file;
+        file.setTicksPerQuarterNote (960);
+
+        for (int t = 0; t < numTracks; ++t)
+        {
+            MidiMessageSequence sequence;
+            double time = 0;
+
+            for (int i = random.nextInt (500); --i >= 0;)
+            {
+                time += random.nextInt (3) * random.nextInt (200);
+                const auto channel = 1 + random.nextInt (2);
+                const auto type = random.nextInt (20);
+
+                if (type == 0)
+                {
+                    const uint8 sysex[] = { 0x41, 0x10, (uint8) random.nextInt (128), 0x12 };
+                    sequence.addEvent (MidiMessage::createSysExMessage (sysex, numElementsInArray (sysex)), time);
+                }
+                else if (type == 1)
+                {
+                    sequence.addEvent (MidiMessage::textMetaEvent (1, "some text"), time);
+                }
+                else if (type == 2)
+                {
+                    sequence.addEvent (MidiMessage::controllerEvent (channel, random.nextInt (128), random.nextInt (128)), time);
+                }
+                else if (type < 11)
+                {
+                    sequence.addEvent (MidiMessage::noteOn (channel, random.nextInt (16), (uint8) (1 + random.nextInt (127))), time);
+                }
+                else
+                {
+                    sequence.addEvent (MidiMessage::noteOff (channel, random.nextInt (16)), time);
+                }
+            }
+
+            file.addTrack (sequence);
+        }
+
+        MemoryOutputStream os;
+        file.writeTo (os);
+        return os.getMemoryBlock();
+    }
+
+    static Array<Range<size_t>> findChunks (const MemoryBlock& data)
+    {
+        Array<Range<size_t>> chunks;
+
+        for (size_t pos = 14; pos + 8 <= data.getSize();)
+        {
+            auto size = (size_t) ByteOrder::bigEndianInt (static_cast<const char*> (data.getData()) + pos + 4);
+            chunks.add (Range<size_t>::withStartAndLength (pos + 8, size));
+            pos += 8 + size;
+        }
+
+        return chunks;
+    }
+
+    void expectSequencesEqual (const MidiMessageSequence& a, const MidiMessageSequence& b)
+    {
+        expectEquals (a.getNumEvents(), b.getNumEvents());
+
+        for (int i = 0; i < jmin (a.getNumEvents(), b.getNumEvents()); ++i)
+        {
+            auto& m1 = a.getEventPointer (i)->message;
+            auto& m2 = b.getEventPointer (i)->message;
+
+            expectEquals (m1.getTimeStamp(), m2.getTimeStamp());
+            expectEquals (m1.getRawDataSize(), m2.getRawDataSize());
+            expect (memcmp (m1.getRawData(), m2.getRawData(), (size_t) jmin (m1.getRawDataSize(), m2.getRawDataSize())) == 0);
+        }
     }
 
     template <typename Fn>
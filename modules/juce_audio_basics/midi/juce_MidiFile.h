@@ -156,14 +156,23 @@ public:
         terms of midi ticks. To convert them to seconds, use the convertTimestampTicksToSeconds()
         method.
 
+        If a ThreadPool is supplied, the tracks are decoded concurrently on its threads, with
+        the calling thread joining in, and this method returns once they have all been added.
+        The resulting tracks are identical to those of a serial read, so this only pays off
+        for files with several large tracks. Don't call it from one of the pool's own jobs.
+
         @param sourceStream              the source stream
         @param createMatchingNoteOffs    if true, any missing note-offs for previous note-ons will
                                          be automatically added at the end of the file by calling
                                          MidiMessageSequence::updateMatchedPairs on each track.
+        @param threadPool                an optional pool to use for decoding the tracks
 
         @returns true if the stream was read successfully
+        @see EventReader
     */
-    bool readFrom (InputStream& sourceStream, bool createMatchingNoteOffs = true);
+    bool readFrom (InputStream& sourceStream,
+                   bool createMatchingNoteOffs = true,
+                   ThreadPool* threadPool = nullptr);
 
     /** Writes the midi tracks as a standard midi file.
         The midiFileType value is written as the file's format type, which can be 0, 1
@@ -183,12 +192,129 @@ public:
     */
     void convertTimestampTicksToSeconds();
 
+private:
+    //==============================================================================
+    struct TrackChunk
+    {
+        const uint8* data;
+        int size;
+    };
+
+public:
+    //==============================================================================
+    /**
+        Iterates the events of a midi file in place, without building MidiMessage or
+        MidiMessageSequence objects for them.
+
+        This is intended for quickly scanning large numbers of files: the reader can
+        memory-map a file, and each Event just points at the bytes of the message in the
+        file's data. The events of each track are returned in the order in which they
+        appear in the file, one track after another, with their positions in midi ticks.
+        Unlike readFrom(), no sorting is done and no note-offs are added.
+
+        @code
+        MidiFile::EventReader reader (file);
+        MidiFile::EventReader::Event e;
+
+        while (reader.readNextEvent (e))
+            if ((e.status & 0xf0) == 0x90 && e.dataSize > 1 && e.data[1] != 0)
+                ++numNoteOns;
+        @endcode
+
+        @see MidiFile::readFrom
+    */
+    class JUCE_API  EventReader
+    {
+    public:
+        /** Memory-maps a file and prepares to read its events. */
+        explicit EventReader (const File& fileToRead);
+
+        /** Prepares to read the events from a block of data in midi file format.
+            The data isn't copied, so it must stay valid while this object is in use.
+        */
+        EventReader (const void* data, size_t numBytes);
+
+        /** Destructor. */
+        ~EventReader();
+
+        /** Returns true if the data could be opened and has a valid header. */
+        bool isValid() const noexcept                   { return valid; }
+
+        /** Returns the raw time format code from the header.
+            @see MidiFile::getTimeFormat
+        */
+        short getTimeFormat() const noexcept            { return timeFormat; }
+
+        /** Returns the number of tracks that were found. */
+        int getNumTracks() const noexcept               { return tracks.size(); }
+
+        //==============================================================================
+        /** A midi event, pointing into the reader's data. */
+        struct Event
+        {
+            /** The position of the event in midi ticks from the start of its track. */
+            int64 tick = 0;
+
+            /** The index of the track that contains the event. */
+            int track = 0;
+
+            /** The status byte of the message, with any running status resolved. */
+            uint8 status = 0;
+
+            /** The bytes of the message that follow the status byte, as they'd appear
+                in MidiMessage::getRawData(). For a sysex these don't include the length
+                prefix, and for a meta-event they start with the type.
+            */
+            const uint8* data = nullptr;
+
+            /** The number of bytes that data points to. */
+            int dataSize = 0;
+
+            /** Creates a MidiMessage for this event, timestamped with its tick. This is
+                the same message that MidiFile::readFrom() would have created.
+            */
+            MidiMessage getMessage() const;
+
+        private:
+            friend class EventReader;
+            const uint8* source = nullptr;
+            int sourceSize = 0;
+            uint8 lastStatusByte = 0;
+        };
+
+        /** Reads the next event, moving on to the next track when the current one ends.
+            @returns false when there are no more events
+        */
+        bool readNextEvent (Event& result) noexcept;
+
+        /** Moves to the start of a track, so that the next event read is its first one.
+            @returns false if the index is out of range
+        */
+        bool seekToTrack (int trackIndex) noexcept;
+
+    private:
+        //==============================================================================
+        std::unique_ptr<MemoryMappedFile> mappedFile;
+        Array<TrackChunk> tracks;
+        const uint8* position = nullptr;
+        int remaining = 0, currentTrack = 0;
+        int64 currentTick = 0;
+        uint8 lastStatusByte = 0;
+        short timeFormat = 0;
+        bool valid = false;
+
+        void initialise (const void*, size_t);
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (EventReader)
+    };
+
 private:
     //==============================================================================
     OwnedArray<MidiMessageSequence> tracks;
     short timeFormat;
 
-    void readNextTrack (const uint8*, int, bool);
+    static bool findTrackChunks (const uint8*, size_t, int, Array<TrackChunk>&);
+    static MidiMessageSequence decodeTrack (const TrackChunk&, bool);
     bool writeTrack (OutputStream&, const MidiMessageSequence&) const;
 
     JUCE_LEAK_DETECTOR (MidiFile)
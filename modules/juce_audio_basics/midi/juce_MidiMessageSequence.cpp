@@ -27,6 +27,31 @@ MidiMessageSequence::MidiEventHolder::MidiEventHolder (const MidiMessage& mm) :
 MidiMessageSequence::MidiEventHolder::MidiEventHolder (MidiMessage&& mm) : message (std::move (mm)) {}
 MidiMessageSequence::MidiEventHolder::~MidiEventHolder() {}
 
+namespace MidiMessageSequenceHelpers
+{
+    static bool isEarlier (const MidiMessageSequence::MidiEventHolder* a, const MidiMessageSequence::MidiEventHolder* b) noexcept
+    {
+        return a->message.getTimeStamp() < b->message.getTimeStamp();
+    }
+
+    // Deletes the events for which the predicate is true, in a single pass
+    template <typename Predicate>
+    static void removeEvents (OwnedArray<MidiMessageSequence::MidiEventHolder>& list, Predicate&& shouldRemove)
+    {
+        auto* dest = list.begin();
+
+        for (auto* meh : list)
+        {
+            if (shouldRemove (meh->message))
+                delete meh;
+            else
+                *dest++ = meh;
+        }
+
+        list.removeLast ((int) (list.end() - dest), false);
+    }
+}
+
 //==============================================================================
 MidiMessageSequence::MidiMessageSequence()
 {
@@ -107,11 +132,9 @@ int MidiMessageSequence::getIndexOfMatchingKeyUp (int index) const noexcept
     {
         if (auto* noteOff = meh->noteOffObject)
         {
-            for (int i = index; i < list.size(); ++i)
-                if (list.getUnchecked(i) == noteOff)
-                    return i;
-
-            jassertfalse; // we've somehow got a pointer to a note-off object that isn't in the sequence
+            auto noteOffIndex = getIndexOf (noteOff);
+            jassert (noteOffIndex >= 0); // we've somehow got a pointer to a note-off object that isn't in the sequence
+            return noteOffIndex;
         }
     }
 
@@ -120,19 +143,33 @@ int MidiMessageSequence::getIndexOfMatchingKeyUp (int index) const noexcept
 
 int MidiMessageSequence::getIndexOf (const MidiEventHolder* event) const noexcept
 {
+    if (event != nullptr)
+    {
+        // The events are sorted, so only the ones with the same time need to be searched..
+        auto time = event->message.getTimeStamp();
+
+        for (auto i = getNextIndexAtTime (time); i < list.size(); ++i)
+        {
+            auto* meh = list.getUnchecked (i);
+
+            if (meh == event)
+                return i;
+
+            if (meh->message.getTimeStamp() != time)
+                break;
+        }
+    }
+
+    // ..unless the event's time has been changed since it was added
     return list.indexOf (event);
 }
 
 int MidiMessageSequence::getNextIndexAtTime (double timeStamp) const noexcept
 {
-    auto numEvents = list.size();
-    int i;
+    auto* found = std::lower_bound (list.begin(), list.end(), timeStamp,
+                                    [] (const MidiEventHolder* meh, double t) { return meh->message.getTimeStamp() < t; });
 
-    for (i = 0; i < numEvents; ++i)
-        if (list.getUnchecked(i)->message.getTimeStamp() >= timeStamp)
-            break;
-
-    return i;
+    return (int) (found - list.begin());
 }
 
 //==============================================================================
@@ -159,13 +196,11 @@ MidiMessageSequence::MidiEventHolder* MidiMessageSequence::addEvent (MidiEventHo
 {
     newEvent->message.addToTimeStamp (timeAdjustment);
     auto time = newEvent->message.getTimeStamp();
-    int i;
 
-    for (i = list.size(); --i >= 0;)
-        if (list.getUnchecked(i)->message.getTimeStamp() <= time)
-            break;
+    auto* insertPoint = std::upper_bound (list.begin(), list.end(), time,
+                                          [] (double t, const MidiEventHolder* meh) { return t < meh->message.getTimeStamp(); });
 
-    list.insert (i + 1, newEvent);
+    list.insert ((int) (insertPoint - list.begin()), newEvent);
     return newEvent;
 }
 
@@ -192,6 +227,9 @@ void MidiMessageSequence::deleteEvent (int index, bool deleteMatchingNoteUp)
 
 void MidiMessageSequence::addSequence (const MidiMessageSequence& other, double timeAdjustment)
 {
+    auto numExistingEvents = list.size();
+    list.ensureStorageAllocated (numExistingEvents + other.getNumEvents());
+
     for (auto* m : other)
     {
         auto newOne = new MidiEventHolder (m->message);
@@ -199,7 +237,7 @@ void MidiMessageSequence::addSequence (const MidiMessageSequence& other, double
         list.add (newOne);
     }
 
-    sort();
+    mergeNewEvents (numExistingEvents);
 }
 
 void MidiMessageSequence::addSequence (const MidiMessageSequence& other,
@@ -207,6 +245,8 @@ void MidiMessageSequence::addSequence (const MidiMessageSequence& other,
                                        double firstAllowableTime,
                                        double endOfAllowableDestTimes)
 {
+    auto numExistingEvents = list.size();
+
     for (auto* m : other)
     {
         auto t = m->message.getTimeStamp() + timeAdjustment;
@@ -219,53 +259,84 @@ void MidiMessageSequence::addSequence (const MidiMessageSequence& other,
         }
     }
 
-    sort();
+    mergeNewEvents (numExistingEvents);
+}
+
+void MidiMessageSequence::mergeNewEvents (int firstNewEventIndex)
+{
+    auto* firstNewEvent = list.begin() + firstNewEventIndex;
+
+    if (std::is_sorted (list.begin(), firstNewEvent, MidiMessageSequenceHelpers::isEarlier)
+         && std::is_sorted (firstNewEvent, list.end(), MidiMessageSequenceHelpers::isEarlier))
+        std::inplace_merge (list.begin(), firstNewEvent, list.end(), MidiMessageSequenceHelpers::isEarlier);
+    else
+        sort();
 }
 
 void MidiMessageSequence::sort() noexcept
 {
-    std::stable_sort (list.begin(), list.end(),
-                      [] (const MidiEventHolder* a, const MidiEventHolder* b) { return a->message.getTimeStamp() < b->message.getTimeStamp(); });
+    std::stable_sort (list.begin(), list.end(), MidiMessageSequenceHelpers::isEarlier);
 }
 
 void MidiMessageSequence::updateMatchedPairs() noexcept
 {
-    for (int i = 0; i < list.size(); ++i)
+    // The note-on which is waiting for a note-off, for each channel and note
+    MidiEventHolder* pendingNoteOns[16][128] = {};
+
+    // If any note-offs have to be added, the events are copied into a new list
+    Array<MidiEventHolder*> newList;
+    auto hasNewList = false;
+    auto numEvents = list.size();
+
+    for (int i = 0; i < numEvents; ++i)
     {
-        auto* meh = list.getUnchecked(i);
-        auto& m1 = meh->message;
+        auto* meh = list.getUnchecked (i);
+        auto& m = meh->message;
+        auto isNoteOn = m.isNoteOn();
 
-        if (m1.isNoteOn())
+        if (isNoteOn || m.isNoteOff())
         {
-            meh->noteOffObject = nullptr;
-            auto note = m1.getNoteNumber();
-            auto chan = m1.getChannel();
-            auto len = list.size();
+            auto chan = m.getChannel();
+            auto note = m.getNoteNumber();
+            auto& pending = pendingNoteOns[chan - 1][note];
 
-            for (int j = i + 1; j < len; ++j)
+            if (isNoteOn)
             {
-                auto* meh2 = list.getUnchecked(j);
-                auto& m = meh2->message;
-
-                if (m.getNoteNumber() == note && m.getChannel() == chan)
+                // a note-on which is followed by another one on the same note is ended by
+                // a note-off at the same time as the second one
+                if (pending != nullptr)
                 {
-                    if (m.isNoteOff())
+                    if (! hasNewList)
                     {
-                        meh->noteOffObject = meh2;
-                        break;
+                        newList.ensureStorageAllocated (numEvents + 1);
+                        newList.addArray (list.begin(), i);
+                        hasNewList = true;
                     }
 
-                    if (m.isNoteOn())
-                    {
-                        auto newEvent = new MidiEventHolder (MidiMessage::noteOff (chan, note));
-                        list.insert (j, newEvent);
-                        newEvent->message.setTimeStamp (m.getTimeStamp());
-                        meh->noteOffObject = newEvent;
-                        break;
-                    }
+                    auto newEvent = new MidiEventHolder (MidiMessage::noteOff (chan, note));
+                    newEvent->message.setTimeStamp (m.getTimeStamp());
+                    pending->noteOffObject = newEvent;
+                    newList.add (newEvent);
                 }
+
+                meh->noteOffObject = nullptr;
+                pending = meh;
+            }
+            else if (pending != nullptr)
+            {
+                pending->noteOffObject = meh;
+                pending = nullptr;
             }
         }
+
+        if (hasNewList)
+            newList.add (meh);
+    }
+
+    if (hasNewList)
+    {
+        list.clearQuick (false);
+        list.addArray (newList);
     }
 }
 
@@ -296,16 +367,12 @@ void MidiMessageSequence::extractSysExMessages (MidiMessageSequence& destSequenc
 
 void MidiMessageSequence::deleteMidiChannelMessages (const int channelNumberToRemove)
 {
-    for (int i = list.size(); --i >= 0;)
-        if (list.getUnchecked(i)->message.isForChannel (channelNumberToRemove))
-            list.remove(i);
+    MidiMessageSequenceHelpers::removeEvents (list, [=] (const MidiMessage& m) { return m.isForChannel (channelNumberToRemove); });
 }
 
 void MidiMessageSequence::deleteSysExMessages()
 {
-    for (int i = list.size(); --i >= 0;)
-        if (list.getUnchecked(i)->message.isSysEx())
-            list.remove(i);
+    MidiMessageSequenceHelpers::removeEvents (list, [] (const MidiMessage& m) { return m.isSysEx(); });
 }
 
 //==============================================================================
@@ -402,6 +469,183 @@ struct MidiMessageSequenceTest  : public UnitTest
         expectEquals (s.getNumEvents(), 7);
         expectEquals (s.getIndexOfMatchingKeyUp (0), -1); // Truncated note, should be no note off
         expectEquals (s.getTimeOfMatchingKeyUp (1), 5.0);
+
+        auto random = getRandom();
+
+        beginTest ("Searching random sequences");
+        for (int repeat = 0; repeat < 20; ++repeat)
+        {
+            MidiMessageSequence seq;
+            std::vector<MidiMessage> expected;
+
+            for (int i = 0; i < 200; ++i)
+            {
+                auto m = MidiMessage::controllerEvent (1, i % 128, i / 128).withTimeStamp (random.nextInt (50));
+                seq.addEvent (m);
+
+                // events are added after any others with the same time
+                auto it = std::upper_bound (expected.begin(), expected.end(), m.getTimeStamp(),
+                                            [] (double t, const MidiMessage& e) { return t < e.getTimeStamp(); });
+                expected.insert (it, m);
+            }
+
+            expectSequenceContains (seq, expected);
+
+            for (int i = 0; i < 20; ++i)
+            {
+                auto time = random.nextDouble() * 60.0 - 5.0;
+                auto index = (int) (std::find_if (expected.begin(), expected.end(),
+                                                  [=] (const MidiMessage& e) { return e.getTimeStamp() >= time; }) - expected.begin());
+
+                expectEquals (seq.getNextIndexAtTime (time), index);
+
+                auto eventIndex = random.nextInt (seq.getNumEvents());
+                expectEquals (seq.getIndexOf (seq.getEventPointer (eventIndex)), eventIndex);
+            }
+
+            // an event whose time has been changed can still be found
+            auto* moved = seq.getEventPointer (10);
+            moved->message.setTimeStamp (1000.0);
+            expectEquals (seq.getIndexOf (moved), 10);
+
+            seq.sort();
+            expectEquals (seq.getIndexOf (moved), seq.getNumEvents() - 1);
+        }
+
+        beginTest ("Matching pairs in random sequences");
+        for (int repeat = 0; repeat < 20; ++repeat)
+        {
+            MidiMessageSequence seq;
+
+            for (int i = 0; i < 300; ++i)
+            {
+                auto channel = 1 + random.nextInt (2);
+                auto note = 60 + random.nextInt (4);
+                auto time = (double) random.nextInt (100);
+
+                switch (random.nextInt (4))
+                {
+                    case 0:  seq.addEvent (MidiMessage::noteOn (channel, note, (uint8) 0).withTimeStamp (time)); break;
+                    case 1:  seq.addEvent (MidiMessage::noteOff (channel, note).withTimeStamp (time)); break;
+                    case 2:  seq.addEvent (MidiMessage::aftertouchChange (channel, note, 10).withTimeStamp (time)); break;
+                    default: seq.addEvent (MidiMessage::noteOn (channel, note, 0.5f).withTimeStamp (time)); break;
+                }
+            }
+
+            std::vector<MidiMessage> expected;
+            std::vector<int> expectedNoteOffs;
+
+            for (auto* meh : seq)
+                expected.push_back (meh->message);
+
+            findMatchedPairs (expected, expectedNoteOffs);
+
+            seq.updateMatchedPairs();
+            expectSequenceContains (seq, expected);
+
+            for (int i = 0; i < seq.getNumEvents(); ++i)
+                if (expected[(size_t) i].isNoteOn())
+                    expectEquals (seq.getIndexOfMatchingKeyUp (i), expectedNoteOffs[(size_t) i]);
+
+            // pairing again doesn't change anything
+            seq.updateMatchedPairs();
+            expectSequenceContains (seq, expected);
+
+            auto copy = seq;
+
+            for (int i = 0; i < seq.getNumEvents(); ++i)
+                expectEquals (copy.getIndexOfMatchingKeyUp (i), seq.getIndexOfMatchingKeyUp (i));
+        }
+
+        beginTest ("Merging and deleting in random sequences");
+        for (int repeat = 0; repeat < 20; ++repeat)
+        {
+            MidiMessageSequence seq1, seq2;
+            std::vector<MidiMessage> expected;
+
+            for (int i = 0; i < 100; ++i)
+            {
+                seq1.addEvent (MidiMessage::controllerEvent (1 + random.nextInt (3), i, 0).withTimeStamp (random.nextInt (50)));
+                seq2.addEvent (MidiMessage::controllerEvent (1 + random.nextInt (3), i, 1).withTimeStamp (random.nextInt (50)));
+            }
+
+            for (auto* meh : seq1)
+                expected.push_back (meh->message);
+
+            for (auto* meh : seq2)
+                expected.push_back (meh->message.withTimeStamp (meh->message.getTimeStamp() + 10.0));
+
+            std::stable_sort (expected.begin(), expected.end(),
+                              [] (const MidiMessage& a, const MidiMessage& b) { return a.getTimeStamp() < b.getTimeStamp(); });
+
+            seq1.addSequence (seq2, 10.0);
+            expectSequenceContains (seq1, expected);
+
+            seq1.deleteMidiChannelMessages (2);
+
+            expected.erase (std::remove_if (expected.begin(), expected.end(),
+                                            [] (const MidiMessage& m) { return m.isForChannel (2); }),
+                            expected.end());
+
+            expectSequenceContains (seq1, expected);
+        }
+    }
+
+    void expectSequenceContains (const MidiMessageSequence& seq, const std::vector<MidiMessage>& expected)
+    {
+        expectEquals (seq.getNumEvents(), (int) expected.size());
+
+        for (int i = 0; i < jmin (seq.getNumEvents(), (int) expected.size()); ++i)
+        {
+            auto& m = seq.getEventPointer (i)->message;
+            auto& e = expected[(size_t) i];
+
+            expect (m.getTimeStamp() == e.getTimeStamp()
+                     && m.getRawDataSize() == e.getRawDataSize()
+                     && memcmp (m.getRawData(), e.getRawData(), (size_t) m.getRawDataSize()) == 0);
+        }
+    }
+
+    // A straightforward version of updateMatchedPairs(), which scans ahead from each note-on
+    static void findMatchedPairs (std::vector<MidiMessage>& events, std::vector<int>& noteOffs)
+    {
+        noteOffs.assign (events.size(), -1);
+
+        for (size_t i = 0; i < events.size(); ++i)
+        {
+            auto m1 = events[i];
+
+            if (! m1.isNoteOn())
+                continue;
+
+            for (size_t j = i + 1; j < events.size(); ++j)
+            {
+                auto& m = events[j];
+
+                if (m.getNoteNumber() == m1.getNoteNumber() && m.getChannel() == m1.getChannel())
+                {
+                    if (m.isNoteOff())
+                    {
+                        noteOffs[i] = (int) j;
+                        break;
+                    }
+
+                    if (m.isNoteOn())
+                    {
+                        events.insert (events.begin() + (int) j, MidiMessage::noteOff (m1.getChannel(), m1.getNoteNumber())
+                                                                     .withTimeStamp (m.getTimeStamp()));
+                        noteOffs.insert (noteOffs.begin() + (int) j, -1);
+
+                        for (auto& n : noteOffs)
+                            if (n >= (int) j)
+                                ++n;
+
+                        noteOffs[i] = (int) j;
+                        break;
+                    }
+                }
+            }
+        }
     }
 };
 
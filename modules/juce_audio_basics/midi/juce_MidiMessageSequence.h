@@ -126,12 +126,18 @@ public:
     */
     int getIndexOfMatchingKeyUp (int index) const noexcept;
 
-    /** Returns the index of an event. */
+    /** Returns the index of an event.
+
+        The event is looked up using its timestamp, so this is quick unless the
+        timestamp has been changed without the sequence being sorted again.
+    */
     int getIndexOf (const MidiEventHolder* event) const noexcept;
 
     /** Returns the index of the first event on or after the given timestamp.
         If the time is beyond the end of the sequence, this will return the
         number of events.
+
+        This does a binary search, so it takes O(log n) time.
     */
     int getNextIndexAtTime (double timeStamp) const noexcept;
 
@@ -155,7 +161,7 @@ public:
     /** Inserts a midi message into the sequence.
 
         The index at which the new message gets inserted will depend on its timestamp,
-        because the sequence is kept sorted.
+        because the sequence is kept sorted. It's found with a binary search.
 
         Remember to call updateMatchedPairs() after adding note-on events.
 
@@ -169,7 +175,7 @@ public:
     /** Inserts a midi message into the sequence.
 
         The index at which the new message gets inserted will depend on its timestamp,
-        because the sequence is kept sorted.
+        because the sequence is kept sorted. It's found with a binary search.
 
         Remember to call updateMatchedPairs() after adding note-on events.
 
@@ -223,7 +229,8 @@ public:
 
         Call this after re-ordering messages or deleting/adding messages, and it
         will scan the list and make sure all the note-offs in the MidiEventHolder
-        structures are pointing at the correct ones.
+        structures are pointing at the correct ones. This is done in a single pass
+        through the sequence.
     */
     void updateMatchedPairs() noexcept;
 
@@ -299,6 +306,7 @@ private:
     OwnedArray<MidiEventHolder> list;
 
     MidiEventHolder* addEvent (MidiEventHolder*, double);
+    void mergeNewEvents (int firstNewEventIndex);
 
     JUCE_LEAK_DETECTOR (MidiMessageSequence)
 };
@@ -41,6 +41,7 @@ MPEInstrument::MPEInstrument() noexcept
     mpeInstrumentFill (lastPressureLowerBitReceivedOnChannel, noLSBValueReceived);
     mpeInstrumentFill (lastTimbreLowerBitReceivedOnChannel, noLSBValueReceived);
     mpeInstrumentFill (isMemberChannelSustained, false);
+    removeAllNotes();
 
     pitchbendDimension.value = &MPENote::pitchbend;
     pressureDimension.value = &MPENote::pressure;
@@ -78,6 +79,46 @@ void MPEInstrument::resetLastReceivedValues()
     }
 }
 
+//==============================================================================
+void MPEInstrument::addNote (const MPENote& note)
+{
+    auto channel = note.midiChannel - 1;
+
+    noteIndex[channel][note.initialNote] = (int16) notes.size();
+    notesOnChannel[channel][numNotesOnChannel[channel]++] = (uint8) note.initialNote;
+    notes.add (note);
+}
+
+void MPEInstrument::removeNote (int index)
+{
+    auto& note = notes.getReference (index);
+    auto channel = note.midiChannel - 1;
+    auto* channelNotes = notesOnChannel[channel];
+
+    std::remove (channelNotes, channelNotes + numNotesOnChannel[channel], (uint8) note.initialNote);
+    --numNotesOnChannel[channel];
+    noteIndex[channel][note.initialNote] = -1;
+
+    notes.remove (index);
+
+    for (auto i = index; i < notes.size(); ++i)
+    {
+        auto& laterNote = notes.getReference (i);
+        --noteIndex[laterNote.midiChannel - 1][laterNote.initialNote];
+    }
+}
+
+void MPEInstrument::removeAllNotes()
+{
+    notes.clear();
+
+    for (auto& channelIndex : noteIndex)
+        mpeInstrumentFill (channelIndex, (int16) -1);
+
+    mpeInstrumentFill (numNotesOnChannel, (uint8) 0);
+}
+
+//==============================================================================
 void MPEInstrument::setZoneLayout (MPEZoneLayout newLayout)
 {
     releaseAllNotes();
@@ -242,17 +283,17 @@ void MPEInstrument::processMidiResetAllControllersMessage (const MidiMessage& me
 
     if (legacyMode.isEnabled && legacyMode.channelRange.contains (message.getChannel()))
     {
-        for (auto i = notes.size(); --i >= 0;)
+        auto channel = message.getChannel() - 1;
+
+        while (numNotesOnChannel[channel] > 0)
         {
+            auto i = noteIndex[channel][notesOnChannel[channel][numNotesOnChannel[channel] - 1]];
             auto& note = notes.getReference (i);
 
-            if (note.midiChannel == message.getChannel())
-            {
-                note.keyState = MPENote::off;
-                note.noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
-                listeners.call ([&] (Listener& l) { l.noteReleased (note); });
-                notes.remove (i);
-            }
+            note.keyState = MPENote::off;
+            note.noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
+            listeners.call ([&] (Listener& l) { l.noteReleased (note); });
+            removeNote (i);
         }
     }
     else if (isMasterChannel (message.getChannel()))
@@ -269,7 +310,7 @@ void MPEInstrument::processMidiResetAllControllersMessage (const MidiMessage& me
                 note.keyState = MPENote::off;
                 note.noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
                 listeners.call ([&] (Listener& l) { l.noteReleased (note); });
-                notes.remove (i);
+                removeNote (i);
             }
         }
     }
@@ -319,6 +360,12 @@ void MPEInstrument::noteOn (int midiChannel,
     if (! isUsingChannel (midiChannel))
         return;
 
+    if (! (isPositiveAndBelow (midiChannel - 1, 16) && isPositiveAndBelow (midiNoteNumber, 128)))
+    {
+        jassertfalse;
+        return;
+    }
+
     MPENote newNote (midiChannel,
                      midiNoteNumber,
                      midiNoteOnVelocity,
@@ -336,10 +383,10 @@ void MPEInstrument::noteOn (int midiChannel,
         alreadyPlayingNote->keyState = MPENote::off;
         alreadyPlayingNote->noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
         listeners.call ([=] (Listener& l) { l.noteReleased (*alreadyPlayingNote); });
-        notes.remove (alreadyPlayingNote);
+        removeNote (noteIndex[midiChannel - 1][midiNoteNumber]);
     }
 
-    notes.add (newNote);
+    addNote (newNote);
     listeners.call ([&] (Listener& l) { l.noteAdded (newNote); });
 }
 
@@ -369,7 +416,7 @@ void MPEInstrument::noteOff (int midiChannel,
         if (note->keyState == MPENote::off)
         {
             listeners.call ([=] (Listener& l) { l.noteReleased (*note); });
-            notes.remove (note);
+            removeNote (noteIndex[midiChannel - 1][midiNoteNumber]);
         }
         else
         {
@@ -401,16 +448,12 @@ void MPEInstrument::polyAftertouch (int midiChannel, int midiNoteNumber, MPEValu
 {
     const ScopedLock sl (lock);
 
-    for (auto i = notes.size(); --i >= 0;)
+    if (auto* note = getNotePtr (midiChannel, midiNoteNumber))
     {
-        auto& note = notes.getReference (i);
-
-        if (note.midiChannel == midiChannel
-            && note.initialNote == midiNoteNumber
-            && pressureDimension.getValue (note) != value)
+        if (pressureDimension.getValue (*note) != value)
         {
-            pressureDimension.getValue (note) = value;
-            callListenersDimensionChanged (note, pressureDimension);
+            pressureDimension.getValue (*note) = value;
+            callListenersDimensionChanged (*note, pressureDimension);
         }
     }
 }
@@ -435,13 +478,10 @@ void MPEInstrument::updateDimension (int midiChannel, MPEDimension& dimension, M
     {
         if (dimension.trackingMode == allNotesOnChannel)
         {
-            for (auto i = notes.size(); --i >= 0;)
-            {
-                auto& note = notes.getReference (i);
+            auto channel = midiChannel - 1;
 
-                if (note.midiChannel == midiChannel)
-                    updateDimensionForNote (note, dimension, value);
-            }
+            for (int i = numNotesOnChannel[channel]; --i >= 0;)
+                updateDimensionForNote (notes.getReference (noteIndex[channel][notesOnChannel[channel][i]]), dimension, value);
         }
         else
         {
@@ -589,7 +629,7 @@ void MPEInstrument::handleSustainOrSostenuto (int midiChannel, bool isDown, bool
             if (note.keyState == MPENote::off)
             {
                 listeners.call ([&] (Listener& l) { l.noteReleased (note); });
-                notes.remove (i);
+                removeNote (i);
             }
             else
             {
@@ -689,15 +729,11 @@ MPENote MPEInstrument::getMostRecentNoteOtherThan (MPENote otherThanThisNote) co
 //==============================================================================
 const MPENote* MPEInstrument::getNotePtr (int midiChannel, int midiNoteNumber) const noexcept
 {
-    for (int i = 0; i < notes.size(); ++i)
-    {
-        auto& note = notes.getReference (i);
+    if (! (isPositiveAndBelow (midiChannel - 1, 16) && isPositiveAndBelow (midiNoteNumber, 128)))
+        return nullptr;
 
-        if (note.midiChannel == midiChannel && note.initialNote == midiNoteNumber)
-            return &note;
-    }
-
-    return nullptr;
+    auto index = noteIndex[midiChannel - 1][midiNoteNumber];
+    return index >= 0 ? &notes.getReference (index) : nullptr;
 }
 
 MPENote* MPEInstrument::getNotePtr (int midiChannel, int midiNoteNumber) noexcept
@@ -727,12 +763,16 @@ MPENote* MPEInstrument::getNotePtr (int midiChannel, TrackingMode mode) noexcept
 //==============================================================================
 const MPENote* MPEInstrument::getLastNotePlayedPtr (int midiChannel) const noexcept
 {
-    for (auto i = notes.size(); --i >= 0;)
+    if (! isPositiveAndBelow (midiChannel - 1, 16))
+        return nullptr;
+
+    auto channel = midiChannel - 1;
+
+    for (int i = numNotesOnChannel[channel]; --i >= 0;)
     {
-        auto& note = notes.getReference (i);
+        auto& note = notes.getReference (noteIndex[channel][notesOnChannel[channel][i]]);
 
-        if (note.midiChannel == midiChannel
-             && (note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained))
+        if (note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained)
             return &note;
     }
 
@@ -747,15 +787,18 @@ MPENote* MPEInstrument::getLastNotePlayedPtr (int midiChannel) noexcept
 //==============================================================================
 const MPENote* MPEInstrument::getHighestNotePtr (int midiChannel) const noexcept
 {
+    if (! isPositiveAndBelow (midiChannel - 1, 16))
+        return nullptr;
+
+    auto channel = midiChannel - 1;
     int initialNoteMax = -1;
     const MPENote* result = nullptr;
 
-    for (auto i = notes.size(); --i >= 0;)
+    for (int i = numNotesOnChannel[channel]; --i >= 0;)
     {
-        auto& note = notes.getReference (i);
+        auto& note = notes.getReference (noteIndex[channel][notesOnChannel[channel][i]]);
 
-        if (note.midiChannel == midiChannel
-             && (note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained)
+        if ((note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained)
              && note.initialNote > initialNoteMax)
         {
             result = &note;
@@ -773,15 +816,18 @@ MPENote* MPEInstrument::getHighestNotePtr (int midiChannel) noexcept
 
 const MPENote* MPEInstrument::getLowestNotePtr (int midiChannel) const noexcept
 {
+    if (! isPositiveAndBelow (midiChannel - 1, 16))
+        return nullptr;
+
+    auto channel = midiChannel - 1;
     int initialNoteMin = 128;
     const MPENote* result = nullptr;
 
-    for (auto i = notes.size(); --i >= 0;)
+    for (int i = numNotesOnChannel[channel]; --i >= 0;)
     {
-        auto& note = notes.getReference (i);
+        auto& note = notes.getReference (noteIndex[channel][notesOnChannel[channel][i]]);
 
-        if (note.midiChannel == midiChannel
-             && (note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained)
+        if ((note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained)
              && note.initialNote < initialNoteMin)
         {
             result = &note;
@@ -810,7 +856,7 @@ void MPEInstrument::releaseAllNotes()
         listeners.call ([&] (Listener& l) { l.noteReleased (note); });
     }
 
-    notes.clear();
+    removeAllNotes();
 }
 
 
@@ -2144,6 +2190,52 @@ public:
                 expectEquals (test.getNumPlayingNotes(), 0);
             }
         }
+
+        beginTest ("note lookups are consistent with the list of playing notes");
+        {
+            auto random = getRandom();
+
+            for (auto legacy : { false, true })
+            {
+                MPEInstrument test;
+
+                if (legacy)
+                    test.enableLegacyMode();
+                else
+                    test.setZoneLayout (testLayout);
+
+                for (int i = 0; i < 5000; ++i)
+                {
+                    if (i % 500 == 0)
+                    {
+                        test.setPressureTrackingMode  ((MPEInstrument::TrackingMode) random.nextInt (4));
+                        test.setPitchbendTrackingMode ((MPEInstrument::TrackingMode) random.nextInt (4));
+                        test.setTimbreTrackingMode    ((MPEInstrument::TrackingMode) random.nextInt (4));
+                    }
+
+                    const auto channel = 1 + random.nextInt (16);
+                    const auto noteNumber = 60 + random.nextInt (8);
+
+                    switch (random.nextInt (9))
+                    {
+                        case 0:
+                        case 1:  test.processNextMidiEvent (MidiMessage::noteOn (channel, noteNumber, (uint8) (1 + random.nextInt (127)))); break;
+                        case 2:
+                        case 3:  test.processNextMidiEvent (MidiMessage::noteOff (channel, noteNumber)); break;
+                        case 4:  test.processNextMidiEvent (MidiMessage::pitchWheel (channel, random.nextInt (16384))); break;
+                        case 5:  test.processNextMidiEvent (MidiMessage::channelPressureChange (channel, random.nextInt (128))); break;
+                        case 6:  test.processNextMidiEvent (MidiMessage::controllerEvent (channel, 74, random.nextInt (128))); break;
+                        case 7:  test.processNextMidiEvent (MidiMessage::controllerEvent (channel, random.nextBool() ? 64 : 66, random.nextInt (128))); break;
+                        default: test.processNextMidiEvent (MidiMessage::aftertouchChange (channel, noteNumber, random.nextInt (128))); break;
+                    }
+
+                    if (random.nextInt (1000) == 0)
+                        test.processNextMidiEvent (MidiMessage::allNotesOff (channel));
+
+                    expectNoteLookupsMatch (test);
+                }
+            }
+        }
     }
 
 private:
@@ -2293,6 +2385,50 @@ private:
         expect (test.lastNoteFinished->keyState == MPENote::off);
     }
 
+    void expectNoteLookupsMatch (const MPEInstrument& test)
+    {
+        for (int channel = 1; channel <= 16; ++channel)
+        {
+            MPENote mostRecent;
+
+            for (int noteNumber = 60; noteNumber < 68; ++noteNumber)
+            {
+                MPENote expected;
+
+                for (int i = 0; i < test.getNumPlayingNotes(); ++i)
+                {
+                    const auto note = test.getNote (i);
+
+                    if (note.midiChannel == channel && note.initialNote == noteNumber)
+                        expected = note;
+                }
+
+                const auto note = test.getNote (channel, noteNumber);
+                expect (note.isValid() == expected.isValid());
+
+                if (note.isValid())
+                {
+                    expect (note == expected);
+                    expect (note.keyState == expected.keyState);
+                    expect (note.pressure == expected.pressure);
+                }
+            }
+
+            for (int i = 0; i < test.getNumPlayingNotes(); ++i)
+            {
+                const auto note = test.getNote (i);
+
+                if (note.midiChannel == channel
+                     && (note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained))
+                    mostRecent = note;
+            }
+
+            const auto note = test.getMostRecentNote (channel);
+            expect (note.isValid() == mostRecent.isValid());
+            expect (! note.isValid() || note == mostRecent);
+        }
+    }
+
     void expectDoubleWithinRelativeError (double actual, double expected, double maxRelativeError)
     {
         const double maxAbsoluteError = jmax (1.0, std::abs (expected)) * maxRelativeError;
@@ -351,6 +351,13 @@ protected:
 private:
     //==============================================================================
     Array<MPENote> notes;
+
+    // An index into the notes array for each channel and initial note number (or -1),
+    // and the initial note numbers of each channel's notes, oldest first.
+    int16 noteIndex[16][128];
+    uint8 notesOnChannel[16][128];
+    uint8 numNotesOnChannel[16];
+
     MPEZoneLayout zoneLayout;
     ListenerList<Listener> listeners;
 
@@ -377,6 +384,9 @@ private:
     MPEDimension pitchbendDimension, pressureDimension, timbreDimension;
 
     void resetLastReceivedValues();
+    void addNote (const MPENote&);
+    void removeNote (int index);
+    void removeAllNotes();
 
     void updateDimension (int midiChannel, MPEDimension&, MPEValue);
     void updateDimensionMaster (bool, MPEDimension&, MPEValue);
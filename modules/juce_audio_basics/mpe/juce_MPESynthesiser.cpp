@@ -312,11 +312,25 @@ void MPESynthesiser::turnOffAllVoices (bool allowTailOff)
     instrument->releaseAllNotes();
 }
 
+//==============================================================================
+void MPESynthesiser::setNumRenderingThreads (int numThreads, int maximumNumChannels, int maximumBlockSize)
+{
+    const ScopedLock sl (voicesLock);
+    voiceRenderer.prepare (numThreads, maximumNumChannels, maximumBlockSize);
+}
+
 //==============================================================================
 void MPESynthesiser::renderNextSubBlock (AudioBuffer<float>& buffer, int startSample, int numSamples)
 {
     const ScopedLock sl (voicesLock);
 
+    if (voiceRenderer.canRender (buffer.getNumChannels()))
+    {
+        voiceRenderer.render (voices, buffer, startSample, numSamples,
+                              [] (const MPESynthesiserVoice& v) { return v.isActive(); });
+        return;
+    }
+
     for (auto* voice : voices)
     {
         if (voice->isActive())
@@ -328,6 +342,13 @@ void MPESynthesiser::renderNextSubBlock (AudioBuffer<double>& buffer, int startS
 {
     const ScopedLock sl (voicesLock);
 
+    if (voiceRenderer.canRender (buffer.getNumChannels()))
+    {
+        voiceRenderer.render (voices, buffer, startSample, numSamples,
+                              [] (const MPESynthesiserVoice& v) { return v.isActive(); });
+        return;
+    }
+
     for (auto* voice : voices)
     {
         if (voice->isActive())
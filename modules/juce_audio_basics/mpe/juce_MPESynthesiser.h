@@ -136,6 +136,22 @@ public:
     */
     void setCurrentPlaybackSampleRate (double newRate) override;
 
+    /** Sets the number of threads used to render the voices.
+
+        With more than one thread, the active voices are rendered at the same time by a
+        set of worker threads and the thread which calls renderNextBlock(), so they mustn't
+        modify any state that they share with each other while rendering. This should be
+        called before the rendering starts.
+
+        @see Synthesiser::setNumRenderingThreads, ParallelVoiceRenderer
+    */
+    void setNumRenderingThreads (int numThreads, int maximumNumChannels, int maximumBlockSize);
+
+    /** Returns the number of threads used to render the voices.
+        @see setNumRenderingThreads
+    */
+    int getNumRenderingThreads() const noexcept                 { return voiceRenderer.getNumThreads(); }
+
     //==============================================================================
     /** Handle incoming MIDI events.
 
@@ -305,6 +321,7 @@ private:
     //==============================================================================
     bool shouldStealVoices = false;
     uint32 lastNoteOnCounter = 0;
+    ParallelVoiceRenderer voiceRenderer;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MPESynthesiser)
 };
@@ -0,0 +1,574 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class ParallelVoiceRenderer::Worker  : public Thread
+{
+public:
+    explicit Worker (ParallelVoiceRenderer& r)
+        : Thread ("Voice rendering thread"), renderer (r)
+    {
+    }
+
+    ~Worker() override
+    {
+        signalThreadShouldExit();
+        notify();
+        stopThread (4000);
+    }
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            wait (-1);
+
+            if (threadShouldExit())
+                break;
+
+            renderer.runAvailableJobs();
+        }
+    }
+
+private:
+    ParallelVoiceRenderer& renderer;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Worker)
+};
+
+//==============================================================================
+ParallelVoiceRenderer::~ParallelVoiceRenderer()
+{
+    release();
+}
+
+void ParallelVoiceRenderer::prepare (int numThreads, int maximumNumChannels, int maximumBlockSize)
+{
+    jassert (maximumNumChannels > 0 && maximumBlockSize > 0);
+
+    release();
+
+    if (numThreads <= 1)
+        return;
+
+    maxNumChannels = maximumNumChannels;
+    maxBlockSize = maximumBlockSize;
+
+    // A few jobs per thread, so that the threads which finish first can take
+    // the jobs with the most active voices from the others
+    slots.resize ((size_t) numThreads * 4);
+    voiceStates.reset (new std::atomic<uint64>[slots.size()]());
+
+    auto allocateBuffers = [this] (Slot& slot)
+    {
+        std::get<AudioBuffer<float>>  (slot.buffers).setSize (maxNumChannels, maxBlockSize);
+        std::get<AudioBuffer<double>> (slot.buffers).setSize (maxNumChannels, maxBlockSize);
+    };
+
+    for (auto& slot : slots)
+        allocateBuffers (slot);
+
+    allocateBuffers (spareSlot);
+
+    for (int i = 1; i < numThreads; ++i)
+        workers.add (new Worker (*this))->startThread (10);
+}
+
+void ParallelVoiceRenderer::release()
+{
+    workers.clear();
+    slots.clear();
+    voiceStates.reset();
+    std::get<AudioBuffer<float>>  (spareSlot.buffers).setSize (0, 0);
+    std::get<AudioBuffer<double>> (spareSlot.buffers).setSize (0, 0);
+    maxNumChannels = 0;
+    maxBlockSize = 0;
+}
+
+bool ParallelVoiceRenderer::canRender (int numChannels) const noexcept
+{
+    if (slots.empty())
+        return false;
+
+    // prepare() must be called with enough channels for the buffers being rendered!
+    jassert (numChannels <= maxNumChannels);
+    return numChannels <= maxNumChannels;
+}
+
+//==============================================================================
+static constexpr uint64 voiceBusyFlag = (uint64) 1 << 31;
+
+void ParallelVoiceRenderer::runJobs (int numJobs, int numVoices, JobFunction function, void* context) noexcept
+{
+    jassert (numJobs < 0x10000 && numVoices < 0x8000);
+
+    if (numJobs <= 0)
+        return;
+
+    jobFunction = function;
+    jobContext = context;
+    numVoicesFinished.store (0, std::memory_order_relaxed);
+
+    // The round number stops the threads which are still looking for jobs or voices from
+    // the previous round from taking one of this round with an outdated index
+    ++round;
+
+    for (int i = 0; i < numJobs; ++i)
+    {
+        auto numVoicesInJob = (uint64) ((numVoices - i + numJobs - 1) / numJobs);
+        voiceStates[(size_t) i].store (((uint64) round << 32) | (numVoicesInJob << 16), std::memory_order_release);
+    }
+
+    jobState.store (((uint64) round << 32) | ((uint64) numJobs << 16), std::memory_order_release);
+
+    for (auto* worker : workers)
+        worker->notify();
+
+    auto startTime = Time::getHighResolutionTicks();
+    runAvailableJobs();
+
+    // A worker which is taking longer than this thread took to do its own share, is
+    // probably not running at all
+    auto waitStartTime = Time::getHighResolutionTicks();
+    auto maxWaitTime = jmax (2 * (waitStartTime - startTime), Time::secondsToHighResolutionTicks (0.0001));
+
+    for (int numAttempts = 0; numVoicesFinished.load (std::memory_order_acquire) < numVoices; ++numAttempts)
+    {
+        auto waitedTooLong = (Time::getHighResolutionTicks() - waitStartTime > maxWaitTime);
+
+        for (int i = 0; i < numJobs; ++i)
+        {
+            renderVoicesOfJob (i, round, false);
+
+            if (waitedTooLong)
+                renderVoicesOfJob (i, round, true);
+        }
+
+        if (numAttempts < 64)
+        {
+           #if JUCE_USE_SSE_INTRINSICS
+            _mm_pause();
+           #endif
+        }
+        else
+        {
+            Thread::yield();
+        }
+    }
+}
+
+void ParallelVoiceRenderer::runAvailableJobs() noexcept
+{
+    auto state = jobState.load (std::memory_order_acquire);
+
+    for (;;)
+    {
+        auto jobIndex = (int) (state & 0xffff);
+        auto numJobs  = (int) ((state >> 16) & 0xffff);
+
+        if (jobIndex >= numJobs)
+            return;
+
+        if (jobState.compare_exchange_weak (state, state + 1, std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            renderVoicesOfJob (jobIndex, (uint32) (state >> 32), false);
+            state = jobState.load (std::memory_order_acquire);
+        }
+    }
+}
+
+void ParallelVoiceRenderer::renderVoicesOfJob (int jobIndex, uint32 jobRound, bool whileBusy) noexcept
+{
+    // Normally, a voice can only be taken while no other voice of the job is being rendered,
+    // so the voices are added to the job's buffer in the same order whichever thread renders
+    // them. With whileBusy, the voices are taken while another thread is stuck in one, and
+    // rendered into the spare buffer instead.
+    auto& voiceState = voiceStates[(size_t) jobIndex];
+    auto state = voiceState.load (std::memory_order_acquire);
+
+    for (;;)
+    {
+        auto voiceNumber    = (int) (state & 0xffff);
+        auto numVoicesInJob = (int) ((state >> 16) & 0x7fff);
+        auto isBusy = (state & voiceBusyFlag) != 0;
+
+        if ((uint32) (state >> 32) != jobRound || voiceNumber >= numVoicesInJob || isBusy != whileBusy)
+            return;
+
+        if (voiceState.compare_exchange_weak (state, (state + 1) | voiceBusyFlag,
+                                              std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            jobFunction (jobContext, jobIndex, voiceNumber, whileBusy);
+
+            state = whileBusy ? voiceState.load (std::memory_order_acquire)
+                              : (voiceState.fetch_and (~voiceBusyFlag, std::memory_order_acq_rel) & ~voiceBusyFlag);
+
+            numVoicesFinished.fetch_add (1, std::memory_order_release);
+        }
+    }
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ParallelVoiceRendererTests  : public UnitTest
+{
+public:
+    ParallelVoiceRendererTests()
+        : UnitTest ("ParallelVoiceRenderer", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Synthesiser renders the same output on several threads");
+        {
+            for (auto numThreads : { 2, 4 })
+            {
+                auto serial   = renderSynthesiser<float> (1);
+                auto parallel = renderSynthesiser<float> (numThreads);
+
+                expectBuffersAreClose (parallel, serial, 1.0e-5);
+                expectBuffersAreEqual (parallel, renderSynthesiser<float> (numThreads));
+            }
+
+            expectBuffersAreClose (renderSynthesiser<double> (3), renderSynthesiser<double> (1), 1.0e-10);
+        }
+
+        beginTest ("MPESynthesiser renders the same output on several threads");
+        {
+            auto serial   = renderMPESynthesiser (1);
+            auto parallel = renderMPESynthesiser (4);
+
+            expectBuffersAreClose (parallel, serial, 1.0e-5);
+            expectBuffersAreEqual (parallel, renderMPESynthesiser (4));
+        }
+
+        beginTest ("Blocks larger than the maximum block size are rendered in parts");
+        {
+            OwnedArray<TestVoice> voices;
+
+            for (int i = 0; i < 10; ++i)
+                voices.add (new TestVoice())->start (60 + i, 0.5f, 8192);
+
+            AudioBuffer<float> expected (2, 300), output (2, 300);
+            expected.clear();
+            output.clear();
+
+            for (auto* voice : voices)
+                voice->renderNextBlock (expected, 10, 290);
+
+            for (int i = 0; i < voices.size(); ++i)
+                voices[i]->start (60 + i, 0.5f, 8192);
+
+            ParallelVoiceRenderer renderer;
+            renderer.prepare (3, 2, 64);
+            expect (renderer.canRender (2));
+            renderer.render (voices, output, 10, 290, [] (const TestVoice& v) { return v.isVoiceActive(); });
+
+            expectBuffersAreClose (output, expected, 1.0e-5);
+        }
+
+        beginTest ("The calling thread renders the voices of a stalled worker's job");
+        {
+            constexpr int numVoices = 24, numSamples = 64;
+
+            StallingVoice::SharedState state;
+            state.callingThread = Thread::getCurrentThreadId();
+            state.numVoicesToWaitFor = numVoices - 1;
+
+            OwnedArray<StallingVoice> voices;
+
+            for (int i = 0; i < numVoices; ++i)
+                voices.add (new StallingVoice (state));
+
+            AudioBuffer<float> expected (2, numSamples), output (2, numSamples);
+            expected.clear();
+
+            for (int i = 0; i < numVoices; ++i)
+            {
+                voices[i]->start (60 + i, 0.1f, 8192);
+                voices[i]->TestVoice::renderNextBlock (expected, 0, numSamples);
+            }
+
+            ParallelVoiceRenderer renderer;
+            renderer.prepare (2, 2, numSamples);
+
+            // The worker may not wake up before the calling thread has rendered all
+            // the voices by itself, so this is tried until the worker takes a voice
+            for (int attempt = 0; attempt < 100 && ! state.renderedOnWorker; ++attempt)
+            {
+                for (int i = 0; i < numVoices; ++i)
+                    voices[i]->start (60 + i, 0.1f, 8192);
+
+                state.numVoicesRendered = 0;
+                output.clear();
+                renderer.render (voices, output, 0, numSamples, [] (const StallingVoice& v) { return v.isVoiceActive(); });
+            }
+
+            expect (state.renderedOnWorker);
+            expect (! state.timedOut);
+            expectBuffersAreClose (output, expected, 1.0e-5);
+        }
+    }
+
+private:
+    //==============================================================================
+    struct TestSound  : public SynthesiserSound
+    {
+        bool appliesToNote (int) override       { return true; }
+        bool appliesToChannel (int) override    { return true; }
+    };
+
+    // A sine voice which stops by itself, to test voices being cleared while rendering
+    struct TestVoice  : public SynthesiserVoice
+    {
+        bool canPlaySound (SynthesiserSound*) override  { return true; }
+
+        void startNote (int midiNoteNumber, float velocity, SynthesiserSound*, int) override
+        {
+            start (midiNoteNumber, velocity, 2000);
+        }
+
+        void start (int midiNoteNumber, float velocity, int numSamplesToPlay)
+        {
+            phase = 0;
+            increment = MathConstants<double>::twoPi * MidiMessage::getMidiNoteInHertz (midiNoteNumber) / 44100.0;
+            level = velocity;
+            samplesLeft = numSamplesToPlay;
+        }
+
+        void stopNote (float, bool) override        { samplesLeft = 0; clearCurrentNote(); }
+        bool isVoiceActive() const override         { return samplesLeft > 0; }
+        void pitchWheelMoved (int) override         {}
+        void controllerMoved (int, int) override    {}
+
+        void renderNextBlock (AudioBuffer<float>& buffer, int startSample, int numSamples) override
+        {
+            renderSine (buffer, startSample, numSamples);
+        }
+
+        void renderNextBlock (AudioBuffer<double>& buffer, int startSample, int numSamples) override
+        {
+            renderSine (buffer, startSample, numSamples);
+        }
+
+        template <typename FloatType>
+        void renderSine (AudioBuffer<FloatType>& buffer, int startSample, int numSamples)
+        {
+            for (int i = startSample; i < startSample + numSamples && samplesLeft > 0; ++i, --samplesLeft)
+            {
+                auto sample = (FloatType) (level * std::sin (phase));
+                phase += increment;
+
+                for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                    buffer.addSample (ch, i, sample * (FloatType) (ch + 1));
+            }
+
+            if (samplesLeft <= 0)
+                clearCurrentNote();
+        }
+
+        double phase = 0, increment = 0;
+        float level = 0;
+        int samplesLeft = 0;
+    };
+
+    // A voice which, when it's rendered by a worker, doesn't finish until all the
+    // other voices have been rendered
+    struct StallingVoice  : public TestVoice
+    {
+        struct SharedState
+        {
+            Thread::ThreadID callingThread = {};
+            int numVoicesToWaitFor = 0;
+            std::atomic<int> numVoicesRendered { 0 };
+            std::atomic<bool> renderedOnWorker { false }, timedOut { false };
+        };
+
+        explicit StallingVoice (SharedState& s)  : state (s) {}
+
+        void renderNextBlock (AudioBuffer<float>& buffer, int startSample, int numSamples) override
+        {
+            if (Thread::getCurrentThreadId() != state.callingThread)
+            {
+                state.renderedOnWorker = true;
+                auto timeout = Time::getMillisecondCounter() + 2000;
+
+                while (state.numVoicesRendered < state.numVoicesToWaitFor)
+                {
+                    if (Time::getMillisecondCounter() > timeout)
+                    {
+                        state.timedOut = true;
+                        break;
+                    }
+
+                    Thread::sleep (1);
+                }
+            }
+
+            TestVoice::renderNextBlock (buffer, startSample, numSamples);
+            ++state.numVoicesRendered;
+        }
+
+        using TestVoice::renderNextBlock;
+
+        SharedState& state;
+    };
+
+    struct TestMPEVoice  : public MPESynthesiserVoice
+    {
+        void noteStarted() override
+        {
+            phase = 0;
+            increment = MathConstants<double>::twoPi * currentlyPlayingNote.getFrequencyInHertz() / 44100.0;
+        }
+
+        void noteStopped (bool) override                { clearCurrentNote(); }
+        void notePressureChanged() override             {}
+        void notePitchbendChanged() override            {}
+        void noteTimbreChanged() override               {}
+        void noteKeyStateChanged() override             {}
+
+        void renderNextBlock (AudioBuffer<float>& buffer, int startSample, int numSamples) override
+        {
+            for (int i = startSample; i < startSample + numSamples; ++i)
+            {
+                auto sample = (float) (0.1 * std::sin (phase));
+                phase += increment;
+
+                for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                    buffer.addSample (ch, i, sample);
+            }
+        }
+
+        void renderNextBlock (AudioBuffer<double>&, int, int) override {}
+
+        double phase = 0, increment = 0;
+    };
+
+    //==============================================================================
+    MidiBuffer createNotes (int numSamples, bool useMPEChannels)
+    {
+        MidiBuffer midi;
+        Random random (123);
+
+        for (int i = 0; i < 64; ++i)
+        {
+            auto channel = useMPEChannels ? 2 + i % 15 : 1;
+            auto note = 36 + random.nextInt (48);
+            auto position = random.nextInt (numSamples);
+
+            midi.addEvent (MidiMessage::noteOn (channel, note, 0.1f), position);
+            midi.addEvent (MidiMessage::noteOff (channel, note), jmin (numSamples - 1, position + random.nextInt (2000)));
+        }
+
+        return midi;
+    }
+
+    template <typename FloatType>
+    AudioBuffer<FloatType> renderSynthesiser (int numThreads)
+    {
+        constexpr int numSamples = 8192, blockSize = 256;
+
+        Synthesiser synth;
+        synth.addSound (new TestSound());
+
+        for (int i = 0; i < 24; ++i)
+            synth.addVoice (new TestVoice());
+
+        synth.setCurrentPlaybackSampleRate (44100.0);
+        synth.setNumRenderingThreads (numThreads, 2, blockSize);
+        expectEquals (synth.getNumRenderingThreads(), numThreads);
+
+        return renderBlocks<FloatType> (synth, createNotes (numSamples, false), numSamples, blockSize);
+    }
+
+    AudioBuffer<float> renderMPESynthesiser (int numThreads)
+    {
+        constexpr int numSamples = 8192, blockSize = 256;
+
+        MPESynthesiser synth;
+
+        for (int i = 0; i < 24; ++i)
+            synth.addVoice (new TestMPEVoice());
+
+        synth.setCurrentPlaybackSampleRate (44100.0);
+        synth.setNumRenderingThreads (numThreads, 2, blockSize);
+        expectEquals (synth.getNumRenderingThreads(), numThreads);
+
+        MPEZoneLayout layout;
+        layout.setLowerZone (15);
+        synth.setZoneLayout (layout);
+
+        return renderBlocks<float> (synth, createNotes (numSamples, true), numSamples, blockSize);
+    }
+
+    template <typename FloatType, typename SynthType>
+    static AudioBuffer<FloatType> renderBlocks (SynthType& synth, const MidiBuffer& midi, int numSamples, int blockSize)
+    {
+        AudioBuffer<FloatType> output (2, numSamples);
+        output.clear();
+
+        for (int start = 0; start < numSamples; start += blockSize)
+        {
+            MidiBuffer block;
+            block.addEvents (midi, start, blockSize, -start);
+
+            AudioBuffer<FloatType> blockBuffer (output.getArrayOfWritePointers(), 2, start, blockSize);
+            synth.renderNextBlock (blockBuffer, block, 0, blockSize);
+        }
+
+        return output;
+    }
+
+    template <typename FloatType>
+    void expectBuffersAreClose (const AudioBuffer<FloatType>& a, const AudioBuffer<FloatType>& b, double tolerance)
+    {
+        expectEquals (a.getNumSamples(), b.getNumSamples());
+        expect (b.getMagnitude (0, b.getNumSamples()) > 0);
+
+        for (int ch = 0; ch < a.getNumChannels(); ++ch)
+            for (int i = 0; i < a.getNumSamples(); ++i)
+                expectWithinAbsoluteError ((double) a.getSample (ch, i), (double) b.getSample (ch, i), tolerance);
+    }
+
+    template <typename FloatType>
+    void expectBuffersAreEqual (const AudioBuffer<FloatType>& a, const AudioBuffer<FloatType>& b)
+    {
+        auto numBytes = sizeof (FloatType) * (size_t) a.getNumSamples();
+
+        for (int ch = 0; ch < a.getNumChannels(); ++ch)
+            expect (std::memcmp (a.getReadPointer (ch), b.getReadPointer (ch), numBytes) == 0);
+    }
+};
+
+static ParallelVoiceRendererTests parallelVoiceRendererTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,204 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Renders the voices of a synthesiser on several threads.
+
+    The voices are divided into a fixed set of jobs, and each job renders its
+    voices one after the other into its own scratch buffer. The jobs are shared
+    between a set of worker threads and the thread which calls render(), and when
+    they have all finished, the scratch buffers are added to the output in the
+    order of the jobs. The result doesn't depend on which thread rendered which
+    voice, so it is the same each time the same notes are played.
+
+    The thread which calls render() never just sits and waits for a worker. Once
+    its own jobs are done, it takes over the voices of any job whose worker is
+    between two voices, and if a worker stays in the middle of a voice for too
+    long, for example because it was preempted, it renders the rest of that job's
+    voices into a spare buffer. Only in that last case can the rounding of the
+    output differ slightly from one run to the next.
+
+    The voices are rendered at the same time, so they mustn't modify any state
+    that they share with each other. This is used by Synthesiser and
+    MPESynthesiser, see Synthesiser::setNumRenderingThreads().
+
+    @tags{Audio}
+*/
+class JUCE_API  ParallelVoiceRenderer
+{
+public:
+    //==============================================================================
+    /** Creates a renderer, which renders the voices on the calling thread until
+        prepare() is called.
+    */
+    ParallelVoiceRenderer() = default;
+
+    /** Destructor. */
+    ~ParallelVoiceRenderer();
+
+    //==============================================================================
+    /** Starts the worker threads and allocates the scratch buffers.
+
+        @param numThreads           the number of threads to render with, including the
+                                    thread which calls render(). With 1 or less, no worker
+                                    thread is used and canRender() returns false
+        @param maximumNumChannels   the maximum number of channels that will be rendered
+        @param maximumBlockSize     the maximum number of samples rendered by each job; larger
+                                    blocks are rendered in several parts
+
+        This must not be called while render() is running.
+    */
+    void prepare (int numThreads, int maximumNumChannels, int maximumBlockSize);
+
+    /** Stops the worker threads and frees the scratch buffers. */
+    void release();
+
+    /** Returns the number of threads used for rendering, including the calling thread. */
+    int getNumThreads() const noexcept                      { return workers.size() + 1; }
+
+    /** Returns true if a buffer with the given number of channels can be rendered
+        with render().
+    */
+    bool canRender (int numChannels) const noexcept;
+
+    //==============================================================================
+    /** Renders the active voices of an array, and adds their output to a buffer.
+
+        The isActive function is called with each voice to know if it must be rendered,
+        and the active voices are rendered by calling their renderNextBlock() function.
+        This function doesn't allocate any memory, but it isn't strictly realtime-safe:
+        waking the worker threads takes an OS mutex, and it doesn't return until all the
+        voices have been rendered, so it can be held up by the slowest of the workers.
+    */
+    template <typename VoiceType, typename FloatType, typename IsActiveFunction>
+    void render (const OwnedArray<VoiceType>& voices, AudioBuffer<FloatType>& outputAudio,
+                 int startSample, int numSamples, IsActiveFunction&& isActive)
+    {
+        jassert (canRender (outputAudio.getNumChannels()));
+
+        auto numVoices = voices.size();
+        auto numJobs = jmin (numVoices, (int) slots.size());
+        auto numChannels = outputAudio.getNumChannels();
+
+        while (numSamples > 0)
+        {
+            auto numThisTime = jmin (numSamples, maxBlockSize);
+
+            // The job jobIndex renders the voices jobIndex, jobIndex + numJobs, etc., so that
+            // the voices which are usually started first are spread over all the jobs
+            auto renderVoice = [&] (int jobIndex, int voiceNumber, bool useSpareSlot)
+            {
+                auto* voice = voices.getUnchecked (jobIndex + voiceNumber * numJobs);
+
+                if (! isActive (*voice))
+                    return;
+
+                auto& slot = useSpareSlot ? spareSlot : slots[(size_t) jobIndex];
+                auto& scratch = std::get<AudioBuffer<FloatType>> (slot.buffers);
+
+                if (! slot.hasOutput)
+                {
+                    scratch.setSize (numChannels, maxBlockSize, false, false, true);
+                    scratch.clear (0, numThisTime);
+                    slot.hasOutput = true;
+                }
+
+                voice->renderNextBlock (scratch, 0, numThisTime);
+            };
+
+            for (int j = 0; j < numJobs; ++j)
+                slots[(size_t) j].hasOutput = false;
+
+            spareSlot.hasOutput = false;
+
+            runJobs (numJobs, numVoices, callJob<decltype (renderVoice)>, &renderVoice);
+
+            auto addSlot = [&] (Slot& slot)
+            {
+                if (slot.hasOutput)
+                {
+                    auto& scratch = std::get<AudioBuffer<FloatType>> (slot.buffers);
+
+                    for (int ch = 0; ch < numChannels; ++ch)
+                        outputAudio.addFrom (ch, startSample, scratch, ch, 0, numThisTime);
+                }
+            };
+
+            for (int j = 0; j < numJobs; ++j)
+                addSlot (slots[(size_t) j]);
+
+            addSlot (spareSlot);
+
+            startSample += numThisTime;
+            numSamples  -= numThisTime;
+        }
+    }
+
+private:
+    //==============================================================================
+    class Worker;
+    using JobFunction = void (*) (void*, int jobIndex, int voiceNumber, bool useSpareSlot);
+
+    struct Slot
+    {
+        std::tuple<AudioBuffer<float>, AudioBuffer<double>> buffers;
+        bool hasOutput = false;
+    };
+
+    template <typename Function>
+    static void callJob (void* function, int jobIndex, int voiceNumber, bool useSpareSlot)
+    {
+        (*static_cast<Function*> (function)) (jobIndex, voiceNumber, useSpareSlot);
+    }
+
+    void runJobs (int numJobs, int numVoices, JobFunction, void* context) noexcept;
+    void runAvailableJobs() noexcept;
+    void renderVoicesOfJob (int jobIndex, uint32 jobRound, bool whileBusy) noexcept;
+
+    //==============================================================================
+    OwnedArray<Worker> workers;
+    std::vector<Slot> slots;
+    Slot spareSlot;
+    int maxNumChannels = 0, maxBlockSize = 0;
+
+    // The round number, the number of jobs and the index of the next job to run
+    std::atomic<uint64> jobState { 0 };
+
+    // For each job: the round number, a flag which is set while a thread is rendering
+    // one of its voices, the number of voices and the index of the next voice to render
+    std::unique_ptr<std::atomic<uint64>[]> voiceStates;
+    std::atomic<int> numVoicesFinished { 0 };
+    uint32 round = 0;
+    JobFunction jobFunction = nullptr;
+    void* jobContext = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParallelVoiceRenderer)
+};
+
+} // namespace juce
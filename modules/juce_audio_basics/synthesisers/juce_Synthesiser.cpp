@@ -50,6 +50,9 @@ void SynthesiserVoice::clearCurrentNote()
     currentlyPlayingNote = -1;
     currentlyPlayingSound = nullptr;
     currentPlayingMidiChannel = 0;
+
+    if (freeVoiceFlags != nullptr)
+        freeVoiceFlags->fetch_or (freeVoiceFlagMask, std::memory_order_relaxed);
 }
 
 void SynthesiserVoice::aftertouchChanged (int) {}
@@ -72,8 +75,301 @@ void SynthesiserVoice::renderNextBlock (AudioBuffer<double>& outputBuffer,
     subBuffer.makeCopyOf (tempBuffer, true);
 }
 
+//==============================================================================
+/*  Keeps track of the voices playing each note, of the order in which the voices were
+    started, and of the voices which aren't playing a note, so that the voices don't all
+    need to be checked for each MIDI event.
+
+    The voices playing each note are kept in a linked list per note. When a voice clears
+    its note, it stays in its list until the list is next traversed, because the voices
+    can be rendered on several threads. Only the free voice flags are updated by the
+    voices, atomically.
+*/
+class Synthesiser::VoiceIndex
+{
+public:
+    void rebuild (const OwnedArray<SynthesiserVoice>& voices)
+    {
+        numVoices = voices.size();
+        entries.clear();
+        entries.resize ((size_t) numVoices);
+        noteHeads.fill (-1);
+
+        numFlagWords = (numVoices + 63) / 64;
+        freeFlags.reset (new std::atomic<uint64>[(size_t) jmax (1, numFlagWords)]);
+
+        for (int i = 0; i < jmax (1, numFlagWords); ++i)
+            freeFlags[(size_t) i].store (0, std::memory_order_relaxed);
+
+        for (int i = 0; i < numVoices; ++i)
+        {
+            auto* voice = voices.getUnchecked (i);
+            entries[(size_t) i].voice = voice;
+            voice->freeVoiceFlags = freeFlags.get() + (i / 64);
+            voice->freeVoiceFlagMask = (uint64) 1 << (i % 64);
+
+            if (voice->currentlyPlayingNote >= 0)
+                linkToNote (i, voice->currentlyPlayingNote);
+            else
+                voice->freeVoiceFlags->fetch_or (voice->freeVoiceFlagMask, std::memory_order_relaxed);
+        }
+
+        std::vector<int> byAge ((size_t) numVoices);
+        std::iota (byAge.begin(), byAge.end(), 0);
+        std::stable_sort (byAge.begin(), byAge.end(), [this] (int a, int b)
+        {
+            return entries[(size_t) a].voice->wasStartedBefore (*entries[(size_t) b].voice);
+        });
+
+        oldest = newest = -1;
+
+        for (auto i : byAge)
+            appendToAgeList (i);
+    }
+
+    bool needsRebuilding (const OwnedArray<SynthesiserVoice>& voices) const noexcept
+    {
+        return numVoices != voices.size();
+    }
+
+    /** Must be called when a voice has been given a new note. */
+    void voiceStarted (SynthesiserVoice& voice)
+    {
+        auto index = indexOf (voice);
+
+        // the voice must be one of the synthesiser's voices!
+        jassert (index >= 0);
+
+        if (index < 0)
+            return;
+
+        unlinkFromNote (index);
+        linkToNote (index, voice.currentlyPlayingNote);
+
+        removeFromAgeList (index);
+        appendToAgeList (index);
+
+        voice.freeVoiceFlags->fetch_and (~voice.freeVoiceFlagMask, std::memory_order_relaxed);
+    }
+
+    /** Calls a function with each voice playing the given note. */
+    template <typename Function>
+    void forEachVoicePlayingNote (int note, Function&& function)
+    {
+        for (auto i = noteHeads[(size_t) getNoteListIndex (note)]; i >= 0;)
+        {
+            auto& entry = entries[(size_t) i];
+            auto next = entry.nextWithNote;
+
+            if (entry.voice->currentlyPlayingNote != entry.note)
+                unlinkFromNote (i);
+            else if (entry.note == note)
+                function (*entry.voice);
+
+            i = next;
+        }
+    }
+
+    /** Calls a function with the voices in the order in which they were started, until it returns true. */
+    template <typename Function>
+    void forEachVoiceFromOldest (Function&& function) const
+    {
+        for (auto i = oldest; i >= 0; i = entries[(size_t) i].newer)
+            if (function (*entries[(size_t) i].voice))
+                return;
+    }
+
+    /** Returns the first voice in the voices array which isn't playing a note, and for
+        which the predicate returns true.
+    */
+    template <typename Predicate>
+    SynthesiserVoice* findFreeVoice (Predicate&& predicate) const
+    {
+        for (int word = 0; word < numFlagWords; ++word)
+        {
+            for (auto bits = freeFlags[(size_t) word].load (std::memory_order_relaxed); bits != 0; bits &= bits - 1)
+            {
+                auto* voice = entries[(size_t) (word * 64 + getLowestBit (bits))].voice;
+
+                if (predicate (*voice))
+                    return voice;
+            }
+        }
+
+        return nullptr;
+    }
+
+    /** Finds the voices with the lowest and highest notes for which the predicate returns true.
+        When several voices play the same note, the first one in the voices array is chosen.
+    */
+    template <typename Predicate>
+    void findLowestAndHighestNotes (Predicate&& predicate, SynthesiserVoice*& lowest, SynthesiserVoice*& highest)
+    {
+        lowest = highest = nullptr;
+
+        // Voices which aren't playing a note only match if isVoiceActive() has been
+        // overridden, but the note they report is then the lowest one
+        findFreeVoice ([&] (SynthesiserVoice& voice)
+        {
+            if (predicate (voice))
+            {
+                chooseVoice (lowest,  voice, false);
+                chooseVoice (highest, voice, true);
+            }
+
+            return false;
+        });
+
+        for (int list = 0; list < numNoteLists && ! findInNoteList (list, predicate, lowest, false); ++list)
+        {}
+
+        for (int list = numNoteLists; --list >= 0 && ! findInNoteList (list, predicate, highest, true);)
+        {}
+    }
+
+private:
+    struct Entry
+    {
+        SynthesiserVoice* voice = nullptr;
+        int note = 0, noteList = -1, previousWithNote = -1, nextWithNote = -1;
+        int older = -1, newer = -1;
+    };
+
+    // Notes outside the MIDI range go in the first and last lists, which keeps the lists
+    // sorted by note
+    static constexpr int numNoteLists = 128;
+    static int getNoteListIndex (int note) noexcept     { return jlimit (0, numNoteLists - 1, note); }
+
+    static int getLowestBit (uint64 bits) noexcept      { return countNumberOfBits ((bits & (~bits + 1)) - 1); }
+
+    int indexOf (const SynthesiserVoice& voice) const noexcept
+    {
+        auto flagIndex = (int) (voice.freeVoiceFlags - freeFlags.get());
+        auto index = flagIndex * 64 + getLowestBit (voice.freeVoiceFlagMask);
+
+        return isPositiveAndBelow (index, numVoices) && entries[(size_t) index].voice == &voice ? index : -1;
+    }
+
+    int indexOfEntry (const SynthesiserVoice* voice) const noexcept
+    {
+        return voice != nullptr ? indexOf (*voice) : -1;
+    }
+
+    void chooseVoice (SynthesiserVoice*& current, SynthesiserVoice& candidate, bool highest) const noexcept
+    {
+        if (current == nullptr)
+        {
+            current = &candidate;
+            return;
+        }
+
+        auto note = candidate.currentlyPlayingNote, currentNote = current->currentlyPlayingNote;
+
+        if (highest ? note > currentNote : note < currentNote)
+            current = &candidate;
+        else if (note == currentNote && indexOfEntry (&candidate) < indexOfEntry (current))
+            current = &candidate;
+    }
+
+    template <typename Predicate>
+    bool findInNoteList (int list, Predicate& predicate, SynthesiserVoice*& current, bool highest)
+    {
+        SynthesiserVoice* found = nullptr;
+
+        for (auto i = noteHeads[(size_t) list]; i >= 0;)
+        {
+            auto& entry = entries[(size_t) i];
+            auto next = entry.nextWithNote;
+
+            if (entry.voice->currentlyPlayingNote != entry.note)
+                unlinkFromNote (i);
+            else if (predicate (*entry.voice))
+                chooseVoice (found, *entry.voice, highest);
+
+            i = next;
+        }
+
+        if (found == nullptr)
+            return false;
+
+        chooseVoice (current, *found, highest);
+        return true;
+    }
+
+    void linkToNote (int index, int note)
+    {
+        auto& entry = entries[(size_t) index];
+        auto list = getNoteListIndex (note);
+
+        entry.note = note;
+        entry.noteList = list;
+        entry.previousWithNote = -1;
+        entry.nextWithNote = noteHeads[(size_t) list];
+
+        if (noteHeads[(size_t) list] >= 0)
+            entries[(size_t) noteHeads[(size_t) list]].previousWithNote = index;
+
+        noteHeads[(size_t) list] = index;
+    }
+
+    void unlinkFromNote (int index)
+    {
+        auto& entry = entries[(size_t) index];
+
+        if (entry.noteList < 0)
+            return;
+
+        if (entry.previousWithNote >= 0)
+            entries[(size_t) entry.previousWithNote].nextWithNote = entry.nextWithNote;
+        else
+            noteHeads[(size_t) entry.noteList] = entry.nextWithNote;
+
+        if (entry.nextWithNote >= 0)
+            entries[(size_t) entry.nextWithNote].previousWithNote = entry.previousWithNote;
+
+        entry.noteList = entry.previousWithNote = entry.nextWithNote = -1;
+    }
+
+    void appendToAgeList (int index)
+    {
+        auto& entry = entries[(size_t) index];
+        entry.older = newest;
+        entry.newer = -1;
+
+        if (newest >= 0)
+            entries[(size_t) newest].newer = index;
+        else
+            oldest = index;
+
+        newest = index;
+    }
+
+    void removeFromAgeList (int index)
+    {
+        auto& entry = entries[(size_t) index];
+
+        if (entry.older >= 0)
+            entries[(size_t) entry.older].newer = entry.newer;
+        else
+            oldest = entry.newer;
+
+        if (entry.newer >= 0)
+            entries[(size_t) entry.newer].older = entry.older;
+        else
+            newest = entry.older;
+
+        entry.older = entry.newer = -1;
+    }
+
+    std::vector<Entry> entries;
+    std::array<int, numNoteLists> noteHeads;
+    std::unique_ptr<std::atomic<uint64>[]> freeFlags;
+    int numVoices = -1, numFlagWords = 0, oldest = -1, newest = -1;
+};
+
 //==============================================================================
 Synthesiser::Synthesiser()
+    : voiceIndex (new VoiceIndex())
 {
     for (int i = 0; i < numElementsInArray (lastPitchWheelValues); ++i)
         lastPitchWheelValues[i] = 0x2000;
@@ -94,19 +390,31 @@ void Synthesiser::clearVoices()
 {
     const ScopedLock sl (lock);
     voices.clear();
+    voiceIndex->rebuild (voices);
 }
 
 SynthesiserVoice* Synthesiser::addVoice (SynthesiserVoice* const newVoice)
 {
     const ScopedLock sl (lock);
     newVoice->setCurrentPlaybackSampleRate (sampleRate);
-    return voices.add (newVoice);
+    voices.add (newVoice);
+    voiceIndex->rebuild (voices);
+    return newVoice;
 }
 
 void Synthesiser::removeVoice (const int index)
 {
     const ScopedLock sl (lock);
     voices.remove (index);
+    voiceIndex->rebuild (voices);
+}
+
+Synthesiser::VoiceIndex& Synthesiser::getVoiceIndex() const
+{
+    if (voiceIndex->needsRebuilding (voices))
+        voiceIndex->rebuild (voices);
+
+    return *voiceIndex;
 }
 
 void Synthesiser::clearSounds()
@@ -139,6 +447,12 @@ void Synthesiser::setMinimumRenderingSubdivisionSize (int numSamples, bool shoul
     subBlockSubdivisionIsStrict = shouldBeStrict;
 }
 
+void Synthesiser::setNumRenderingThreads (int numThreads, int maximumNumChannels, int maximumBlockSize)
+{
+    const ScopedLock sl (lock);
+    voiceRenderer.prepare (numThreads, maximumNumChannels, maximumBlockSize);
+}
+
 //==============================================================================
 void Synthesiser::setCurrentPlaybackSampleRate (const double newRate)
 {
@@ -230,12 +544,26 @@ void Synthesiser::renderNextBlock (AudioBuffer<double>& outputAudio, const MidiB
 
 void Synthesiser::renderVoices (AudioBuffer<float>& buffer, int startSample, int numSamples)
 {
+    if (voiceRenderer.canRender (buffer.getNumChannels()))
+    {
+        voiceRenderer.render (voices, buffer, startSample, numSamples,
+                              [] (const SynthesiserVoice& v) { return v.isVoiceActive(); });
+        return;
+    }
+
     for (auto* voice : voices)
         voice->renderNextBlock (buffer, startSample, numSamples);
 }
 
 void Synthesiser::renderVoices (AudioBuffer<double>& buffer, int startSample, int numSamples)
 {
+    if (voiceRenderer.canRender (buffer.getNumChannels()))
+    {
+        voiceRenderer.render (voices, buffer, startSample, numSamples,
+                              [] (const SynthesiserVoice& v) { return v.isVoiceActive(); });
+        return;
+    }
+
     for (auto* voice : voices)
         voice->renderNextBlock (buffer, startSample, numSamples);
 }
@@ -293,9 +621,11 @@ void Synthesiser::noteOn (const int midiChannel,
         {
             // If hitting a note that's still ringing, stop it first (it could be
             // still playing because of the sustain or sostenuto pedal).
-            for (auto* voice : voices)
-                if (voice->getCurrentlyPlayingNote() == midiNoteNumber && voice->isPlayingChannel (midiChannel))
-                    stopVoice (voice, 1.0f, true);
+            getVoiceIndex().forEachVoicePlayingNote (midiNoteNumber, [&] (SynthesiserVoice& voice)
+            {
+                if (voice.isPlayingChannel (midiChannel))
+                    stopVoice (&voice, 1.0f, true);
+            });
 
             startVoice (findFreeVoice (sound, midiChannel, midiNoteNumber, shouldStealNotes),
                         sound, midiChannel, midiNoteNumber, velocity);
@@ -322,6 +652,8 @@ void Synthesiser::startVoice (SynthesiserVoice* const voice,
         voice->setSostenutoPedalDown (false);
         voice->setSustainPedalDown (sustainPedalsDown[midiChannel]);
 
+        getVoiceIndex().voiceStarted (*voice);
+
         voice->startNote (midiNoteNumber, velocity, sound,
                           lastPitchWheelValues [midiChannel - 1]);
     }
@@ -344,26 +676,25 @@ void Synthesiser::noteOff (const int midiChannel,
 {
     const ScopedLock sl (lock);
 
-    for (auto* voice : voices)
+    getVoiceIndex().forEachVoicePlayingNote (midiNoteNumber, [&] (SynthesiserVoice& voice)
     {
-        if (voice->getCurrentlyPlayingNote() == midiNoteNumber
-              && voice->isPlayingChannel (midiChannel))
+        if (voice.isPlayingChannel (midiChannel))
         {
-            if (auto sound = voice->getCurrentlyPlayingSound())
+            if (auto sound = voice.getCurrentlyPlayingSound())
             {
                 if (sound->appliesToNote (midiNoteNumber)
                      && sound->appliesToChannel (midiChannel))
                 {
-                    jassert (! voice->keyIsDown || voice->isSustainPedalDown() == sustainPedalsDown [midiChannel]);
+                    jassert (! voice.keyIsDown || voice.isSustainPedalDown() == sustainPedalsDown [midiChannel]);
 
-                    voice->setKeyDown (false);
+                    voice.setKeyDown (false);
 
-                    if (! (voice->isSustainPedalDown() || voice->isSostenutoPedalDown()))
-                        stopVoice (voice, velocity, allowTailOff);
+                    if (! (voice.isSustainPedalDown() || voice.isSostenutoPedalDown()))
+                        stopVoice (&voice, velocity, allowTailOff);
                 }
             }
         }
-    }
+    });
 }
 
 void Synthesiser::allNotesOff (const int midiChannel, const bool allowTailOff)
@@ -409,10 +740,11 @@ void Synthesiser::handleAftertouch (int midiChannel, int midiNoteNumber, int aft
 {
     const ScopedLock sl (lock);
 
-    for (auto* voice : voices)
-        if (voice->getCurrentlyPlayingNote() == midiNoteNumber
-              && (midiChannel <= 0 || voice->isPlayingChannel (midiChannel)))
-            voice->aftertouchChanged (aftertouchValue);
+    getVoiceIndex().forEachVoicePlayingNote (midiNoteNumber, [&] (SynthesiserVoice& voice)
+    {
+        if (midiChannel <= 0 || voice.isPlayingChannel (midiChannel))
+            voice.aftertouchChanged (aftertouchValue);
+    });
 }
 
 void Synthesiser::handleChannelPressure (int midiChannel, int channelPressureValue)
@@ -490,9 +822,11 @@ SynthesiserVoice* Synthesiser::findFreeVoice (SynthesiserSound* soundToPlay,
 {
     const ScopedLock sl (lock);
 
-    for (auto* voice : voices)
-        if ((! voice->isVoiceActive()) && voice->canPlaySound (soundToPlay))
-            return voice;
+    if (auto* voice = getVoiceIndex().findFreeVoice ([soundToPlay] (SynthesiserVoice& v)
+                                                     {
+                                                         return (! v.isVoiceActive()) && v.canPlaySound (soundToPlay);
+                                                     }))
+        return voice;
 
     if (stealIfNoneAvailable)
         return findVoiceToSteal (soundToPlay, midiChannel, midiNoteNumber);
@@ -510,76 +844,301 @@ SynthesiserVoice* Synthesiser::findVoiceToSteal (SynthesiserSound* soundToPlay,
     // apparently you are trying to render audio without having any voices...
     jassert (! voices.isEmpty());
 
+    auto& index = getVoiceIndex();
+
     // These are the voices we want to protect (ie: only steal if unavoidable)
     SynthesiserVoice* low = nullptr; // Lowest sounding note, might be sustained, but NOT in release phase
     SynthesiserVoice* top = nullptr; // Highest sounding note, might be sustained, but NOT in release phase
 
-    // this is a list of voices we can steal, sorted by how long they've been running
-    Array<SynthesiserVoice*> usableVoices;
-    usableVoices.ensureStorageAllocated (voices.size());
+    index.findLowestAndHighestNotes ([soundToPlay] (SynthesiserVoice& voice)
+                                     {
+                                         // Don't protect released notes
+                                         return voice.canPlaySound (soundToPlay) && ! voice.isPlayingButReleased();
+                                     },
+                                     low, top);
 
-    for (auto* voice : voices)
+    // Eliminate pathological cases (ie: only 1 note playing): we always give precedence to the lowest note(s)
+    if (top == low)
+        top = nullptr;
+
+    // The oldest note that's playing with the target pitch is ideal..
+    SynthesiserVoice* oldestWithSameNote = nullptr;
+
+    index.forEachVoicePlayingNote (midiNoteNumber, [&] (SynthesiserVoice& voice)
     {
-        if (voice->canPlaySound (soundToPlay))
+        if (voice.canPlaySound (soundToPlay)
+             && (oldestWithSameNote == nullptr || voice.wasStartedBefore (*oldestWithSameNote)))
+            oldestWithSameNote = &voice;
+    });
+
+    if (oldestWithSameNote != nullptr)
+        return oldestWithSameNote;
+
+    // Going through the voices from the oldest one, find the oldest voice that has been released
+    // (no finger on it and not held by sustain pedal), or else the oldest voice that doesn't have
+    // a finger on it, or else the oldest voice that isn't protected
+    SynthesiserVoice* oldestReleased = nullptr;
+    SynthesiserVoice* oldestNotHeld = nullptr;
+    SynthesiserVoice* oldestUnprotected = nullptr;
+
+    index.forEachVoiceFromOldest ([&] (SynthesiserVoice& voice)
+    {
+        if (&voice == low || &voice == top || ! voice.canPlaySound (soundToPlay))
+            return false;
+
+        jassert (voice.isVoiceActive()); // We wouldn't be here otherwise
+
+        if (voice.isPlayingButReleased())
         {
-            jassert (voice->isVoiceActive()); // We wouldn't be here otherwise
+            oldestReleased = &voice;
+            return true;
+        }
 
-            usableVoices.add (voice);
+        if (oldestNotHeld == nullptr && ! voice.isKeyDown())
+            oldestNotHeld = &voice;
 
-            // NB: Using a functor rather than a lambda here due to scare-stories about
-            // compilers generating code containing heap allocations..
-            struct Sorter
-            {
-                bool operator() (const SynthesiserVoice* a, const SynthesiserVoice* b) const noexcept { return a->wasStartedBefore (*b); }
-            };
+        if (oldestUnprotected == nullptr)
+            oldestUnprotected = &voice;
+
+        return false;
+    });
+
+    if (oldestReleased != nullptr)     return oldestReleased;
+    if (oldestNotHeld != nullptr)      return oldestNotHeld;
+    if (oldestUnprotected != nullptr)  return oldestUnprotected;
 
-            std::sort (usableVoices.begin(), usableVoices.end(), Sorter());
+    // We've only got "protected" voices now: lowest note takes priority
+    jassert (low != nullptr);
+
+    // Duophonic synth: give priority to the bass note:
+    if (top != nullptr)
+        return top;
+
+    return low;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class SynthesiserTests  : public UnitTest
+{
+public:
+    SynthesiserTests()
+        : UnitTest ("Synthesiser", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Voices are allocated and stolen in the same way as with a linear search");
+        {
+            auto random = getRandom();
 
-            if (! voice->isPlayingButReleased()) // Don't protect released notes
+            for (int run = 0; run < 20; ++run)
             {
-                auto note = voice->getCurrentlyPlayingNote();
+                Synthesiser synth;
+                LinearSearchSynthesiser reference;
+
+                auto numVoices = 1 + random.nextInt (40);
+
+                for (auto* s : { &synth, static_cast<Synthesiser*> (&reference) })
+                {
+                    s->setCurrentPlaybackSampleRate (44100.0);
+                    s->addSound (new TestSound());
+
+                    for (int i = 0; i < numVoices; ++i)
+                        s->addVoice (new TestVoice());
+                }
 
-                if (low == nullptr || note < low->getCurrentlyPlayingNote())
-                    low = voice;
+                AudioBuffer<float> buffer (1, 64);
 
-                if (top == nullptr || note > top->getCurrentlyPlayingNote())
-                    top = voice;
+                for (int event = 0; event < 2000; ++event)
+                {
+                    MidiBuffer midi;
+                    midi.addEvent (createRandomMessage (random), 0);
+                    synth.renderNextBlock (buffer, midi, 0, 0);
+                    reference.renderNextBlock (buffer, midi, 0, 0);
+
+                    if (random.nextInt (8) == 0)
+                    {
+                        auto numSamples = 1 + random.nextInt (64);
+                        synth.renderNextBlock (buffer, {}, 0, numSamples);
+                        reference.renderNextBlock (buffer, {}, 0, numSamples);
+                    }
+
+                    expect (haveSameVoiceStates (synth, reference));
+                }
             }
         }
+
+        beginTest ("Voices which are removed and added are indexed");
+        {
+            Synthesiser synth;
+            synth.setCurrentPlaybackSampleRate (44100.0);
+            synth.addSound (new TestSound());
+
+            for (int i = 0; i < 4; ++i)
+                synth.addVoice (new TestVoice());
+
+            synth.noteOn (1, 60, 1.0f);
+            synth.noteOn (1, 62, 1.0f);
+            synth.removeVoice (0);
+            synth.addVoice (new TestVoice());
+
+            expectEquals (synth.getVoice (0)->getCurrentlyPlayingNote(), 62);
+
+            synth.noteOff (1, 62, 1.0f, false);
+            expect (! synth.getVoice (0)->isVoiceActive());
+
+            synth.noteOn (1, 64, 1.0f);
+            expectEquals (synth.getVoice (0)->getCurrentlyPlayingNote(), 64);
+        }
     }
 
-    // Eliminate pathological cases (ie: only 1 note playing): we always give precedence to the lowest note(s)
-    if (top == low)
-        top = nullptr;
+private:
+    //==============================================================================
+    struct TestSound  : public SynthesiserSound
+    {
+        bool appliesToNote (int) override       { return true; }
+        bool appliesToChannel (int) override    { return true; }
+    };
 
-    // The oldest note that's playing with the target pitch is ideal..
-    for (auto* voice : usableVoices)
-        if (voice->getCurrentlyPlayingNote() == midiNoteNumber)
-            return voice;
+    // A voice which takes a few samples to tail off
+    struct TestVoice  : public SynthesiserVoice
+    {
+        bool canPlaySound (SynthesiserSound*) override          { return true; }
+        void startNote (int, float, SynthesiserSound*, int) override   { tailOff = 0; }
+        void pitchWheelMoved (int) override                     {}
+        void controllerMoved (int, int) override                {}
 
-    // Oldest voice that has been released (no finger on it and not held by sustain pedal)
-    for (auto* voice : usableVoices)
-        if (voice != low && voice != top && voice->isPlayingButReleased())
-            return voice;
+        void stopNote (float, bool allowTailOff) override
+        {
+            if (allowTailOff)
+                tailOff = 40;
+            else
+                clearCurrentNote();
+        }
 
-    // Oldest voice that doesn't have a finger on it:
-    for (auto* voice : usableVoices)
-        if (voice != low && voice != top && ! voice->isKeyDown())
-            return voice;
+        void renderNextBlock (AudioBuffer<float>&, int, int numSamples) override
+        {
+            if (tailOff > 0 && (tailOff -= numSamples) <= 0)
+            {
+                tailOff = 0;
+                clearCurrentNote();
+            }
+        }
 
-    // Oldest voice that isn't protected
-    for (auto* voice : usableVoices)
-        if (voice != low && voice != top)
-            return voice;
+        using SynthesiserVoice::renderNextBlock;
+        int tailOff = 0;
+    };
 
-    // We've only got "protected" voices now: lowest note takes priority
-    jassert (low != nullptr);
+    // Finds voices by going through all of them, as the synthesiser used to do
+    struct LinearSearchSynthesiser  : public Synthesiser
+    {
+        using Synthesiser::findFreeVoice;
+        using Synthesiser::findVoiceToSteal;
 
-    // Duophonic synth: give priority to the bass note:
-    if (top != nullptr)
-        return top;
+        SynthesiserVoice* findFreeVoice (SynthesiserSound* soundToPlay, int midiChannel,
+                                         int midiNoteNumber, bool stealIfNoneAvailable) const override
+        {
+            for (auto* voice : voices)
+                if ((! voice->isVoiceActive()) && voice->canPlaySound (soundToPlay))
+                    return voice;
 
-    return low;
-}
+            if (stealIfNoneAvailable)
+                return findVoiceToSteal (soundToPlay, midiChannel, midiNoteNumber);
+
+            return nullptr;
+        }
+
+        SynthesiserVoice* findVoiceToSteal (SynthesiserSound* soundToPlay, int, int midiNoteNumber) const override
+        {
+            SynthesiserVoice* low = nullptr;
+            SynthesiserVoice* top = nullptr;
+            Array<SynthesiserVoice*> usableVoices;
+
+            for (auto* voice : voices)
+            {
+                if (voice->canPlaySound (soundToPlay))
+                {
+                    usableVoices.add (voice);
+
+                    if (! voice->isPlayingButReleased())
+                    {
+                        auto note = voice->getCurrentlyPlayingNote();
+
+                        if (low == nullptr || note < low->getCurrentlyPlayingNote())
+                            low = voice;
+
+                        if (top == nullptr || note > top->getCurrentlyPlayingNote())
+                            top = voice;
+                    }
+                }
+            }
+
+            std::sort (usableVoices.begin(), usableVoices.end(),
+                       [] (const SynthesiserVoice* a, const SynthesiserVoice* b) { return a->wasStartedBefore (*b); });
+
+            if (top == low)
+                top = nullptr;
+
+            for (auto* voice : usableVoices)
+                if (voice->getCurrentlyPlayingNote() == midiNoteNumber)
+                    return voice;
+
+            for (auto* voice : usableVoices)
+                if (voice != low && voice != top && voice->isPlayingButReleased())
+                    return voice;
+
+            for (auto* voice : usableVoices)
+                if (voice != low && voice != top && ! voice->isKeyDown())
+                    return voice;
+
+            for (auto* voice : usableVoices)
+                if (voice != low && voice != top)
+                    return voice;
+
+            return top != nullptr ? top : low;
+        }
+    };
+
+    static MidiMessage createRandomMessage (Random& random)
+    {
+        auto channel = 1 + random.nextInt (2);
+        auto note = 48 + random.nextInt (24);
+
+        switch (random.nextInt (10))
+        {
+            case 0:   return MidiMessage::controllerEvent (channel, 0x40, random.nextBool() ? 127 : 0);
+            case 1:   return MidiMessage::controllerEvent (channel, 0x42, random.nextBool() ? 127 : 0);
+            case 2:
+            case 3:
+            case 4:
+            case 5:   return MidiMessage::noteOff (channel, note);
+            default:  return MidiMessage::noteOn (channel, note, 0.5f);
+        }
+    }
+
+    static bool haveSameVoiceStates (const Synthesiser& a, const Synthesiser& b)
+    {
+        for (int i = 0; i < a.getNumVoices(); ++i)
+        {
+            auto* voiceA = a.getVoice (i);
+            auto* voiceB = b.getVoice (i);
+
+            if (voiceA->getCurrentlyPlayingNote() != voiceB->getCurrentlyPlayingNote()
+                 || voiceA->isKeyDown() != voiceB->isKeyDown()
+                 || voiceA->isSustainPedalDown() != voiceB->isSustainPedalDown()
+                 || voiceA->isSostenutoPedalDown() != voiceB->isSostenutoPedalDown())
+                return false;
+        }
+
+        return true;
+    }
+};
+
+static SynthesiserTests synthesiserTests;
+
+#endif
 
 } // namespace juce
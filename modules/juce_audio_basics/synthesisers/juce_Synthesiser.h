@@ -272,6 +272,11 @@ private:
     SynthesiserSound::Ptr currentlyPlayingSound;
     bool keyIsDown = false, sustainPedalDown = false, sostenutoPedalDown = false;
 
+    // The word and bit of the synthesiser's set of free voices, which clearCurrentNote()
+    // sets when the voice is rendered on another thread
+    std::atomic<uint64>* freeVoiceFlags = nullptr;
+    uint64 freeVoiceFlagMask = 0;
+
     AudioBuffer<float> tempBuffer;
 
     JUCE_LEAK_DETECTOR (SynthesiserVoice)
@@ -557,11 +562,43 @@ public:
     */
     void setMinimumRenderingSubdivisionSize (int numSamples, bool shouldBeStrict = false) noexcept;
 
+    /** Sets the number of threads used to render the voices.
+
+        With more than one thread, the voices are rendered at the same time by a set of
+        worker threads and the thread which calls renderNextBlock(), each into its own
+        buffer, and then added to the output in a fixed order. Only the voices for which
+        isVoiceActive() returns true are rendered, and they mustn't modify any state that
+        they share with each other while rendering.
+
+        This starts the threads and allocates the buffers, so it should be called before
+        the rendering starts, e.g. in prepareToPlay().
+
+        @param numThreads           the number of threads, including the rendering thread.
+                                    1 (the default) renders all the voices on the rendering thread
+        @param maximumNumChannels   the maximum number of channels of the output buffers
+        @param maximumBlockSize     the maximum number of samples rendered at once; larger
+                                    sub-blocks are rendered in several parts
+
+        @see ParallelVoiceRenderer
+    */
+    void setNumRenderingThreads (int numThreads, int maximumNumChannels, int maximumBlockSize);
+
+    /** Returns the number of threads used to render the voices.
+        @see setNumRenderingThreads
+    */
+    int getNumRenderingThreads() const noexcept                 { return voiceRenderer.getNumThreads(); }
+
 protected:
     //==============================================================================
     /** This is used to control access to the rendering callback and the note trigger methods. */
     CriticalSection lock;
 
+    /** The voices of the synthesiser.
+
+        The synthesiser keeps an index of the voices playing each note, of their ages and of
+        the free voices, which is rebuilt when the number of voices changes, so the voices
+        should be replaced with removeVoice() and addVoice() rather than in this array.
+    */
     OwnedArray<SynthesiserVoice> voices;
     ReferenceCountedArray<SynthesiserSound> sounds;
 
@@ -582,6 +619,10 @@ protected:
 
         Returns nullptr if all voices are busy and stealing isn't enabled.
 
+        Only the voices which aren't playing a note (see getCurrentlyPlayingNote()) are
+        checked with isVoiceActive(), so that a free voice can be found without going
+        through all the voices.
+
         To implement a custom note-stealing algorithm, you can either override this
         method, or (preferably) override findVoiceToSteal().
     */
@@ -627,12 +668,19 @@ private:
     bool subBlockSubdivisionIsStrict = false;
     bool shouldStealNotes = true;
     BigInteger sustainPedalsDown;
+    ParallelVoiceRenderer voiceRenderer;
+
+    class VoiceIndex;
+    std::unique_ptr<VoiceIndex> voiceIndex;
+    VoiceIndex& getVoiceIndex() const;
 
     template <typename floatType>
     void processNextBlock (AudioBuffer<floatType>&, const MidiBuffer&, int startSample, int numSamples);
 
    #if JUCE_CATCH_DEPRECATED_CODE_MISUSE
-    // Note the new parameters for these methods.
+protected:
+    // Note the new parameters for these methods. These are protected so that a
+    // subclass can bring them into scope alongside its own overrides.
     virtual int findFreeVoice (const bool) const { return 0; }
     virtual int noteOff (int, int, int) { return 0; }
     virtual int findFreeVoice (SynthesiserSound*, const bool) { return 0; }
@@ -0,0 +1,237 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+#if JUCE_UNIT_TESTS
+
+class ReverbTests  : public UnitTest
+{
+public:
+    ReverbTests()
+        : UnitTest ("Reverb", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        for (auto sampleRate : { 44100.0, 96000.0, 1000.0 })
+        {
+            beginTest ("Stereo output matches a per-sample implementation at " + String (sampleRate) + " Hz");
+            compareWithReference (sampleRate, 2);
+
+            beginTest ("Mono output matches a per-sample implementation at " + String (sampleRate) + " Hz");
+            compareWithReference (sampleRate, 1);
+        }
+    }
+
+private:
+    //==============================================================================
+    // A straightforward version of the algorithm, which processes each comb filter separately
+    struct ReferenceReverb
+    {
+        struct DelayLine
+        {
+            void setSize (int size)     { buffer.assign ((size_t) size, 0.0f); index = 0; }
+
+            float read() const          { return buffer[(size_t) index]; }
+
+            void write (float value)
+            {
+                buffer[(size_t) index] = value;
+                index = (index + 1) % (int) buffer.size();
+            }
+
+            std::vector<float> buffer;
+            int index = 0;
+            float last = 0;
+        };
+
+        ReferenceReverb()
+        {
+            setParameters ({});
+        }
+
+        void setSampleRate (double sampleRate)
+        {
+            const short combTunings[] = { 1116, 1188, 1277, 1356, 1422, 1491, 1557, 1617 };
+            const short allPassTunings[] = { 556, 441, 341, 225 };
+            const auto intSampleRate = (int) sampleRate;
+
+            for (int i = 0; i < 8; ++i)
+            {
+                combs[0][i].setSize ((intSampleRate * combTunings[i]) / 44100);
+                combs[1][i].setSize ((intSampleRate * (combTunings[i] + 23)) / 44100);
+            }
+
+            for (int i = 0; i < 4; ++i)
+            {
+                allPasses[0][i].setSize ((intSampleRate * allPassTunings[i]) / 44100);
+                allPasses[1][i].setSize ((intSampleRate * (allPassTunings[i] + 23)) / 44100);
+            }
+
+            for (auto* value : { &damping, &feedback, &dryGain, &wetGain1, &wetGain2 })
+                value->reset (sampleRate, 0.01);
+        }
+
+        void setParameters (const Reverb::Parameters& p)
+        {
+            const auto frozen = p.freezeMode >= 0.5f;
+            const auto wet = p.wetLevel * 3.0f;
+
+            dryGain.setTargetValue (p.dryLevel * 2.0f);
+            wetGain1.setTargetValue (0.5f * wet * (1.0f + p.width));
+            wetGain2.setTargetValue (0.5f * wet * (1.0f - p.width));
+            gain = frozen ? 0.0f : 0.015f;
+            damping.setTargetValue (frozen ? 0.0f : p.damping * 0.4f);
+            feedback.setTargetValue (frozen ? 1.0f : p.roomSize * 0.28f + 0.7f);
+        }
+
+        float processCombs (DelayLine* channelCombs, float input, float damp, float feedbackLevel)
+        {
+            float output = 0;
+
+            for (int j = 0; j < 8; ++j)
+            {
+                auto& c = channelCombs[j];
+                const auto delayed = c.read();
+                output += delayed;
+
+                c.last = (delayed * (1.0f - damp)) + (c.last * damp);
+                JUCE_UNDENORMALISE (c.last);
+
+                float temp = input + (c.last * feedbackLevel);
+                JUCE_UNDENORMALISE (temp);
+                c.write (temp);
+            }
+
+            return output;
+        }
+
+        float processAllPasses (DelayLine* channelAllPasses, float value)
+        {
+            for (int j = 0; j < 4; ++j)
+            {
+                auto& a = channelAllPasses[j];
+                const auto delayed = a.read();
+
+                float temp = value + (delayed * 0.5f);
+                JUCE_UNDENORMALISE (temp);
+                a.write (temp);
+                value = delayed - value;
+            }
+
+            return value;
+        }
+
+        void process (float* left, float* right, int numSamples)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const auto input = (right != nullptr ? left[i] + right[i] : left[i]) * gain;
+                const auto damp = damping.getNextValue(), feedbackLevel = feedback.getNextValue();
+
+                auto outL = processAllPasses (allPasses[0], processCombs (combs[0], input, damp, feedbackLevel));
+                auto outR = right != nullptr ? processAllPasses (allPasses[1], processCombs (combs[1], input, damp, feedbackLevel)) : 0.0f;
+
+                const auto dry = dryGain.getNextValue(), wet1 = wetGain1.getNextValue(), wet2 = wetGain2.getNextValue();
+
+                if (right != nullptr)
+                {
+                    left[i]  = outL * wet1 + outR * wet2 + left[i]  * dry;
+                    right[i] = outR * wet1 + outL * wet2 + right[i] * dry;
+                }
+                else
+                {
+                    left[i] = outL * wet1 + left[i] * dry;
+                }
+            }
+        }
+
+        DelayLine combs[2][8], allPasses[2][4];
+        SmoothedValue<float> damping, feedback, dryGain, wetGain1, wetGain2;
+        float gain = 0;
+    };
+
+    //==============================================================================
+    void compareWithReference (double sampleRate, int numChannels)
+    {
+        auto random = getRandom();
+
+        Reverb reverb;
+        ReferenceReverb reference;
+        reverb.setSampleRate (sampleRate);
+        reference.setSampleRate (sampleRate);
+
+        AudioBuffer<float> actual (numChannels, 512), expected (numChannels, 512);
+        float maxError = 0;
+
+        for (int block = 0; block < 200; ++block)
+        {
+            if (block % 50 == 0)
+            {
+                Reverb::Parameters params;
+                params.roomSize = random.nextFloat();
+                params.damping = random.nextFloat();
+                params.width = random.nextFloat();
+                params.freezeMode = block == 150 ? 1.0f : 0.0f;
+
+                reverb.setParameters (params);
+                reference.setParameters (params);
+            }
+
+            const auto numSamples = random.nextInt ({ 1, 513 });
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                for (int i = 0; i < numSamples; ++i)
+                    actual.setSample (channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+                expected.copyFrom (channel, 0, actual, channel, 0, numSamples);
+            }
+
+            if (numChannels == 2)
+            {
+                reverb.processStereo (actual.getWritePointer (0), actual.getWritePointer (1), numSamples);
+                reference.process (expected.getWritePointer (0), expected.getWritePointer (1), numSamples);
+            }
+            else
+            {
+                reverb.processMono (actual.getWritePointer (0), numSamples);
+                reference.process (expected.getWritePointer (0), nullptr, numSamples);
+            }
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                for (int i = 0; i < numSamples; ++i)
+                    maxError = jmax (maxError, std::abs (actual.getSample (channel, i) - expected.getSample (channel, i)));
+        }
+
+        expectLessOrEqual (maxError, 1.0e-5f);
+    }
+};
+
+static ReverbTests reverbTests;
+
+#endif
+
+} // namespace juce
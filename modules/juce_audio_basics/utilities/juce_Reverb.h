@@ -96,8 +96,8 @@ public:
 
         for (int i = 0; i < numCombs; ++i)
         {
-            comb[0][i].setSize ((intSampleRate * combTunings[i]) / 44100);
-            comb[1][i].setSize ((intSampleRate * (combTunings[i] + stereoSpread)) / 44100);
+            combs.setSize (i,            (intSampleRate * combTunings[i]) / 44100);
+            combs.setSize (numCombs + i, (intSampleRate * (combTunings[i] + stereoSpread)) / 44100);
         }
 
         for (int i = 0; i < numAllPasses; ++i)
@@ -117,11 +117,10 @@ public:
     /** Clears the reverb's buffers. */
     void reset()
     {
+        combs.clear();
+
         for (int j = 0; j < numChannels; ++j)
         {
-            for (int i = 0; i < numCombs; ++i)
-                comb[j][i].clear();
-
             for (int i = 0; i < numAllPasses; ++i)
                 allPass[j][i].clear();
         }
@@ -133,32 +132,37 @@ public:
     {
         jassert (left != nullptr && right != nullptr);
 
-        for (int i = 0; i < numSamples; ++i)
+        float input[CombFilterBank::maxBlockSize], outL[CombFilterBank::maxBlockSize], outR[CombFilterBank::maxBlockSize];
+        float* const combOutputs[] = { outL, outR };
+
+        for (int start = 0; start < numSamples; start += combs.getBlockSize())
         {
-            const float input = (left[i] + right[i]) * gain;
-            float outL = 0, outR = 0;
+            const int num = jmin (combs.getBlockSize(), numSamples - start);
+            auto* l = left + start;
+            auto* r = right + start;
 
-            const float damp    = damping.getNextValue();
-            const float feedbck = feedback.getNextValue();
+            for (int i = 0; i < num; ++i)
+                input[i] = (l[i] + r[i]) * gain;
 
-            for (int j = 0; j < numCombs; ++j)  // accumulate the comb filters in parallel
-            {
-                outL += comb[0][j].process (input, damp, feedbck);
-                outR += comb[1][j].process (input, damp, feedbck);
-            }
+            combs.process<2> (input, combOutputs, num, damping, feedback);
 
-            for (int j = 0; j < numAllPasses; ++j)  // run the allpass filters in series
+            for (int i = 0; i < num; ++i)
             {
-                outL = allPass[0][j].process (outL);
-                outR = allPass[1][j].process (outR);
-            }
+                float wetL = outL[i], wetR = outR[i];
 
-            const float dry  = dryGain.getNextValue();
-            const float wet1 = wetGain1.getNextValue();
-            const float wet2 = wetGain2.getNextValue();
+                for (int j = 0; j < numAllPasses; ++j)  // run the allpass filters in series
+                {
+                    wetL = allPass[0][j].process (wetL);
+                    wetR = allPass[1][j].process (wetR);
+                }
 
-            left[i]  = outL * wet1 + outR * wet2 + left[i]  * dry;
-            right[i] = outR * wet1 + outL * wet2 + right[i] * dry;
+                const float dry  = dryGain.getNextValue();
+                const float wet1 = wetGain1.getNextValue();
+                const float wet2 = wetGain2.getNextValue();
+
+                l[i] = wetL * wet1 + wetR * wet2 + l[i] * dry;
+                r[i] = wetR * wet1 + wetL * wet2 + r[i] * dry;
+            }
         }
     }
 
@@ -167,24 +171,31 @@ public:
     {
         jassert (samples != nullptr);
 
-        for (int i = 0; i < numSamples; ++i)
+        float input[CombFilterBank::maxBlockSize], output[CombFilterBank::maxBlockSize];
+        float* const combOutputs[] = { output };
+
+        for (int start = 0; start < numSamples; start += combs.getBlockSize())
         {
-            const float input = samples[i] * gain;
-            float output = 0;
+            const int num = jmin (combs.getBlockSize(), numSamples - start);
+            auto* s = samples + start;
+
+            for (int i = 0; i < num; ++i)
+                input[i] = s[i] * gain;
 
-            const float damp    = damping.getNextValue();
-            const float feedbck = feedback.getNextValue();
+            combs.process<1> (input, combOutputs, num, damping, feedback);
 
-            for (int j = 0; j < numCombs; ++j)  // accumulate the comb filters in parallel
-                output += comb[0][j].process (input, damp, feedbck);
+            for (int i = 0; i < num; ++i)
+            {
+                float wet = output[i];
 
-            for (int j = 0; j < numAllPasses; ++j)  // run the allpass filters in series
-                output = allPass[0][j].process (output);
+                for (int j = 0; j < numAllPasses; ++j)  // run the allpass filters in series
+                    wet = allPass[0][j].process (wet);
 
-            const float dry  = dryGain.getNextValue();
-            const float wet1 = wetGain1.getNextValue();
+                const float dry  = dryGain.getNextValue();
+                const float wet1 = wetGain1.getNextValue();
 
-            samples[i] = output * wet1 + samples[i] * dry;
+                s[i] = wet * wet1 + s[i] * dry;
+            }
         }
     }
 
@@ -212,48 +223,146 @@ private:
     }
 
     //==============================================================================
-    class CombFilter
+    enum { numCombs = 8, numAllPasses = 4, numChannels = 2 };
+
+    //==============================================================================
+    /*  The comb filters for both channels, with their state stored as a structure of
+        arrays so that all the combs can be updated together using SIMD instructions.
+
+        The samples are processed in blocks which are no longer than the shortest delay
+        line, so the delayed samples for a whole block can be read before any of the new
+        ones are written back.
+    */
+    class CombFilterBank
     {
     public:
-        CombFilter() noexcept {}
+        CombFilterBank() noexcept {}
 
-        void setSize (const int size)
+        enum { numLanes = numChannels * numCombs, maxBlockSize = 32 };
+
+        void setSize (const int lane, const int size)
         {
-            if (size != bufferSize)
+            jassert (size > 0);
+
+            if (size != sizes[lane])
             {
-                bufferIndex = 0;
-                buffer.malloc (size);
-                bufferSize = size;
+                indices[lane] = 0;
+                buffers[lane].malloc (size);
+                sizes[lane] = size;
             }
 
-            clear();
+            last[lane] = 0;
+            buffers[lane].clear ((size_t) size);
+
+            blockSize = maxBlockSize;
+
+            for (auto s : sizes)
+                if (s > 0)
+                    blockSize = jmin (blockSize, s);
         }
 
         void clear() noexcept
         {
-            last = 0;
-            buffer.clear ((size_t) bufferSize);
+            for (int lane = 0; lane < numLanes; ++lane)
+            {
+                last[lane] = 0;
+                buffers[lane].clear ((size_t) sizes[lane]);
+            }
         }
 
-        float process (const float input, const float damp, const float feedbackLevel) noexcept
+        int getBlockSize() const noexcept       { return blockSize; }
+
+        /*  Feeds the same input to the combs of the first numChannelsToUse channels, and
+            writes the sum of each channel's combs to its output array.
+        */
+        template <int numChannelsToUse>
+        void process (const float* input, float* const* outputs, const int numSamples,
+                      SmoothedValue<float>& damping, SmoothedValue<float>& feedback) noexcept
         {
-            const float output = buffer[bufferIndex];
-            last = (output * (1.0f - damp)) + (last * damp);
-            JUCE_UNDENORMALISE (last);
+            constexpr int numLanesToUse = numChannelsToUse * numCombs;
+            jassert (numSamples <= blockSize);
 
-            float temp = input + (last * feedbackLevel);
-            JUCE_UNDENORMALISE (temp);
-            buffer[bufferIndex] = temp;
-            bufferIndex = (bufferIndex + 1) % bufferSize;
-            return output;
+            // The delayed samples are stored with all the lanes for each sample next to each other
+            float delayed[(size_t) (maxBlockSize * numLanesToUse)], state[(size_t) numLanesToUse];
+            readDelayedSamples (delayed, numLanesToUse, numSamples);
+            std::copy (last, last + numLanesToUse, state);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                auto* d = delayed + i * numLanesToUse;
+
+                for (int channel = 0; channel < numChannelsToUse; ++channel)
+                {
+                    float output = 0;
+
+                    for (int j = 0; j < numCombs; ++j)  // accumulate the comb filters in parallel
+                        output += d[channel * numCombs + j];
+
+                    outputs[channel][i] = output;
+                }
+
+                const float damp = damping.getNextValue();
+                const float feedbackLevel = feedback.getNextValue();
+                const float in = input[i];
+
+                for (int lane = 0; lane < numLanesToUse; ++lane)
+                {
+                    state[lane] = (d[lane] * (1.0f - damp)) + (state[lane] * damp);
+                    JUCE_UNDENORMALISE (state[lane]);
+
+                    float temp = in + (state[lane] * feedbackLevel);
+                    JUCE_UNDENORMALISE (temp);
+                    d[lane] = temp;
+                }
+            }
+
+            std::copy (state, state + numLanesToUse, last);
+            writeDelayedSamples (delayed, numLanesToUse, numSamples);
         }
 
     private:
-        HeapBlock<float> buffer;
-        int bufferSize = 0, bufferIndex = 0;
-        float last = 0.0f;
+        void readDelayedSamples (float* dest, const int numLanesToUse, const int numSamples) const noexcept
+        {
+            for (int lane = 0; lane < numLanesToUse; ++lane)
+            {
+                auto* buffer = buffers[lane].get();
+                auto index = indices[lane];
+
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    dest[i * numLanesToUse + lane] = buffer[index];
+
+                    if (++index == sizes[lane])
+                        index = 0;
+                }
+            }
+        }
+
+        void writeDelayedSamples (const float* src, const int numLanesToUse, const int numSamples) noexcept
+        {
+            for (int lane = 0; lane < numLanesToUse; ++lane)
+            {
+                auto* buffer = buffers[lane].get();
+                auto index = indices[lane];
+
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    buffer[index] = src[i * numLanesToUse + lane];
+
+                    if (++index == sizes[lane])
+                        index = 0;
+                }
+
+                indices[lane] = index;
+            }
+        }
 
-        JUCE_DECLARE_NON_COPYABLE (CombFilter)
+        HeapBlock<float> buffers[numLanes];
+        int sizes[numLanes] = {}, indices[numLanes] = {};
+        float last[numLanes] = {};
+        int blockSize = maxBlockSize;
+
+        JUCE_DECLARE_NON_COPYABLE (CombFilterBank)
     };
 
     //==============================================================================
@@ -285,7 +394,10 @@ private:
             float temp = input + (bufferedValue * 0.5f);
             JUCE_UNDENORMALISE (temp);
             buffer [bufferIndex] = temp;
-            bufferIndex = (bufferIndex + 1) % bufferSize;
+
+            if (++bufferIndex == bufferSize)
+                bufferIndex = 0;
+
             return bufferedValue - input;
         }
 
@@ -297,12 +409,10 @@ private:
     };
 
     //==============================================================================
-    enum { numCombs = 8, numAllPasses = 4, numChannels = 2 };
-
     Parameters parameters;
     float gain;
 
-    CombFilter comb [numChannels][numCombs];
+    CombFilterBank combs;
     AllPassFilter allPass [numChannels][numAllPasses];
 
     SmoothedValue<float> damping, feedback, dryGain, wetGain1, wetGain2;
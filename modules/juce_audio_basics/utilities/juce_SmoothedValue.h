@@ -90,15 +90,12 @@ public:
     {
         jassert (numSamples >= 0);
 
-        if (isSmoothing())
+        const auto numSmoothed = applySmoothedGains (numSamples, [samples] (int start, const FloatType* gains, int num)
         {
-            for (int i = 0; i < numSamples; ++i)
-                samples[i] *= getNextSmoothedValue();
-        }
-        else
-        {
-            FloatVectorOperations::multiply (samples, target, numSamples);
-        }
+            FloatVectorOperations::multiply (samples + start, gains, num);
+        });
+
+        FloatVectorOperations::multiply (samples + numSmoothed, target, numSamples - numSmoothed);
     }
 
     /** Computes output as a smoothed gain applied to a stream of samples.
@@ -111,15 +108,12 @@ public:
     {
         jassert (numSamples >= 0);
 
-        if (isSmoothing())
-        {
-            for (int i = 0; i < numSamples; ++i)
-                samplesOut[i] = samplesIn[i] * getNextSmoothedValue();
-        }
-        else
+        const auto numSmoothed = applySmoothedGains (numSamples, [samplesOut, samplesIn] (int start, const FloatType* gains, int num)
         {
-            FloatVectorOperations::multiply (samplesOut, samplesIn, target, numSamples);
-        }
+            FloatVectorOperations::multiply (samplesOut + start, samplesIn + start, gains, num);
+        });
+
+        FloatVectorOperations::multiply (samplesOut + numSmoothed, samplesIn + numSmoothed, target, numSamples - numSmoothed);
     }
 
     /** Applies a smoothed gain to a buffer */
@@ -127,30 +121,13 @@ public:
     {
         jassert (numSamples >= 0);
 
-        if (isSmoothing())
+        const auto numSmoothed = applySmoothedGains (numSamples, [&buffer] (int start, const FloatType* gains, int num)
         {
-            if (buffer.getNumChannels() == 1)
-            {
-                auto* samples = buffer.getWritePointer (0);
-
-                for (int i = 0; i < numSamples; ++i)
-                    samples[i] *= getNextSmoothedValue();
-            }
-            else
-            {
-                for (auto i = 0; i < numSamples; ++i)
-                {
-                    auto gain = getNextSmoothedValue();
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                FloatVectorOperations::multiply (buffer.getWritePointer (channel, start), gains, num);
+        });
 
-                    for (int channel = 0; channel < buffer.getNumChannels(); channel++)
-                        buffer.setSample (channel, i, buffer.getSample (channel, i) * gain);
-                }
-            }
-        }
-        else
-        {
-            buffer.applyGain (0, numSamples, target);
-        }
+        buffer.applyGain (numSmoothed, numSamples - numSmoothed, target);
     }
 
 private:
@@ -160,6 +137,29 @@ private:
         return static_cast <SmoothedValueType*> (this)->getNextValue();
     }
 
+    /*  Calculates the gains for the part of a block where the value is still moving, a
+        few at a time, and passes them to a function that applies them to the samples.
+        Returns the number of samples that were processed, after which the gain is the target.
+    */
+    template <typename ApplyGainsFunction>
+    int applySmoothedGains (int numSamples, ApplyGainsFunction&& applyGains) noexcept
+    {
+        const auto numSmoothed = jmin (numSamples, countdown);
+        FloatType gains[64];
+
+        for (int start = 0; start < numSmoothed; start += numElementsInArray (gains))
+        {
+            const auto num = jmin (numElementsInArray (gains), numSmoothed - start);
+
+            for (int i = 0; i < num; ++i)
+                gains[i] = getNextSmoothedValue();
+
+            applyGains (start, gains, num);
+        }
+
+        return numSmoothed;
+    }
+
 protected:
     //==============================================================================
     FloatType currentValue = 0;
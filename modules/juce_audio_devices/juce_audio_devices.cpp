@@ -54,6 +54,7 @@
 #include "midi_io/ump/juce_UMPView.h"
 #include "midi_io/ump/juce_UMPIterator.h"
 #include "midi_io/ump/juce_UMPackets.h"
+#include "midi_io/ump/juce_UMPFifo.h"
 #include "midi_io/ump/juce_UMPFactory.h"
 #include "midi_io/ump/juce_UMPConversion.h"
 #include "midi_io/ump/juce_UMPMidi1ToBytestreamTranslator.h"
@@ -23,8 +23,123 @@
 namespace juce
 {
 
+//==============================================================================
+/*  A bounded multi-producer, single-consumer queue of timestamped messages.
+
+    The storage is a ring of fixed-size blocks, each of which has a header. A producer
+    claims the blocks for a message by advancing the write position with a
+    compare-and-swap, copies the message in, and then publishes it by storing the
+    number of blocks used in the header of the first one. If a message would straddle
+    the end of the ring, the producer also claims the blocks before the end, and marks
+    them as padding with a negative count.
+
+    The consumer walks along the headers from the read position, stopping at the first
+    one that hasn't been published yet, and clears each header before handing the
+    blocks back to the producers.
+
+    When ensureStorageAllocated() needs a bigger queue, the old one can't be deleted,
+    because a producer might still be pushing a message into it. So the new queue is
+    linked onto the end of the old one, which keeps it alive, and the consumer goes on
+    emptying all of them.
+*/
+struct MidiMessageCollector::MessageQueue
+{
+    explicit MessageQueue (size_t minBytes)
+        : numBlocks (nextPowerOfTwo (jmax (16, (int) ((minBytes + blockSize - 1) / blockSize)))),
+          headers (new Header[(size_t) numBlocks])
+    {
+        data.calloc ((size_t) numBlocks * blockSize);
+    }
+
+    size_t getCapacityInBytes() const noexcept    { return (size_t) numBlocks * blockSize; }
+
+    bool push (const uint8* bytes, int numBytes, double timeStamp) noexcept
+    {
+        auto numNeeded = jmax (1, (numBytes + blockSize - 1) / blockSize);
+
+        if (numNeeded > numBlocks)
+            return false;
+
+        auto start = writePos.load (std::memory_order_relaxed);
+        int numPaddingBlocks;
+
+        for (;;)
+        {
+            auto offset = (int) (start & mask);
+            numPaddingBlocks = offset + numNeeded > numBlocks ? numBlocks - offset : 0;
+            auto end = start + (uint32) (numPaddingBlocks + numNeeded);
+
+            if (end - readPos.load (std::memory_order_acquire) > (uint32) numBlocks)
+                return false;
+
+            if (writePos.compare_exchange_weak (start, end, std::memory_order_relaxed))
+                break;
+        }
+
+        if (numPaddingBlocks > 0)
+            headers[start & mask].numBlocks.store (-numPaddingBlocks, std::memory_order_release);
+
+        auto first = (start + (uint32) numPaddingBlocks) & mask;
+        auto& header = headers[first];
+
+        memcpy (data + first * blockSize, bytes, (size_t) numBytes);
+        header.numBytes = numBytes;
+        header.timeStamp = timeStamp;
+        header.numBlocks.store (numNeeded, std::memory_order_release);
+        return true;
+    }
+
+    template <typename Callback>
+    void popAll (Callback&& callback) noexcept
+    {
+        auto pos = readPos.load (std::memory_order_relaxed);
+
+        for (;;)
+        {
+            auto& header = headers[pos & mask];
+            auto count = header.numBlocks.load (std::memory_order_acquire);
+
+            if (count == 0)
+                break;
+
+            if (count > 0)
+                callback (data + (pos & mask) * blockSize, header.numBytes, header.timeStamp);
+
+            header.numBlocks.store (0, std::memory_order_relaxed);
+            pos += (uint32) std::abs (count);
+        }
+
+        readPos.store (pos, std::memory_order_release);
+    }
+
+    // a bigger queue that has replaced this one
+    std::unique_ptr<MessageQueue> next;
+
+private:
+    struct Header
+    {
+        std::atomic<int> numBlocks { 0 };
+        int numBytes = 0;
+        double timeStamp = 0;
+    };
+
+    static constexpr int blockSize = 16;
+
+    const int numBlocks;
+    const uint32 mask = (uint32) numBlocks - 1;
+    std::unique_ptr<Header[]> headers;
+    HeapBlock<uint8> data;
+    std::atomic<uint32> writePos { 0 }, readPos { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE (MessageQueue)
+};
+
+//==============================================================================
 MidiMessageCollector::MidiMessageCollector()
+    : queue (new MessageQueue (32768)),
+      newestQueue (queue.get())
 {
+    incomingMessages.ensureSize (queue->getCapacityInBytes());
 }
 
 MidiMessageCollector::~MidiMessageCollector()
@@ -34,22 +149,24 @@ MidiMessageCollector::~MidiMessageCollector()
 //==============================================================================
 void MidiMessageCollector::reset (const double newSampleRate)
 {
-    const ScopedLock sl (midiCallbackLock);
-
     jassert (newSampleRate > 0);
 
+    const SpinLock::ScopedLockType sl (consumerLock);
+
    #if JUCE_DEBUG
     hasCalledReset = true;
    #endif
     sampleRate = newSampleRate;
+
+    for (auto* q = queue.get(); q != nullptr; q = q->next.get())
+        q->popAll ([] (const uint8*, int, double) {});
+
     incomingMessages.clear();
     lastCallbackTime = Time::getMillisecondCounterHiRes();
 }
 
 void MidiMessageCollector::addMessageToQueue (const MidiMessage& message)
 {
-    const ScopedLock sl (midiCallbackLock);
-
    #if JUCE_DEBUG
     jassert (hasCalledReset); // you need to call reset() to set the correct sample rate before using this object
    #endif
@@ -58,12 +175,43 @@ void MidiMessageCollector::addMessageToQueue (const MidiMessage& message)
     // for details of what the number should be.
     jassert (message.getTimeStamp() != 0);
 
-    auto sampleNumber = (int) ((message.getTimeStamp() - 0.001 * lastCallbackTime) * sampleRate);
+    auto* data = message.getRawData();
+    auto numBytes = message.getRawDataSize();
+    auto timeStamp = message.getTimeStamp();
+
+    if (newestQueue.load (std::memory_order_acquire)->push (data, numBytes, timeStamp))
+        return;
+
+    // The queue is full, probably because nothing is removing the messages at the moment,
+    // e.g. while the audio device is stopped, or else the message is too big for it. So this
+    // does the consumer's job for a moment, and moves the messages into incomingMessages,
+    // which only keeps the ones that are less than a second older than the newest.
+    const SpinLock::ScopedLockType sl (consumerLock);
+    auto blockStartTime = 0.001 * lastCallbackTime;
 
-    incomingMessages.addEvent (message, sampleNumber);
+    moveQueuedMessagesToIncoming (blockStartTime);
+    addIncomingMessage (data, numBytes, timeStamp, blockStartTime);
+}
+
+void MidiMessageCollector::moveQueuedMessagesToIncoming (double blockStartTime)
+{
+    for (auto* q = queue.get(); q != nullptr; q = q->next.get())
+    {
+        q->popAll ([this, blockStartTime] (const uint8* data, int numBytes, double timeStamp)
+        {
+            addIncomingMessage (data, numBytes, timeStamp, blockStartTime);
+        });
+    }
+}
+
+void MidiMessageCollector::addIncomingMessage (const uint8* data, int numBytes, double timeStamp, double blockStartTime)
+{
+    auto sampleNumber = (int) ((timeStamp - blockStartTime) * sampleRate);
+
+    incomingMessages.addEvent (data, numBytes, sampleNumber);
 
     // if the messages don't get used for over a second, we'd better
-    // get rid of any old ones to avoid the queue getting too big
+    // get rid of any old ones to avoid the buffer getting too big
     if (sampleNumber > sampleRate)
         incomingMessages.clear (0, sampleNumber - (int) sampleRate);
 }
@@ -71,19 +219,26 @@ void MidiMessageCollector::addMessageToQueue (const MidiMessage& message)
 void MidiMessageCollector::removeNextBlockOfMessages (MidiBuffer& destBuffer,
                                                       const int numSamples)
 {
-    const ScopedLock sl (midiCallbackLock);
-
    #if JUCE_DEBUG
     jassert (hasCalledReset); // you need to call reset() to set the correct sample rate before using this object
    #endif
 
     jassert (numSamples > 0);
 
+    // this is only contended while a producer is dealing with a full queue, or
+    // while reset() or ensureStorageAllocated() is being called
+    const SpinLock::ScopedLockType sl (consumerLock);
+
     auto timeNow = Time::getMillisecondCounterHiRes();
     auto msElapsed = timeNow - lastCallbackTime;
+    auto blockStartTime = 0.001 * lastCallbackTime;
 
     lastCallbackTime = timeNow;
 
+    // the events are inserted by sample position, so they end up sorted by timestamp
+    // no matter which order the producers managed to add them to the queue in
+    moveQueuedMessagesToIncoming (blockStartTime);
+
     if (! incomingMessages.isEmpty())
     {
         int numSourceSamples = jmax (1, roundToInt (msElapsed * 0.001 * sampleRate));
@@ -130,6 +285,26 @@ void MidiMessageCollector::removeNextBlockOfMessages (MidiBuffer& destBuffer,
 
 void MidiMessageCollector::ensureStorageAllocated (size_t bytes)
 {
+    std::unique_ptr<MessageQueue> newQueue;
+
+    if (bytes > newestQueue.load (std::memory_order_relaxed)->getCapacityInBytes())
+        newQueue.reset (new MessageQueue (bytes));
+
+    const SpinLock::ScopedLockType sl (consumerLock);
+
+    if (newQueue != nullptr)
+    {
+        auto* oldQueue = newestQueue.load (std::memory_order_relaxed);
+
+        if (bytes > oldQueue->getCapacityInBytes())
+        {
+            // a producer may still be pushing a message into the old queue, but that's
+            // fine, because the consumer keeps on emptying it
+            oldQueue->next = std::move (newQueue);
+            newestQueue.store (oldQueue->next.get(), std::memory_order_release);
+        }
+    }
+
     incomingMessages.ensureSize (bytes);
 }
 
@@ -155,4 +330,260 @@ void MidiMessageCollector::handleIncomingMidiMessage (MidiInput*, const MidiMess
     addMessageToQueue (message);
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class MidiMessageCollectorTests  : public UnitTest
+{
+public:
+    MidiMessageCollectorTests()
+        : UnitTest ("MidiMessageCollector", UnitTestCategories::midi)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Messages are returned in timestamp order");
+        {
+            MidiMessageCollector collector;
+            collector.reset (44100.0);
+
+            auto startTime = Time::getMillisecondCounterHiRes() * 0.001;
+            Thread::sleep (50);
+
+            for (int i = 8; i > 0; --i)
+            {
+                auto m = MidiMessage::noteOn (1, i, (uint8) 100);
+                m.setTimeStamp (startTime + i * 0.005);
+                collector.addMessageToQueue (m);
+            }
+
+            MidiBuffer buffer;
+            collector.removeNextBlockOfMessages (buffer, 44100);
+
+            expectEquals (buffer.getNumEvents(), 8);
+
+            int expectedNote = 1, lastPosition = -1;
+
+            for (const auto metadata : buffer)
+            {
+                expectEquals (metadata.getMessage().getNoteNumber(), expectedNote++);
+                expect (metadata.samplePosition > lastPosition);
+                lastPosition = metadata.samplePosition;
+            }
+        }
+
+        beginTest ("Messages from several threads are all collected");
+        {
+            constexpr int numProducers = 4, numMessagesPerProducer = 1000;
+
+            MidiMessageCollector collector;
+            collector.reset (44100.0);
+
+            // the ring is smaller than all the messages, so it still wraps around, but it's
+            // big enough not to overflow if this thread is held up for a few tens of ms
+            collector.ensureStorageAllocated (128 * 1024);
+
+            std::atomic<int> numProducersFinished { 0 };
+
+            for (int producer = 0; producer < numProducers; ++producer)
+            {
+                Thread::launch ([&collector, &numProducersFinished, producer]
+                {
+                    uint8 payload[40] = {};
+                    payload[0] = (uint8) producer;
+
+                    for (int i = 0; i < numMessagesPerProducer; ++i)
+                    {
+                        // these all need three of the queue's blocks, which don't divide
+                        // its size, so some of them will have to wrap around the end
+                        payload[1] = (uint8) (i >> 7);
+                        payload[2] = (uint8) (i & 127);
+
+                        auto m = MidiMessage::createSysExMessage (payload, 33 + i % 7);
+                        m.setTimeStamp (Time::getMillisecondCounterHiRes() * 0.001);
+                        collector.addMessageToQueue (m);
+
+                        if ((i & 15) == 0)
+                            Thread::sleep (1);
+                    }
+
+                    ++numProducersFinished;
+                });
+            }
+
+            int nextExpected[numProducers] = {};
+            bool allInOrder = true;
+            MidiBuffer buffer;
+
+            for (;;)
+            {
+                auto allProducersFinished = (numProducersFinished == numProducers);
+
+                buffer.clear();
+                // a long block, so that the messages aren't squeezed out of it if this thread
+                // gets held up for a while
+                collector.removeNextBlockOfMessages (buffer, 8192);
+
+                for (const auto metadata : buffer)
+                {
+                    auto m = metadata.getMessage();
+                    auto* payload = m.getSysExData();
+                    auto& expected = nextExpected[payload[0]];
+
+                    allInOrder = allInOrder
+                                  && m.getSysExDataSize() == 33 + expected % 7
+                                  && (payload[1] << 7) + payload[2] == expected;
+                    ++expected;
+                }
+
+                if (allProducersFinished)
+                    break;
+
+                Thread::sleep (1);
+            }
+
+            expect (allInOrder);
+
+            for (auto numReceived : nextExpected)
+                expectEquals (numReceived, numMessagesPerProducer);
+        }
+
+        beginTest ("Old messages are dropped when nothing is removing them");
+        {
+            // these would need far more than the default storage, and cover three seconds
+            constexpr int numMessages = 3000;
+
+            MidiMessageCollector collector;
+            collector.reset (44100.0);
+
+            auto startTime = Time::getMillisecondCounterHiRes() * 0.001;
+
+            for (int i = 0; i < numMessages; ++i)
+                collector.addMessageToQueue (createNumberedSysEx (i, startTime + i * 0.001));
+
+            MidiBuffer buffer;
+            collector.removeNextBlockOfMessages (buffer, 44100);
+
+            // the messages from the last second are all kept, in order
+            auto numKept = buffer.getNumEvents();
+            auto expectedNumber = numMessages - numKept;
+            bool allInOrder = true;
+
+            for (const auto metadata : buffer)
+                allInOrder = allInOrder && getSysExNumber (metadata.getMessage()) == expectedNumber++;
+
+            expect (numKept >= 990 && numKept < numMessages - 1000);
+            expect (allInOrder);
+        }
+
+        beginTest ("Messages bigger than the storage are collected");
+        {
+            MidiMessageCollector collector;
+            collector.reset (44100.0);
+
+            // bigger than the default storage, but still small enough for a MidiBuffer
+            HeapBlock<uint8> payload (40000, true);
+            auto m = MidiMessage::createSysExMessage (payload, 40000);
+            m.setTimeStamp (Time::getMillisecondCounterHiRes() * 0.001);
+            collector.addMessageToQueue (m);
+
+            MidiBuffer buffer;
+            collector.removeNextBlockOfMessages (buffer, 512);
+
+            expectEquals (buffer.getNumEvents(), 1);
+
+            for (const auto metadata : buffer)
+                expectEquals (metadata.getMessage().getSysExDataSize(), 40000);
+        }
+
+        beginTest ("reset() and ensureStorageAllocated() can be called while messages are being added");
+        {
+            constexpr int numProducers = 4;
+
+            MidiMessageCollector collector;
+            collector.reset (44100.0);
+
+            std::atomic<bool> shouldStop { false };
+            std::atomic<int> numProducersFinished { 0 };
+
+            for (int producer = 0; producer < numProducers; ++producer)
+            {
+                Thread::launch ([&collector, &shouldStop, &numProducersFinished]
+                {
+                    for (int i = 0; ! shouldStop; ++i)
+                    {
+                        collector.addMessageToQueue (createNumberedSysEx (i, Time::getMillisecondCounterHiRes() * 0.001));
+
+                        if ((i & 15) == 0)
+                            Thread::sleep (1);
+                    }
+
+                    ++numProducersFinished;
+                });
+            }
+
+            bool allIntact = true;
+            MidiBuffer buffer;
+
+            for (int i = 0; i < 200; ++i)
+            {
+                if (i % 10 == 0)
+                    collector.ensureStorageAllocated ((size_t) (32768 << (i / 40)));
+
+                if (i % 7 == 0)
+                    collector.reset (44100.0);
+
+                buffer.clear();
+                collector.removeNextBlockOfMessages (buffer, 512);
+
+                for (const auto metadata : buffer)
+                    allIntact = allIntact && isIntactNumberedSysEx (metadata.getMessage());
+
+                Thread::sleep (1);
+            }
+
+            shouldStop = true;
+
+            while (numProducersFinished != numProducers)
+                Thread::yield();
+
+            expect (allIntact);
+        }
+    }
+
+private:
+    // a sysex message that needs three of the queue's blocks, with a number and a checksum in it
+    static MidiMessage createNumberedSysEx (int number, double timeStamp)
+    {
+        uint8 payload[40] = {};
+        payload[0] = (uint8) ((number >> 14) & 127);
+        payload[1] = (uint8) ((number >> 7) & 127);
+        payload[2] = (uint8) (number & 127);
+        payload[39] = (uint8) ((payload[0] + payload[1] + payload[2]) & 127);
+
+        auto m = MidiMessage::createSysExMessage (payload, (int) sizeof (payload));
+        m.setTimeStamp (timeStamp);
+        return m;
+    }
+
+    static int getSysExNumber (const MidiMessage& m)
+    {
+        auto* payload = m.getSysExData();
+        return (payload[0] << 14) + (payload[1] << 7) + payload[2];
+    }
+
+    static bool isIntactNumberedSysEx (const MidiMessage& m)
+    {
+        auto* payload = m.getSysExData();
+
+        return m.getSysExDataSize() == 40
+                && payload[39] == ((payload[0] + payload[1] + payload[2]) & 127);
+    }
+};
+
+static MidiMessageCollectorTests midiMessageCollectorTests;
+
+#endif
+
 } // namespace juce
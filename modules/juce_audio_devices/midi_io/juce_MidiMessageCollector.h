@@ -50,7 +50,9 @@ public:
     /** Clears any messages from the queue.
 
         You need to call this method before starting to use the collector, so that
-        it knows the correct sample rate to use.
+        it knows the correct sample rate to use. It's safe to call it while other
+        threads are adding or removing messages, e.g. when the audio device restarts
+        while the MIDI inputs are still open.
     */
     void reset (double sampleRate);
 
@@ -59,8 +61,13 @@ public:
         The message's timestamp is taken, and it will be ready for retrieval as part
         of the block returned by the next call to removeNextBlockOfMessages().
 
-        This method is fully thread-safe when overlapping calls are made with
-        removeNextBlockOfMessages().
+        This can be called from any number of threads at once, overlapping with calls
+        to removeNextBlockOfMessages(). The message is copied into storage that was
+        preallocated by the constructor or ensureStorageAllocated(), without locking or
+        allocating. If that storage is full, e.g. because nothing is removing the messages
+        while the audio device is stopped, or if the message is too big for it, this
+        briefly locks out the other threads while it moves the messages somewhere else,
+        throwing away any that are over a second older than the newest one.
     */
     void addMessageToQueue (const MidiMessage& message);
 
@@ -73,8 +80,12 @@ public:
         callback, because the time that it happens is used in calculating the
         midi event positions.
 
-        This method is fully thread-safe when overlapping calls are made with
-        addMessageToQueue().
+        The messages are placed in the buffer in the order of their timestamps.
+
+        This can be called while other threads are calling addMessageToQueue(), and
+        it only has to wait for them if one of them has found the storage full, or if
+        reset() or ensureStorageAllocated() is being called. Only one thread may remove
+        messages at a time.
 
         Precondition: numSamples must be greater than 0.
     */
@@ -84,7 +95,9 @@ public:
 
         This can be called before audio processing begins to ensure that there
         is sufficient space for the expected MIDI messages, in order to avoid
-        allocations within the audio callback.
+        allocations within the audio callback and addMessageToQueue() having to lock
+        when the storage fills up. Like reset(), it's safe to call this while other
+        threads are adding or removing messages.
     */
     void ensureStorageAllocated (size_t bytes);
 
@@ -99,12 +112,19 @@ public:
 
 private:
     //==============================================================================
-    double lastCallbackTime = 0;
-    CriticalSection midiCallbackLock;
+    struct MessageQueue;
+
+    void moveQueuedMessagesToIncoming (double blockStartTime);
+    void addIncomingMessage (const uint8* data, int numBytes, double timeStamp, double blockStartTime);
+
+    std::unique_ptr<MessageQueue> queue;
+    std::atomic<MessageQueue*> newestQueue;
+    SpinLock consumerLock;
     MidiBuffer incomingMessages;
+    double lastCallbackTime = 0;
     double sampleRate = 44100.0;
    #if JUCE_DEBUG
-    bool hasCalledReset = false;
+    std::atomic<bool> hasCalledReset { false };
    #endif
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MidiMessageCollector)
@@ -320,6 +320,17 @@ struct Conversion
                 return;
         }
     }
+
+    /** Converts a contiguous range of whole UMP packets, such as the contents of a
+        Packets collection or a span read from a Fifo, in the same way as the
+        single-packet version of midi2ToMidi1DefaultTranslation.
+    */
+    template <typename Callback>
+    static void midi2ToMidi1DefaultTranslation (const uint32_t* begin, const uint32_t* end, Callback&& callback)
+    {
+        for (auto* packet = begin; packet < end; packet += Utils::getNumWordsForMessageType (*packet))
+            midi2ToMidi1DefaultTranslation (View (packet), callback);
+    }
 };
 
 }
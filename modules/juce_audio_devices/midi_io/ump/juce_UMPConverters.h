@@ -43,6 +43,12 @@ namespace universal_midi_packets
         {
             Conversion::midi2ToMidi1DefaultTranslation (v, std::forward<Fn> (fn));
         }
+
+        template <typename Fn>
+        void convert (const uint32_t* begin, const uint32_t* end, Fn&& fn)
+        {
+            Conversion::midi2ToMidi1DefaultTranslation (begin, end, std::forward<Fn> (fn));
+        }
     };
 
     /**
@@ -68,6 +74,12 @@ namespace universal_midi_packets
             translator.dispatch (v, std::forward<Fn> (fn));
         }
 
+        template <typename Fn>
+        void convert (const uint32_t* begin, const uint32_t* end, Fn&& fn)
+        {
+            translator.dispatch (begin, end, std::forward<Fn> (fn));
+        }
+
         void reset()
         {
             translator.reset();
@@ -124,6 +136,19 @@ namespace universal_midi_packets
             });
         }
 
+        /** Converts a contiguous range of whole packets, such as a span read from a Fifo.
+            This only checks the protocol once for the whole range.
+        */
+        template <typename Fn>
+        void convert (const uint32_t* begin, const uint32_t* end, Fn&& fn)
+        {
+            switch (mode)
+            {
+                case PacketProtocol::MIDI_1_0: return std::get<0> (converters).convert (begin, end, std::forward<Fn> (fn));
+                case PacketProtocol::MIDI_2_0: return std::get<1> (converters).convert (begin, end, std::forward<Fn> (fn));
+            }
+        }
+
         PacketProtocol getProtocol() const noexcept { return mode; }
 
     private:
@@ -42,6 +42,9 @@ public:
 
         If the range ends part-way through a packet, the next call to `dispatch` will
         continue from that point in the packet (unless `reset` is called first).
+
+        Whole packets are passed to the callback in place, so only a packet that is
+        split across two calls gets copied.
     */
     template <typename PacketCallbackFunction>
     void dispatch (const uint32_t* begin,
@@ -49,16 +52,35 @@ public:
                    double timeStamp,
                    PacketCallbackFunction&& callback)
     {
-        std::for_each (begin, end, [&] (uint32_t word)
+        if (currentPacketLen != 0)
         {
-            nextPacket[currentPacketLen++] = word;
+            const auto numWords = Utils::getNumWordsForMessageType (nextPacket.front());
+            const auto numToCopy = std::min ((size_t) (end - begin), numWords - currentPacketLen);
 
-            if (currentPacketLen == Utils::getNumWordsForMessageType (nextPacket.front()))
-            {
-                callback (View (nextPacket.data()), timeStamp);
-                currentPacketLen = 0;
-            }
-        });
+            std::copy (begin, begin + numToCopy, nextPacket.begin() + currentPacketLen);
+            begin += numToCopy;
+            currentPacketLen += numToCopy;
+
+            if (currentPacketLen < numWords)
+                return;
+
+            callback (View (nextPacket.data()), timeStamp);
+            currentPacketLen = 0;
+        }
+
+        while (begin != end)
+        {
+            const auto numWords = Utils::getNumWordsForMessageType (*begin);
+
+            if ((size_t) (end - begin) < numWords)
+                break;
+
+            callback (View (begin), timeStamp);
+            begin += numWords;
+        }
+
+        currentPacketLen = (size_t) (end - begin);
+        std::copy (begin, end, nextPacket.begin());
     }
 
 private:
@@ -0,0 +1,188 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+namespace universal_midi_packets
+{
+
+/**
+    A lock-free, single-producer single-consumer queue of Universal MIDI Packets.
+
+    This is intended for passing packets from a device thread to the audio thread.
+    All the storage is allocated by the constructor, so pushing and reading never
+    allocate or block.
+
+    The writer only ever adds whole packets, and a packet is never split across the
+    end of the internal buffer: if it would be, the remaining words are filled with
+    NOOP utility messages (which are a single zero word), and the packet is written
+    at the start of the buffer. This means that the reader always sees contiguous
+    runs of whole packets, which can be passed directly to a Dispatcher, Iterator,
+    or one of the converters.
+
+    Only one thread may push packets, and only one thread may read them.
+
+    @tags{Audio}
+*/
+class Fifo
+{
+public:
+    /** Creates a fifo that can hold at least `minNumWords` 32-bit words. */
+    explicit Fifo (size_t minNumWords)
+        : storage ((size_t) nextPowerOfTwo ((int) std::max (minNumWords, (size_t) 4)))
+    {}
+
+    /** Adds a single packet, returning false if there wasn't enough room for it.
+
+        This must only be called by the writer thread.
+    */
+    bool push (const View& v)  { return push (v.data(), v.data() + v.size()); }
+
+    /** Adds a range of whole packets.
+
+        Either all the packets are added, or, if there isn't enough room for all of
+        them or the range ends part way through a packet, none of them are and this
+        returns false.
+
+        This must only be called by the writer thread.
+    */
+    bool push (const uint32_t* begin, const uint32_t* end)
+    {
+        const auto capacity = storage.size();
+        const auto start = writePosition.load (std::memory_order_relaxed);
+        const auto readPos = readPosition.load (std::memory_order_acquire);
+
+        for (auto* packet = begin; packet < end;)
+        {
+            const auto numWords = (ptrdiff_t) Utils::getNumWordsForMessageType (*packet);
+
+            if (numWords > end - packet)
+                return false;
+
+            packet += numWords;
+        }
+
+        const auto forEachPacket = [&] (auto&& fn)
+        {
+            auto pos = start;
+
+            for (auto* packet = begin; packet < end;)
+            {
+                const auto numWords = Utils::getNumWordsForMessageType (*packet);
+
+                const auto numBeforeWrap = capacity - (pos & (capacity - 1));
+
+                if (numBeforeWrap < numWords)
+                {
+                    fn (pos, nullptr, numBeforeWrap);
+                    pos += numBeforeWrap;
+                }
+
+                fn (pos, packet, (size_t) numWords);
+                pos += numWords;
+                packet += numWords;
+            }
+
+            return pos;
+        };
+
+        const auto newWritePosition = forEachPacket ([] (size_t, const uint32_t*, size_t) {});
+
+        if (newWritePosition - readPos > capacity)
+            return false;
+
+        forEachPacket ([this, capacity] (size_t pos, const uint32_t* packet, size_t numWords)
+        {
+            auto* dest = storage.data() + (pos & (capacity - 1));
+
+            if (packet != nullptr)
+                std::copy (packet, packet + numWords, dest);
+            else
+                std::fill (dest, dest + numWords, 0u);
+        });
+
+        writePosition.store (newWritePosition, std::memory_order_release);
+        return true;
+    }
+
+    /** Reads all the words that are ready, and frees the space they took up.
+
+        `callback` is called with a `(const uint32_t* begin, const uint32_t* end)`
+        pair for each contiguous run of packets - there will be at most two of these.
+        The memory is only valid during the callback.
+
+        This must only be called by the reader thread.
+
+        @returns the number of words that were read
+    */
+    template <typename SpanCallback>
+    size_t read (SpanCallback&& callback)
+    {
+        const auto capacity = storage.size();
+        const auto start = readPosition.load (std::memory_order_relaxed);
+        const auto end = writePosition.load (std::memory_order_acquire);
+        const auto numReady = end - start;
+
+        if (numReady == 0)
+            return 0;
+
+        const auto* data = storage.data();
+        const auto offset = start & (capacity - 1);
+        const auto numBeforeWrap = std::min (numReady, capacity - offset);
+
+        callback (data + offset, data + offset + numBeforeWrap);
+
+        if (numBeforeWrap < numReady)
+            callback (data, data + (numReady - numBeforeWrap));
+
+        readPosition.store (end, std::memory_order_release);
+        return numReady;
+    }
+
+    /** Returns the number of words waiting to be read. */
+    size_t getNumReady() const noexcept
+    {
+        return writePosition.load (std::memory_order_acquire) - readPosition.load (std::memory_order_acquire);
+    }
+
+    /** Returns the total number of words that the fifo can hold. */
+    size_t getCapacity() const noexcept     { return storage.size(); }
+
+    /** Discards any words that haven't been read.
+
+        This isn't thread-safe, so neither the reader nor the writer can be
+        using the fifo while it's called.
+    */
+    void reset() noexcept
+    {
+        readPosition = 0;
+        writePosition = 0;
+    }
+
+private:
+    std::vector<uint32_t> storage;
+    std::atomic<size_t> readPosition { 0 }, writePosition { 0 };
+};
+
+}
+}
@@ -115,6 +115,17 @@ public:
         }
     }
 
+    /** Converts a contiguous range of whole MIDI 1 Universal MIDI Packets, such as
+        the contents of a Packets collection or a span read from a Fifo, calling
+        `callback` with each converted packet.
+    */
+    template <typename PacketCallback>
+    void dispatch (const uint32_t* begin, const uint32_t* end, PacketCallback&& callback)
+    {
+        for (auto* packet = begin; packet < end; packet += Utils::getNumWordsForMessageType (*packet))
+            dispatch (View (packet), callback);
+    }
+
     void reset()
     {
         groupAccumulators = {};
@@ -873,6 +873,123 @@ public:
 
             checkMidi1ToMidi2Conversion (midi1, midi2);
         }
+
+        beginTest ("Dispatcher finds packets split across calls");
+        {
+            const auto input = createRandomPackets (random, 1000);
+            Packets found;
+            Dispatcher dispatcher;
+
+            for (auto* word = input.data(), *end = input.data() + input.size(); word < end;)
+            {
+                const auto numWords = std::min ((size_t) random.nextInt (9), (size_t) (end - word));
+                dispatcher.dispatch (word, word + numWords, 0, [&] (const View& v, double) { found.add (v); });
+                word += numWords;
+            }
+
+            checkBytestreamConversion (found, input);
+        }
+
+        beginTest ("Fifo never splits packets and fails when full");
+        {
+            Fifo fifo (6);
+            expectEquals ((int) fifo.getCapacity(), 8);
+
+            const PacketX4 packet { 0x50000000, 1, 2, 3 };
+            const PacketX1 smallPacket { 0x20901234 };
+            std::vector<std::vector<uint32_t>> spans;
+            const auto readSpans = [&] { return fifo.read ([&] (const uint32_t* b, const uint32_t* e) { spans.emplace_back (b, e); }); };
+
+            expect (fifo.push (View (packet.data())));
+            expect (fifo.push (View (packet.data())));
+            expect (! fifo.push (View (smallPacket.data())));
+            expectEquals ((int) readSpans(), 8);
+            expectEquals ((int) fifo.getNumReady(), 0);
+
+            expect (fifo.push (View (packet.data())));
+            expect (fifo.push (View (smallPacket.data())));
+            expectEquals ((int) readSpans(), 5);
+
+            // this packet doesn't fit before the end of the buffer, so the end gets padded
+            spans.clear();
+            expect (fifo.push (View (packet.data())));
+            expectEquals ((int) fifo.getNumReady(), 7);
+            expectEquals ((int) readSpans(), 7);
+
+            expectEquals ((int) spans.size(), 2);
+            expect (spans[0] == std::vector<uint32_t> { 0, 0, 0 });
+            expect (spans[1] == std::vector<uint32_t> { 0x50000000, 1, 2, 3 });
+
+            // a range which ends part way through a packet is rejected as a whole
+            const uint32_t truncated[] { 0x20901234, 0x50000000, 1 };
+            expect (! fifo.push (truncated, truncated + 3));
+            expectEquals ((int) fifo.getNumReady(), 0);
+            expect (fifo.push (truncated, truncated + 1));
+            expectEquals ((int) fifo.getNumReady(), 1);
+        }
+
+        beginTest ("Fifo passes packets between threads");
+        {
+            const auto input = createRandomPackets (random, 5000);
+            Fifo fifo (256);
+
+            WaitableEvent writerFinished;
+
+            Thread::launch ([&]
+            {
+                for (auto* word = input.data(), *end = input.data() + input.size(); word < end;)
+                {
+                    const auto numWords = Utils::getNumWordsForMessageType (*word);
+
+                    while (! fifo.push (word, word + numWords))
+                        Thread::sleep (1);
+
+                    word += numWords;
+                }
+
+                writerFinished.signal();
+            });
+
+            Packets received;
+
+            while (received.size() < input.size())
+            {
+                const auto numRead = fifo.read ([&] (const uint32_t* b, const uint32_t* e)
+                {
+                    for (auto* word = b; word < e; word += Utils::getNumWordsForMessageType (*word))
+                    {
+                        expect (word + Utils::getNumWordsForMessageType (*word) <= e);
+
+                        if (*word != 0)
+                            received.add (View (word));
+                    }
+                });
+
+                if (numRead == 0)
+                    Thread::sleep (1);
+            }
+
+            writerFinished.wait();
+            checkBytestreamConversion (received, input);
+        }
+
+        beginTest ("Converting a range of packets matches converting them one by one");
+        {
+            const auto input = createRandomPackets (random, 1000);
+
+            for (auto protocol : { PacketProtocol::MIDI_1_0, PacketProtocol::MIDI_2_0 })
+            {
+                GenericUMPConverter individually (protocol), asRange (protocol);
+                Packets expected, actual;
+
+                for (const auto& packet : input)
+                    individually.convert (packet, [&] (const View& v) { expected.add (v); });
+
+                asRange.convert (input.data(), input.data() + input.size(), [&] (const View& v) { actual.add (v); });
+
+                checkBytestreamConversion (actual, expected);
+            }
+        }
     }
 
 private:
@@ -932,6 +1049,29 @@ private:
         return MidiMessage::createSysExMessage (data.data(), int (data.size()));
     }
 
+    // Creates a stream of random packets of all sizes, none of which are utility messages
+    static Packets createRandomPackets (Random& random, int numPackets)
+    {
+        Packets packets;
+
+        for (int i = 0; i < numPackets; ++i)
+        {
+            const auto randomWord = [&] { return (uint32_t) random.nextInt(); };
+            const auto messageType = (uint32_t) (1 + random.nextInt (5));
+            const auto firstWord = (messageType << 0x1c) | (randomWord() & 0x0fffffff);
+
+            switch (Utils::getNumWordsForMessageType (firstWord))
+            {
+                case 1:  packets.add (PacketX1 { firstWord }); break;
+                case 2:  packets.add (PacketX2 { firstWord, randomWord() }); break;
+                case 3:  packets.add (PacketX3 { firstWord, randomWord(), randomWord() }); break;
+                default: packets.add (PacketX4 { firstWord, randomWord(), randomWord(), randomWord() }); break;
+            }
+        }
+
+        return packets;
+    }
+
     PacketX1 createRandomUtilityUMP (Random& random)
     {
         const auto status = random.nextInt (3);
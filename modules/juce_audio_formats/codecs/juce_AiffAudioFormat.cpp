@@ -924,6 +924,8 @@ public:
 
     using AudioFormatReader::readMaxLevels;
 
+    bool isLittleEndian() const noexcept override           { return littleEndian; }
+
 private:
     const bool littleEndian;
 
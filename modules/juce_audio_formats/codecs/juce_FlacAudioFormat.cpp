@@ -166,6 +166,22 @@ namespace FlacNamespace
 //==============================================================================
 static const char* const flacFormatName = "FLAC file";
 
+// the CRC-8 that ends a frame header
+static uint8 getFlacFrameHeaderCRC (const uint8* data, size_t size) noexcept
+{
+    uint8 crc = 0;
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        crc ^= data[i];
+
+        for (int bit = 0; bit < 8; ++bit)
+            crc = (uint8) ((crc & 0x80) != 0 ? (crc << 1) ^ 0x07 : crc << 1);
+    }
+
+    return crc;
+}
+
 
 //==============================================================================
 class FlacReader  : public AudioFormatReader
@@ -212,6 +228,7 @@ public:
         bitsPerSample = info.bits_per_sample;
         lengthInSamples = (unsigned int) info.total_samples;
         numChannels = info.channels;
+        minFrameSize = (int) info.min_framesize;
 
         reservoir.setSize ((int) numChannels, 2 * (int) info.max_blocksize, false, false, true);
     }
@@ -249,6 +266,10 @@ public:
                 {
                     samplesInReservoir = 0;
                 }
+                else if (! frameIndex.isEmpty())
+                {
+                    decodeFrameContaining (startSampleInFile);
+                }
                 else if (startSampleInFile < reservoirStart
                           || startSampleInFile > reservoirStart + jmax (samplesInReservoir, (int64) 511))
                 {
@@ -314,6 +335,247 @@ public:
         }
     }
 
+    //==============================================================================
+    /*  The frame index holds the position of every frame in the stream, so that a read
+        can jump straight to the frame it needs instead of letting libFLAC search for it,
+        which involves a lot of frame syncing when the stream has no seek table.
+    */
+    struct IndexedFrame
+    {
+        int64 firstSample, streamPosition;
+    };
+
+    enum
+    {
+        frameIndexMagicNumber = 0x49434c66, // "fLCI"
+        frameIndexVersion = 1
+    };
+
+    // Builds the index by scanning the frame headers, without decoding the audio
+    bool buildFrameIndex()
+    {
+        FlacNamespace::FLAC__uint64 firstFramePosition = 0;
+
+        if (! (ok && FLAC__stream_decoder_get_decode_position (decoder, &firstFramePosition)))
+            return false;
+
+        auto oldPosition = input->getPosition();
+        auto succeeded = scanFrameHeaders ((int64) firstFramePosition);
+        input->setPosition (oldPosition);
+
+        if (! succeeded)
+            frameIndex.clear();
+
+        return succeeded;
+    }
+
+    bool loadFrameIndex (InputStream& source)
+    {
+        frameIndex.clear();
+
+        if (! SavedFrameIndex::readHeader (source, frameIndexMagicNumber, frameIndexVersion, input->getTotalLength())
+             || source.readInt64() != lengthInSamples)
+            return false;
+
+        auto numFrames = source.readInt();
+
+        if (numFrames <= 0 || numFrames > lengthInSamples)
+            return false;
+
+        frameIndex.ensureStorageAllocated (numFrames);
+        SavedFrameIndex::IncreasingValues firstSamples (lengthInSamples), streamPositions (input->getTotalLength());
+
+        for (int i = 0; i < numFrames; ++i)
+        {
+            IndexedFrame frame;
+
+            if (! (firstSamples.read (source, frame.firstSample) && streamPositions.read (source, frame.streamPosition)))
+                break;
+
+            frameIndex.add (frame);
+        }
+
+        if (frameIndex.size() != numFrames || frameIndex.getFirst().firstSample != 0)
+        {
+            frameIndex.clear();
+            return false;
+        }
+
+        return true;
+    }
+
+    bool saveFrameIndex (OutputStream& dest) const
+    {
+        if (frameIndex.isEmpty())
+            return false;
+
+        if (! (SavedFrameIndex::writeHeader (dest, frameIndexMagicNumber, frameIndexVersion, input->getTotalLength())
+                && dest.writeInt64 (lengthInSamples)
+                && dest.writeInt (frameIndex.size())))
+            return false;
+
+        for (auto& frame : frameIndex)
+            if (! (dest.writeInt64 (frame.firstSample) && dest.writeInt64 (frame.streamPosition)))
+                return false;
+
+        return true;
+    }
+
+    void decodeFrameContaining (int64 sample)
+    {
+        auto frame = (int) (std::upper_bound (frameIndex.begin(), frameIndex.end(), sample,
+                                              [] (int64 s, const IndexedFrame& f) { return s < f.firstSample; })
+                             - frameIndex.begin()) - 1;
+
+        // If this isn't the frame that the decoder is about to read anyway, the input is moved
+        // to it, and the decoder's buffered data is discarded so it'll start again from there.
+        if (frame != nextIndexedFrame)
+        {
+            input->setPosition (frameIndex.getReference (frame).streamPosition);
+            FLAC__stream_decoder_flush (decoder);
+        }
+
+        reservoirStart = frameIndex.getReference (frame).firstSample;
+        samplesInReservoir = 0;
+        FLAC__stream_decoder_process_single (decoder);
+
+        // A saved index can pass the checks in loadFrameIndex() and still point somewhere
+        // other than the start of the frame, in which case the decoder syncs to a different
+        // frame or none at all. Then the index can't be trusted, so it's dropped and
+        // libFLAC does the seeking from now on.
+        if (samplesInReservoir == 0 || decodedFrameStart != reservoirStart)
+        {
+            frameIndex.clear();
+            reservoirStart = sample & ~(int64) 511;
+            samplesInReservoir = 0;
+            FLAC__stream_decoder_seek_absolute (decoder, (FlacNamespace::FLAC__uint64) reservoirStart);
+            return;
+        }
+
+        nextIndexedFrame = frame + 1;
+    }
+
+    bool scanFrameHeaders (int64 firstFramePosition)
+    {
+        constexpr int bufferSize = 65536, maxHeaderSize = 16;
+        HeapBlock<uint8> buffer (bufferSize);
+        int64 bufferStart = 0;
+        int bufferLength = 0;
+
+        // returns the number of bytes available in the buffer from this position
+        auto fillBuffer = [&] (int64 position, int numNeeded)
+        {
+            if (position < bufferStart || position + numNeeded > bufferStart + bufferLength)
+            {
+                input->setPosition (position);
+                bufferStart = position;
+                bufferLength = jmax (0, input->read (buffer, bufferSize));
+            }
+
+            return (int) jmax ((int64) 0, bufferStart + bufferLength - position);
+        };
+
+        frameIndex.clearQuick();
+        int64 nextSample = 0;
+        auto position = firstFramePosition;
+
+        while (nextSample < lengthInSamples)
+        {
+            auto available = fillBuffer (position, maxHeaderSize);
+
+            if (available < 2)
+                break;
+
+            auto* start = buffer + (position - bufferStart);
+            auto* syncByte = static_cast<const uint8*> (memchr (start, 0xff, (size_t) available - 1));
+
+            if (syncByte == nullptr)
+            {
+                position += available - 1;
+                continue;
+            }
+
+            position += syncByte - start;
+            available = fillBuffer (position, maxHeaderSize);
+
+            FrameHeader header;
+
+            if (parseFrameHeader (buffer + (position - bufferStart), available, header)
+                 && header.number == (header.isVariableBlockSize ? (uint64) nextSample : (uint64) frameIndex.size()))
+            {
+                frameIndex.add ({ nextSample, position });
+                nextSample += header.blockSize;
+                position += jmax (minFrameSize, header.size + 3);
+            }
+            else
+            {
+                ++position;
+            }
+        }
+
+        return nextSample == lengthInSamples && lengthInSamples > 0;
+    }
+
+    struct FrameHeader
+    {
+        int size = 0, blockSize = 0;
+        uint64 number = 0;
+        bool isVariableBlockSize = false;
+    };
+
+    static bool parseFrameHeader (const uint8* data, int available, FrameHeader& header)
+    {
+        if (available < 6 || data[0] != 0xff || (data[1] & 0xfe) != 0xf8)
+            return false;
+
+        auto blockSizeCode = data[2] >> 4;
+        auto sampleRateCode = data[2] & 0x0f;
+        auto channelCode = data[3] >> 4;
+        auto sampleSizeCode = (data[3] >> 1) & 7;
+
+        if (blockSizeCode == 0 || sampleRateCode == 15 || channelCode > 10
+             || sampleSizeCode == 3 || sampleSizeCode == 7 || (data[3] & 1) != 0)
+            return false;
+
+        header.isVariableBlockSize = (data[1] & 1) != 0;
+
+        // the frame or sample number is coded like a UTF-8 character
+        int numberSize = 1;
+
+        for (auto b = data[4]; (b & 0xc0) == 0xc0 && numberSize < 8; b = (uint8) (b << 1))
+            ++numberSize;
+
+        if ((data[4] & 0xc0) == 0x80 || numberSize > (header.isVariableBlockSize ? 7 : 6))
+            return false;
+
+        auto extraBlockSizeBytes = blockSizeCode == 6 ? 1 : (blockSizeCode == 7 ? 2 : 0);
+        auto extraSampleRateBytes = sampleRateCode == 12 ? 1 : (sampleRateCode == 13 || sampleRateCode == 14 ? 2 : 0);
+        header.size = 4 + numberSize + extraBlockSizeBytes + extraSampleRateBytes + 1;
+
+        if (header.size > available)
+            return false;
+
+        header.number = numberSize == 1 ? data[4] : (uint64) (data[4] & (0x7f >> numberSize));
+
+        for (int i = 1; i < numberSize; ++i)
+        {
+            if ((data[4 + i] & 0xc0) != 0x80)
+                return false;
+
+            header.number = (header.number << 6) | (uint64) (data[4 + i] & 0x3f);
+        }
+
+        auto* extra = data + 4 + numberSize;
+
+        if (blockSizeCode == 1)         header.blockSize = 192;
+        else if (blockSizeCode <= 5)    header.blockSize = 576 << (blockSizeCode - 2);
+        else if (blockSizeCode == 6)    header.blockSize = extra[0] + 1;
+        else if (blockSizeCode == 7)    header.blockSize = ((extra[0] << 8) | extra[1]) + 1;
+        else                            header.blockSize = 256 << (blockSizeCode - 8);
+
+        return getFlacFrameHeaderCRC (data, (size_t) header.size - 1) == data[header.size - 1];
+    }
+
     //==============================================================================
     static FlacNamespace::FLAC__StreamDecoderReadStatus readCallback_ (const FlacNamespace::FLAC__StreamDecoder*, FlacNamespace::FLAC__byte buffer[], size_t* bytes, void* client_data)
     {
@@ -349,7 +611,9 @@ public:
                                                                          const FlacNamespace::FLAC__int32* const buffer[],
                                                                          void* client_data)
     {
-        static_cast<FlacReader*> (client_data)->useSamples (buffer, (int) frame->header.blocksize);
+        auto* reader = static_cast<FlacReader*> (client_data);
+        reader->decodedFrameStart = (int64) frame->header.number.sample_number;
+        reader->useSamples (buffer, (int) frame->header.blocksize);
         return FlacNamespace::FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
     }
 
@@ -367,7 +631,9 @@ public:
 private:
     FlacNamespace::FLAC__StreamDecoder* decoder;
     AudioBuffer<float> reservoir;
-    int64 reservoirStart = 0, samplesInReservoir = 0;
+    int64 reservoirStart = 0, samplesInReservoir = 0, decodedFrameStart = -1;
+    Array<IndexedFrame> frameIndex;
+    int nextIndexedFrame = 0, minFrameSize = 0;
     bool ok = false, scanningForLength = false;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlacReader)
@@ -378,34 +644,51 @@ private:
 class FlacWriter  : public AudioFormatWriter
 {
 public:
-    FlacWriter (OutputStream* out, double rate, uint32 numChans, uint32 bits, int qualityOptionIndex)
+    FlacWriter (OutputStream* out, double rate, uint32 numChans, uint32 bits, int qualityOptionIndex,
+                ThreadPool* pool = nullptr)
         : AudioFormatWriter (out, flacFormatName, rate, numChans, bits),
-          streamStartPos (output != nullptr ? jmax (output->getPosition(), 0ll) : 0ll)
+          streamStartPos (output != nullptr ? jmax (output->getPosition(), 0ll) : 0ll),
+          quality (qualityOptionIndex),
+          threadPool (pool)
     {
         encoder = FlacNamespace::FLAC__stream_encoder_new();
+        configureEncoder (encoder);
 
-        if (qualityOptionIndex > 0)
-            FLAC__stream_encoder_set_compression_level (encoder, (uint32) jmin (8, qualityOptionIndex));
-
-        FLAC__stream_encoder_set_do_mid_side_stereo (encoder, numChannels == 2);
-        FLAC__stream_encoder_set_loose_mid_side_stereo (encoder, numChannels == 2);
-        FLAC__stream_encoder_set_channels (encoder, numChannels);
-        FLAC__stream_encoder_set_bits_per_sample (encoder, jmin ((unsigned int) 24, bitsPerSample));
-        FLAC__stream_encoder_set_sample_rate (encoder, (unsigned int) sampleRate);
-        FLAC__stream_encoder_set_blocksize (encoder, 0);
-        FLAC__stream_encoder_set_do_escape_coding (encoder, true);
-
-        ok = FLAC__stream_encoder_init_stream (encoder,
-                                               encodeWriteCallback, encodeSeekCallback,
-                                               encodeTellCallback, encodeMetadataCallback,
-                                               this) == FlacNamespace::FLAC__STREAM_ENCODER_INIT_STATUS_OK;
+        if (threadPool != nullptr)
+        {
+            // The chunks are encoded separately, so the frames all need to be the same size
+            // for their numbers to follow on. This is the size libFLAC would pick by default.
+            blockSize = FlacNamespace::FLAC__stream_encoder_get_max_lpc_order (encoder) == 0 ? 1152 : 4096;
+            FlacNamespace::FLAC__stream_encoder_set_blocksize (encoder, blockSize);
+
+            // this encoder is only used to check that the settings are valid
+            ok = FLAC__stream_encoder_init_stream (encoder, chunkWriteCallback, nullptr, nullptr, nullptr, nullptr)
+                    == FlacNamespace::FLAC__STREAM_ENCODER_INIT_STATUS_OK
+                  && output != nullptr
+                  && writeParallelStreamHeader();
+
+           #if JUCE_INCLUDE_FLAC_CODE || ! defined (JUCE_INCLUDE_FLAC_CODE)
+            FlacNamespace::FLAC__MD5Init (&md5);
+           #endif
+        }
+        else
+        {
+            ok = FLAC__stream_encoder_init_stream (encoder,
+                                                   encodeWriteCallback, encodeSeekCallback,
+                                                   encodeTellCallback, encodeMetadataCallback,
+                                                   this) == FlacNamespace::FLAC__STREAM_ENCODER_INIT_STATUS_OK;
+        }
     }
 
     ~FlacWriter() override
     {
         if (ok)
         {
-            FlacNamespace::FLAC__stream_encoder_finish (encoder);
+            if (threadPool != nullptr)
+                finishParallelEncoding();
+            else
+                FlacNamespace::FLAC__stream_encoder_finish (encoder);
+
             output->flush();
         }
         else
@@ -423,6 +706,9 @@ public:
         if (! ok)
             return false;
 
+        if (threadPool != nullptr)
+            return writeParallel (samplesToWrite, numSamples);
+
         HeapBlock<int*> channels;
         HeapBlock<int> temp;
         auto bitsToShift = 32 - (int) bitsPerSample;
@@ -532,8 +818,374 @@ public:
     bool ok = false;
 
 private:
+    //==============================================================================
+    void configureEncoder (FlacNamespace::FLAC__StreamEncoder* e) const
+    {
+        using namespace FlacNamespace;
+
+        if (quality > 0)
+            FLAC__stream_encoder_set_compression_level (e, (uint32) jmin (8, quality));
+
+        FLAC__stream_encoder_set_do_mid_side_stereo (e, numChannels == 2);
+        FLAC__stream_encoder_set_loose_mid_side_stereo (e, numChannels == 2);
+        FLAC__stream_encoder_set_channels (e, numChannels);
+        FLAC__stream_encoder_set_bits_per_sample (e, jmin ((unsigned int) 24, bitsPerSample));
+        FLAC__stream_encoder_set_sample_rate (e, (unsigned int) sampleRate);
+        FLAC__stream_encoder_set_blocksize (e, blockSize);
+        FLAC__stream_encoder_set_do_escape_coding (e, true);
+    }
+
+    //==============================================================================
+    struct Chunk
+    {
+        Chunk (uint32 numChans, int size)  : capacity (size)
+        {
+            samples.malloc ((size_t) numChans * (size_t) capacity);
+        }
+
+        const FlacNamespace::FLAC__int32* getChannel (uint32 channel) const noexcept    { return samples + channel * (size_t) capacity; }
+        FlacNamespace::FLAC__int32* getChannel (uint32 channel) noexcept                { return samples + channel * (size_t) capacity; }
+
+        const int capacity;
+        HeapBlock<FlacNamespace::FLAC__int32> samples;
+        int numSamples = 0;
+        uint32 firstFrameNumber = 0;
+
+        MemoryOutputStream encodedFrames;
+        Array<int> frameSizes;
+        bool encodedOk = false;
+        WaitableEvent finished { true };
+    };
+
+    enum
+    {
+        numFramesPerChunk = 64,
+        numSeekPoints = 256,
+        seekPointSize = 18,
+        metadataBlockHeaderSize = 4
+    };
+
+    int getChunkSize() const noexcept     { return numFramesPerChunk * (int) blockSize; }
+
+    bool writeParallelStreamHeader()
+    {
+        using namespace FlacNamespace;
+
+        // The STREAMINFO block is filled in at the end, and the SEEKTABLE starts out
+        // full of placeholder points, some of which get replaced by real ones.
+        MemoryOutputStream header;
+        header.write ("fLaC", 4);
+        header.writeIntBigEndian (FLAC__STREAM_METADATA_STREAMINFO_LENGTH);
+        header.writeRepeatedByte (0, FLAC__STREAM_METADATA_STREAMINFO_LENGTH);
+        header.writeIntBigEndian ((int) ((0x80u | FLAC__METADATA_TYPE_SEEKTABLE) << 24) | (numSeekPoints * seekPointSize));
+
+        for (int i = 0; i < numSeekPoints; ++i)
+        {
+            header.writeInt64BigEndian ((int64) FLAC__STREAM_METADATA_SEEKPOINT_PLACEHOLDER);
+            header.writeRepeatedByte (0, seekPointSize - 8);
+        }
+
+        framesStartPos = streamStartPos + (int64) header.getDataSize();
+        return output->write (header.getData(), header.getDataSize());
+    }
+
+    bool writeParallel (const int** samplesToWrite, int numSamples)
+    {
+        auto bitsToShift = 32 - (int) bitsPerSample;
+        auto chunkSize = getChunkSize();
+
+        for (int done = 0; done < numSamples;)
+        {
+            if (currentChunk == nullptr)
+                currentChunk.reset (new Chunk (numChannels, chunkSize));
+
+            auto num = jmin (numSamples - done, chunkSize - currentChunk->numSamples);
+
+            for (uint32 i = 0; i < numChannels; ++i)
+            {
+                auto* dest = currentChunk->getChannel (i) + currentChunk->numSamples;
+
+                if (auto* src = samplesToWrite[i])
+                {
+                    for (int j = 0; j < num; ++j)
+                        dest[j] = src[done + j] >> bitsToShift;
+                }
+                else
+                {
+                    zeromem (dest, (size_t) num * sizeof (*dest));
+                }
+            }
+
+            currentChunk->numSamples += num;
+            done += num;
+
+            if (currentChunk->numSamples == chunkSize)
+                startEncodingCurrentChunk();
+
+            if (! writeFinishedChunks (2 * threadPool->getNumThreads()))
+                return false;
+        }
+
+        return true;
+    }
+
+    void startEncodingCurrentChunk()
+    {
+        auto* chunk = pendingChunks.add (currentChunk.release());
+
+        chunk->firstFrameNumber = numFramesStarted;
+        numFramesStarted += (uint32) ((chunk->numSamples + (int) blockSize - 1) / (int) blockSize);
+        totalSamples += (uint64) chunk->numSamples;
+
+       #if JUCE_INCLUDE_FLAC_CODE || ! defined (JUCE_INCLUDE_FLAC_CODE)
+        // the MD5 has to be worked out in order, so it's done here rather than by the encoders
+        const FlacNamespace::FLAC__int32* channels[FLAC__MAX_CHANNELS] = {};
+
+        for (uint32 i = 0; i < numChannels; ++i)
+            channels[i] = chunk->getChannel (i);
+
+        FlacNamespace::FLAC__MD5Accumulate (&md5, channels, numChannels, (unsigned) chunk->numSamples,
+                                            (jmin ((unsigned int) 24, bitsPerSample) + 7) / 8);
+       #endif
+
+        threadPool->addJob ([this, chunk]
+        {
+            encodeChunk (*chunk);
+            chunk->finished.signal();
+        });
+    }
+
+    // Writes out any chunks at the front of the queue that have been encoded, and then
+    // waits for more of them until no more than the given number are still pending.
+    bool writeFinishedChunks (int maxNumPending)
+    {
+        while (! pendingChunks.isEmpty())
+        {
+            auto& chunk = *pendingChunks.getFirst();
+
+            if (pendingChunks.size() <= maxNumPending && ! chunk.finished.wait (0))
+                break;
+
+            chunk.finished.wait();
+            writeFailed = writeFailed || ! writeEncodedChunk (chunk);
+            pendingChunks.remove (0);
+        }
+
+        return ! writeFailed;
+    }
+
+    bool writeEncodedChunk (const Chunk& chunk)
+    {
+        if (writeFailed || ! chunk.encodedOk)
+            return false;
+
+        for (auto size : chunk.frameSizes)
+        {
+            frameOffsets.add (numFrameBytesWritten);
+            numFrameBytesWritten += size;
+            minFrameSize = jmin (minFrameSize, (uint32) size);
+            maxFrameSize = jmax (maxFrameSize, (uint32) size);
+        }
+
+        return output->write (chunk.encodedFrames.getData(), chunk.encodedFrames.getDataSize());
+    }
+
+    void encodeChunk (Chunk& chunk) const
+    {
+        using namespace FlacNamespace;
+
+        const FLAC__int32* channels[FLAC__MAX_CHANNELS] = {};
+
+        for (uint32 i = 0; i < numChannels; ++i)
+            channels[i] = chunk.getChannel (i);
+
+        auto* e = FLAC__stream_encoder_new();
+        configureEncoder (e);
+        FLAC__stream_encoder_set_do_md5 (e, false);
+
+        chunk.encodedOk = FLAC__stream_encoder_init_stream (e, chunkWriteCallback, nullptr, nullptr, nullptr, &chunk)
+                             == FLAC__STREAM_ENCODER_INIT_STATUS_OK
+                           && FLAC__stream_encoder_process (e, channels, (unsigned) chunk.numSamples) != 0
+                           && FLAC__stream_encoder_finish (e) != 0
+                           && (int) chunk.frameSizes.size() * (int) blockSize >= chunk.numSamples;
+
+        FLAC__stream_encoder_delete (e);
+    }
+
+    void finishParallelEncoding()
+    {
+        if (currentChunk != nullptr && currentChunk->numSamples > 0)
+            startEncodingCurrentChunk();
+
+        using namespace FlacNamespace;
+
+        FLAC__StreamMetadata metadata;
+        zerostruct (metadata);
+        metadata.type = FLAC__METADATA_TYPE_STREAMINFO;
+
+        auto& info = metadata.data.stream_info;
+
+       #if JUCE_INCLUDE_FLAC_CODE || ! defined (JUCE_INCLUDE_FLAC_CODE)
+        FLAC__MD5Final (info.md5sum, &md5);
+       #endif
+
+        if (! writeFinishedChunks (0))
+            return;
+
+        info.min_blocksize = blockSize;
+        info.max_blocksize = blockSize;
+        info.min_framesize = frameOffsets.isEmpty() ? 0 : minFrameSize;
+        info.max_framesize = maxFrameSize;
+        info.sample_rate = (unsigned int) sampleRate;
+        info.channels = numChannels;
+        info.bits_per_sample = jmin ((unsigned int) 24, bitsPerSample);
+        info.total_samples = totalSamples;
+
+        writeMetaData (&metadata);
+        writeSeekTable();
+    }
+
+    void writeSeekTable()
+    {
+        // spreads the points evenly through the stream, leaving any spare ones as placeholders
+        auto numFrames = frameOffsets.size();
+        auto numPoints = jmin ((int) numSeekPoints, numFrames);
+
+        output->setPosition (framesStartPos - numSeekPoints * seekPointSize);
+
+        for (int i = 0; i < numPoints; ++i)
+        {
+            auto frame = (int) ((int64) i * numFrames / numPoints);
+            auto firstSample = (uint64) frame * blockSize;
+
+            output->writeInt64BigEndian ((int64) firstSample);
+            output->writeInt64BigEndian (frameOffsets.getUnchecked (frame));
+            output->writeShortBigEndian ((short) jmin ((uint64) blockSize, totalSamples - firstSample));
+        }
+    }
+
+    //==============================================================================
+    static uint16 updateFrameCRC16 (uint16 crc, const uint8* data, size_t size) noexcept
+    {
+        static const auto table = []
+        {
+            std::array<uint16, 256> t;
+
+            for (int i = 0; i < 256; ++i)
+            {
+                auto value = (uint16) (i << 8);
+
+                for (int bit = 0; bit < 8; ++bit)
+                    value = (uint16) ((value & 0x8000) != 0 ? (value << 1) ^ 0x8005 : value << 1);
+
+                t[(size_t) i] = value;
+            }
+
+            return t;
+        }();
+
+        for (size_t i = 0; i < size; ++i)
+            crc = (uint16) ((crc << 8) ^ table[(size_t) ((crc >> 8) ^ data[i])]);
+
+        return crc;
+    }
+
+    // Copies a frame that was encoded as part of a chunk, replacing the frame number in
+    // its header with its number in the whole stream, and updating its checksums.
+    static bool appendRenumberedFrame (MemoryOutputStream& out, const uint8* frame, size_t size, uint32 frameNumber)
+    {
+        if (size < 7 || frame[0] != 0xff || (frame[1] & 0xfe) != 0xf8)
+            return false;
+
+        size_t numberSize = 1;
+
+        for (auto b = frame[4]; (b & 0xc0) == 0xc0; b = (uint8) (b << 1))
+            ++numberSize;
+
+        auto blockSizeCode = frame[2] >> 4;
+        auto sampleRateCode = frame[2] & 0x0f;
+        auto numExtraBytes = (size_t) ((blockSizeCode == 6 ? 1 : (blockSizeCode == 7 ? 2 : 0))
+                                        + (sampleRateCode == 12 ? 1 : (sampleRateCode == 13 || sampleRateCode == 14 ? 2 : 0)));
+
+        auto oldHeaderSize = 4 + numberSize + numExtraBytes + 1;
+
+        if (oldHeaderSize + 2 > size)
+            return false;
+
+        uint8 header[16];
+        memcpy (header, frame, 4);
+        auto headerSize = 4 + writeFrameNumber (header + 4, frameNumber);
+        memcpy (header + headerSize, frame + 4 + numberSize, numExtraBytes);
+        headerSize += numExtraBytes;
+        header[headerSize] = getFlacFrameHeaderCRC (header, headerSize);
+        ++headerSize;
+
+        auto* body = frame + oldHeaderSize;
+        auto bodySize = size - oldHeaderSize - 2;
+        auto crc = updateFrameCRC16 (updateFrameCRC16 (0, header, headerSize), body, bodySize);
+
+        return out.write (header, headerSize)
+            && out.write (body, bodySize)
+            && out.writeShortBigEndian ((short) crc);
+    }
+
+    // frame numbers are stored in the same way as UTF-8 characters
+    static size_t writeFrameNumber (uint8* dest, uint32 n) noexcept
+    {
+        if (n < 0x80)
+        {
+            dest[0] = (uint8) n;
+            return 1;
+        }
+
+        size_t numExtraBytes = n < 0x800 ? 1 : (n < 0x10000 ? 2 : (n < 0x200000 ? 3 : (n < 0x4000000 ? 4 : 5)));
+        dest[0] = (uint8) (((0xff00 >> (numExtraBytes + 1)) & 0xff) | (n >> (6 * numExtraBytes)));
+
+        for (size_t i = 1; i <= numExtraBytes; ++i)
+            dest[i] = (uint8) (0x80 | ((n >> (6 * (numExtraBytes - i))) & 0x3f));
+
+        return numExtraBytes + 1;
+    }
+
+    static FlacNamespace::FLAC__StreamEncoderWriteStatus chunkWriteCallback (const FlacNamespace::FLAC__StreamEncoder*,
+                                                                             const FlacNamespace::FLAC__byte buffer[],
+                                                                             size_t bytes,
+                                                                             unsigned int samples,
+                                                                             unsigned int /*current_frame*/,
+                                                                             void* client_data)
+    {
+        // the stream header and metadata are written with a sample count of zero
+        if (samples == 0 || client_data == nullptr)
+            return FlacNamespace::FLAC__STREAM_ENCODER_WRITE_STATUS_OK;
+
+        auto& chunk = *static_cast<Chunk*> (client_data);
+        auto sizeBefore = chunk.encodedFrames.getDataSize();
+
+        if (! appendRenumberedFrame (chunk.encodedFrames, buffer, bytes, chunk.firstFrameNumber + (uint32) chunk.frameSizes.size()))
+            return FlacNamespace::FLAC__STREAM_ENCODER_WRITE_STATUS_FATAL_ERROR;
+
+        chunk.frameSizes.add ((int) (chunk.encodedFrames.getDataSize() - sizeBefore));
+        return FlacNamespace::FLAC__STREAM_ENCODER_WRITE_STATUS_OK;
+    }
+
+    //==============================================================================
     FlacNamespace::FLAC__StreamEncoder* encoder;
     int64 streamStartPos;
+    int quality;
+    uint32 blockSize = 0;
+
+    ThreadPool* threadPool;
+    std::unique_ptr<Chunk> currentChunk;
+    OwnedArray<Chunk> pendingChunks;
+    Array<int64> frameOffsets;
+    int64 framesStartPos = 0, numFrameBytesWritten = 0;
+    uint64 totalSamples = 0;
+    uint32 numFramesStarted = 0, minFrameSize = 0xffffffff, maxFrameSize = 0;
+    bool writeFailed = false;
+
+   #if JUCE_INCLUDE_FLAC_CODE || ! defined (JUCE_INCLUDE_FLAC_CODE)
+    FlacNamespace::FLAC__MD5Context md5;
+   #endif
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlacWriter)
 };
@@ -571,6 +1223,33 @@ AudioFormatReader* FlacAudioFormat::createReaderFor (InputStream* in, const bool
     return nullptr;
 }
 
+AudioFormatReader* FlacAudioFormat::createIndexedReaderFor (InputStream* in, const bool deleteStreamIfOpeningFails,
+                                                            InputStream* savedFrameIndex)
+{
+    std::unique_ptr<FlacReader> r (new FlacReader (in));
+
+    if (r->sampleRate > 0)
+    {
+        if (savedFrameIndex == nullptr || ! r->loadFrameIndex (*savedFrameIndex))
+            r->buildFrameIndex();
+
+        return r.release();
+    }
+
+    if (! deleteStreamIfOpeningFails)
+        r->input = nullptr;
+
+    return nullptr;
+}
+
+bool FlacAudioFormat::writeFrameIndex (const AudioFormatReader& reader, OutputStream& destStream)
+{
+    if (auto* r = dynamic_cast<const FlacReader*> (&reader))
+        return r->saveFrameIndex (destStream);
+
+    return false;
+}
+
 AudioFormatWriter* FlacAudioFormat::createWriterFor (OutputStream* out,
                                                      double sampleRate,
                                                      unsigned int numberOfChannels,
@@ -589,11 +1268,274 @@ AudioFormatWriter* FlacAudioFormat::createWriterFor (OutputStream* out,
     return nullptr;
 }
 
+AudioFormatWriter* FlacAudioFormat::createParallelWriterFor (OutputStream* out,
+                                                             double sampleRate,
+                                                             unsigned int numberOfChannels,
+                                                             int bitsPerSample,
+                                                             const StringPairArray& /*metadataValues*/,
+                                                             int qualityOptionIndex,
+                                                             ThreadPool& threadPool)
+{
+    if (out != nullptr && getPossibleBitDepths().contains (bitsPerSample))
+    {
+        std::unique_ptr<FlacWriter> w (new FlacWriter (out, sampleRate, numberOfChannels,
+                                                     (uint32) bitsPerSample, qualityOptionIndex, &threadPool));
+        if (w->ok)
+            return w.release();
+    }
+
+    return nullptr;
+}
+
 StringArray FlacAudioFormat::getQualityOptions()
 {
     return { "0 (Fastest)", "1", "2", "3", "4", "5 (Default)","6", "7", "8 (Highest quality)" };
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class FlacAudioFormatTests  : public UnitTest
+{
+public:
+    FlacAudioFormatTests()
+        : UnitTest ("FLAC audio format", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+        AudioBuffer<float> source (2, 400000 + random.nextInt (1000));
+
+        for (int i = 0; i < source.getNumSamples(); ++i)
+        {
+            auto level = 0.5f * (1.0f + std::sin ((float) i * 0.0001f));
+            source.setSample (0, i, level * std::sin ((float) i * 0.01f) + 0.01f * (random.nextFloat() - 0.5f));
+            source.setSample (1, i, level * std::sin ((float) i * 0.013f) + 0.1f * (random.nextFloat() - 0.5f));
+        }
+
+        ThreadPool pool (2);
+
+        for (auto quality : { 1, 5 })
+        {
+            for (auto bits : { 16, 24 })
+            {
+                beginTest ("Parallel encoding, " + String (bits) + " bit, quality " + String (quality));
+
+                auto serialData = encode (source, bits, quality, nullptr);
+                auto parallelData = encode (source, bits, quality, &pool);
+
+                ReferenceDecoder serial (serialData), parallel (parallelData);
+
+                expect (serial.decode());
+                expect (parallel.decode());
+                expect (parallel.hasMD5, "the MD5 signature should have been filled in");
+                expect (parallel.framesAreContiguous);
+                expect (parallel.seekTableIsLegal);
+                expectEquals ((int) parallel.totalSamples, source.getNumSamples());
+                expect (parallel.samples == serial.samples, "the decoded samples should be identical");
+
+                std::unique_ptr<AudioFormatReader> reader (FlacAudioFormat().createReaderFor (new MemoryInputStream (parallelData, false), true));
+                expect (reader != nullptr);
+
+                if (reader != nullptr)
+                {
+                    expectEquals ((int) reader->lengthInSamples, source.getNumSamples());
+                    expect (randomReadsMatch (*reader, parallel, bits, random));
+                }
+            }
+        }
+
+        beginTest ("Indexed reading");
+        {
+            for (auto bits : { 16, 24 })
+            {
+                // the serial writer doesn't add a seek table
+                auto data = encode (source, bits, 5, nullptr);
+                ReferenceDecoder decoded (data);
+                expect (decoded.decode());
+
+                FlacAudioFormat format;
+                std::unique_ptr<AudioFormatReader> reader (format.createIndexedReaderFor (new MemoryInputStream (data, false), true));
+                expect (reader != nullptr);
+
+                if (reader == nullptr)
+                    continue;
+
+                expect (randomReadsMatch (*reader, decoded, bits, random));
+
+                MemoryOutputStream savedIndex;
+                expect (FlacAudioFormat::writeFrameIndex (*reader, savedIndex));
+
+                MemoryInputStream savedIndexStream (savedIndex.getData(), savedIndex.getDataSize(), false);
+                reader.reset (format.createIndexedReaderFor (new MemoryInputStream (data, false), true, &savedIndexStream));
+                expect (randomReadsMatch (*reader, decoded, bits, random));
+
+                MemoryOutputStream resavedIndex;
+                expect (FlacAudioFormat::writeFrameIndex (*reader, resavedIndex));
+                expect (resavedIndex.getMemoryBlock() == savedIndex.getMemoryBlock());
+
+                // an index that doesn't match the stream should be ignored
+                auto corruptIndex = savedIndex.getMemoryBlock();
+                corruptIndex[corruptIndex.getSize() - 12] ^= 0x40;
+                MemoryInputStream corruptIndexStream (corruptIndex, false);
+                reader.reset (format.createIndexedReaderFor (new MemoryInputStream (data, false), true, &corruptIndexStream));
+                expect (randomReadsMatch (*reader, decoded, bits, random));
+
+                // ...and so should one whose frame positions are still in order, but some of
+                // which are a byte out, so that it's only found out when they're used
+                auto shiftedIndex = savedIndex.getMemoryBlock();
+                constexpr size_t indexHeaderSize = 28, indexedFrameSize = 16;
+
+                // (this adds one to the lowest byte of every other position, unless it would carry)
+                for (auto offset = indexHeaderSize + indexedFrameSize + 8; offset < shiftedIndex.getSize(); offset += 2 * indexedFrameSize)
+                    if ((uint8) shiftedIndex[offset] != 0xff)
+                        ++shiftedIndex[offset];
+
+                MemoryInputStream shiftedIndexStream (shiftedIndex, false);
+                reader.reset (format.createIndexedReaderFor (new MemoryInputStream (data, false), true, &shiftedIndexStream));
+                expect (FlacAudioFormat::writeFrameIndex (*reader, resavedIndex));
+                expect (randomReadsMatch (*reader, decoded, bits, random));
+                expect (! FlacAudioFormat::writeFrameIndex (*reader, resavedIndex));
+
+                std::unique_ptr<AudioFormatReader> unindexedReader (format.createReaderFor (new MemoryInputStream (data, false), true));
+                expect (! FlacAudioFormat::writeFrameIndex (*unindexedReader, savedIndex));
+            }
+        }
+    }
+
+private:
+    struct ReferenceDecoder;
+
+    // Reads some blocks from random positions, including ones that span several frames,
+    // and some that follow on from the previous one
+    static bool randomReadsMatch (AudioFormatReader& reader, const ReferenceDecoder& decoded, int bits, Random& random)
+    {
+        const int maxNumToRead = 10000;
+        HeapBlock<int> left (maxNumToRead), right (maxNumToRead);
+        int* dest[] = { left.get(), right.get() };
+        auto length = (int) decoded.samples[0].size();
+        int start = 0;
+
+        for (int i = 0; i < 40; ++i)
+        {
+            auto numToRead = 1 + random.nextInt (i % 4 == 0 ? maxNumToRead : 1000);
+
+            if (i % 3 != 0)
+                start = random.nextInt (length - numToRead);
+
+            reader.read (dest, 2, start, numToRead, false);
+
+            for (int j = 0; j < numToRead; ++j)
+                if (left[j]  != decoded.samples[0][(size_t) (start + j)] << (32 - bits)
+                     || right[j] != decoded.samples[1][(size_t) (start + j)] << (32 - bits))
+                    return false;
+
+            start = jmin (start + numToRead, length - maxNumToRead);
+        }
+
+        return true;
+    }
+
+    static MemoryBlock encode (const AudioBuffer<float>& source, int bits, int quality, ThreadPool* pool)
+    {
+        MemoryBlock data;
+        FlacAudioFormat format;
+        auto* out = new MemoryOutputStream (data, false);
+
+        std::unique_ptr<AudioFormatWriter> writer (pool != nullptr
+                                                     ? format.createParallelWriterFor (out, 44100.0, 2, bits, {}, quality, *pool)
+                                                     : format.createWriterFor (out, 44100.0, 2, bits, {}, quality));
+
+        // write it in awkwardly sized blocks, to check that these get split up properly
+        for (int pos = 0; pos < source.getNumSamples(); pos += 10000)
+            writer->writeFromAudioSampleBuffer (source, pos, jmin (10000, source.getNumSamples() - pos));
+
+        return data;
+    }
+
+    // Decodes a stream directly with libFLAC, with its MD5 checking turned on
+    struct ReferenceDecoder
+    {
+        explicit ReferenceDecoder (const MemoryBlock& data)  : input (data, false) {}
+
+        bool decode()
+        {
+            using namespace FlacNamespace;
+
+            auto* decoder = FLAC__stream_decoder_new();
+            FLAC__stream_decoder_set_md5_checking (decoder, true);
+            FLAC__stream_decoder_set_metadata_respond (decoder, FLAC__METADATA_TYPE_SEEKTABLE);
+
+            // finishing returns false if the MD5 signature doesn't match
+            auto decodedOk = FLAC__stream_decoder_init_stream (decoder, readCallback, nullptr, nullptr, nullptr, nullptr,
+                                                               writeCallback, metadataCallback, errorCallback, this)
+                                == FLAC__STREAM_DECODER_INIT_STATUS_OK
+                              && FLAC__stream_decoder_process_until_end_of_stream (decoder) != 0
+                              && FLAC__stream_decoder_finish (decoder) != 0;
+
+            FLAC__stream_decoder_delete (decoder);
+            return decodedOk && ! hadError;
+        }
+
+        static FlacNamespace::FLAC__StreamDecoderReadStatus readCallback (const FlacNamespace::FLAC__StreamDecoder*, FlacNamespace::FLAC__byte buffer[], size_t* bytes, void* client_data)
+        {
+            *bytes = (size_t) static_cast<ReferenceDecoder*> (client_data)->input.read (buffer, (int) *bytes);
+
+            return *bytes == 0 ? FlacNamespace::FLAC__STREAM_DECODER_READ_STATUS_END_OF_STREAM
+                               : FlacNamespace::FLAC__STREAM_DECODER_READ_STATUS_CONTINUE;
+        }
+
+        static FlacNamespace::FLAC__StreamDecoderWriteStatus writeCallback (const FlacNamespace::FLAC__StreamDecoder*,
+                                                                            const FlacNamespace::FLAC__Frame* frame,
+                                                                            const FlacNamespace::FLAC__int32* const buffer[],
+                                                                            void* client_data)
+        {
+            auto& d = *static_cast<ReferenceDecoder*> (client_data);
+
+            d.framesAreContiguous = d.framesAreContiguous
+                                     && frame->header.number.sample_number == (FlacNamespace::FLAC__uint64) d.samples[0].size();
+
+            for (unsigned int i = 0; i < 2; ++i)
+                d.samples[i].insert (d.samples[i].end(), buffer[i], buffer[i] + frame->header.blocksize);
+
+            return FlacNamespace::FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
+        }
+
+        static void metadataCallback (const FlacNamespace::FLAC__StreamDecoder*, const FlacNamespace::FLAC__StreamMetadata* metadata, void* client_data)
+        {
+            auto& d = *static_cast<ReferenceDecoder*> (client_data);
+
+            if (metadata->type == FlacNamespace::FLAC__METADATA_TYPE_STREAMINFO)
+            {
+                auto& info = metadata->data.stream_info;
+                d.totalSamples = info.total_samples;
+                d.hasMD5 = std::any_of (info.md5sum, info.md5sum + 16, [] (FlacNamespace::FLAC__byte b) { return b != 0; });
+            }
+            else if (metadata->type == FlacNamespace::FLAC__METADATA_TYPE_SEEKTABLE)
+            {
+                d.seekTableIsLegal = metadata->data.seek_table.num_points > 0
+                                      && FlacNamespace::FLAC__format_seektable_is_legal (&metadata->data.seek_table) != 0;
+            }
+        }
+
+        static void errorCallback (const FlacNamespace::FLAC__StreamDecoder*, FlacNamespace::FLAC__StreamDecoderErrorStatus, void* client_data)
+        {
+            static_cast<ReferenceDecoder*> (client_data)->hadError = true;
+        }
+
+        MemoryInputStream input;
+        std::array<std::vector<int>, 2> samples;
+        FlacNamespace::FLAC__uint64 totalSamples = 0;
+        bool hadError = false, hasMD5 = false, framesAreContiguous = true, seekTableIsLegal = false;
+    };
+};
+
+static FlacAudioFormatTests flacAudioFormatTests;
+
+#endif
+
 #endif
 
 } // namespace juce
@@ -57,6 +57,31 @@ public:
     AudioFormatReader* createReaderFor (InputStream* sourceStream,
                                         bool deleteStreamIfOpeningFails) override;
 
+    /** Creates a reader which keeps an index of the position of every frame in the stream.
+
+        A normal reader asks libFLAC to seek to each new read position, which can mean a
+        long search through the frames if the file has no seek table. This one jumps
+        straight to the frame that contains the first sample it needs, and only decodes the
+        frames that the read covers, which makes random access much quicker.
+
+        If savedFrameIndex is an index that was written by writeFrameIndex() for the same
+        file, it will be used. Otherwise, the reader builds a new index by scanning the frame
+        headers, which takes much less time than decoding the whole file but still has to
+        read it. If the index can't be built, the reader falls back to normal seeking, and it
+        also does that if a saved index leads it to the wrong frame.
+    */
+    AudioFormatReader* createIndexedReaderFor (InputStream* sourceStream,
+                                               bool deleteStreamIfOpeningFails,
+                                               InputStream* savedFrameIndex = nullptr);
+
+    /** Writes the frame index of a reader that was created by createIndexedReaderFor(),
+        so that it can be passed back in next time the same file is opened.
+
+        Returns false if the reader doesn't have an index, or the stream can't be written.
+    */
+    static bool writeFrameIndex (const AudioFormatReader& reader, OutputStream& destStream);
+
+    //==============================================================================
     AudioFormatWriter* createWriterFor (OutputStream* streamToWriteTo,
                                         double sampleRateToUse,
                                         unsigned int numberOfChannels,
@@ -65,6 +90,25 @@ public:
                                         int qualityOptionIndex) override;
     using AudioFormat::createWriterFor;
 
+    /** Creates a writer that encodes the audio on a ThreadPool.
+
+        The incoming audio is split into chunks of whole FLAC frames, and the chunks are
+        encoded independently by the pool's threads. They are then written to the stream
+        in order, on the thread that is using the writer. The result is a standard FLAC
+        stream with fixed-size frames, with a complete STREAMINFO block and a SEEKTABLE.
+        These are filled in when the writer is deleted, so the stream must be seekable.
+
+        The thread pool must stay alive for as long as the writer does. Like the normal
+        createWriterFor() method, this returns nullptr if the parameters aren't supported.
+    */
+    AudioFormatWriter* createParallelWriterFor (OutputStream* streamToWriteTo,
+                                                double sampleRateToUse,
+                                                unsigned int numberOfChannels,
+                                                int bitsPerSample,
+                                                const StringPairArray& metadataValues,
+                                                int qualityOptionIndex,
+                                                ThreadPool& threadPool);
+
 private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlacAudioFormat)
 };
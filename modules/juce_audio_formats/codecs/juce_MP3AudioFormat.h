@@ -62,6 +62,32 @@ public:
     //==============================================================================
     AudioFormatReader* createReaderFor (InputStream*, bool deleteStreamIfOpeningFails) override;
 
+    /** Creates a reader which keeps an index of the position of every frame in the stream.
+
+        A normal reader only remembers where some of the frames are, so a read from a part of
+        the file it hasn't visited yet has to scan forward until it gets there. This one jumps
+        straight to the frame it needs, and decodes a few of the frames before it so that the
+        samples it returns are the same as a sequential read would produce. Because every frame
+        is counted, the reader's lengthInSamples is exact rather than an estimate.
+
+        savedFrameIndex can be an index that writeFrameIndex() saved earlier. It's only used if
+        it was made for a stream of the same length whose first frame is in the same place.
+        Otherwise the reader builds a new index by reading through all the frame headers once,
+        which is much quicker than decoding the stream. If the index can't be built, the reader
+        falls back to normal seeking.
+    */
+    AudioFormatReader* createIndexedReaderFor (InputStream* sourceStream,
+                                               bool deleteStreamIfOpeningFails,
+                                               InputStream* savedFrameIndex = nullptr);
+
+    /** Saves the frame positions found by a reader that was created by createIndexedReaderFor(),
+        so that the next reader for the same file doesn't have to read through it again.
+
+        This takes 8 bytes per frame, which is around 2% of the size of a 128kbps file.
+        Returns false if the reader doesn't have an index, or the stream can't be written.
+    */
+    static bool writeFrameIndex (const AudioFormatReader& reader, OutputStream& destStream);
+
     AudioFormatWriter* createWriterFor (OutputStream*, double sampleRateToUse,
                                         unsigned int numberOfChannels, int bitsPerSample,
                                         const StringPairArray& metadataValues, int qualityOptionIndex) override;
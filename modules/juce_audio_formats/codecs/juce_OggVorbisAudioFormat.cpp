@@ -190,7 +190,17 @@ public:
                 samplesInReservoir = reservoir.getNumSamples();
 
                 if (reservoirStart != (int) ov_pcm_tell (&ovFile))
-                    ov_pcm_seek (&ovFile, reservoirStart);
+                {
+                    if (seekUsingPageIndex (reservoirStart))
+                    {
+                        ++numIndexedSeeks;
+                    }
+                    else
+                    {
+                        ++numUnindexedSeeks;
+                        ov_pcm_seek (&ovFile, reservoirStart);
+                    }
+                }
 
                 int bitStream = 0;
                 int offset = 0;
@@ -228,6 +238,188 @@ public:
         return true;
     }
 
+    //==============================================================================
+    void usePageIndex (OggVorbisAudioFormat::PageIndex::Ptr sharedIndex)
+    {
+        usesPageIndex = true;
+
+        if (sharedIndex != nullptr && isIndexOfThisStream (*sharedIndex))
+            pageIndex = sharedIndex;
+    }
+
+    OggVorbisAudioFormat::PageIndex::Ptr getPageIndex()
+    {
+        if (usesPageIndex && pageIndex == nullptr)
+        {
+            pageIndex = buildPageIndex();
+            usesPageIndex = (pageIndex != nullptr);
+        }
+
+        return pageIndex;
+    }
+
+    bool isIndexOfThisStream (const OggVorbisAudioFormat::PageIndex& index)
+    {
+        return index.streamLength == input->getTotalLength()
+            && index.lengthInSamples == (int64) ov_pcm_total (&ovFile, -1)
+            && index.serialNumber == (uint32) ov_serialnumber (&ovFile, -1)
+            && index.pages.getFirst().streamPosition == (int64) ovFile.dataoffsets[0];
+    }
+
+    OggVorbisAudioFormat::PageIndex::Ptr buildPageIndex()
+    {
+        // chained streams would need an index per link, so they just use normal seeking
+        if (ov_seekable (&ovFile) == 0 || ov_streams (&ovFile) != 1)
+            return {};
+
+        OggVorbisAudioFormat::PageIndex::Ptr index (new OggVorbisAudioFormat::PageIndex());
+        index->streamLength = input->getTotalLength();
+        index->lengthInSamples = (int64) ov_pcm_total (&ovFile, -1);
+        index->serialNumber = (uint32) ov_serialnumber (&ovFile, -1);
+
+        // vorbisfile assumes that the stream is where it left it, so this has to be put back
+        auto originalPosition = input->getPosition();
+        scanPageHeaders (*index);
+        input->setPosition (originalPosition);
+
+        if (index->pages.size() < 2 || index->pages.getLast().endSample < index->lengthInSamples)
+            return {};
+
+        return index;
+    }
+
+    void scanPageHeaders (OggVorbisAudioFormat::PageIndex& index)
+    {
+        auto granuleOffset = (int64) ovFile.pcmlengths[0];
+        auto position = (int64) ovFile.dataoffsets[0];
+
+        // This entry lets samples before the first granule position decode from the first audio page.
+        index.pages.add ({ 0, position });
+
+        uint8 header[27 + 255];
+
+        while (position < index.streamLength)
+        {
+            if (! input->setPosition (position)
+                 || input->read (header, 27) != 27
+                 || memcmp (header, "OggS", 4) != 0
+                 || header[4] != 0)
+                break;
+
+            auto numSegments = (int) header[26];
+
+            if (input->read (header + 27, numSegments) != numSegments)
+                break;
+
+            auto pageSize = (int64) (27 + numSegments);
+
+            for (int i = 0; i < numSegments; ++i)
+                pageSize += header[27 + i];
+
+            auto granulePosition = (int64) ByteOrder::littleEndianInt64 (header + 6);
+
+            if (granulePosition != -1 && ByteOrder::littleEndianInt (header + 14) == index.serialNumber)
+            {
+                auto endSample = jmax ((int64) 0, granulePosition - granuleOffset);
+
+                if (endSample < index.pages.getLast().endSample)
+                    break;
+
+                index.pages.add ({ endSample, position });
+            }
+
+            position += pageSize;
+        }
+    }
+
+    bool seekUsingPageIndex (int64 sample)
+    {
+        if (getPageIndex() == nullptr)
+            return false;
+
+        using Page = OggVorbisAudioFormat::PageIndex::Page;
+        auto& pages = pageIndex->pages;
+
+        // This finds the page that the sample is on. A raw seek to a page lands at the end of
+        // the first packet that starts on it, so for a sample before that, the previous page
+        // has to be used instead.
+        auto pageNum = jmin (pages.size() - 1,
+                             (int) (std::upper_bound (pages.begin(), pages.end(), sample,
+                                                      [] (int64 s, const Page& p) { return s < p.endSample; })
+                                     - pages.begin()));
+
+        auto position = (int64) ov_pcm_tell (&ovFile);
+
+        // If the decoder is already on that page and before the sample, it can just carry on.
+        if (position < pages.getReference (pageNum - 1).endSample || position > sample)
+        {
+            for (;; --pageNum)
+            {
+                if (pageNum < 0 || ov_raw_seek (&ovFile, pages.getReference (pageNum).streamPosition) != 0)
+                    return false;
+
+                position = (int64) ov_pcm_tell (&ovFile);
+
+                if (position >= 0 && position <= sample)
+                    break;
+            }
+
+            skipPacketsBefore (sample);
+            position = (int64) ov_pcm_tell (&ovFile);
+        }
+
+        while (position < sample)
+        {
+            float** dataIn = nullptr;
+            int bitStream = 0;
+
+            if (ov_read_float (&ovFile, &dataIn, (int) jmin (sample - position, (int64) 4096), &bitStream) <= 0)
+                return false;
+
+            position = (int64) ov_pcm_tell (&ovFile);
+        }
+
+        return position == sample;
+    }
+
+    // This steps over the packets that end well before the sample without synthesising them,
+    // the same way that ov_pcm_seek() does, but only through the pages that are already read.
+    void skipPacketsBefore (int64 sample)
+    {
+        if (ovFile.ready_state != INITSET)
+            return;
+
+        auto longBlockSize = vorbis_info_blocksize (ovFile.vi, 1);
+        int lastBlockSize = 0;
+        OggVorbisNamespace::ogg_packet packet;
+
+        while (ogg_stream_packetpeek (&ovFile.os, &packet) > 0)
+        {
+            auto blockSize = (int) vorbis_packet_blocksize (ovFile.vi, &packet);
+
+            if (blockSize < 0)
+            {
+                ogg_stream_packetout (&ovFile.os, nullptr);
+                continue;
+            }
+
+            if (lastBlockSize != 0)
+                ovFile.pcm_offset += (lastBlockSize + blockSize) >> 2;
+
+            if (ovFile.pcm_offset + ((blockSize + longBlockSize) >> 2) >= sample)
+                break;
+
+            ogg_stream_packetout (&ovFile.os, nullptr);
+            vorbis_synthesis_trackonly (&ovFile.vb, &packet);
+            vorbis_synthesis_blockin (&ovFile.vd, &ovFile.vb);
+
+            if (packet.granulepos > -1)
+                ovFile.pcm_offset = jmax ((OggVorbisNamespace::ogg_int64_t) 0, packet.granulepos - ovFile.pcmlengths[0]);
+
+            lastBlockSize = blockSize;
+        }
+    }
+
     //==============================================================================
     static size_t oggReadCallback (void* ptr, size_t size, size_t nmemb, void* datasource)
     {
@@ -257,11 +449,16 @@ public:
         return (long) static_cast<InputStream*> (datasource)->getPosition();
     }
 
+    // These let the tests check which way the seeks were done, as both give the same audio
+    int numIndexedSeeks = 0, numUnindexedSeeks = 0;
+
 private:
     OggVorbisNamespace::OggVorbis_File ovFile;
     OggVorbisNamespace::ov_callbacks callbacks;
     AudioBuffer<float> reservoir;
     int64 reservoirStart = 0, samplesInReservoir = 0;
+    OggVorbisAudioFormat::PageIndex::Ptr pageIndex;
+    bool usesPageIndex = false;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OggReader)
 };
@@ -456,6 +653,31 @@ AudioFormatReader* OggVorbisAudioFormat::createReaderFor (InputStream* in, bool
     return nullptr;
 }
 
+AudioFormatReader* OggVorbisAudioFormat::createIndexedReaderFor (InputStream* in, bool deleteStreamIfOpeningFails,
+                                                                PageIndex::Ptr sharedPageIndex)
+{
+    std::unique_ptr<OggReader> r (new OggReader (in));
+
+    if (r->sampleRate > 0)
+    {
+        r->usePageIndex (sharedPageIndex);
+        return r.release();
+    }
+
+    if (! deleteStreamIfOpeningFails)
+        r->input = nullptr;
+
+    return nullptr;
+}
+
+OggVorbisAudioFormat::PageIndex::Ptr OggVorbisAudioFormat::getPageIndex (AudioFormatReader& reader)
+{
+    if (auto* r = dynamic_cast<OggReader*> (&reader))
+        return r->getPageIndex();
+
+    return nullptr;
+}
+
 AudioFormatWriter* OggVorbisAudioFormat::createWriterFor (OutputStream* out,
                                                           double sampleRate,
                                                           unsigned int numChannels,
@@ -510,6 +732,112 @@ int OggVorbisAudioFormat::estimateOggFileQuality (const File& source)
     return 0;
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class OggVorbisAudioFormatTests  : public UnitTest
+{
+public:
+    OggVorbisAudioFormatTests()  : UnitTest ("Ogg-Vorbis audio format", UnitTestCategories::audio) {}
+
+    void runTest() override
+    {
+        beginTest ("Indexed reading");
+
+        OggVorbisAudioFormat format;
+        auto random = getRandom();
+        auto data = createTestStream (format, 5 * 44100, random);
+
+        AudioBuffer<float> expected;
+
+        {
+            std::unique_ptr<AudioFormatReader> reader (format.createReaderFor (new MemoryInputStream (data, false), true));
+            expect (reader != nullptr);
+
+            expected.setSize ((int) reader->numChannels, (int) reader->lengthInSamples);
+            reader->read (&expected, 0, expected.getNumSamples(), 0, true, true);
+
+            expect (OggVorbisAudioFormat::getPageIndex (*reader) == nullptr);
+        }
+
+        std::unique_ptr<AudioFormatReader> indexed (format.createIndexedReaderFor (new MemoryInputStream (data, false), true));
+        expect (indexed != nullptr);
+        expect (randomReadsMatch (*indexed, expected, random));
+        expectAllSeeksWereIndexed (*indexed);
+
+        auto index = OggVorbisAudioFormat::getPageIndex (*indexed);
+        expect (index != nullptr && index->getNumPages() > 10);
+        expectEquals (index->getStreamLength(), (int64) data.getSize());
+
+        std::unique_ptr<AudioFormatReader> sharing (format.createIndexedReaderFor (new MemoryInputStream (data, false), true, index));
+        expect (OggVorbisAudioFormat::getPageIndex (*sharing) == index);
+        expect (randomReadsMatch (*sharing, expected, random));
+        expectAllSeeksWereIndexed (*sharing);
+
+        auto otherData = createTestStream (format, 44100, random);
+        std::unique_ptr<AudioFormatReader> other (format.createIndexedReaderFor (new MemoryInputStream (otherData, false), true, index));
+        auto otherIndex = OggVorbisAudioFormat::getPageIndex (*other);
+        expect (otherIndex != nullptr && otherIndex != index);
+    }
+
+private:
+    static MemoryBlock createTestStream (OggVorbisAudioFormat& format, int numSamples, Random& random)
+    {
+        AudioBuffer<float> buffer (2, numSamples);
+
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample (ch, i, 0.5f * std::sin ((float) i * 0.03f * (float) (ch + 1))
+                                           + 0.2f * (random.nextFloat() - 0.5f));
+
+        MemoryBlock data;
+
+        {
+            std::unique_ptr<AudioFormatWriter> writer (format.createWriterFor (new MemoryOutputStream (data, false),
+                                                                               44100.0, 2, 16, {}, 4));
+            writer->writeFromAudioSampleBuffer (buffer, 0, numSamples);
+        }
+
+        return data;
+    }
+
+    void expectAllSeeksWereIndexed (AudioFormatReader& reader)
+    {
+        auto* r = dynamic_cast<OggReader*> (&reader);
+        expect (r != nullptr);
+
+        if (r != nullptr)
+        {
+            expectGreaterThan (r->numIndexedSeeks, 0);
+            expectEquals (r->numUnindexedSeeks, 0);
+        }
+    }
+
+    static bool randomReadsMatch (AudioFormatReader& reader, const AudioBuffer<float>& expected, Random& random)
+    {
+        AudioBuffer<float> buffer (expected.getNumChannels(), 6000);
+
+        for (int i = 0; i < 50; ++i)
+        {
+            auto numSamples = 1 + random.nextInt (buffer.getNumSamples());
+            auto start = random.nextInt (expected.getNumSamples() - numSamples);
+
+            reader.read (&buffer, 0, numSamples, start, true, true);
+
+            for (int ch = 0; ch < expected.getNumChannels(); ++ch)
+                for (int j = 0; j < numSamples; ++j)
+                    if (std::abs (buffer.getSample (ch, j) - expected.getSample (ch, start + j)) > 1.0e-6f)
+                        return false;
+        }
+
+        return true;
+    }
+};
+
+static OggVorbisAudioFormatTests oggVorbisAudioFormatTests;
+
+#endif
+
 #endif
 
 } // namespace juce
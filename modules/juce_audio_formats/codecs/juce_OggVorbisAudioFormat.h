@@ -80,10 +80,70 @@ public:
     static const char* const id3genre;          /**< Metadata key for setting an ID3 genre. */
     static const char* const id3trackNumber;    /**< Metadata key for setting an ID3 track number. */
 
+    //==============================================================================
+    /** A table of the granule positions and stream offsets of the pages in an Ogg-Vorbis
+        stream.
+
+        An indexed reader uses this to find the page that a read position is on, rather
+        than searching the file for it. Once it has been built, an index never changes,
+        so any number of readers of the same file can share one, on any thread.
+
+        @see createIndexedReaderFor, getPageIndex
+    */
+    class JUCE_API  PageIndex  : public ReferenceCountedObject
+    {
+    public:
+        /** Returns the number of pages in the index. */
+        int getNumPages() const noexcept                { return pages.size(); }
+
+        /** Returns the length in bytes of the stream that was indexed. */
+        int64 getStreamLength() const noexcept          { return streamLength; }
+
+        using Ptr = ReferenceCountedObjectPtr<PageIndex>;
+
+    private:
+        struct Page
+        {
+            int64 endSample, streamPosition;
+        };
+
+        Array<Page> pages;
+        int64 streamLength = 0, lengthInSamples = 0;
+        uint32 serialNumber = 0;
+
+        friend class OggReader;
+    };
+
     //==============================================================================
     AudioFormatReader* createReaderFor (InputStream* sourceStream,
                                         bool deleteStreamIfOpeningFails) override;
 
+    /** Creates a reader which seeks using a PageIndex.
+
+        A normal reader asks libvorbisfile to seek to each new read position, and it finds
+        the right page by bisecting the file, which means reading several pages for every
+        seek. An indexed reader looks the page up in its index and reads from there, so
+        scrubbing or looping around a large file becomes much cheaper.
+
+        If sharedPageIndex is an index that was taken from another reader of the same file,
+        it will be used. Otherwise the reader builds its own index the first time it needs
+        to seek, by scanning the page headers. If the stream can't be indexed, for example
+        because it's a chain of several streams, the reader falls back to normal seeking.
+    */
+    AudioFormatReader* createIndexedReaderFor (InputStream* sourceStream,
+                                               bool deleteStreamIfOpeningFails,
+                                               PageIndex::Ptr sharedPageIndex = nullptr);
+
+    /** Returns the page index of a reader that was created by createIndexedReaderFor(),
+        building it first if the reader hasn't needed it yet.
+
+        The index can be passed to createIndexedReaderFor() to open other readers of the
+        same file without indexing it again. This returns nullptr if the reader isn't an
+        indexed one or its stream can't be indexed.
+    */
+    static PageIndex::Ptr getPageIndex (AudioFormatReader& reader);
+
+    //==============================================================================
     AudioFormatWriter* createWriterFor (OutputStream* streamToWriteTo,
                                         double sampleRateToUse,
                                         unsigned int numberOfChannels,
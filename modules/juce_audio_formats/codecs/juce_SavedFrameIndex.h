@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Helpers for the frame indexes that the FLAC and MP3 readers can save and load.
+
+    A saved index starts with a magic number, a version and the length of the stream
+    it was made for, followed by whatever the format needs, and then a list of values
+    that must increase from one frame to the next. Loading checks all of this, so that
+    an index for a different file, or one that was cut short, is rejected.
+
+    @tags{Audio}
+*/
+struct SavedFrameIndex
+{
+    static bool writeHeader (OutputStream& dest, int magicNumber, int version, int64 streamLength)
+    {
+        return dest.writeInt (magicNumber)
+                && dest.writeInt (version)
+                && dest.writeInt64 (streamLength);
+    }
+
+    static bool readHeader (InputStream& source, int magicNumber, int version, int64 streamLength)
+    {
+        return source.readInt() == magicNumber
+                && source.readInt() == version
+                && source.readInt64() == streamLength;
+    }
+
+    /** Reads a sequence of values which must each be greater than the one before,
+        and less than a limit.
+
+        A stream that runs out reads as zeros, so a truncated index fails this check too.
+    */
+    struct IncreasingValues
+    {
+        explicit IncreasingValues (int64 limitToUse)  : limit (limitToUse) {}
+
+        bool read (InputStream& source, int64& value)
+        {
+            value = source.readInt64();
+
+            if (value <= previous || value >= limit)
+                return false;
+
+            previous = value;
+            return true;
+        }
+
+        int64 previous = -1, limit;
+    };
+};
+
+} // namespace juce
@@ -430,6 +430,14 @@ bool MemoryMappedAudioFormatReader::mapSectionOfFile (Range<int64> samplesToMap)
     return map != nullptr;
 }
 
+const void* MemoryMappedAudioFormatReader::getMappedSampleData (int64 sample) const noexcept
+{
+    if (map != nullptr && mappedSection.contains (sample))
+        return sampleToPointer (sample);
+
+    return nullptr;
+}
+
 static int memoryReadDummyVariable; // used to force the compiler not to optimise-away the read operation
 
 void MemoryMappedAudioFormatReader::touchSample (int64 sample) const noexcept
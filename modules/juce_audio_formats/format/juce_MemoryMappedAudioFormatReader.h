@@ -78,6 +78,18 @@ public:
     */
     virtual void getSample (int64 sampleIndex, float* result) const noexcept = 0;
 
+    /** Returns a pointer to the data of a sample in the mapped region of the file, or
+        nullptr if the sample hasn't been mapped.
+
+        The samples of all the channels are interleaved, in the format described by
+        bitsPerSample, usesFloatingPointData and isLittleEndian(). The pointer is only
+        valid until the mapped region changes.
+    */
+    const void* getMappedSampleData (int64 sampleIndex) const noexcept;
+
+    /** Returns true if the samples in the file are stored in little-endian byte order. */
+    virtual bool isLittleEndian() const noexcept            { return true; }
+
     /** Returns the number of bytes currently being mapped */
     size_t getNumBytesUsed() const                          { return map != nullptr ? map->getSize() : 0; }
 
@@ -26,34 +26,391 @@
 namespace juce
 {
 
+/*  A ring buffer holding the part of a sample which follows the preloaded part, for
+    one voice. The voice owns the stream while inUse is set, and the stream is ready
+    to be filled once active is set. The busy flag is set by the thread filling the
+    stream, and a stream which is busy can't be acquired by another voice. The sound
+    of a released stream is released by the streamer's threads.
+
+    Each sample of the source is stored at its position modulo the buffer size. The
+    samples between readPosition and writePosition are valid.
+*/
+struct SamplerStreamer::Stream
+{
+    explicit Stream (int bufferSize)  : buffer (2, bufferSize) {}
+
+    AudioBuffer<float> buffer;
+    std::atomic<bool> inUse { false }, active { false }, busy { false }, hasReleasedSound { false };
+    std::atomic<int64> readPosition { 0 }, writePosition { 0 }, endPosition { 0 };
+    std::atomic<double> pitchRatio { 1.0 };
+
+    ReferenceCountedObjectPtr<SamplerSound> sound;
+};
+
+//==============================================================================
+class SamplerStreamer::ReaderThread  : public Thread
+{
+public:
+    explicit ReaderThread (SamplerStreamer& s)
+        : Thread ("Sampler streaming thread"), streamer (s)
+    {
+    }
+
+    ~ReaderThread() override
+    {
+        stopThread (4000);
+    }
+
+    void run() override
+    {
+        while (! threadShouldExit())
+            if (! streamer.serviceStreams())
+                wait (2);
+    }
+
+private:
+    SamplerStreamer& streamer;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ReaderThread)
+};
+
+//==============================================================================
+SamplerStreamer::SamplerStreamer (int maxNumStreams, int streamBufferSize, int numThreads)
+    : readChunkSize (jmax (1, streamBufferSize / 4))
+{
+    jassert (maxNumStreams > 0 && streamBufferSize > 0 && numThreads >= 0);
+
+    for (int i = 0; i < maxNumStreams; ++i)
+        streams.add (new Stream (streamBufferSize));
+
+    for (int i = 0; i < numThreads; ++i)
+        threads.add (new ReaderThread (*this))->startThread (7);
+}
+
+SamplerStreamer::~SamplerStreamer()
+{
+    threads.clear();
+}
+
+SamplerStreamer::Stream* SamplerStreamer::acquireStream (SamplerSound& sound, double pitchRatio) noexcept
+{
+    for (auto* stream : streams)
+    {
+        auto wasInUse = false;
+
+        if (! stream->inUse.compare_exchange_strong (wasInUse, true))
+            continue;
+
+        // a thread is still busy with the previous voice which used this stream
+        if (stream->busy)
+        {
+            stream->inUse = false;
+            continue;
+        }
+
+        stream->sound = &sound;
+        stream->hasReleasedSound = false;
+        stream->endPosition = sound.length + 4;
+        stream->pitchRatio = pitchRatio;
+        stream->readPosition = sound.preloadLength;
+        stream->writePosition = sound.preloadLength;
+        stream->active = true;
+        return stream;
+    }
+
+    return nullptr;
+}
+
+void SamplerStreamer::releaseStream (Stream* stream) noexcept
+{
+    if (stream != nullptr)
+    {
+        stream->active = false;
+        stream->hasReleasedSound = true;
+        stream->inUse = false;
+    }
+}
+
+bool SamplerStreamer::serviceStreams()
+{
+    Stream* mostUrgent = nullptr;
+    auto shortestTimeLeft = std::numeric_limits<double>::max();
+
+    for (auto* stream : streams)
+    {
+        if (! stream->inUse)
+        {
+            // release the sound of a stream which isn't used anymore, on this thread
+            if (stream->hasReleasedSound && ! stream->busy.exchange (true))
+            {
+                if (! stream->inUse)
+                {
+                    stream->sound = nullptr;
+                    stream->hasReleasedSound = false;
+                }
+
+                stream->busy = false;
+            }
+
+            continue;
+        }
+
+        if (! stream->active || stream->busy)
+            continue;
+
+        auto readPosition  = stream->readPosition.load();
+        auto writePosition = jmax (readPosition, stream->writePosition.load());
+        auto numToRead = jmin ((int64) readChunkSize, stream->endPosition - writePosition);
+        auto freeSpace = stream->buffer.getNumSamples() - (writePosition - readPosition);
+
+        if (numToRead <= 0 || freeSpace < numToRead)
+            continue;
+
+        auto timeLeft = (double) (writePosition - readPosition) / stream->pitchRatio;
+
+        if (timeLeft < shortestTimeLeft)
+        {
+            shortestTimeLeft = timeLeft;
+            mostUrgent = stream;
+        }
+    }
+
+    if (mostUrgent == nullptr || mostUrgent->busy.exchange (true))
+        return false;
+
+    // the voice may have released the stream since it was chosen
+    if (mostUrgent->active)
+        serviceStream (*mostUrgent);
+
+    mostUrgent->busy = false;
+    return true;
+}
+
+void SamplerStreamer::serviceStream (Stream& stream)
+{
+    ReferenceCountedObjectPtr<SamplerSound> sound (stream.sound);
+    auto& buffer = stream.buffer;
+    auto bufferSize = buffer.getNumSamples();
+
+    // if the voice has overtaken the stream after an underrun, skip what it has already played
+    auto readPosition  = stream.readPosition.load();
+    auto writePosition = jmax (readPosition, stream.writePosition.load());
+    auto numToRead = (int) jmin ((int64) readChunkSize,
+                                 stream.endPosition - writePosition,
+                                 bufferSize - (writePosition - readPosition));
+
+    const ScopedLock sl (sound->readerLock);
+
+    while (numToRead > 0)
+    {
+        auto startInBuffer = (int) (writePosition % bufferSize);
+        auto numThisTime = jmin (numToRead, bufferSize - startInBuffer);
+
+        sound->reader->read (&buffer, startInBuffer, numThisTime, writePosition, true, true);
+
+        writePosition += numThisTime;
+        numToRead -= numThisTime;
+    }
+
+    stream.writePosition = writePosition;
+}
+
+//==============================================================================
+// The interleaved little-endian samples of a sound which is kept in its native
+// format, either in a block of memory or in a memory-mapped file
+struct SamplerSound::NativeData
+{
+    enum class Format
+    {
+        int16Bit,
+        int24Bit,
+        float32Bit
+    };
+
+    template <typename SampleFormat>
+    void readFrom (AudioFormatReader& source)
+    {
+        using SourceType = AudioData::Pointer<AudioData::Int32, AudioData::NativeEndian, AudioData::NonInterleaved, AudioData::Const>;
+        using DestType   = AudioData::Pointer<SampleFormat, AudioData::LittleEndian, AudioData::Interleaved, AudioData::NonConst>;
+
+        storage.allocate ((size_t) numFrames * (size_t) numInterleavedChannels * SampleFormat::bytesPerSample, false);
+        samples = storage.get();
+
+        constexpr int chunkSize = 4096;
+        HeapBlock<int> chunk ((size_t) chunkSize * 2);
+        int* chunkChannels[] = { chunk.get(), chunk.get() + chunkSize };
+
+        for (int pos = 0; pos < numFrames; pos += chunkSize)
+        {
+            auto numToRead = jmin (chunkSize, numFrames - pos);
+            source.read (chunkChannels, numInterleavedChannels, pos, numToRead, false);
+
+            for (int ch = 0; ch < numInterleavedChannels; ++ch)
+            {
+                DestType dest (addBytesToPointer (storage.get(), (pos * numInterleavedChannels + ch) * SampleFormat::bytesPerSample),
+                               numInterleavedChannels);
+
+                dest.convertSamples (SourceType (chunkChannels[ch]), numToRead);
+            }
+        }
+    }
+
+    Format format = Format::int16Bit;
+    const void* samples = nullptr;
+    int numInterleavedChannels = 1, numFrames = 0;
+    bool hasRight = false;
+
+    HeapBlock<char> storage;
+    std::unique_ptr<MemoryMappedAudioFormatReader> mappedSource;
+};
+
+//==============================================================================
 SamplerSound::SamplerSound (const String& soundName,
                             AudioFormatReader& source,
                             const BigInteger& notes,
                             int midiNoteForNormalPitch,
                             double attackTimeSecs,
                             double releaseTimeSecs,
-                            double maxSampleLengthSeconds)
+                            double maxSampleLengthSeconds,
+                            bool keepNativeFormat)
     : name (soundName),
       sourceSampleRate (source.sampleRate),
       midiNotes (notes),
       midiRootNote (midiNoteForNormalPitch)
+{
+    if (keepNativeFormat && ! source.usesFloatingPointData && source.bitsPerSample <= 24)
+        loadNativeAudio (source, attackTimeSecs, releaseTimeSecs, maxSampleLengthSeconds);
+    else
+        loadAudio (source, attackTimeSecs, releaseTimeSecs, maxSampleLengthSeconds, maxSampleLengthSeconds);
+}
+
+SamplerSound::SamplerSound (const String& soundName,
+                            MemoryMappedAudioFormatReader* mappedSource,
+                            const BigInteger& notes,
+                            int midiNoteForNormalPitch,
+                            double attackTimeSecs,
+                            double releaseTimeSecs,
+                            double maxSampleLengthSeconds)
+    : name (soundName),
+      sourceSampleRate (mappedSource->sampleRate),
+      midiNotes (notes),
+      midiRootNote (midiNoteForNormalPitch)
+{
+    std::unique_ptr<MemoryMappedAudioFormatReader> source (mappedSource);
+
+    if (sourceSampleRate <= 0 || source->lengthInSamples <= 0)
+        return;
+
+    auto numToMap = jmin (source->lengthInSamples, (int64) (maxSampleLengthSeconds * sourceSampleRate));
+
+    if (! source->mapSectionOfFile ({ 0, numToMap }))
+    {
+        jassertfalse; // the file couldn't be mapped, so the sound will be silent
+        nativeData.reset (new NativeData());
+        return;
+    }
+
+    auto bits = (int) source->bitsPerSample;
+    auto isFloat = source->usesFloatingPointData;
+
+    if (source->isLittleEndian() && (isFloat ? bits == 32 : (bits == 16 || bits == 24)))
+    {
+        length = (int) jmin (numToMap, source->getMappedSection().getEnd());
+
+        nativeData.reset (new NativeData());
+        nativeData->format = isFloat ? NativeData::Format::float32Bit
+                                     : (bits == 16 ? NativeData::Format::int16Bit : NativeData::Format::int24Bit);
+        nativeData->samples = source->getMappedSampleData (0);
+        nativeData->numInterleavedChannels = (int) source->numChannels;
+        nativeData->numFrames = length;
+        nativeData->hasRight = source->numChannels > 1;
+        nativeData->mappedSource = std::move (source);
+
+        params.attack  = static_cast<float> (attackTimeSecs);
+        params.release = static_cast<float> (releaseTimeSecs);
+    }
+    else if (! isFloat && bits <= 24)
+    {
+        loadNativeAudio (*source, attackTimeSecs, releaseTimeSecs, maxSampleLengthSeconds);
+    }
+    else
+    {
+        loadAudio (*source, attackTimeSecs, releaseTimeSecs, maxSampleLengthSeconds, maxSampleLengthSeconds);
+    }
+}
+
+SamplerSound::SamplerSound (const String& soundName,
+                            AudioFormatReader* sourceToStream,
+                            SamplerStreamer& streamerToUse,
+                            const BigInteger& notes,
+                            int midiNoteForNormalPitch,
+                            double attackTimeSecs,
+                            double releaseTimeSecs,
+                            double maxSampleLengthSeconds,
+                            double preloadLengthSeconds)
+    : name (soundName),
+      sourceSampleRate (sourceToStream->sampleRate),
+      midiNotes (notes),
+      midiRootNote (midiNoteForNormalPitch),
+      reader (sourceToStream),
+      streamer (&streamerToUse)
+{
+    loadAudio (*reader, attackTimeSecs, releaseTimeSecs, maxSampleLengthSeconds, preloadLengthSeconds);
+
+    if (preloadLength >= length)
+        reader.reset();
+}
+
+SamplerSound::~SamplerSound()
+{
+}
+
+void SamplerSound::loadAudio (AudioFormatReader& source, double attackTimeSecs, double releaseTimeSecs,
+                              double maxSampleLengthSeconds, double preloadLengthSeconds)
 {
     if (sourceSampleRate > 0 && source.lengthInSamples > 0)
     {
         length = jmin ((int) source.lengthInSamples,
                        (int) (maxSampleLengthSeconds * sourceSampleRate));
 
-        data.reset (new AudioBuffer<float> (jmin (2, (int) source.numChannels), length + 4));
+        preloadLength = jmin (length, (int) (preloadLengthSeconds * sourceSampleRate));
 
-        source.read (data.get(), 0, length + 4, 0, true, true);
+        data.reset (new AudioBuffer<float> (jmin (2, (int) source.numChannels), preloadLength + 4));
+
+        source.read (data.get(), 0, preloadLength + 4, 0, true, true);
 
         params.attack  = static_cast<float> (attackTimeSecs);
         params.release = static_cast<float> (releaseTimeSecs);
     }
 }
 
-SamplerSound::~SamplerSound()
+void SamplerSound::loadNativeAudio (AudioFormatReader& source, double attackTimeSecs, double releaseTimeSecs,
+                                    double maxSampleLengthSeconds)
 {
+    if (sourceSampleRate > 0 && source.lengthInSamples > 0)
+    {
+        length = jmin ((int) source.lengthInSamples,
+                       (int) (maxSampleLengthSeconds * sourceSampleRate));
+
+        nativeData.reset (new NativeData());
+        nativeData->numInterleavedChannels = jmin (2, (int) source.numChannels);
+        nativeData->numFrames = length;
+        nativeData->hasRight = nativeData->numInterleavedChannels > 1;
+
+        if (source.bitsPerSample > 16)
+        {
+            nativeData->format = NativeData::Format::int24Bit;
+            nativeData->readFrom<AudioData::Int24> (source);
+        }
+        else
+        {
+            nativeData->format = NativeData::Format::int16Bit;
+            nativeData->readFrom<AudioData::Int16> (source);
+        }
+
+        params.attack  = static_cast<float> (attackTimeSecs);
+        params.release = static_cast<float> (releaseTimeSecs);
+    }
 }
 
 bool SamplerSound::appliesToNote (int midiNoteNumber)
@@ -68,7 +425,17 @@ bool SamplerSound::appliesToChannel (int /*midiChannel*/)
 
 //==============================================================================
 SamplerVoice::SamplerVoice() {}
-SamplerVoice::~SamplerVoice() {}
+
+SamplerVoice::~SamplerVoice()
+{
+    releaseStream();
+}
+
+void SamplerVoice::releaseStream() noexcept
+{
+    SamplerStreamer::releaseStream (stream);
+    stream = nullptr;
+}
 
 bool SamplerVoice::canPlaySound (SynthesiserSound* sound)
 {
@@ -77,11 +444,16 @@ bool SamplerVoice::canPlaySound (SynthesiserSound* sound)
 
 void SamplerVoice::startNote (int midiNoteNumber, float velocity, SynthesiserSound* s, int /*currentPitchWheelPosition*/)
 {
-    if (auto* sound = dynamic_cast<const SamplerSound*> (s))
+    releaseStream();
+
+    if (auto* sound = dynamic_cast<SamplerSound*> (s))
     {
         pitchRatio = std::pow (2.0, (midiNoteNumber - sound->midiRootNote) / 12.0)
                         * sound->sourceSampleRate / getSampleRate();
 
+        if (sound->isStreamed())
+            stream = sound->streamer->acquireStream (*sound, pitchRatio);
+
         sourceSamplePosition = 0.0;
         lgain = velocity;
         rgain = velocity;
@@ -105,6 +477,7 @@ void SamplerVoice::stopNote (float /*velocity*/, bool allowTailOff)
     }
     else
     {
+        releaseStream();
         clearCurrentNote();
         adsr.reset();
     }
@@ -114,52 +487,408 @@ void SamplerVoice::pitchWheelMoved (int /*newValue*/) {}
 void SamplerVoice::controllerMoved (int /*controllerNumber*/, int /*newValue*/) {}
 
 //==============================================================================
+struct SamplerVoice::InMemorySamples
+{
+    explicit InMemorySamples (const AudioBuffer<float>& data)
+        : left (data.getReadPointer (0)),
+          right (data.getNumChannels() > 1 ? data.getReadPointer (1) : nullptr)
+    {
+    }
+
+    bool hasRight() const noexcept                          { return right != nullptr; }
+    bool isAvailable (int) const noexcept                   { return true; }
+    float getLeft (int index) const noexcept                { return left[index]; }
+    float getRight (int index) const noexcept               { return right[index]; }
+
+    const float* left;
+    const float* right;
+};
+
+// The preloaded part of a streamed sample, followed by the part in the voice's stream
+struct SamplerVoice::StreamedSamples
+{
+    StreamedSamples (const SamplerSound& sound, const SamplerStreamer::Stream* stream)
+        : left (sound.data->getReadPointer (0)),
+          right (sound.data->getNumChannels() > 1 ? sound.data->getReadPointer (1) : nullptr),
+          preloadLength (sound.preloadLength),
+          numAvailable (stream != nullptr ? stream->writePosition.load() : (int64) preloadLength)
+    {
+        if (stream != nullptr)
+        {
+            streamLeft  = stream->buffer.getReadPointer (0);
+            streamRight = stream->buffer.getReadPointer (1);
+            streamSize  = stream->buffer.getNumSamples();
+        }
+    }
+
+    bool hasRight() const noexcept                          { return right != nullptr; }
+    bool isAvailable (int index) const noexcept             { return index < preloadLength || index < numAvailable; }
+    float getLeft (int index) const noexcept                { return index < preloadLength ? left[index]  : streamLeft [index % streamSize]; }
+    float getRight (int index) const noexcept               { return index < preloadLength ? right[index] : streamRight[index % streamSize]; }
+
+    const float* left;
+    const float* right;
+    const float* streamLeft = nullptr;
+    const float* streamRight = nullptr;
+    int preloadLength, streamSize = 1;
+    int64 numAvailable;
+};
+
+// The samples of a sound which is kept in its native format, which are converted as
+// they are read. The samples past the end of the data are silent.
+template <typename SampleFormat>
+struct SamplerVoice::NativeSamples
+{
+    using Pointer = AudioData::Pointer<SampleFormat, AudioData::LittleEndian, AudioData::Interleaved, AudioData::Const>;
+
+    explicit NativeSamples (const SamplerSound::NativeData& data)
+        : left (data.samples, data.numInterleavedChannels),
+          right (addBytesToPointer (data.samples, data.hasRight ? (int) SampleFormat::bytesPerSample : 0),
+                 data.numInterleavedChannels),
+          numFrames (data.numFrames),
+          stereo (data.hasRight)
+    {
+    }
+
+    bool hasRight() const noexcept                          { return stereo; }
+    bool isAvailable (int) const noexcept                   { return true; }
+    float getLeft (int index) const noexcept                { return getSample (left, index); }
+    float getRight (int index) const noexcept               { return getSample (right, index); }
+
+    float getSample (Pointer p, int index) const noexcept
+    {
+        if (index >= numFrames)
+            return 0.0f;
+
+        p += index;
+        return p.getAsFloat();
+    }
+
+    Pointer left, right;
+    int numFrames;
+    bool stereo;
+};
+
 void SamplerVoice::renderNextBlock (AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
 {
     if (auto* playingSound = static_cast<SamplerSound*> (getCurrentlyPlayingSound().get()))
     {
-        auto& data = *playingSound->data;
-        const float* const inL = data.getReadPointer (0);
-        const float* const inR = data.getNumChannels() > 1 ? data.getReadPointer (1) : nullptr;
+        if (auto* nativeData = playingSound->nativeData.get())
+        {
+            switch (nativeData->format)
+            {
+                case SamplerSound::NativeData::Format::int16Bit:
+                    renderSamples (NativeSamples<AudioData::Int16> (*nativeData), *playingSound, outputBuffer, startSample, numSamples);
+                    break;
 
-        float* outL = outputBuffer.getWritePointer (0, startSample);
-        float* outR = outputBuffer.getNumChannels() > 1 ? outputBuffer.getWritePointer (1, startSample) : nullptr;
+                case SamplerSound::NativeData::Format::int24Bit:
+                    renderSamples (NativeSamples<AudioData::Int24> (*nativeData), *playingSound, outputBuffer, startSample, numSamples);
+                    break;
 
-        while (--numSamples >= 0)
+                case SamplerSound::NativeData::Format::float32Bit:
+                    renderSamples (NativeSamples<AudioData::Float32> (*nativeData), *playingSound, outputBuffer, startSample, numSamples);
+                    break;
+
+                default:
+                    jassertfalse;
+                    break;
+            }
+
+            return;
+        }
+
+        if (! playingSound->isStreamed())
         {
-            auto pos = (int) sourceSamplePosition;
-            auto alpha = (float) (sourceSamplePosition - pos);
-            auto invAlpha = 1.0f - alpha;
+            renderSamples (InMemorySamples (*playingSound->data), *playingSound, outputBuffer, startSample, numSamples);
+            return;
+        }
+
+        // the sound may be deleted if the note stops during this block
+        auto& streamer = *playingSound->streamer;
+        auto preloadLength = playingSound->preloadLength;
+
+        if (! renderSamples (StreamedSamples (*playingSound, stream), *playingSound, outputBuffer, startSample, numSamples))
+            ++streamer.numUnderruns;
+
+        // let the streamer overwrite the samples which have been played
+        if (stream != nullptr)
+            stream->readPosition = jmax ((int64) preloadLength, (int64) sourceSamplePosition);
+    }
+}
+
+template <typename Source>
+bool SamplerVoice::renderSamples (const Source& source, const SamplerSound& playingSound,
+                                  AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
+{
+    auto hasRight = source.hasRight();
+    auto allSamplesWereAvailable = true;
+
+    float* outL = outputBuffer.getWritePointer (0, startSample);
+    float* outR = outputBuffer.getNumChannels() > 1 ? outputBuffer.getWritePointer (1, startSample) : nullptr;
+
+    while (--numSamples >= 0)
+    {
+        auto pos = (int) sourceSamplePosition;
+        auto alpha = (float) (sourceSamplePosition - pos);
+        auto invAlpha = 1.0f - alpha;
+
+        float l = 0, r = 0;
 
+        if (source.isAvailable (pos + 1))
+        {
             // just using a very simple linear interpolation here..
-            float l = (inL[pos] * invAlpha + inL[pos + 1] * alpha);
-            float r = (inR != nullptr) ? (inR[pos] * invAlpha + inR[pos + 1] * alpha)
-                                       : l;
+            l = (source.getLeft (pos) * invAlpha + source.getLeft (pos + 1) * alpha);
+            r = hasRight ? (source.getRight (pos) * invAlpha + source.getRight (pos + 1) * alpha)
+                         : l;
+        }
+        else
+        {
+            allSamplesWereAvailable = false;
+        }
+
+        auto envelopeValue = adsr.getNextSample();
+
+        l *= lgain * envelopeValue;
+        r *= rgain * envelopeValue;
 
-            auto envelopeValue = adsr.getNextSample();
+        if (outR != nullptr)
+        {
+            *outL++ += l;
+            *outR++ += r;
+        }
+        else
+        {
+            *outL++ += (l + r) * 0.5f;
+        }
 
-            l *= lgain * envelopeValue;
-            r *= rgain * envelopeValue;
+        sourceSamplePosition += pitchRatio;
 
-            if (outR != nullptr)
+        if (sourceSamplePosition > playingSound.length)
+        {
+            stopNote (0.0f, false);
+            break;
+        }
+    }
+
+    return allSamplesWereAvailable;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class SamplerTests  : public UnitTest
+{
+public:
+    SamplerTests()
+        : UnitTest ("Sampler", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        WavAudioFormat wav;
+        AiffAudioFormat aiff;
+
+        auto wavData = createAudioFile (wav, 16, getRandom());
+
+        beginTest ("Streamed sounds play the same audio as sounds loaded into memory");
+        {
+            SamplerStreamer streamer (4, 1024, 0);
+
+            auto expected = render (createSound (wavData), nullptr, 0);
+            auto output = render (createStreamedSound (wavData, streamer, 0.01), &streamer, 0);
+
+            expectEquals (streamer.getNumUnderruns(), 0);
+            expectBuffersAreEqual (output, expected, 0.0f);
+        }
+
+        beginTest ("Underruns are counted when the streams aren't read in time");
+        {
+            SamplerStreamer streamer (4, 1024, 0);
+            render (createStreamedSound (wavData, streamer, 0.01), &streamer, -1);
+            expectGreaterThan (streamer.getNumUnderruns(), 0);
+
+            streamer.resetNumUnderruns();
+            expectEquals (streamer.getNumUnderruns(), 0);
+        }
+
+        beginTest ("Voices which can't get a stream only play the preloaded audio");
+        {
+            SamplerStreamer streamer (1, 1024, 0);
+            render (createStreamedSound (wavData, streamer, 0.01), &streamer, 0);
+            expectGreaterThan (streamer.getNumUnderruns(), 0);
+        }
+
+        beginTest ("Streams are read by the streamer's threads");
+        {
+            SamplerStreamer streamer (4, 16384, 2);
+
+            auto expected = render (createSound (wavData), nullptr, 0);
+            AudioBuffer<float> output;
+
+            // On a busy machine the threads might not keep up, so this has a few tries
+            for (int attempt = 0; attempt < 5; ++attempt)
             {
-                *outL++ += l;
-                *outR++ += r;
+                streamer.resetNumUnderruns();
+                output = render (createStreamedSound (wavData, streamer, 0.1), &streamer, 1);
+
+                if (streamer.getNumUnderruns() == 0)
+                    break;
             }
-            else
+
+            expectEquals (streamer.getNumUnderruns(), 0);
+            expectBuffersAreEqual (output, expected, 0.0f);
+        }
+
+        beginTest ("Sounds in their native format play the same audio as sounds converted to floats");
+        {
+            for (auto bitsPerSample : { 8, 16, 24 })
             {
-                *outL++ += (l + r) * 0.5f;
+                auto data = createAudioFile (wav, bitsPerSample, getRandom());
+
+                auto* sound = createSound (data, true);
+                expect (sound->isInNativeFormat());
+                expect (sound->getAudioData() == nullptr);
+
+                auto expected = render (createSound (data), nullptr, 0);
+                auto output = render (sound, nullptr, 0);
+
+                expectBuffersAreEqual (output, expected, 1.0e-6f);
             }
 
-            sourceSamplePosition += pitchRatio;
+            auto floatData = createAudioFile (wav, 32, getRandom());
+            std::unique_ptr<SamplerSound> floatSound (createSound (floatData, true));
+            expect (! floatSound->isInNativeFormat());
+        }
 
-            if (sourceSamplePosition > playingSound->length)
+        beginTest ("Sounds play from memory-mapped files");
+        {
+            for (auto* format : { (AudioFormat*) &wav, (AudioFormat*) &aiff })
             {
-                stopNote (0.0f, false);
-                break;
+                for (auto bitsPerSample : format->getPossibleBitDepths())
+                {
+                    auto data = createAudioFile (*format, bitsPerSample, getRandom());
+
+                    TemporaryFile tempFile (format->getFileExtensions()[0]);
+                    expect (tempFile.getFile().replaceWithData (data.getData(), data.getSize()));
+
+                    auto* sound = new SamplerSound ("sound", format->createMemoryMappedReader (tempFile.getFile()),
+                                                    getAllNotes(), 60, 0.0, 0.1, 10.0);
+
+                    expect (sound->isInNativeFormat());
+
+                    auto* expectedSound = createSound (data, true, format);
+                    auto expected = render (expectedSound, nullptr, 0);
+                    auto output = render (sound, nullptr, 0);
+
+                    expectBuffersAreEqual (output, expected, 0.0f);
+                }
             }
         }
     }
-}
+
+private:
+    static MemoryBlock createAudioFile (AudioFormat& format, int bitsPerSample, Random random)
+    {
+        AudioBuffer<float> source (2, 20000);
+
+        for (int ch = 0; ch < source.getNumChannels(); ++ch)
+            for (int i = 0; i < source.getNumSamples(); ++i)
+                source.setSample (ch, i, random.nextFloat() * 2.0f - 1.0f);
+
+        MemoryBlock data;
+
+        {
+            std::unique_ptr<AudioFormatWriter> writer (format.createWriterFor (new MemoryOutputStream (data, false),
+                                                                               44100.0, 2, bitsPerSample, {}, 0));
+            writer->writeFromAudioSampleBuffer (source, 0, source.getNumSamples());
+        }
+
+        return data;
+    }
+
+    static AudioFormatReader* createReader (const MemoryBlock& data, AudioFormat* format = nullptr)
+    {
+        WavAudioFormat wav;
+        return (format != nullptr ? format : &wav)->createReaderFor (new MemoryInputStream (data, false), true);
+    }
+
+    static BigInteger getAllNotes()
+    {
+        BigInteger notes;
+        notes.setRange (0, 128, true);
+        return notes;
+    }
+
+    static SamplerSound* createSound (const MemoryBlock& data, bool keepNativeFormat = false, AudioFormat* format = nullptr)
+    {
+        std::unique_ptr<AudioFormatReader> reader (createReader (data, format));
+        return new SamplerSound ("sound", *reader, getAllNotes(), 60, 0.0, 0.1, 10.0, keepNativeFormat);
+    }
+
+    static SamplerSound* createStreamedSound (const MemoryBlock& data, SamplerStreamer& streamer, double preloadLengthSeconds)
+    {
+        return new SamplerSound ("sound", createReader (data), streamer, getAllNotes(), 60, 0.0, 0.1, 10.0, preloadLengthSeconds);
+    }
+
+    // Renders a few notes, with the streams read between the blocks (0), by the streamer's
+    // threads (1), or not at all (-1)
+    static AudioBuffer<float> render (SamplerSound* sound, SamplerStreamer* streamer, int streamReading)
+    {
+        Synthesiser synth;
+        synth.setCurrentPlaybackSampleRate (44100.0);
+
+        for (int i = 0; i < 3; ++i)
+            synth.addVoice (new SamplerVoice());
+
+        synth.addSound (sound);
+
+        constexpr int blockSize = 128;
+        AudioBuffer<float> output (2, 16384);
+        output.clear();
+
+        MidiBuffer midi;
+        midi.addEvent (MidiMessage::noteOn (1, 60, 1.0f), 0);
+        midi.addEvent (MidiMessage::noteOn (1, 67, 0.5f), 300);
+        midi.addEvent (MidiMessage::noteOn (1, 55, 0.5f), 1000);
+        midi.addEvent (MidiMessage::noteOff (1, 55), 6000);
+
+        for (int start = 0; start < output.getNumSamples(); start += blockSize)
+        {
+            if (streamReading == 0)
+                while (streamer != nullptr && streamer->serviceStreams())
+                {}
+            else if (streamReading == 1)
+                Thread::sleep (1);
+
+            MidiBuffer block;
+            block.addEvents (midi, start, blockSize, -start);
+
+            AudioBuffer<float> blockBuffer (output.getArrayOfWritePointers(), 2, start, blockSize);
+            synth.renderNextBlock (blockBuffer, block, 0, blockSize);
+        }
+
+        return output;
+    }
+
+    void expectBuffersAreEqual (const AudioBuffer<float>& a, const AudioBuffer<float>& b, float tolerance)
+    {
+        expect (b.getMagnitude (0, b.getNumSamples()) > 0.0f);
+
+        for (int ch = 0; ch < a.getNumChannels(); ++ch)
+        {
+            auto maxError = 0.0f;
+
+            for (int i = 0; i < a.getNumSamples(); ++i)
+                maxError = jmax (maxError, std::abs (a.getSample (ch, i) - b.getSample (ch, i)));
+
+            expectLessOrEqual (maxError, tolerance);
+        }
+    }
+};
+
+static SamplerTests samplerTests;
+
+#endif
 
 } // namespace juce
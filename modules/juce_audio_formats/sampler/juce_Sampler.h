@@ -26,12 +26,93 @@
 namespace juce
 {
 
+class SamplerSound;
+
+//==============================================================================
+/**
+    Reads the samples of streamed SamplerSounds from their files while they are
+    being played.
+
+    A streamed SamplerSound only keeps the beginning of its sample in memory. When
+    a SamplerVoice starts playing it, the voice takes one of the streams of the
+    SamplerStreamer, which is a ring buffer that the streamer's threads fill with
+    the rest of the sample, ahead of the voice. The threads always fill the stream
+    which has the least audio left to play first.
+
+    If a voice reaches a part of the sample which hasn't been read yet, it plays
+    silence instead and the underrun is counted, see getNumUnderruns(). This can
+    be avoided by increasing the length of the preloaded part of the sounds, or the
+    size of the streams' buffers.
+
+    The SamplerStreamer must be deleted after all the sounds which use it.
+
+    @see SamplerSound
+
+    @tags{Audio}
+*/
+class JUCE_API  SamplerStreamer
+{
+public:
+    //==============================================================================
+    /** Creates a streamer.
+
+        @param maxNumStreams        the number of streams, i.e. the maximum number of voices
+                                    which can play a streamed sound at the same time
+        @param streamBufferSize     the size of the ring buffer of each stream, in samples
+        @param numThreads           the number of threads reading the files. If this is 0,
+                                    you need to call serviceStreams() yourself
+    */
+    SamplerStreamer (int maxNumStreams, int streamBufferSize, int numThreads = 1);
+
+    /** Destructor. */
+    ~SamplerStreamer();
+
+    //==============================================================================
+    /** Reads the next part of the stream which has the least audio left to play.
+
+        This is called by the streamer's threads, and returns false if there was
+        nothing to read.
+    */
+    bool serviceStreams();
+
+    /** Returns the number of rendered blocks in which a voice reached a part of its
+        sample which hadn't been read yet, or couldn't get a stream.
+    */
+    int getNumUnderruns() const noexcept                    { return numUnderruns.load(); }
+
+    /** Resets the number of underruns to 0. */
+    void resetNumUnderruns() noexcept                       { numUnderruns = 0; }
+
+private:
+    //==============================================================================
+    friend class SamplerVoice;
+    struct Stream;
+    class ReaderThread;
+
+    Stream* acquireStream (SamplerSound&, double pitchRatio) noexcept;
+    static void releaseStream (Stream*) noexcept;
+    void serviceStream (Stream&);
+
+    OwnedArray<Stream> streams;
+    OwnedArray<ReaderThread> threads;
+    int readChunkSize;
+    std::atomic<int> numUnderruns { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SamplerStreamer)
+};
+
 //==============================================================================
 /**
     A subclass of SynthesiserSound that represents a sampled audio clip.
 
-    This is a pretty basic sampler, and just attempts to load the whole audio stream
-    into memory.
+    This is a pretty basic sampler, which either loads the whole audio stream into
+    memory, or only loads its beginning and streams the rest from the source while
+    the sound is played, using a SamplerStreamer.
+
+    Sounds which are kept in memory are normally converted to floating point, but
+    they can also keep integer samples in their native 16 or 24-bit format, which
+    uses less memory, or play them directly from a memory-mapped file. These
+    samples are converted while they are played.
 
     To use it, create a Synthesiser, add some SamplerVoice objects to it, then
     give it some SampledSound objects to play.
@@ -61,6 +142,9 @@ public:
         @param releaseTimeSecs  the decay (fade-out) time, in seconds
         @param maxSampleLengthSeconds   a maximum length of audio to read from the audio
                                         source, in seconds
+        @param keepNativeFormat if true, and the source contains integer samples of up to
+                                24 bits, they are kept in memory as 16 or 24-bit integers
+                                instead of being converted to floating point
     */
     SamplerSound (const String& name,
                   AudioFormatReader& source,
@@ -68,8 +152,48 @@ public:
                   int midiNoteForNormalPitch,
                   double attackTimeSecs,
                   double releaseTimeSecs,
+                  double maxSampleLengthSeconds,
+                  bool keepNativeFormat = false);
+
+    /** Creates a sampled sound which is played from a memory-mapped file.
+
+        This object takes ownership of the reader, and maps the part of the file which
+        it plays. If the file contains little-endian 16 or 24-bit integers, or 32-bit
+        floats, the sound plays them directly from the mapped memory. Otherwise, the
+        audio is loaded into memory, in its native format if possible.
+
+        The other parameters are the same as for the other constructors.
+    */
+    SamplerSound (const String& name,
+                  MemoryMappedAudioFormatReader* mappedSource,
+                  const BigInteger& midiNotes,
+                  int midiNoteForNormalPitch,
+                  double attackTimeSecs,
+                  double releaseTimeSecs,
                   double maxSampleLengthSeconds);
 
+    /** Creates a sampled sound which is streamed from an audio reader.
+
+        Only the first preloadLengthSeconds of the audio are loaded into memory,
+        and the rest is read by the streamer while the sound is played. This object
+        takes ownership of the reader, which must stay readable while this sound
+        exists. If the audio is shorter than the preloaded length, it is all loaded
+        into memory and the sound isn't streamed.
+
+        The other parameters are the same as for the other constructor.
+
+        @see SamplerStreamer
+    */
+    SamplerSound (const String& name,
+                  AudioFormatReader* sourceToStream,
+                  SamplerStreamer& streamer,
+                  const BigInteger& midiNotes,
+                  int midiNoteForNormalPitch,
+                  double attackTimeSecs,
+                  double releaseTimeSecs,
+                  double maxSampleLengthSeconds,
+                  double preloadLengthSeconds);
+
     /** Destructor. */
     ~SamplerSound() override;
 
@@ -78,10 +202,20 @@ public:
     const String& getName() const noexcept                  { return name; }
 
     /** Returns the audio sample data.
-        This could return nullptr if there was a problem loading the data.
+        For a streamed sound, this only contains the preloaded part of the sample.
+        This returns nullptr if the sample is kept in its native format, or if there
+        was a problem loading the data.
     */
     AudioBuffer<float>* getAudioData() const noexcept       { return data.get(); }
 
+    /** Returns true if the sample is streamed from its source while it is played. */
+    bool isStreamed() const noexcept                        { return reader != nullptr; }
+
+    /** Returns true if the sample is kept in its native format rather than as floats,
+        either in memory or in a memory-mapped file.
+    */
+    bool isInNativeFormat() const noexcept                  { return nativeData != nullptr; }
+
     //==============================================================================
     /** Changes the parameters of the ADSR envelope which will be applied to the sample. */
     void setEnvelopeParameters (ADSR::Parameters parametersToUse)    { params = parametersToUse; }
@@ -93,13 +227,28 @@ public:
 private:
     //==============================================================================
     friend class SamplerVoice;
+    friend class SamplerStreamer;
+
+    struct NativeData;
+
+    void loadAudio (AudioFormatReader&, double attackTimeSecs, double releaseTimeSecs,
+                    double maxSampleLengthSeconds, double preloadLengthSeconds);
+    void loadNativeAudio (AudioFormatReader&, double attackTimeSecs, double releaseTimeSecs,
+                          double maxSampleLengthSeconds);
 
     String name;
     std::unique_ptr<AudioBuffer<float>> data;
+    std::unique_ptr<NativeData> nativeData;
     double sourceSampleRate;
     BigInteger midiNotes;
     int length = 0, midiRootNote = 0;
 
+    // The preloaded length of a streamed sound
+    int preloadLength = 0;
+    std::unique_ptr<AudioFormatReader> reader;
+    CriticalSection readerLock;
+    SamplerStreamer* streamer = nullptr;
+
     ADSR::Parameters params;
 
     JUCE_LEAK_DETECTOR (SamplerSound)
@@ -141,6 +290,16 @@ public:
 
 private:
     //==============================================================================
+    struct InMemorySamples;
+    struct StreamedSamples;
+    template <typename SampleFormat> struct NativeSamples;
+
+    template <typename Source>
+    bool renderSamples (const Source&, const SamplerSound&, AudioBuffer<float>&, int startSample, int numSamples);
+
+    void releaseStream() noexcept;
+
+    SamplerStreamer::Stream* stream = nullptr;
     double pitchRatio = 0;
     double sourceSamplePosition = 0;
     float lgain = 0, rgain = 0;
@@ -180,7 +180,16 @@ struct ConvolutionEngine
         updateSegmentsIfNecessary (numInputSegments, buffersInputSegments);
         updateSegmentsIfNecessary (numSegments,      buffersImpulseSegments);
 
-        auto FFTTempObject = std::make_unique<FFT> (roundToInt (std::log2 (fftSize)));
+        setImpulseResponse (samples, numSamples);
+        reset();
+    }
+
+    // Replaces the impulse response without allocating. The new impulse response
+    // must not need more segments than the one used to create the engine.
+    void setImpulseResponse (const float* samples, size_t numSamples)
+    {
+        jassert (numSamples / (fftSize - blockSize) + 1u <= numSegments);
+
         size_t currentPtr = 0;
 
         for (auto& buf : buffersImpulseSegments)
@@ -192,17 +201,16 @@ struct ConvolutionEngine
             if (&buf == &buffersImpulseSegments.front())
                 impulseResponse[0] = 1.0f;
 
-            FloatVectorOperations::copy (impulseResponse,
-                                         samples + currentPtr,
-                                         static_cast<int> (jmin (fftSize - blockSize, numSamples - currentPtr)));
+            if (currentPtr < numSamples)
+                FloatVectorOperations::copy (impulseResponse,
+                                             samples + currentPtr,
+                                             static_cast<int> (jmin (fftSize - blockSize, numSamples - currentPtr)));
 
-            FFTTempObject->performRealOnlyForwardTransform (impulseResponse);
+            fftObject->performRealOnlyForwardTransform (impulseResponse);
             prepareForConvolution (impulseResponse);
 
             currentPtr += (fftSize - blockSize);
         }
-
-        reset();
     }
 
     void reset()
@@ -439,6 +447,54 @@ struct ConvolutionEngine
     std::vector<AudioBuffer<float>> buffersInputSegments, buffersImpulseSegments;
 };
 
+//==============================================================================
+struct FIR::FFTConvolver::Impl
+{
+    Impl (const float* samples, size_t numSamples, size_t maxBlockSize)
+        : engine (samples, numSamples, maxBlockSize),
+          coefficients (samples, samples + numSamples)
+    {}
+
+    ConvolutionEngine engine;
+    std::vector<float> coefficients;
+};
+
+FIR::FFTConvolver::FFTConvolver (const float* samples, size_t numSamples, size_t maximumBlockSize)
+    : pimpl (std::make_unique<Impl> (samples, numSamples, jlimit ((size_t) 64, (size_t) 4096, maximumBlockSize)))
+{
+}
+
+FIR::FFTConvolver::~FFTConvolver() = default;
+
+size_t FIR::FFTConvolver::getNumCoefficients() const noexcept
+{
+    return pimpl->coefficients.size();
+}
+
+bool FIR::FFTConvolver::hasCoefficients (const float* samples, size_t numSamples) const noexcept
+{
+    return numSamples == pimpl->coefficients.size()
+            && std::equal (pimpl->coefficients.begin(), pimpl->coefficients.end(), samples);
+}
+
+void FIR::FFTConvolver::setCoefficients (const float* samples, size_t numSamples) noexcept
+{
+    jassert (numSamples == pimpl->coefficients.size());
+
+    std::copy (samples, samples + numSamples, pimpl->coefficients.begin());
+    pimpl->engine.setImpulseResponse (samples, numSamples);
+}
+
+void FIR::FFTConvolver::reset() noexcept
+{
+    pimpl->engine.reset();
+}
+
+void FIR::FFTConvolver::process (const float* input, float* output, size_t numSamples) noexcept
+{
+    pimpl->engine.processSamples (input, output, numSamples);
+}
+
 //==============================================================================
 class MultichannelEngine
 {
@@ -64,9 +64,11 @@
 #include "processors/juce_DelayLine.cpp"
 #include "processors/juce_DryWetMixer.cpp"
 #include "processors/juce_StateVariableTPTFilter.cpp"
+#include "processors/juce_FilterBank.cpp"
 #include "maths/juce_SpecialFunctions.cpp"
 #include "maths/juce_Matrix.cpp"
 #include "maths/juce_LookupTable.cpp"
+#include "maths/juce_VectorMath.cpp"
 #include "frequency/juce_FFT.cpp"
 #include "frequency/juce_Convolution.cpp"
 #include "frequency/juce_Windowing.cpp"
@@ -77,6 +79,7 @@
 #include "widgets/juce_Limiter.cpp"
 #include "widgets/juce_Phaser.cpp"
 #include "widgets/juce_Chorus.cpp"
+#include "widgets/juce_WavetableOscillatorBank.cpp"
 
 #if JUCE_USE_SIMD
  #if defined(__i386__) || defined(__amd64__) || defined(_M_X64) || defined(_X86_) || defined(_M_IX86)
@@ -95,6 +98,7 @@
 #if JUCE_UNIT_TESTS
  #include "maths/juce_Matrix_test.cpp"
  #include "maths/juce_LogRampedValue_test.cpp"
+ #include "maths/juce_VectorMath_test.cpp"
 
  #if JUCE_USE_SIMD
   #include "containers/juce_SIMDRegister_test.cpp"
@@ -104,6 +108,11 @@
  #include "containers/juce_FixedSizeFunction_test.cpp"
  #include "frequency/juce_Convolution_test.cpp"
  #include "frequency/juce_FFT_test.cpp"
+ #include "processors/juce_DelayLine_test.cpp"
  #include "processors/juce_FIRFilter_test.cpp"
+ #include "processors/juce_FilterBank_test.cpp"
+ #include "processors/juce_IIRFilter_test.cpp"
+ #include "processors/juce_Oversampling_test.cpp"
  #include "processors/juce_ProcessorChain_test.cpp"
+ #include "widgets/juce_WavetableOscillatorBank_test.cpp"
 #endif
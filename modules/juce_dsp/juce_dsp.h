@@ -244,6 +244,7 @@ namespace juce
 #include "maths/juce_LogRampedValue.h"
 #include "containers/juce_AudioBlock.h"
 #include "containers/juce_FixedSizeFunction.h"
+#include "maths/juce_VectorMath.h"
 #include "processors/juce_ProcessContext.h"
 #include "processors/juce_ProcessorWrapper.h"
 #include "processors/juce_ProcessorChain.h"
@@ -259,6 +260,7 @@ namespace juce
 #include "processors/juce_LinkwitzRileyFilter.h"
 #include "processors/juce_DryWetMixer.h"
 #include "processors/juce_StateVariableTPTFilter.h"
+#include "processors/juce_FilterBank.h"
 #include "frequency/juce_FFT.h"
 #include "frequency/juce_Convolution.h"
 #include "frequency/juce_Windowing.h"
@@ -268,6 +270,7 @@ namespace juce
 #include "widgets/juce_Gain.h"
 #include "widgets/juce_WaveShaper.h"
 #include "widgets/juce_Oscillator.h"
+#include "widgets/juce_WavetableOscillatorBank.h"
 #include "widgets/juce_LadderFilter.h"
 #include "widgets/juce_Compressor.h"
 #include "widgets/juce_NoiseGate.h"
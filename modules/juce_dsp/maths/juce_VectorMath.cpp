@@ -0,0 +1,412 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+namespace VectorMathHelpers
+{
+    //==============================================================================
+    template <typename FloatType>
+    struct Constants;
+
+    template <>
+    struct Constants<float>
+    {
+        static constexpr float minExpInput = -87.33f, maxExpInput = 88.37f, maxTanhInput = 9.5f;
+
+        // Cody-Waite splits of ln (2) and pi / 2, so that the range reductions are exact
+        static constexpr float ln2Hi = 0.693359375f, ln2Lo = -2.12194440e-4f;
+        static constexpr float piOver2Hi = 1.5703125f, piOver2Mid = 4.837512969970703125e-4f, piOver2Lo = 7.54978995489188216e-8f;
+
+        static constexpr int numExponentBits = 7, numReciprocalIterations = 3;
+
+        static const float powersOfTwo[numExponentBits], inversePowersOfTwo[numExponentBits];
+        static const float expCoefficients[6], logCoefficients[4], sinCoefficients[3], cosCoefficients[3];
+    };
+
+    template <>
+    struct Constants<double>
+    {
+        static constexpr double minExpInput = -708.39, maxExpInput = 709.43, maxTanhInput = 20.0;
+
+        static constexpr double ln2Hi = 6.93145751953125e-1, ln2Lo = 1.42860682030941723212e-6;
+        static constexpr double piOver2Hi = 1.57079625129699707031, piOver2Mid = 7.54978941586159635335e-8, piOver2Lo = 5.39030285815811905290e-15;
+
+        static constexpr int numExponentBits = 10, numReciprocalIterations = 4;
+
+        static const double powersOfTwo[numExponentBits], inversePowersOfTwo[numExponentBits];
+        static const double expCoefficients[12], logCoefficients[9], sinCoefficients[6], cosCoefficients[6];
+    };
+
+    const float Constants<float>::powersOfTwo[]         = { std::ldexp (1.0f, 64),  std::ldexp (1.0f, 32),  std::ldexp (1.0f, 16),  std::ldexp (1.0f, 8),
+                                                            std::ldexp (1.0f, 4),   std::ldexp (1.0f, 2),   std::ldexp (1.0f, 1) };
+    const float Constants<float>::inversePowersOfTwo[]  = { std::ldexp (1.0f, -64), std::ldexp (1.0f, -32), std::ldexp (1.0f, -16), std::ldexp (1.0f, -8),
+                                                            std::ldexp (1.0f, -4),  std::ldexp (1.0f, -2),  std::ldexp (1.0f, -1) };
+
+    const double Constants<double>::powersOfTwo[]        = { std::ldexp (1.0, 512),  std::ldexp (1.0, 256),  std::ldexp (1.0, 128),  std::ldexp (1.0, 64),
+                                                             std::ldexp (1.0, 32),   std::ldexp (1.0, 16),   std::ldexp (1.0, 8),    std::ldexp (1.0, 4),
+                                                             std::ldexp (1.0, 2),    std::ldexp (1.0, 1) };
+    const double Constants<double>::inversePowersOfTwo[] = { std::ldexp (1.0, -512), std::ldexp (1.0, -256), std::ldexp (1.0, -128), std::ldexp (1.0, -64),
+                                                             std::ldexp (1.0, -32),  std::ldexp (1.0, -16),  std::ldexp (1.0, -8),   std::ldexp (1.0, -4),
+                                                             std::ldexp (1.0, -2),   std::ldexp (1.0, -1) };
+
+    // Taylor series of (exp (r) - 1 - r) / r^2
+    const float Constants<float>::expCoefficients[] = { 1.0f / 5040.0f, 1.0f / 720.0f, 1.0f / 120.0f, 1.0f / 24.0f, 1.0f / 6.0f, 0.5f };
+
+    const double Constants<double>::expCoefficients[] = { 1.0 / 6227020800.0, 1.0 / 479001600.0, 1.0 / 39916800.0, 1.0 / 3628800.0,
+                                                          1.0 / 362880.0, 1.0 / 40320.0, 1.0 / 5040.0, 1.0 / 720.0,
+                                                          1.0 / 120.0, 1.0 / 24.0, 1.0 / 6.0, 0.5 };
+
+    // Taylor series of (atanh (s) - s) / s^3, as a polynomial of s^2
+    const float Constants<float>::logCoefficients[] = { 1.0f / 9.0f, 1.0f / 7.0f, 1.0f / 5.0f, 1.0f / 3.0f };
+
+    const double Constants<double>::logCoefficients[] = { 1.0 / 19.0, 1.0 / 17.0, 1.0 / 15.0, 1.0 / 13.0, 1.0 / 11.0,
+                                                          1.0 / 9.0,  1.0 / 7.0,  1.0 / 5.0,  1.0 / 3.0 };
+
+    // minimax polynomials on [-pi/4, pi/4] from the Cephes library
+    const float Constants<float>::sinCoefficients[] = { -1.9515295891e-4f, 8.3321608736e-3f, -1.6666654611e-1f };
+    const float Constants<float>::cosCoefficients[] = { 2.443315711809948e-5f, -1.388731625493765e-3f, 4.166664568298827e-2f };
+
+    const double Constants<double>::sinCoefficients[] = {  1.58962301576546568060e-10, -2.50507477628578072866e-8,
+                                                           2.75573136213857245213e-6,  -1.98412698295895385996e-4,
+                                                           8.33333333332211858878e-3,  -1.66666666666666307295e-1 };
+    const double Constants<double>::cosCoefficients[] = { -1.13585365213876817300e-11,  2.08757008419747316778e-9,
+                                                          -2.75573141792967388112e-7,   2.48015872888517045348e-5,
+                                                          -1.38888888888730564116e-3,   4.16666666666665929218e-2 };
+
+    //==============================================================================
+    template <typename FloatType>
+    struct Maths
+    {
+        using C = Constants<FloatType>;
+
+       #if JUCE_USE_SIMD
+        using Vector = SIMDRegister<FloatType>;
+        using Mask   = typename Vector::vMaskType;
+
+        static Vector load (const FloatType* source) noexcept               { return Vector::fromRawArray (source); }
+        static void store (FloatType* dest, Vector value) noexcept          { value.copyToRawArray (dest); }
+
+        static Vector select (Mask mask, Vector a, Vector b) noexcept       { return (a & mask) + (b & ~mask); }
+        static Mask lessThan (Vector a, Vector b) noexcept                  { return Vector::lessThan (a, b); }
+        static Mask greaterThan (Vector a, Vector b) noexcept               { return Vector::greaterThan (a, b); }
+        static Mask greaterThanOrEqual (Vector a, Vector b) noexcept        { return Vector::greaterThanOrEqual (a, b); }
+        static Vector min (Vector a, Vector b) noexcept                     { return Vector::min (a, b); }
+        static Vector max (Vector a, Vector b) noexcept                     { return Vector::max (a, b); }
+        static Vector abs (Vector a) noexcept                               { return Vector::abs (a); }
+        static Vector truncate (Vector a) noexcept                          { return Vector::truncate (a); }
+       #else
+        using Vector = FloatType;
+        using Mask   = bool;
+
+        static Vector load (const FloatType* source) noexcept               { return *source; }
+        static void store (FloatType* dest, Vector value) noexcept          { *dest = value; }
+
+        static Vector select (Mask mask, Vector a, Vector b) noexcept       { return mask ? a : b; }
+        static Mask lessThan (Vector a, Vector b) noexcept                  { return a < b; }
+        static Mask greaterThan (Vector a, Vector b) noexcept               { return a > b; }
+        static Mask greaterThanOrEqual (Vector a, Vector b) noexcept        { return a >= b; }
+        static Vector min (Vector a, Vector b) noexcept                     { return b < a ? b : a; }
+        static Vector max (Vector a, Vector b) noexcept                     { return a < b ? b : a; }
+        static Vector abs (Vector a) noexcept                               { return std::abs (a); }
+        static Vector truncate (Vector a) noexcept                          { return std::trunc (a); }
+       #endif
+
+        static constexpr int width = (int) (sizeof (Vector) / sizeof (FloatType));
+
+        //==============================================================================
+        template <typename Kernel>
+        static void apply (FloatType* dest, const FloatType* src, int numValues, Kernel&& kernel) noexcept
+        {
+            constexpr int chunkSize = 64;
+
+            FloatType storage[(size_t) (chunkSize + width)];
+            auto* buffer = snapPointerToAlignment (storage, sizeof (Vector));
+
+            for (int start = 0; start < numValues; start += chunkSize)
+            {
+                auto num = jmin (chunkSize, numValues - start);
+                auto numPadded = ((num + width - 1) / width) * width;
+
+                std::copy (src + start, src + start + num, buffer);
+                std::fill (buffer + num, buffer + numPadded, FloatType (1));
+
+                for (int i = 0; i < numPadded; i += width)
+                    store (buffer + i, kernel (load (buffer + i)));
+
+                std::copy (buffer, buffer + num, dest + start);
+            }
+        }
+
+        //==============================================================================
+        template <size_t numCoefficients>
+        static Vector horner (Vector x, const FloatType (&coefficients)[numCoefficients]) noexcept
+        {
+            Vector result (coefficients[0]);
+
+            for (size_t i = 1; i < numCoefficients; ++i)
+                result = result * x + coefficients[i];
+
+            return result;
+        }
+
+        static Vector floor (Vector x) noexcept
+        {
+            auto t = truncate (x);
+            return select (lessThan (x, t), t - (FloatType) 1, t);
+        }
+
+        /*  Calculates 1 / d for values of d between lo and hi, starting from the linear
+            estimate with the smallest maximum relative error on that range. There's no
+            division in SIMDRegister, and this is as fast and exact for bounded inputs.
+        */
+        static Vector reciprocal (Vector d, FloatType lo, FloatType hi) noexcept
+        {
+            auto beta  = (FloatType) 8 / ((lo + hi) * (lo + hi) + (FloatType) 4 * lo * hi);
+            auto alpha = beta * (lo + hi);
+
+            auto r = Vector (alpha) - d * beta;
+
+            for (int i = 0; i < C::numReciprocalIterations; ++i)
+                r = r * (Vector ((FloatType) 2) - d * r);
+
+            return r;
+        }
+
+        /*  Returns 2^n for an integer n, with abs (n) < 2^numExponentBits. */
+        static Vector powerOfTwo (Vector n) noexcept
+        {
+            auto isNegative = lessThan (n, (FloatType) 0);
+            auto remaining = abs (n);
+            Vector result ((FloatType) 1);
+
+            for (int i = 0; i < C::numExponentBits; ++i)
+            {
+                auto bit = (FloatType) (1 << (C::numExponentBits - 1 - i));
+                auto hasBit = greaterThanOrEqual (remaining, bit);
+                auto factor = select (isNegative, Vector (C::inversePowersOfTwo[i]), Vector (C::powersOfTwo[i]));
+
+                result = result * select (hasBit, factor, Vector ((FloatType) 1));
+                remaining = remaining - select (hasBit, Vector (bit), Vector ((FloatType) 0));
+            }
+
+            return result;
+        }
+
+        //==============================================================================
+        /*  Returns q so that exp (x) = scale * (1 + q), which keeps the full relative
+            precision of exp (x) - 1 for small inputs.
+        */
+        static Vector expParts (Vector x, Vector& scale) noexcept
+        {
+            x = max (min (x, C::maxExpInput), C::minExpInput);
+
+            auto n = floor (x * (FloatType) 1.4426950408889634 + (FloatType) 0.5);
+            auto r = x - n * C::ln2Hi - n * C::ln2Lo;
+
+            scale = powerOfTwo (n);
+            return r + r * r * horner (r, C::expCoefficients);
+        }
+
+        static Vector exp (Vector x) noexcept
+        {
+            Vector scale;
+            auto q = expParts (x, scale);
+            return scale + scale * q;
+        }
+
+        static Vector log (Vector x) noexcept
+        {
+            constexpr auto smallestNormal = std::numeric_limits<FloatType>::min();
+            constexpr auto smallestExponent = (FloatType) (1 - std::numeric_limits<FloatType>::min_exponent);
+
+            x = max (x, smallestNormal);
+
+            // splits x into m * 2^e with m in [1, 2), using a binary search on the exponent
+            auto isSmall = lessThan (x, (FloatType) 1);
+            auto m = x * select (isSmall, Vector ((FloatType) 1 / smallestNormal), Vector ((FloatType) 1));
+            auto e = select (isSmall, Vector (-smallestExponent), Vector ((FloatType) 0));
+
+            for (int i = 0; i < C::numExponentBits; ++i)
+            {
+                auto hasBit = greaterThanOrEqual (m, C::powersOfTwo[i]);
+
+                m = m * select (hasBit, Vector (C::inversePowersOfTwo[i]), Vector ((FloatType) 1));
+                e = e + select (hasBit, Vector ((FloatType) (1 << (C::numExponentBits - 1 - i))), Vector ((FloatType) 0));
+            }
+
+            auto isLarge = greaterThan (m, MathConstants<FloatType>::sqrt2);
+            m = select (isLarge, m * (FloatType) 0.5, m);
+            e = e + select (isLarge, Vector ((FloatType) 1), Vector ((FloatType) 0));
+
+            // log (m) = 2 * atanh ((m - 1) / (m + 1))
+            auto s = (m - (FloatType) 1) * reciprocal (m + (FloatType) 1,
+                                                       (FloatType) 1 + MathConstants<FloatType>::sqrt2 / (FloatType) 2,
+                                                       (FloatType) 1 + MathConstants<FloatType>::sqrt2);
+            auto z = s * s;
+            auto logM = (s + s * z * horner (z, C::logCoefficients)) * (FloatType) 2;
+
+            return e * C::ln2Hi + (logM + e * C::ln2Lo);
+        }
+
+        static Vector tanh (Vector x) noexcept
+        {
+            // tanh (a) = (1 - u) / (1 + u) with u = exp (-2a), which is in (0, 1]
+            auto a = min (abs (x), C::maxTanhInput);
+
+            Vector scale;
+            auto q = expParts (a * (FloatType) -2, scale);
+
+            auto oneMinusU = Vector ((FloatType) 0) - (scale * q + (scale - (FloatType) 1));
+            auto onePlusU  = Vector ((FloatType) 2) - oneMinusU;
+
+            auto result = oneMinusU * reciprocal (onePlusU, (FloatType) 1, (FloatType) 2);
+            return select (lessThan (x, (FloatType) 0), Vector ((FloatType) 0) - result, result);
+        }
+
+        /*  Calculates sin (x + quadrantOffset * pi / 2). */
+        static Vector sin (Vector x, FloatType quadrantOffset) noexcept
+        {
+            auto k = floor (x * (FloatType) 0.6366197723675814 + (FloatType) 0.5);
+            auto r = x - k * C::piOver2Hi - k * C::piOver2Mid - k * C::piOver2Lo;
+            auto z = r * r;
+
+            auto sinR = r + r * z * horner (z, C::sinCoefficients);
+            auto cosR = Vector ((FloatType) 1) - z * (FloatType) 0.5 + z * z * horner (z, C::cosCoefficients);
+
+            auto quadrant = k + quadrantOffset;
+            quadrant = quadrant - floor (quadrant * (FloatType) 0.25) * (FloatType) 4;
+
+            auto isOdd = greaterThan (quadrant - floor (quadrant * (FloatType) 0.5) * (FloatType) 2, (FloatType) 0.5);
+            auto result = select (isOdd, cosR, sinR);
+
+            return select (greaterThanOrEqual (quadrant, (FloatType) 2), Vector ((FloatType) 0) - result, result);
+        }
+
+        static Vector pow (Vector x, FloatType exponent) noexcept
+        {
+            return select (greaterThan (x, (FloatType) 0), exp (log (x) * exponent), Vector ((FloatType) 0));
+        }
+
+        //==============================================================================
+        static void exp (FloatType* dest, const FloatType* src, int num) noexcept
+        {
+            apply (dest, src, num, [] (Vector x) { return exp (x); });
+        }
+
+        static void log (FloatType* dest, const FloatType* src, int num) noexcept
+        {
+            apply (dest, src, num, [] (Vector x) { return log (x); });
+        }
+
+        static void tanh (FloatType* dest, const FloatType* src, int num) noexcept
+        {
+            apply (dest, src, num, [] (Vector x) { return tanh (x); });
+        }
+
+        static void sin (FloatType* dest, const FloatType* src, int num) noexcept
+        {
+            apply (dest, src, num, [] (Vector x) { return sin (x, (FloatType) 0); });
+        }
+
+        static void cos (FloatType* dest, const FloatType* src, int num) noexcept
+        {
+            apply (dest, src, num, [] (Vector x) { return sin (x, (FloatType) 1); });
+        }
+
+        static void pow (FloatType* dest, const FloatType* src, FloatType exponent, int num) noexcept
+        {
+            apply (dest, src, num, [exponent] (Vector x) { return pow (x, exponent); });
+        }
+
+        static void decibelsToGain (FloatType* dest, const FloatType* src, int num, FloatType minusInfinityDb) noexcept
+        {
+            apply (dest, src, num, [minusInfinityDb] (Vector x)
+            {
+                return select (greaterThan (x, minusInfinityDb),
+                               exp (x * (FloatType) 0.11512925464970229),
+                               Vector ((FloatType) 0));
+            });
+        }
+
+        static void gainToDecibels (FloatType* dest, const FloatType* src, int num, FloatType minusInfinityDb) noexcept
+        {
+            apply (dest, src, num, [minusInfinityDb] (Vector x)
+            {
+                return select (greaterThan (x, (FloatType) 0),
+                               max (log (x) * (FloatType) 8.685889638065035, minusInfinityDb),
+                               Vector (minusInfinityDb));
+            });
+        }
+    };
+}
+
+//==============================================================================
+void VectorMath::exp (float* dest, const float* src, int num) noexcept      { VectorMathHelpers::Maths<float>::exp (dest, src, num); }
+void VectorMath::exp (double* dest, const double* src, int num) noexcept    { VectorMathHelpers::Maths<double>::exp (dest, src, num); }
+void VectorMath::log (float* dest, const float* src, int num) noexcept      { VectorMathHelpers::Maths<float>::log (dest, src, num); }
+void VectorMath::log (double* dest, const double* src, int num) noexcept    { VectorMathHelpers::Maths<double>::log (dest, src, num); }
+void VectorMath::tanh (float* dest, const float* src, int num) noexcept     { VectorMathHelpers::Maths<float>::tanh (dest, src, num); }
+void VectorMath::tanh (double* dest, const double* src, int num) noexcept   { VectorMathHelpers::Maths<double>::tanh (dest, src, num); }
+void VectorMath::sin (float* dest, const float* src, int num) noexcept      { VectorMathHelpers::Maths<float>::sin (dest, src, num); }
+void VectorMath::sin (double* dest, const double* src, int num) noexcept    { VectorMathHelpers::Maths<double>::sin (dest, src, num); }
+void VectorMath::cos (float* dest, const float* src, int num) noexcept      { VectorMathHelpers::Maths<float>::cos (dest, src, num); }
+void VectorMath::cos (double* dest, const double* src, int num) noexcept    { VectorMathHelpers::Maths<double>::cos (dest, src, num); }
+
+void VectorMath::pow (float* dest, const float* src, float exponent, int num) noexcept
+{
+    VectorMathHelpers::Maths<float>::pow (dest, src, exponent, num);
+}
+
+void VectorMath::pow (double* dest, const double* src, double exponent, int num) noexcept
+{
+    VectorMathHelpers::Maths<double>::pow (dest, src, exponent, num);
+}
+
+void VectorMath::decibelsToGain (float* dest, const float* src, int num, float minusInfinityDb) noexcept
+{
+    VectorMathHelpers::Maths<float>::decibelsToGain (dest, src, num, minusInfinityDb);
+}
+
+void VectorMath::decibelsToGain (double* dest, const double* src, int num, double minusInfinityDb) noexcept
+{
+    VectorMathHelpers::Maths<double>::decibelsToGain (dest, src, num, minusInfinityDb);
+}
+
+void VectorMath::gainToDecibels (float* dest, const float* src, int num, float minusInfinityDb) noexcept
+{
+    VectorMathHelpers::Maths<float>::gainToDecibels (dest, src, num, minusInfinityDb);
+}
+
+void VectorMath::gainToDecibels (double* dest, const double* src, int num, double minusInfinityDb) noexcept
+{
+    VectorMathHelpers::Maths<double>::gainToDecibels (dest, src, num, minusInfinityDb);
+}
+
+} // namespace dsp
+} // namespace juce
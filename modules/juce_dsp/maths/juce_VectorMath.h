@@ -0,0 +1,243 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    A set of transcendental functions which are calculated on whole buffers at
+    once, using SIMD registers when they are available.
+
+    Unlike FastMathApproximations, these functions are accurate over the whole
+    range of their arguments, and they are much faster than calling the standard
+    library functions on each sample. The results don't depend on the platform,
+    since the same algorithms are used when SIMD isn't available.
+
+    The maximum errors, measured against the standard library functions, are
+    given below, with eps = 2e-7 for float and eps = 4e-16 for double:
+
+    | Function         | Maximum error                                         |
+    |------------------|-------------------------------------------------------|
+    | exp              | eps relative                                          |
+    | log              | eps absolute, or relative when abs (result) > 1       |
+    | tanh             | 1.5 * eps relative                                    |
+    | sin, cos         | eps absolute                                          |
+    | pow              | eps * (1 + abs (exponent * log (x))) relative         |
+    | decibelsToGain   | eps * (1 + abs (decibels) / 20) relative              |
+    | gainToDecibels   | eps * (10 + abs (result)) absolute                    |
+
+    The destination and source buffers can be the same for in-place processing,
+    and they don't need to be aligned.
+
+    @see FastMathApproximations, FloatVectorOperations, WaveShaper
+
+    @tags{DSP}
+*/
+struct VectorMath
+{
+    //==============================================================================
+    /** Calculates exp (x) for each element of the source buffer.
+
+        The results are limited to the range of the normal floating point numbers,
+        so inputs smaller than about -87 (float) or -708 (double) return the smallest
+        normal number instead of a denormal, and inputs larger than about 88 (float)
+        or 709 (double) saturate instead of returning infinity.
+    */
+    static void exp (float* dest, const float* src, int numValues) noexcept;
+
+    /** Calculates exp (x) for each element of the source buffer. */
+    static void exp (double* dest, const double* src, int numValues) noexcept;
+
+    /** Calculates the natural logarithm of each element of the source buffer.
+
+        Zero, negative and denormal inputs return the logarithm of the smallest
+        normal number, rather than minus infinity or NaN.
+    */
+    static void log (float* dest, const float* src, int numValues) noexcept;
+
+    /** Calculates the natural logarithm of each element of the source buffer. */
+    static void log (double* dest, const double* src, int numValues) noexcept;
+
+    /** Calculates tanh (x) for each element of the source buffer. */
+    static void tanh (float* dest, const float* src, int numValues) noexcept;
+
+    /** Calculates tanh (x) for each element of the source buffer. */
+    static void tanh (double* dest, const double* src, int numValues) noexcept;
+
+    /** Calculates sin (x) for each element of the source buffer.
+
+        The error bounds are guaranteed for inputs between -8192 and +8192 (float),
+        or -1e6 and +1e6 (double), which are reduced to the [-pi/4, pi/4] range
+        before calculating the result.
+    */
+    static void sin (float* dest, const float* src, int numValues) noexcept;
+
+    /** Calculates sin (x) for each element of the source buffer. */
+    static void sin (double* dest, const double* src, int numValues) noexcept;
+
+    /** Calculates cos (x) for each element of the source buffer.
+
+        The error bounds are guaranteed for inputs between -8192 and +8192 (float),
+        or -1e6 and +1e6 (double).
+    */
+    static void cos (float* dest, const float* src, int numValues) noexcept;
+
+    /** Calculates cos (x) for each element of the source buffer. */
+    static void cos (double* dest, const double* src, int numValues) noexcept;
+
+    /** Raises each element of the source buffer to the given power.
+
+        This is only defined for positive inputs: zero and negative inputs return zero.
+    */
+    static void pow (float* dest, const float* src, float exponent, int numValues) noexcept;
+
+    /** Raises each element of the source buffer to the given power. */
+    static void pow (double* dest, const double* src, double exponent, int numValues) noexcept;
+
+    /** Converts each element of the source buffer from decibels to a gain, in the
+        same way as Decibels::decibelsToGain.
+    */
+    static void decibelsToGain (float* dest, const float* src, int numValues,
+                                float minusInfinityDb = -100.0f) noexcept;
+
+    /** Converts each element of the source buffer from decibels to a gain. */
+    static void decibelsToGain (double* dest, const double* src, int numValues,
+                                double minusInfinityDb = -100.0) noexcept;
+
+    /** Converts each element of the source buffer from a gain to decibels, in the
+        same way as Decibels::gainToDecibels.
+    */
+    static void gainToDecibels (float* dest, const float* src, int numValues,
+                                float minusInfinityDb = -100.0f) noexcept;
+
+    /** Converts each element of the source buffer from a gain to decibels. */
+    static void gainToDecibels (double* dest, const double* src, int numValues,
+                                double minusInfinityDb = -100.0) noexcept;
+
+    //==============================================================================
+    /** Replaces each sample of an AudioBlock with its exponential. */
+    template <typename SampleType>
+    static void exp (const AudioBlock<SampleType>& block) noexcept
+    {
+        processInPlace (block, [] (SampleType* d, const SampleType* s, int n) { exp (d, s, n); });
+    }
+
+    /** Replaces each sample of an AudioBlock with its natural logarithm. */
+    template <typename SampleType>
+    static void log (const AudioBlock<SampleType>& block) noexcept
+    {
+        processInPlace (block, [] (SampleType* d, const SampleType* s, int n) { log (d, s, n); });
+    }
+
+    /** Replaces each sample of an AudioBlock with its hyperbolic tangent. */
+    template <typename SampleType>
+    static void tanh (const AudioBlock<SampleType>& block) noexcept
+    {
+        processInPlace (block, [] (SampleType* d, const SampleType* s, int n) { tanh (d, s, n); });
+    }
+
+    /** Replaces each sample of an AudioBlock with its sine. */
+    template <typename SampleType>
+    static void sin (const AudioBlock<SampleType>& block) noexcept
+    {
+        processInPlace (block, [] (SampleType* d, const SampleType* s, int n) { sin (d, s, n); });
+    }
+
+    /** Replaces each sample of an AudioBlock with its cosine. */
+    template <typename SampleType>
+    static void cos (const AudioBlock<SampleType>& block) noexcept
+    {
+        processInPlace (block, [] (SampleType* d, const SampleType* s, int n) { cos (d, s, n); });
+    }
+
+    /** Raises each sample of an AudioBlock to the given power. */
+    template <typename SampleType>
+    static void pow (const AudioBlock<SampleType>& block, SampleType exponent) noexcept
+    {
+        processInPlace (block, [exponent] (SampleType* d, const SampleType* s, int n) { pow (d, s, exponent, n); });
+    }
+
+    /** Converts each sample of an AudioBlock from decibels to a gain. */
+    template <typename SampleType>
+    static void decibelsToGain (const AudioBlock<SampleType>& block,
+                                SampleType minusInfinityDb = SampleType (-100)) noexcept
+    {
+        processInPlace (block, [minusInfinityDb] (SampleType* d, const SampleType* s, int n) { decibelsToGain (d, s, n, minusInfinityDb); });
+    }
+
+    /** Converts each sample of an AudioBlock from a gain to decibels. */
+    template <typename SampleType>
+    static void gainToDecibels (const AudioBlock<SampleType>& block,
+                                SampleType minusInfinityDb = SampleType (-100)) noexcept
+    {
+        processInPlace (block, [minusInfinityDb] (SampleType* d, const SampleType* s, int n) { gainToDecibels (d, s, n, minusInfinityDb); });
+    }
+
+    //==============================================================================
+    /** A function object calculating tanh, which can be used as the function of a
+        WaveShaper to process whole blocks with VectorMath::tanh.
+
+        Single samples are processed with std::tanh.
+    */
+    struct Tanh
+    {
+        template <typename SampleType>
+        SampleType operator() (SampleType x) const noexcept                                        { return std::tanh (x); }
+
+        template <typename SampleType>
+        void operator() (SampleType* dest, const SampleType* src, size_t numValues) const noexcept { tanh (dest, src, (int) numValues); }
+    };
+
+    /** A function object calculating sin, which can be used as the function of a
+        WaveShaper to process whole blocks with VectorMath::sin.
+
+        Single samples are processed with std::sin.
+    */
+    struct Sin
+    {
+        template <typename SampleType>
+        SampleType operator() (SampleType x) const noexcept                                        { return std::sin (x); }
+
+        template <typename SampleType>
+        void operator() (SampleType* dest, const SampleType* src, size_t numValues) const noexcept { sin (dest, src, (int) numValues); }
+    };
+
+private:
+    //==============================================================================
+    template <typename SampleType, typename Function>
+    static void processInPlace (const AudioBlock<SampleType>& block, Function&& function) noexcept
+    {
+        for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+        {
+            auto* samples = block.getChannelPointer (channel);
+            function (samples, samples, (int) block.getNumSamples());
+        }
+    }
+};
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,327 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class VectorMathTest : public UnitTest
+{
+public:
+    VectorMathTest()
+        : UnitTest ("Vector Math", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Exponential");
+        {
+            runFunctionTest<float>  (&expFloat,  [] (double x) { return std::exp (x); }, -87.0, 88.0, 2.0e-7, true);
+            runFunctionTest<double> (&expDouble, [] (double x) { return std::exp (x); }, -700.0, 700.0, 4.0e-16, true);
+        }
+
+        beginTest ("Logarithm");
+        {
+            runFunctionTest<float>  (&logFloat,  [] (double x) { return std::log (x); }, 1.0e-37, 1.0e37, 2.0e-7, false, true);
+            runFunctionTest<double> (&logDouble, [] (double x) { return std::log (x); }, 1.0e-300, 1.0e300, 4.0e-16, false, true);
+            runFunctionTest<float>  (&logFloat,  [] (double x) { return std::log (x); }, 0.5, 2.0, 2.0e-7, false);
+            runFunctionTest<double> (&logDouble, [] (double x) { return std::log (x); }, 0.5, 2.0, 4.0e-16, false);
+        }
+
+        beginTest ("Hyperbolic tangent");
+        {
+            runFunctionTest<float>  (&tanhFloat,  [] (double x) { return std::tanh (x); }, -12.0, 12.0, 3.0e-7, true);
+            runFunctionTest<double> (&tanhDouble, [] (double x) { return std::tanh (x); }, -25.0, 25.0, 8.0e-16, true);
+            runFunctionTest<float>  (&tanhFloat,  [] (double x) { return std::tanh (x); }, -1.0e-3, 1.0e-3, 3.0e-7, true);
+            runFunctionTest<double> (&tanhDouble, [] (double x) { return std::tanh (x); }, -1.0e-3, 1.0e-3, 8.0e-16, true);
+        }
+
+        beginTest ("Sine and cosine");
+        {
+            runFunctionTest<float>  (&sinFloat,  [] (double x) { return std::sin (x); }, -8192.0, 8192.0, 2.0e-7, false);
+            runFunctionTest<double> (&sinDouble, [] (double x) { return std::sin (x); }, -1.0e6, 1.0e6, 4.0e-16, false);
+            runFunctionTest<float>  (&cosFloat,  [] (double x) { return std::cos (x); }, -8192.0, 8192.0, 2.0e-7, false);
+            runFunctionTest<double> (&cosDouble, [] (double x) { return std::cos (x); }, -1.0e6, 1.0e6, 4.0e-16, false);
+        }
+
+        beginTest ("Power");
+        {
+            runPowTest<float>  (2.0e-7);
+            runPowTest<double> (4.0e-16);
+        }
+
+        beginTest ("Decibels");
+        {
+            runDecibelsTest<float>  (2.0e-7);
+            runDecibelsTest<double> (4.0e-16);
+        }
+
+        beginTest ("Special values");
+        {
+            float input[]  = { 0.0f, -1.0f, 1.0f, -0.0f, 1.0e30f, -1.0e30f };
+            float output[6];
+
+            VectorMath::log (output, input, 3);
+            expectEquals (output[0], std::log (std::numeric_limits<float>::min()));
+            expectEquals (output[1], std::log (std::numeric_limits<float>::min()));
+            expectEquals (output[2], 0.0f);
+
+            VectorMath::exp (output, input, 1);
+            expectEquals (output[0], 1.0f);
+
+            VectorMath::tanh (output, input, 6);
+            expectEquals (output[0], 0.0f);
+            expectEquals (output[4], 1.0f);
+            expectEquals (output[5], -1.0f);
+
+            VectorMath::pow (output, input, 2.0f, 3);
+            expectEquals (output[0], 0.0f);
+            expectEquals (output[1], 0.0f);
+            expectEquals (output[2], 1.0f);
+
+            VectorMath::gainToDecibels (output, input, 3);
+            expectEquals (output[0], -100.0f);
+            expectEquals (output[1], -100.0f);
+            expectEquals (output[2], 0.0f);
+        }
+
+        beginTest ("AudioBlock functions");
+        {
+            AudioBuffer<float> buffer (3, 100), expected (3, 100);
+            auto random = getRandom();
+
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                    buffer.setSample (channel, i, random.nextFloat() * 8.0f - 4.0f);
+
+            expected.makeCopyOf (buffer);
+
+            for (int channel = 0; channel < expected.getNumChannels(); ++channel)
+                VectorMath::tanh (expected.getWritePointer (channel), expected.getReadPointer (channel), expected.getNumSamples());
+
+            VectorMath::tanh (AudioBlock<float> (buffer));
+
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                    expectEquals (buffer.getSample (channel, i), expected.getSample (channel, i));
+        }
+
+        beginTest ("WaveShaper processes blocks with the vectorised functions");
+        {
+            AudioBuffer<float> buffer (2, 300);
+            auto random = getRandom();
+
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                    buffer.setSample (channel, i, random.nextFloat() * 8.0f - 4.0f);
+
+            AudioBuffer<float> output (2, 300);
+
+            WaveShaper<float, VectorMath::Tanh> shaper;
+            AudioBlock<float> outputBlock (output);
+            shaper.process (ProcessContextNonReplacing<float> (AudioBlock<const float> (buffer), outputBlock));
+
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            {
+                float expected[300];
+                VectorMath::tanh (expected, buffer.getReadPointer (channel), 300);
+
+                for (int i = 0; i < 300; ++i)
+                {
+                    expectEquals (output.getSample (channel, i), expected[i]);
+                    expectWithinAbsoluteError (shaper.processSample (buffer.getSample (channel, i)), expected[i], 1.0e-6f);
+                }
+            }
+        }
+
+        beginTest ("Compressor with vectorised gain computation");
+        {
+            runCompressorTest<float>  (1.0e-5);
+            runCompressorTest<double> (1.0e-12);
+        }
+    }
+
+private:
+    //==============================================================================
+    static void expFloat   (float* d, const float* s, int n)     { VectorMath::exp (d, s, n); }
+    static void expDouble  (double* d, const double* s, int n)   { VectorMath::exp (d, s, n); }
+    static void logFloat   (float* d, const float* s, int n)     { VectorMath::log (d, s, n); }
+    static void logDouble  (double* d, const double* s, int n)   { VectorMath::log (d, s, n); }
+    static void tanhFloat  (float* d, const float* s, int n)     { VectorMath::tanh (d, s, n); }
+    static void tanhDouble (double* d, const double* s, int n)   { VectorMath::tanh (d, s, n); }
+    static void sinFloat   (float* d, const float* s, int n)     { VectorMath::sin (d, s, n); }
+    static void sinDouble  (double* d, const double* s, int n)   { VectorMath::sin (d, s, n); }
+    static void cosFloat   (float* d, const float* s, int n)     { VectorMath::cos (d, s, n); }
+    static void cosDouble  (double* d, const double* s, int n)   { VectorMath::cos (d, s, n); }
+
+    static constexpr int numValues = 10000;
+
+    template <typename FloatType>
+    std::vector<FloatType> makeInput (double minimum, double maximum, bool logarithmic)
+    {
+        auto random = getRandom();
+        std::vector<FloatType> input (numValues);
+
+        for (auto& x : input)
+        {
+            auto proportion = random.nextDouble();
+
+            x = (FloatType) (logarithmic ? std::exp (std::log (minimum) + (std::log (maximum) - std::log (minimum)) * proportion)
+                                         : minimum + (maximum - minimum) * proportion);
+        }
+
+        return input;
+    }
+
+    template <typename FloatType, typename Reference>
+    void runFunctionTest (void (*function) (FloatType*, const FloatType*, int), Reference reference,
+                          double minimum, double maximum, double maximumError, bool relativeError,
+                          bool logarithmic = false)
+    {
+        auto input = makeInput<FloatType> (minimum, maximum, logarithmic);
+        std::vector<FloatType> output (numValues + 1);
+
+        // use an unaligned destination, and an odd number of values
+        function (output.data() + 1, input.data(), numValues - 1);
+
+        auto worstError = 0.0;
+
+        for (int i = 0; i < numValues - 1; ++i)
+        {
+            auto expected = reference ((double) input[(size_t) i]);
+            auto error = std::abs ((double) output[(size_t) i + 1] - expected);
+
+            // the absolute errors become relative when the results are larger than one
+            error /= relativeError ? jmax (std::abs (expected), (double) std::numeric_limits<FloatType>::min())
+                                   : jmax (std::abs (expected), 1.0);
+
+            worstError = jmax (worstError, error);
+        }
+
+        expectLessThan (worstError, maximumError);
+
+        // in-place processing
+        auto inPlace = input;
+        function (inPlace.data(), inPlace.data(), numValues);
+
+        for (int i = 0; i < numValues - 1; ++i)
+            if (inPlace[(size_t) i] != output[(size_t) i + 1])
+                return expect (false, "in-place processing gives different results");
+    }
+
+    template <typename FloatType>
+    void runPowTest (double epsilon)
+    {
+        auto input = makeInput<FloatType> (1.0e-3, 1.0e3, true);
+        std::vector<FloatType> output (numValues);
+
+        for (auto exponent : { (FloatType) 0.25, (FloatType) -1.5, (FloatType) 3 })
+        {
+            VectorMath::pow (output.data(), input.data(), exponent, numValues);
+
+            for (size_t i = 0; i < (size_t) numValues; ++i)
+            {
+                auto expected = std::pow ((double) input[i], (double) exponent);
+                auto bound = epsilon * (1.0 + std::abs ((double) exponent * std::log ((double) input[i])));
+
+                if (std::abs ((double) output[i] - expected) > bound * expected)
+                    return expect (false, "pow error is too large");
+            }
+        }
+    }
+
+    template <typename FloatType>
+    void runDecibelsTest (double epsilon)
+    {
+        auto decibels = makeInput<FloatType> (-120.0, 40.0, false);
+        auto gains = makeInput<FloatType> (1.0e-7, 100.0, true);
+        std::vector<FloatType> output (numValues);
+
+        VectorMath::decibelsToGain (output.data(), decibels.data(), numValues);
+
+        for (size_t i = 0; i < (size_t) numValues; ++i)
+        {
+            auto expected = Decibels::decibelsToGain ((double) decibels[i]);
+
+            auto bound = epsilon * (1.0 + std::abs ((double) decibels[i]) / 20.0);
+
+            if (std::abs ((double) output[i] - expected) > bound * expected)
+                return expect (false, "decibelsToGain error is too large");
+        }
+
+        VectorMath::gainToDecibels (output.data(), gains.data(), numValues);
+
+        for (size_t i = 0; i < (size_t) numValues; ++i)
+        {
+            auto expected = Decibels::gainToDecibels ((double) gains[i]);
+
+            if (std::abs ((double) output[i] - expected) > epsilon * (10.0 + std::abs (expected)))
+                return expect (false, "gainToDecibels error is too large");
+        }
+    }
+
+    template <typename SampleType>
+    void runCompressorTest (double tolerance)
+    {
+        constexpr int numChannels = 2, numSamples = 1000;
+
+        Compressor<SampleType> reference, compressor;
+        compressor.setUsingVectorisedMath (true);
+
+        for (auto* c : { &reference, &compressor })
+        {
+            c->setThreshold ((SampleType) -20);
+            c->setRatio ((SampleType) 4);
+            c->setAttack ((SampleType) 1);
+            c->setRelease ((SampleType) 50);
+            c->prepare ({ 44100.0, (uint32) numSamples, (uint32) numChannels });
+        }
+
+        AudioBuffer<SampleType> buffer (numChannels, numSamples), expected;
+        auto random = getRandom();
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample (channel, i, (SampleType) ((random.nextDouble() * 2.0 - 1.0) * std::sin (i * 0.01)));
+
+        expected.makeCopyOf (buffer);
+
+        AudioBlock<SampleType> block (buffer), expectedBlock (expected);
+        compressor.process (ProcessContextReplacing<SampleType> (block));
+        reference.process (ProcessContextReplacing<SampleType> (expectedBlock));
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                expectWithinAbsoluteError ((double) buffer.getSample (channel, i),
+                                           (double) expected.getSample (channel, i),
+                                           tolerance);
+    }
+};
+
+static VectorMathTest vectorMathTest;
+
+} // namespace dsp
+} // namespace juce
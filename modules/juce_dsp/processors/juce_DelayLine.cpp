@@ -41,6 +41,7 @@ DelayLine<SampleType, InterpolationType>::DelayLine (int maximumDelayInSamples)
     jassert (maximumDelayInSamples >= 0);
 
     totalSize = jmax (4, maximumDelayInSamples + 1);
+    maximumDelay = totalSize - 1;
     sampleRate = 44100.0;
 }
 
@@ -48,7 +49,7 @@ DelayLine<SampleType, InterpolationType>::DelayLine (int maximumDelayInSamples)
 template <typename SampleType, typename InterpolationType>
 void DelayLine<SampleType, InterpolationType>::setDelay (SampleType newDelayInSamples)
 {
-    auto upperLimit = (SampleType) (totalSize - 1);
+    auto upperLimit = (SampleType) maximumDelay;
     jassert (isPositiveAndNotGreaterThan (newDelayInSamples, upperLimit));
 
     delay     = jlimit ((SampleType) 0, upperLimit, newDelayInSamples);
@@ -70,7 +71,11 @@ void DelayLine<SampleType, InterpolationType>::prepare (const ProcessSpec& spec)
 {
     jassert (spec.numChannels > 0);
 
-    bufferData.setSize ((int) spec.numChannels, totalSize, false, false, true);
+    // the buffer needs some extra space to push whole blocks before reading them
+    maximumBlockSize = jmax (1, (int) spec.maximumBlockSize);
+    totalSize = maximumDelay + 1 + maximumBlockSize;
+
+    bufferData.setSize ((int) spec.numChannels, totalSize + numGuardSamples, false, false, true);
 
     writePos.resize (spec.numChannels);
     readPos.resize  (spec.numChannels);
@@ -96,8 +101,14 @@ void DelayLine<SampleType, InterpolationType>::reset()
 template <typename SampleType, typename InterpolationType>
 void DelayLine<SampleType, InterpolationType>::pushSample (int channel, SampleType sample)
 {
-    bufferData.setSample (channel, writePos[(size_t) channel], sample);
-    writePos[(size_t) channel] = (writePos[(size_t) channel] + totalSize - 1) % totalSize;
+    auto& pos = writePos[(size_t) channel];
+
+    bufferData.setSample (channel, pos, sample);
+
+    if (pos < numGuardSamples)
+        bufferData.setSample (channel, pos + totalSize, sample);
+
+    pos = (pos + totalSize - 1) % totalSize;
 }
 
 template <typename SampleType, typename InterpolationType>
@@ -114,6 +125,51 @@ SampleType DelayLine<SampleType, InterpolationType>::popSample (int channel, Sam
     return result;
 }
 
+//==============================================================================
+template <typename SampleType, typename InterpolationType>
+void DelayLine<SampleType, InterpolationType>::pushBlock (int channel, const SampleType* samples, int numSamples)
+{
+    // You can't push more samples at once than the maximum block size given to prepare!
+    jassert (numSamples <= maximumBlockSize);
+
+    auto* data = bufferData.getWritePointer (channel);
+    auto pos = writePos[(size_t) channel];
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        data[pos] = samples[i];
+
+        if (pos < numGuardSamples)
+            data[pos + totalSize] = samples[i];
+
+        pos = (pos == 0 ? totalSize - 1 : pos - 1);
+    }
+
+    writePos[(size_t) channel] = pos;
+}
+
+template <typename SampleType, typename InterpolationType>
+void DelayLine<SampleType, InterpolationType>::popBlock (int channel, SampleType* outputSamples,
+                                                         const SampleType* delaysInSamples,
+                                                         int numSamples, bool updateReadPointer)
+{
+    popMultiTapBlock (channel, &outputSamples, &delaysInSamples, 1, numSamples, updateReadPointer);
+}
+
+template <typename SampleType, typename InterpolationType>
+void DelayLine<SampleType, InterpolationType>::popMultiTapBlock (int channel, SampleType* const* tapOutputs,
+                                                                 const SampleType* const* tapDelays,
+                                                                 int numTaps, int numSamples, bool updateReadPointer)
+{
+    jassert (numSamples <= maximumBlockSize);
+
+    for (int tap = 0; tap < numTaps; ++tap)
+        interpolateBlock (channel, tapOutputs[tap], tapDelays[tap], numSamples);
+
+    if (updateReadPointer)
+        readPos[(size_t) channel] = (readPos[(size_t) channel] + totalSize - (numSamples % totalSize)) % totalSize;
+}
+
 //==============================================================================
 template class DelayLine<float,  DelayLineInterpolationTypes::None>;
 template class DelayLine<double, DelayLineInterpolationTypes::None>;
@@ -145,6 +145,68 @@ public:
     */
     SampleType popSample (int channel, SampleType delayInSamples = -1, bool updateReadPointer = true);
 
+    //==============================================================================
+    /** Pushes a block of samples into one channel of the delay line.
+
+        This is the block equivalent of pushSample. After pushing a block, call popBlock
+        or popMultiTapBlock with the same number of samples to read the delayed signal.
+        The number of samples can't be higher than the maximum block size given to
+        prepare.
+
+        @see popBlock, popMultiTapBlock, pushSample
+    */
+    void pushBlock (int channel, const SampleType* samples, int numSamples);
+
+    /** Pops a block of samples from one channel of the delay line, with a delay which
+        can be modulated for each sample.
+
+        This gives the same result as calling pushSample and popSample for each sample
+        of a block, but is much more efficient.
+
+        @param channel              the target channel for the delay line.
+
+        @param outputSamples        where the delayed samples will be written.
+
+        @param delaysInSamples      an array of numSamples fractional delays in samples,
+                                    one for each output sample, or nullptr to use the
+                                    value set with the setDelay function.
+
+        @param numSamples           the number of samples, which must be the same as the
+                                    number of samples given to the previous call to pushBlock.
+
+        @param updateReadPointer    should be set to true if the block is read only
+                                    once, or false if you need multi-tap delay capabilities.
+
+        @see pushBlock, popMultiTapBlock, popSample
+    */
+    void popBlock (int channel, SampleType* outputSamples, const SampleType* delaysInSamples,
+                   int numSamples, bool updateReadPointer = true);
+
+    /** Pops several taps of a block of samples from one channel of the delay line.
+
+        This is the same as calling popBlock for each tap without updating the read
+        pointer, before updating it once at the end if requested. The Thiran
+        interpolation is stateful, so it should only be used with a single tap.
+
+        @param channel              the target channel for the delay line.
+
+        @param tapOutputs           an array of numTaps output arrays of numSamples samples.
+
+        @param tapDelays            an array of numTaps delay arrays of numSamples fractional
+                                    delays in samples, in which each array can be nullptr
+                                    to use the value set with the setDelay function.
+
+        @param numTaps              the number of taps to read.
+
+        @param numSamples           the number of samples given to the previous call to pushBlock.
+
+        @param updateReadPointer    should be set to true to move on to the next block.
+
+        @see pushBlock, popBlock
+    */
+    void popMultiTapBlock (int channel, SampleType* const* tapOutputs, const SampleType* const* tapDelays,
+                           int numTaps, int numSamples, bool updateReadPointer = true);
+
     //==============================================================================
     /** Processes the input and output samples supplied in the processing context.
 
@@ -176,10 +238,14 @@ public:
             auto* inputSamples = inputBlock.getChannelPointer (channel);
             auto* outputSamples = outputBlock.getChannelPointer (channel);
 
-            for (size_t i = 0; i < numSamples; ++i)
+            for (size_t start = 0; start < numSamples;)
             {
-                pushSample ((int) channel, inputSamples[i]);
-                outputSamples[i] = popSample ((int) channel);
+                auto num = (int) jmin (numSamples - start, (size_t) maximumBlockSize);
+
+                pushBlock ((int) channel, inputSamples + start, num);
+                popBlock ((int) channel, outputSamples + start, nullptr, num);
+
+                start += (size_t) num;
             }
         }
     }
@@ -249,6 +315,172 @@ private:
         return value1 * c1 + delayFrac * (value2 * c2 + value3 * c3 + value4 * c4);
     }
 
+    //==============================================================================
+    template <typename T = InterpolationType>
+    typename std::enable_if <std::is_same <T, DelayLineInterpolationTypes::None>::value, void>::type
+    interpolateBlock (int channel, SampleType* output, const SampleType* delays, int numSamples)
+    {
+        auto* samples = bufferData.getReadPointer (channel);
+
+        for (int start = 0; start < numSamples; start += blockChunkSize)
+        {
+            auto num = jmin (blockChunkSize, numSamples - start);
+            int indices[blockChunkSize];
+            SampleType fractions[blockChunkSize];
+
+            getIndicesAndFractions (channel, start, num, delays, indices, fractions);
+
+            for (int i = 0; i < num; ++i)
+                output[start + i] = samples[indices[i]];
+        }
+    }
+
+    template <typename T = InterpolationType>
+    typename std::enable_if <std::is_same <T, DelayLineInterpolationTypes::Linear>::value, void>::type
+    interpolateBlock (int channel, SampleType* output, const SampleType* delays, int numSamples)
+    {
+        auto* samples = bufferData.getReadPointer (channel);
+
+        for (int start = 0; start < numSamples; start += blockChunkSize)
+        {
+            auto num = jmin (blockChunkSize, numSamples - start);
+            int indices[blockChunkSize];
+            SampleType fractions[blockChunkSize], values1[blockChunkSize], values2[blockChunkSize];
+
+            getIndicesAndFractions (channel, start, num, delays, indices, fractions);
+
+            for (int i = 0; i < num; ++i)
+            {
+                values1[i] = samples[indices[i]];
+                values2[i] = samples[indices[i] + 1];
+            }
+
+            auto* dest = output + start;
+
+            for (int i = 0; i < num; ++i)
+                dest[i] = values1[i] + fractions[i] * (values2[i] - values1[i]);
+        }
+    }
+
+    template <typename T = InterpolationType>
+    typename std::enable_if <std::is_same <T, DelayLineInterpolationTypes::Lagrange3rd>::value, void>::type
+    interpolateBlock (int channel, SampleType* output, const SampleType* delays, int numSamples)
+    {
+        auto* samples = bufferData.getReadPointer (channel);
+
+        for (int start = 0; start < numSamples; start += blockChunkSize)
+        {
+            auto num = jmin (blockChunkSize, numSamples - start);
+            int indices[blockChunkSize];
+            SampleType fractions[blockChunkSize], values1[blockChunkSize], values2[blockChunkSize],
+                       values3[blockChunkSize], values4[blockChunkSize];
+
+            getIndicesAndFractions (channel, start, num, delays, indices, fractions);
+
+            for (int i = 0; i < num; ++i)
+            {
+                auto* s = samples + indices[i];
+
+                values1[i] = s[0];
+                values2[i] = s[1];
+                values3[i] = s[2];
+                values4[i] = s[3];
+            }
+
+            auto* dest = output + start;
+
+            for (int i = 0; i < num; ++i)
+            {
+                auto frac = fractions[i];
+                auto d1 = frac - (SampleType) 1;
+                auto d2 = frac - (SampleType) 2;
+                auto d3 = frac - (SampleType) 3;
+
+                auto c1 = -d1 * d2 * d3 / (SampleType) 6;
+                auto c2 = d2 * d3 * (SampleType) 0.5;
+                auto c3 = -d1 * d3 * (SampleType) 0.5;
+                auto c4 = d1 * d2 / (SampleType) 6;
+
+                dest[i] = values1[i] * c1 + frac * (values2[i] * c2 + values3[i] * c3 + values4[i] * c4);
+            }
+        }
+    }
+
+    template <typename T = InterpolationType>
+    typename std::enable_if <std::is_same <T, DelayLineInterpolationTypes::Thiran>::value, void>::type
+    interpolateBlock (int channel, SampleType* output, const SampleType* delays, int numSamples)
+    {
+        auto* samples = bufferData.getReadPointer (channel);
+        auto state = v[(size_t) channel];
+
+        for (int start = 0; start < numSamples; start += blockChunkSize)
+        {
+            auto num = jmin (blockChunkSize, numSamples - start);
+            int indices[blockChunkSize];
+            SampleType fractions[blockChunkSize];
+
+            getIndicesAndFractions (channel, start, num, delays, indices, fractions);
+
+            // the Thiran interpolator is recursive, so it can't be vectorised
+            for (int i = 0; i < num; ++i)
+            {
+                auto frac = fractions[i];
+                auto value1 = samples[indices[i]];
+                auto value2 = samples[indices[i] + 1];
+
+                state = frac == 0 ? value1
+                                  : value2 + ((1 - frac) / (1 + frac)) * (value1 - state);
+                output[start + i] = state;
+            }
+        }
+
+        v[(size_t) channel] = state;
+    }
+
+    /*  Converts the delays of a chunk of samples into positions in the buffer, and
+        fractional delays adjusted in the same way as updateInternalVariables does.
+    */
+    void getIndicesAndFractions (int channel, int start, int num, const SampleType* delays,
+                                 int* indices, SampleType* fractions) const noexcept
+    {
+        auto base = readPos[(size_t) channel] - start;
+
+        if (delays == nullptr)
+        {
+            for (int i = 0; i < num; ++i)
+            {
+                auto index = base - i + delayInt;
+                indices[i] = index < 0 ? index + totalSize : (index >= totalSize ? index - totalSize : index);
+                fractions[i] = delayFrac;
+            }
+
+            return;
+        }
+
+        auto upperLimit = (SampleType) maximumDelay;
+        auto minimumInt = std::is_same<InterpolationType, DelayLineInterpolationTypes::None>::value
+                        || std::is_same<InterpolationType, DelayLineInterpolationTypes::Linear>::value ? 0 : 1;
+        auto threshold = std::is_same<InterpolationType, DelayLineInterpolationTypes::Thiran>::value ? (SampleType) 0.618
+                                                                                                     : (SampleType) 1;
+
+        for (int i = 0; i < num; ++i)
+        {
+            auto delayValue = jlimit ((SampleType) 0, upperLimit, delays[start + i]);
+            auto dInt = (int) delayValue;
+            auto dFrac = delayValue - (SampleType) dInt;
+
+            if (dInt >= minimumInt && minimumInt > 0 && dFrac < threshold)
+            {
+                dFrac += 1;
+                dInt -= 1;
+            }
+
+            auto index = base - i + dInt;
+            indices[i] = index < 0 ? index + totalSize : (index >= totalSize ? index - totalSize : index);
+            fractions[i] = dFrac;
+        }
+    }
+
     template <typename T = InterpolationType>
     typename std::enable_if <std::is_same <T, DelayLineInterpolationTypes::Thiran>::value, SampleType>::type
     interpolateSample (int channel)
@@ -308,6 +540,11 @@ private:
         alpha = (1 - delayFrac) / (1 + delayFrac);
     }
 
+    //==============================================================================
+    // The buffer has copies of its first samples after its end, so that the
+    // interpolation of the block functions doesn't need to handle wrapping around
+    static constexpr int numGuardSamples = 3, blockChunkSize = 64;
+
     //==============================================================================
     double sampleRate;
 
@@ -316,7 +553,7 @@ private:
     std::vector<SampleType> v;
     std::vector<int> writePos, readPos;
     SampleType delay = 0.0, delayFrac = 0.0;
-    int delayInt = 0, totalSize = 4;
+    int delayInt = 0, totalSize = 4, maximumDelay = 3, maximumBlockSize = 0;
     SampleType alpha = 0.0;
 };
 
@@ -0,0 +1,225 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class DelayLineTest : public UnitTest
+{
+public:
+    DelayLineTest()
+        : UnitTest ("Delay Line", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Modulated block reads match sample by sample processing");
+        {
+            runModulatedTest<float,  DelayLineInterpolationTypes::None>();
+            runModulatedTest<float,  DelayLineInterpolationTypes::Linear>();
+            runModulatedTest<float,  DelayLineInterpolationTypes::Lagrange3rd>();
+            runModulatedTest<double, DelayLineInterpolationTypes::Lagrange3rd>();
+            runModulatedTest<float,  DelayLineInterpolationTypes::Thiran>();
+        }
+
+        beginTest ("Multi-tap block reads match sample by sample processing");
+        {
+            runMultiTapTest<float,  DelayLineInterpolationTypes::Linear>();
+            runMultiTapTest<double, DelayLineInterpolationTypes::Lagrange3rd>();
+        }
+
+        beginTest ("Block processing with a fixed delay matches sample by sample processing");
+        {
+            runFixedDelayTest<float,  DelayLineInterpolationTypes::None>();
+            runFixedDelayTest<float,  DelayLineInterpolationTypes::Linear>();
+            runFixedDelayTest<double, DelayLineInterpolationTypes::Lagrange3rd>();
+            runFixedDelayTest<float,  DelayLineInterpolationTypes::Thiran>();
+        }
+    }
+
+private:
+    static constexpr int maximumDelay = 300, blockSize = 128, numBlocks = 20;
+
+    template <typename SampleType>
+    static std::vector<SampleType> makeRandom (Random& random, int numSamples, SampleType minimum, SampleType maximum)
+    {
+        std::vector<SampleType> result ((size_t) numSamples);
+
+        for (auto& sample : result)
+            sample = minimum + (maximum - minimum) * (SampleType) random.nextDouble();
+
+        return result;
+    }
+
+    template <typename SampleType>
+    void expectSimilar (const std::vector<SampleType>& a, const std::vector<SampleType>& b)
+    {
+        expectEquals ((int) a.size(), (int) b.size());
+
+        auto maxError = 0.0;
+
+        for (size_t i = 0; i < a.size(); ++i)
+            maxError = jmax (maxError, (double) std::abs (a[i] - b[i]));
+
+        expectLessThan (maxError, 1.0e-5);
+    }
+
+    //==============================================================================
+    template <typename SampleType, typename InterpolationType>
+    void runModulatedTest()
+    {
+        Random random (4567);
+        constexpr auto numSamples = blockSize * numBlocks;
+
+        auto input  = makeRandom<SampleType> (random, numSamples, -1, 1);
+        auto delays = makeRandom<SampleType> (random, numSamples, 0, (SampleType) maximumDelay);
+
+        DelayLine<SampleType, InterpolationType> reference (maximumDelay), delayLine (maximumDelay);
+        reference.prepare ({ 44100.0, (uint32) blockSize, 1 });
+        delayLine.prepare ({ 44100.0, (uint32) blockSize, 1 });
+
+        std::vector<SampleType> expected ((size_t) numSamples), output ((size_t) numSamples);
+
+        for (size_t i = 0; i < (size_t) numSamples; ++i)
+        {
+            reference.pushSample (0, input[i]);
+            expected[i] = reference.popSample (0, delays[i]);
+        }
+
+        for (int start = 0; start < numSamples;)
+        {
+            auto num = jmin (numSamples - start, 1 + random.nextInt (blockSize));
+
+            delayLine.pushBlock (0, input.data() + start, num);
+            delayLine.popBlock (0, output.data() + start, delays.data() + start, num);
+
+            start += num;
+        }
+
+        expectSimilar (output, expected);
+    }
+
+    template <typename SampleType, typename InterpolationType>
+    void runMultiTapTest()
+    {
+        Random random (8910);
+        constexpr auto numSamples = blockSize * numBlocks;
+        constexpr auto numTaps = 3;
+
+        auto input = makeRandom<SampleType> (random, numSamples, -1, 1);
+        std::vector<SampleType> delays[numTaps], expected[numTaps], output[numTaps];
+
+        for (int tap = 0; tap < numTaps; ++tap)
+        {
+            delays[tap] = makeRandom<SampleType> (random, numSamples, 0, (SampleType) maximumDelay);
+            expected[tap].resize ((size_t) numSamples);
+            output[tap].resize ((size_t) numSamples);
+        }
+
+        DelayLine<SampleType, InterpolationType> reference (maximumDelay), delayLine (maximumDelay);
+        reference.prepare ({ 44100.0, (uint32) blockSize, 1 });
+        delayLine.prepare ({ 44100.0, (uint32) blockSize, 1 });
+
+        for (size_t i = 0; i < (size_t) numSamples; ++i)
+        {
+            reference.pushSample (0, input[i]);
+
+            for (int tap = 0; tap < numTaps; ++tap)
+                expected[tap][i] = reference.popSample (0, delays[tap][i], tap == numTaps - 1);
+        }
+
+        for (int start = 0; start < numSamples; start += blockSize)
+        {
+            SampleType* outputs[numTaps];
+            const SampleType* tapDelays[numTaps];
+
+            for (int tap = 0; tap < numTaps; ++tap)
+            {
+                outputs[tap] = output[tap].data() + start;
+                tapDelays[tap] = delays[tap].data() + start;
+            }
+
+            delayLine.pushBlock (0, input.data() + start, blockSize);
+            delayLine.popMultiTapBlock (0, outputs, tapDelays, numTaps, blockSize);
+        }
+
+        for (int tap = 0; tap < numTaps; ++tap)
+            expectSimilar (output[tap], expected[tap]);
+    }
+
+    template <typename SampleType, typename InterpolationType>
+    void runFixedDelayTest()
+    {
+        Random random (1112);
+        constexpr auto numSamples = blockSize * numBlocks;
+        constexpr auto numChannels = 2;
+
+        DelayLine<SampleType, InterpolationType> reference (maximumDelay), delayLine (maximumDelay);
+        reference.prepare ({ 44100.0, (uint32) blockSize, numChannels });
+        delayLine.prepare ({ 44100.0, (uint32) blockSize, numChannels });
+
+        for (auto delay : { (SampleType) 0, (SampleType) 1.25, (SampleType) 17.7, (SampleType) maximumDelay })
+        {
+            reference.setDelay (delay);
+            delayLine.setDelay (delay);
+
+            AudioBuffer<SampleType> buffer (numChannels, numSamples);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                for (int i = 0; i < numSamples; ++i)
+                    buffer.setSample (channel, i, (SampleType) (random.nextDouble() * 2.0 - 1.0));
+
+            std::vector<SampleType> expected[numChannels];
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    reference.pushSample (channel, buffer.getSample (channel, i));
+                    expected[channel].push_back (reference.popSample (channel));
+                }
+            }
+
+            for (int start = 0; start < numSamples; start += blockSize)
+            {
+                auto block = AudioBlock<SampleType> (buffer).getSubBlock ((size_t) start, (size_t) blockSize);
+                ProcessContextReplacing<SampleType> context (block);
+                delayLine.process (context);
+            }
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                expectSimilar (std::vector<SampleType> (buffer.getReadPointer (channel),
+                                                        buffer.getReadPointer (channel) + numSamples),
+                               expected[channel]);
+        }
+    }
+};
+
+static DelayLineTest delayLineTest;
+
+} // namespace dsp
+} // namespace juce
@@ -36,15 +36,45 @@ namespace FIR
     template <typename NumericType>
     struct Coefficients;
 
+   #ifndef DOXYGEN
+    /** An FFT based, zero-latency partitioned convolution engine, which is used
+        internally by the FIR::Filter class to process long filters.
+
+        @tags{DSP}
+    */
+    class FFTConvolver
+    {
+    public:
+        FFTConvolver (const float* coefficients, size_t numCoefficients, size_t maximumBlockSize);
+        ~FFTConvolver();
+
+        size_t getNumCoefficients() const noexcept;
+        bool hasCoefficients (const float* coefficients, size_t numCoefficients) const noexcept;
+        void setCoefficients (const float* coefficients, size_t numCoefficients) noexcept;
+
+        void reset() noexcept;
+        void process (const float* input, float* output, size_t numSamples) noexcept;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> pimpl;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FFTConvolver)
+    };
+   #endif
+
     //==============================================================================
     /**
-        A processing class that can perform FIR filtering on an audio signal, in the
-        time domain.
+        A processing class that can perform FIR filtering on an audio signal.
 
-        Using FIRFilter is fast enough for FIRCoefficients with a size lower than 128
-        samples. For longer filters, it might be more efficient to use the class
-        Convolution instead, which does the same processing in the frequency domain
-        thanks to FFT.
+        Short filters are processed in the time domain, using vectorised operations
+        when whole blocks of float or double samples are processed. When a filter of
+        single precision samples has more coefficients than the fast convolution
+        threshold, the filter switches transparently to a zero-latency partitioned
+        convolution in the frequency domain, thanks to FFT. The output is the same as
+        with the time domain processing (within floating point precision), and no
+        additional latency is introduced, so linear phase filters keep a latency
+        of half their order.
 
         @see FIRFilter::Coefficients, Convolution, FFT
 
@@ -62,6 +92,11 @@ namespace FIR
         /** A typedef for a ref-counted pointer to the coefficients object */
         using CoefficientsPtr = typename Coefficients<NumericType>::Ptr;
 
+        /** The default number of coefficients above which the processing switches to
+            fast convolution.
+        */
+        static constexpr size_t defaultFastConvolutionThreshold = 128;
+
         //==============================================================================
         /** This will create a filter which will produce silence. */
         Filter() : coefficients (new Coefficients<NumericType>)                                     { reset(); }
@@ -81,7 +116,11 @@ namespace FIR
             // This class can only process mono signals. Use the ProcessorDuplicator class
             // to apply this filter on a multi-channel audio stream.
             jassert (spec.numChannels == 1);
-            ignoreUnused (spec);
+
+            if (spec.maximumBlockSize > 0)
+                maximumBlockSize = spec.maximumBlockSize;
+
+            convolver.reset();
             reset();
         }
 
@@ -102,13 +141,37 @@ namespace FIR
 
                     fifo = snapPointerToAlignment (memory.getData(), sizeof (SampleType));
                     size = newSize;
+
+                    if (std::is_same<SampleType, float>::value || std::is_same<SampleType, double>::value)
+                        history.malloc (2 * size + historyBlockSize);
                 }
 
                 for (size_t i = 0; i < size; ++i)
                     fifo[i] = SampleType {0};
+
+                updateConvolver();
             }
         }
 
+        //==============================================================================
+        /** Sets the number of coefficients above which single precision filters are
+            processed using FFT convolution instead of in the time domain. A value of
+            zero disables the fast convolution.
+
+            This method may allocate, so it shouldn't be called on the audio thread.
+        */
+        void setFastConvolutionThreshold (size_t newThreshold)
+        {
+            fastConvolutionThreshold = newThreshold;
+            reset();
+        }
+
+        /** Returns the number of coefficients above which FFT convolution is used. */
+        size_t getFastConvolutionThreshold() const noexcept     { return fastConvolutionThreshold; }
+
+        /** Returns true if the filter is currently processed with FFT convolution. */
+        bool isUsingFastConvolution() const noexcept            { return convolver != nullptr; }
+
         //==============================================================================
         /** The coefficients of the FIR filter. It's up to the caller to ensure that
             these coefficients are modified in a thread-safe way.
@@ -139,24 +202,38 @@ namespace FIR
             auto* src = inputBlock .getChannelPointer (0);
             auto* dst = outputBlock.getChannelPointer (0);
 
-            auto* fir = coefficients->getRawCoefficients();
-            size_t p = pos;
-
             if (context.isBypassed)
             {
+                size_t p = pos;
+
                 for (size_t i = 0; i < numSamples; ++i)
                 {
                     fifo[p] = dst[i] = src[i];
                     p = (p == 0 ? size - 1 : p - 1);
                 }
+
+                pos = p;
+                convolverNeedsSync = true;
+            }
+            else if (convolver != nullptr)
+            {
+                updateCoefficients (*convolver, coefficients->getRawCoefficients(), size);
+                processWithConvolver (src, dst, numSamples);
+            }
+            else if (history != nullptr && numSamples >= minimumVectorisedBlockSize)
+            {
+                processTimeDomainBlock (src, dst, numSamples);
             }
             else
             {
+                auto* fir = coefficients->getRawCoefficients();
+                size_t p = pos;
+
                 for (size_t i = 0; i < numSamples; ++i)
                     dst[i] = processSingleSample (src[i], fifo, fir, size, p);
-            }
 
-            pos = p;
+                pos = p;
+            }
         }
 
 
@@ -166,15 +243,22 @@ namespace FIR
         SampleType JUCE_VECTOR_CALLTYPE processSample (SampleType sample) noexcept
         {
             check();
+            convolverNeedsSync = true;
             return processSingleSample (sample, fifo, coefficients->getRawCoefficients(), size, pos);
         }
 
     private:
         //==============================================================================
-        HeapBlock<SampleType> memory;
+        static constexpr size_t historyBlockSize = 256, minimumVectorisedBlockSize = 16;
+
+        HeapBlock<SampleType> memory, history;
         SampleType* fifo = nullptr;
         size_t pos = 0, size = 0;
 
+        std::unique_ptr<FFTConvolver> convolver;
+        size_t maximumBlockSize = 512, fastConvolutionThreshold = defaultFastConvolutionThreshold;
+        bool convolverNeedsSync = false;
+
         //==============================================================================
         void check()
         {
@@ -184,6 +268,134 @@ namespace FIR
                 reset();
         }
 
+        void updateConvolver()
+        {
+            if (std::is_same<SampleType, float>::value
+                 && fastConvolutionThreshold > 0 && size > fastConvolutionThreshold)
+            {
+                auto* fir = coefficients->getRawCoefficients();
+
+                if (convolver == nullptr || convolver->getNumCoefficients() != size)
+                    convolver = createConvolver (fir, size, maximumBlockSize);
+                else
+                    updateCoefficients (*convolver, fir, size);
+
+                convolver->reset();
+            }
+            else
+            {
+                convolver.reset();
+            }
+
+            convolverNeedsSync = false;
+        }
+
+        // The FIFO stores the latest samples backwards from the position following pos,
+        // these functions convert it to and from chronological order
+        void copyFifoTo (SampleType* dest) const noexcept
+        {
+            for (size_t age = 0; age + 1 < size; ++age)
+                dest[size - 2 - age] = fifo[(pos + 1 + age) % size];
+        }
+
+        void copyFifoFrom (const SampleType* source) noexcept
+        {
+            for (size_t age = 0; age + 1 < size; ++age)
+                fifo[age] = source[size - 2 - age];
+
+            pos = size - 1;
+        }
+
+        void pushToFifo (const SampleType* samples, size_t numSamples) noexcept
+        {
+            auto numSkipped = numSamples > size ? numSamples - size : 0;
+            pos = (pos + size - (numSkipped % size)) % size;
+
+            for (size_t i = numSkipped; i < numSamples; ++i)
+            {
+                fifo[pos] = samples[i];
+                pos = (pos == 0 ? size - 1 : pos - 1);
+            }
+        }
+
+        void processWithConvolver (const SampleType* src, SampleType* dst, size_t numSamples) noexcept
+        {
+            if (convolverNeedsSync)
+            {
+                // feeds the samples processed without the convolver back into it
+                auto* samples = history.getData();
+
+                copyFifoTo (samples);
+                convolver->reset();
+                convolve (*convolver, samples, samples + size, size - 1);
+                convolverNeedsSync = false;
+            }
+
+            // the FIFO is kept up to date so that processSample can be used at any time
+            pushToFifo (src, numSamples);
+            convolve (*convolver, src, dst, numSamples);
+        }
+
+        void processTimeDomainBlock (const SampleType* src, SampleType* dst, size_t numSamples) noexcept
+        {
+            auto* fir = coefficients->getRawCoefficients();
+            auto* samples = history.getData();
+            auto* current = samples + size - 1;
+
+            copyFifoTo (samples);
+
+            for (size_t start = 0; start < numSamples; start += historyBlockSize)
+            {
+                auto num = jmin (numSamples - start, historyBlockSize);
+                auto* output = dst + start;
+
+                std::copy (src + start, src + start + num, current);
+                multiply (output, current, fir[0], num);
+
+                for (size_t k = 1; k < size; ++k)
+                    multiplyAdd (output, current - k, fir[k], num);
+
+                std::copy (samples + num, samples + num + size - 1, samples);
+            }
+
+            copyFifoFrom (samples);
+        }
+
+        //==============================================================================
+        static std::unique_ptr<FFTConvolver> createConvolver (const float* fir, size_t numCoefficients, size_t blockSize)
+        {
+            return std::make_unique<FFTConvolver> (fir, numCoefficients, blockSize);
+        }
+
+        static void convolve (FFTConvolver& c, const float* src, float* dst, size_t n) noexcept         { c.process (src, dst, n); }
+
+        static void updateCoefficients (FFTConvolver& c, const float* fir, size_t n) noexcept
+        {
+            if (! c.hasCoefficients (fir, n))
+                c.setCoefficients (fir, n);
+        }
+
+        static void multiply (float* dst, const float* src, float m, size_t n) noexcept                 { FloatVectorOperations::copyWithMultiply (dst, src, m, (int) n); }
+        static void multiply (double* dst, const double* src, double m, size_t n) noexcept              { FloatVectorOperations::copyWithMultiply (dst, src, m, (int) n); }
+        static void multiplyAdd (float* dst, const float* src, float m, size_t n) noexcept              { FloatVectorOperations::addWithMultiply (dst, src, m, (int) n); }
+        static void multiplyAdd (double* dst, const double* src, double m, size_t n) noexcept           { FloatVectorOperations::addWithMultiply (dst, src, m, (int) n); }
+
+        // These are only used for sample types which don't support the fast paths
+        template <typename Type>
+        static std::unique_ptr<FFTConvolver> createConvolver (const Type*, size_t, size_t)              { jassertfalse; return {}; }
+
+        template <typename Type>
+        static void convolve (FFTConvolver&, const Type*, Type*, size_t) noexcept                       { jassertfalse; }
+
+        template <typename Type>
+        static void updateCoefficients (FFTConvolver&, const Type*, size_t) noexcept                    { jassertfalse; }
+
+        template <typename Type, typename Multiplier>
+        static void multiply (Type*, const Type*, Multiplier, size_t) noexcept                          { jassertfalse; }
+
+        template <typename Type, typename Multiplier>
+        static void multiplyAdd (Type*, const Type*, Multiplier, size_t) noexcept                       { jassertfalse; }
+
         static SampleType JUCE_VECTOR_CALLTYPE processSingleSample (SampleType sample, SampleType* buf,
                                                                     const NumericType* fir, size_t m, size_t& p) noexcept
         {
@@ -203,6 +203,59 @@ class FIRFilterTest : public UnitTest
     }
 
 
+    //==============================================================================
+    void runFastConvolutionTest()
+    {
+        beginTest ("Fast convolution");
+
+        Random random (2947);
+
+        for (auto size : { 129, 300, 1000, 2049 })
+        {
+            constexpr size_t n = 5000;
+
+            HeapBlock<float> input (n), output (n), ref (n), fir ((size_t) size);
+            fillRandom (random, input.getData(), n);
+            fillRandom (random, fir.getData(), (size_t) size);
+
+            reference<float, float> (fir.getData(), (size_t) size, input.getData(), ref.getData(), n);
+
+            FIR::Filter<float> filter (*new FIR::Coefficients<float> (fir.getData(), (size_t) size));
+            filter.prepare ({ 44100.0, 256, 1 });
+            expect (filter.isUsingFastConvolution());
+
+            // mixes blocks of various sizes with single samples, which must all be consistent
+            for (size_t i = 0, len = 0; i < n; i += len)
+            {
+                len = jmin (n - i, (size_t) (random.nextBool() ? 1 + random.nextInt (3) : random.nextInt (400)));
+                auto* src = input.getData() + i;
+                auto* dst = output.getData() + i;
+
+                if (len <= 3)
+                {
+                    for (size_t j = 0; j < len; ++j)
+                        dst[j] = filter.processSample (src[j]);
+                }
+                else
+                {
+                    AudioBlock<const float> inBlock (&src, 1, len);
+                    AudioBlock<float> outBlock (&dst, 1, len);
+                    filter.process (ProcessContextNonReplacing<float> (inBlock, outBlock));
+                }
+            }
+
+            auto maxError = 0.0f;
+
+            for (size_t i = 0; i < n; ++i)
+                maxError = jmax (maxError, std::abs (output[i] - ref[i]));
+
+            expectLessThan (maxError, 1.0e-3f);
+
+            filter.setFastConvolutionThreshold (0);
+            expect (! filter.isUsingFastConvolution());
+        }
+    }
+
 public:
     FIRFilterTest()
         : UnitTest ("FIR Filter", UnitTestCategories::dsp)
@@ -213,6 +266,7 @@ public:
         runTestForAllTypes<LargeBlockTest> ("Large Blocks");
         runTestForAllTypes<SampleBySampleTest> ("Sample by Sample");
         runTestForAllTypes<SplitBlockTest> ("Split Block");
+        runFastConvolutionTest();
     }
 };
 
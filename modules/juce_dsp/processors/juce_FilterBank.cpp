@@ -0,0 +1,367 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+namespace FilterBankHelpers
+{
+    template <typename VectorType, typename SampleType>
+    static inline VectorType load (const SampleType* source) noexcept
+    {
+       #if JUCE_USE_SIMD
+        return VectorType::fromRawArray (source);
+       #else
+        return *source;
+       #endif
+    }
+
+    template <typename VectorType, typename SampleType>
+    static inline void store (SampleType* dest, VectorType value) noexcept
+    {
+       #if JUCE_USE_SIMD
+        value.copyToRawArray (dest);
+       #else
+        *dest = value;
+       #endif
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+FilterBank<SampleType>::FilterBank()
+{
+}
+
+template <typename SampleType>
+FilterBank<SampleType>::FilterBank (size_t numBandsToUse, size_t numSectionsPerBand)
+{
+    setLayout (numBandsToUse, numSectionsPerBand);
+}
+
+template <typename SampleType>
+void FilterBank<SampleType>::setLayout (size_t newNumBands, size_t newNumSectionsPerBand)
+{
+    numBands = newNumBands;
+    numSections = newNumSectionsPerBand;
+
+    bandCoefficients.assign (numBands * numSections * numCoefficientsPerSection, SampleType (0));
+
+    for (size_t i = 0; i < bandCoefficients.size(); i += numCoefficientsPerSection)
+        bandCoefficients[i] = SampleType (1);
+
+    if (numChannels > 0)
+        prepare ({ sampleRate, 0, (uint32) numChannels });
+}
+
+//==============================================================================
+template <typename SampleType>
+void FilterBank<SampleType>::setSection (size_t bandIndex, size_t sectionIndex,
+                                         const Coefficients& newCoefficients) noexcept
+{
+    writeSection (bandIndex, sectionIndex, &newCoefficients);
+    startRamp();
+}
+
+template <typename SampleType>
+void FilterBank<SampleType>::setBand (size_t bandIndex, const ReferenceCountedArray<Coefficients>& sections) noexcept
+{
+    jassert ((size_t) sections.size() <= numSections);
+
+    for (size_t i = 0; i < numSections; ++i)
+        writeSection (bandIndex, i, sections[(int) i].get());
+
+    startRamp();
+}
+
+template <typename SampleType>
+void FilterBank<SampleType>::writeSection (size_t bandIndex, size_t sectionIndex,
+                                           const Coefficients* newCoefficients) noexcept
+{
+    jassert (bandIndex < numBands && sectionIndex < numSections);
+
+    // a null section is a pass-through
+    auto order = newCoefficients != nullptr ? newCoefficients->getFilterOrder() : (size_t) 3;
+    auto* raw = newCoefficients != nullptr ? newCoefficients->getRawCoefficients() : nullptr;
+    auto* dest = bandCoefficients.data() + (bandIndex * numSections + sectionIndex) * numCoefficientsPerSection;
+
+    // The filter bank can only process first and second order sections!
+    jassert (newCoefficients == nullptr || order <= 2);
+
+    switch (order)
+    {
+        case 0:   dest[0] = raw[0]; dest[1] = 0;      dest[2] = 0;      dest[3] = 0;      dest[4] = 0;      break;
+        case 1:   dest[0] = raw[0]; dest[1] = raw[1]; dest[2] = 0;      dest[3] = raw[2]; dest[4] = 0;      break;
+        case 2:   dest[0] = raw[0]; dest[1] = raw[1]; dest[2] = raw[2]; dest[3] = raw[3]; dest[4] = raw[4]; break;
+        default:  dest[0] = 1;      dest[1] = 0;      dest[2] = 0;      dest[3] = 0;      dest[4] = 0;      break;
+    }
+
+    updateLanes (bandIndex, sectionIndex);
+}
+
+template <typename SampleType>
+void FilterBank<SampleType>::setCoefficientRampDuration (double newDurationSeconds) noexcept
+{
+    jassert (newDurationSeconds >= 0);
+
+    rampDurationSeconds = newDurationSeconds;
+    rampLengthSamples = roundToInt (rampDurationSeconds * sampleRate);
+}
+
+//==============================================================================
+template <typename SampleType>
+void FilterBank<SampleType>::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.sampleRate > 0);
+    jassert (spec.numChannels > 0);
+
+    sampleRate = spec.sampleRate;
+    numChannels = (size_t) spec.numChannels;
+    numGroups = (getNumLanes() + laneWidth - 1) / laneWidth;
+
+    auto groupStride = numGroups * laneWidth;
+    auto numCoefficients = groupStride * numSections * numCoefficientsPerSection;
+    auto numStates = groupStride * numSections * 2;
+    auto totalSize = numCoefficients * 3 + numStates + groupStride * 2;
+
+    laneMemory.malloc (totalSize * sizeof (SampleType) + sizeof (Vector));
+    auto* data = snapPointerToAlignment (reinterpret_cast<SampleType*> (laneMemory.getData()), sizeof (Vector));
+
+    coefficients = data;
+    targets      = coefficients + numCoefficients;
+    increments   = targets + numCoefficients;
+    state        = increments + numCoefficients;
+    laneInput    = state + numStates;
+    laneOutput   = laneInput + groupStride;
+
+    std::fill (data, data + totalSize, SampleType (0));
+
+    // the padding lanes are left as pass-through sections
+    for (size_t i = 0; i < numCoefficients; i += numCoefficientsPerSection * laneWidth)
+        std::fill (targets + i, targets + i + laneWidth, SampleType (1));
+
+    for (size_t band = 0; band < numBands; ++band)
+        for (size_t section = 0; section < numSections; ++section)
+            updateLanes (band, section);
+
+    setCoefficientRampDuration (rampDurationSeconds);
+    reset();
+}
+
+template <typename SampleType>
+void FilterBank<SampleType>::reset() noexcept
+{
+    if (state != nullptr)
+        std::fill (state, state + numGroups * laneWidth * numSections * 2, SampleType (0));
+
+    finishRamp();
+}
+
+template <typename SampleType>
+void FilterBank<SampleType>::snapToZero() noexcept
+{
+    if (state != nullptr)
+        for (size_t i = 0; i < numGroups * laneWidth * numSections * 2; ++i)
+            util::snapToZero (state[i]);
+}
+
+//==============================================================================
+template <typename SampleType>
+void FilterBank<SampleType>::updateLanes (size_t bandIndex, size_t sectionIndex) noexcept
+{
+    if (targets == nullptr)
+        return;
+
+    auto* source = bandCoefficients.data() + (bandIndex * numSections + sectionIndex) * numCoefficientsPerSection;
+
+    for (size_t channel = 0; channel < numChannels; ++channel)
+    {
+        auto lane = bandIndex * numChannels + channel;
+        auto group = lane / laneWidth;
+        auto* dest = targets + ((group * numSections + sectionIndex) * numCoefficientsPerSection * laneWidth) + (lane % laneWidth);
+
+        for (size_t i = 0; i < numCoefficientsPerSection; ++i)
+            dest[i * laneWidth] = source[i];
+    }
+}
+
+template <typename SampleType>
+void FilterBank<SampleType>::startRamp() noexcept
+{
+    if (coefficients == nullptr)
+        return;
+
+    if (rampLengthSamples <= 0)
+    {
+        finishRamp();
+        return;
+    }
+
+    auto numCoefficients = numGroups * laneWidth * numSections * numCoefficientsPerSection;
+    auto scale = SampleType (1) / static_cast<SampleType> (rampLengthSamples);
+
+    for (size_t i = 0; i < numCoefficients; ++i)
+        increments[i] = (targets[i] - coefficients[i]) * scale;
+
+    rampSamplesRemaining = rampLengthSamples;
+}
+
+template <typename SampleType>
+void FilterBank<SampleType>::finishRamp() noexcept
+{
+    if (coefficients != nullptr)
+        std::copy (targets, targets + numGroups * laneWidth * numSections * numCoefficientsPerSection, coefficients);
+
+    rampSamplesRemaining = 0;
+}
+
+//==============================================================================
+template <typename SampleType>
+void FilterBank<SampleType>::processBands (const AudioBlock<const SampleType>& inputBlock,
+                                           const AudioBlock<SampleType>& outputBlock) noexcept
+{
+    jassert (outputBlock.getNumChannels() == inputBlock.getNumChannels() * numBands);
+    jassert (inputBlock.getNumSamples()   == outputBlock.getNumSamples());
+
+    processInternal (inputBlock, outputBlock, false);
+}
+
+template <typename SampleType>
+void FilterBank<SampleType>::processInternal (const AudioBlock<const SampleType>& inputBlock,
+                                              const AudioBlock<SampleType>& outputBlock,
+                                              bool sumBands) noexcept
+{
+    // You must call prepare() and setLayout() before processing!
+    jassert (state != nullptr && numBands > 0);
+    jassert (inputBlock.getNumChannels() == numChannels);
+
+    if (state == nullptr || numBands == 0)
+    {
+        outputBlock.clear();
+        return;
+    }
+
+    auto numSamples = inputBlock.getNumSamples();
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            auto input = inputBlock.getSample ((int) channel, (int) i);
+
+            for (size_t band = 0; band < numBands; ++band)
+                laneInput[band * numChannels + channel] = input;
+        }
+
+        if (rampSamplesRemaining > 0)
+        {
+            processLanes<true>();
+
+            if (--rampSamplesRemaining == 0)
+                finishRamp();
+        }
+        else
+        {
+            processLanes<false>();
+        }
+
+        if (sumBands)
+        {
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                auto sum = laneOutput[channel];
+
+                for (size_t band = 1; band < numBands; ++band)
+                    sum += laneOutput[band * numChannels + channel];
+
+                outputBlock.setSample ((int) channel, (int) i, sum);
+            }
+        }
+        else
+        {
+            for (size_t lane = 0; lane < getNumLanes(); ++lane)
+                outputBlock.setSample ((int) lane, (int) i, laneOutput[lane]);
+        }
+    }
+
+    snapToZero();
+}
+
+template <typename SampleType>
+template <bool isRamping>
+void FilterBank<SampleType>::processLanes() noexcept
+{
+    using namespace FilterBankHelpers;
+
+    constexpr auto w = laneWidth;
+    auto* c   = coefficients;
+    auto* inc = increments;
+    auto* s   = state;
+
+    for (size_t group = 0; group < numGroups; ++group)
+    {
+        auto x = load<Vector> (laneInput + group * w);
+
+        for (size_t section = 0; section < numSections; ++section)
+        {
+            auto b0 = load<Vector> (c);
+            auto b1 = load<Vector> (c + w);
+            auto b2 = load<Vector> (c + 2 * w);
+            auto a1 = load<Vector> (c + 3 * w);
+            auto a2 = load<Vector> (c + 4 * w);
+
+            auto lv1 = load<Vector> (s);
+            auto lv2 = load<Vector> (s + w);
+
+            auto y = (b0 * x) + lv1;
+
+            store (s,     (b1 * x) - (a1 * y) + lv2);
+            store (s + w, (b2 * x) - (a2 * y));
+
+            if (isRamping)
+            {
+                for (size_t i = 0; i < numCoefficientsPerSection * w; i += w)
+                    store (c + i, load<Vector> (c + i) + load<Vector> (inc + i));
+
+                inc += numCoefficientsPerSection * w;
+            }
+
+            x = y;
+            c += numCoefficientsPerSection * w;
+            s += 2 * w;
+        }
+
+        store (laneOutput + group * w, x);
+    }
+}
+
+//==============================================================================
+template class FilterBank<float>;
+template class FilterBank<double>;
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,206 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    A bank of IIR filters which processes many bands of cascaded second order
+    sections in a single pass over the audio data.
+
+    Each band is made of a fixed number of first or second order sections
+    (using the same Transposed Direct Form II structure as IIR::Filter), which
+    are processed in series. All the bands of all the channels are processed in
+    parallel, with one band of one channel per SIMD lane, so that a multi-band
+    crossover or a bank of analysis filters only reads and writes each sample
+    once, instead of once per filter.
+
+    The coefficients of the sections are usually obtained from the
+    IIR::Coefficients factory functions or from the FilterDesign class. When the
+    coefficients are changed while the filter bank is running, they are linearly
+    interpolated towards their new values over a configurable ramp duration, to
+    avoid clicks.
+
+    There are two ways of using the processed bands:
+    - process() sums the outputs of all the bands of each channel, which is useful
+      for cascaded equalisers (with one band made of many sections) or for
+      parallel filter structures.
+    - processBands() writes each band to its own set of output channels, which is
+      useful for crossovers and filter bank analysis.
+
+    @see IIR::Filter, FilterDesign, LinkwitzRileyFilter
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class FilterBank
+{
+public:
+    //==============================================================================
+    /** The coefficients type used to describe each section of a band. */
+    using Coefficients = IIR::Coefficients<SampleType>;
+
+    //==============================================================================
+    /** Creates an empty filter bank. Call setLayout() before using it. */
+    FilterBank();
+
+    /** Creates a filter bank with a given number of bands and sections per band.
+        @see setLayout
+    */
+    FilterBank (size_t numBands, size_t numSectionsPerBand);
+
+    //==============================================================================
+    /** Sets the number of bands, and the number of cascaded sections in each band.
+
+        All the sections are reset to a pass-through state. This method allocates
+        memory, so it must not be called on the audio thread.
+    */
+    void setLayout (size_t numBands, size_t numSectionsPerBand);
+
+    /** Returns the number of bands in the filter bank. */
+    size_t getNumBands() const noexcept                 { return numBands; }
+
+    /** Returns the number of cascaded sections in each band. */
+    size_t getNumSectionsPerBand() const noexcept       { return numSections; }
+
+    //==============================================================================
+    /** Sets the coefficients of one of the sections of a band.
+
+        The coefficients must describe a first or a second order filter. If the
+        filter bank has been prepared and a ramp duration has been set, the new
+        coefficients will be reached progressively.
+
+        This method doesn't allocate, so it can be called from the audio thread, but
+        it's up to the caller to make sure it isn't called while processing.
+    */
+    void setSection (size_t bandIndex, size_t sectionIndex, const Coefficients& newCoefficients) noexcept;
+
+    /** Sets the coefficients of all the sections of a band, using for example the
+        output of one of the FilterDesign IIR methods.
+
+        If the array contains fewer sections than the number of sections per band,
+        the remaining ones are set to pass-through. It must not contain more.
+    */
+    void setBand (size_t bandIndex, const ReferenceCountedArray<Coefficients>& sections) noexcept;
+
+    /** Sets the duration over which new coefficients are interpolated. A value of
+        zero means that new coefficients are applied instantly.
+    */
+    void setCoefficientRampDuration (double newDurationSeconds) noexcept;
+
+    //==============================================================================
+    /** Initialises the filter bank. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the internal state variables of all the sections, and finishes any
+        coefficient ramp in progress.
+    */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Processes the input and output samples supplied in the processing context,
+        summing the outputs of all the bands of each channel.
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock      = context.getOutputBlock();
+
+        jassert (inputBlock.getNumChannels() == outputBlock.getNumChannels());
+        jassert (inputBlock.getNumSamples()  == outputBlock.getNumSamples());
+
+        if (context.isBypassed)
+        {
+            if (context.usesSeparateInputAndOutputBlocks())
+                outputBlock.copyFrom (inputBlock);
+
+            return;
+        }
+
+        processInternal (inputBlock, outputBlock, true);
+    }
+
+    /** Processes a block of samples, writing the output of each band to its own
+        set of channels.
+
+        The output block must have getNumBands() times as many channels as the input
+        block, with the output of the band b for the input channel c being written to
+        the channel (b * numInputChannels + c).
+    */
+    void processBands (const AudioBlock<const SampleType>& inputBlock,
+                       const AudioBlock<SampleType>& outputBlock) noexcept;
+
+    /** Ensure that the state variables are rounded to zero if the state
+        variables are denormals.
+    */
+    void snapToZero() noexcept;
+
+private:
+    //==============================================================================
+   #if JUCE_USE_SIMD
+    using Vector = SIMDRegister<SampleType>;
+   #else
+    using Vector = SampleType;
+   #endif
+
+    static constexpr size_t laneWidth = sizeof (Vector) / sizeof (SampleType);
+    static constexpr size_t numCoefficientsPerSection = 5;
+
+    //==============================================================================
+    void processInternal (const AudioBlock<const SampleType>&, const AudioBlock<SampleType>&, bool sumBands) noexcept;
+
+    template <bool isRamping>
+    void processLanes() noexcept;
+
+    void writeSection (size_t bandIndex, size_t sectionIndex, const Coefficients*) noexcept;
+    void updateLanes (size_t bandIndex, size_t sectionIndex) noexcept;
+    void startRamp() noexcept;
+    void finishRamp() noexcept;
+
+    size_t getNumLanes() const noexcept       { return numBands * numChannels; }
+
+    //==============================================================================
+    size_t numBands = 0, numSections = 0, numChannels = 0, numGroups = 0;
+    std::vector<SampleType> bandCoefficients;
+
+    HeapBlock<char> laneMemory;
+    SampleType* coefficients = nullptr;
+    SampleType* targets = nullptr;
+    SampleType* increments = nullptr;
+    SampleType* state = nullptr;
+    SampleType* laneInput = nullptr;
+    SampleType* laneOutput = nullptr;
+
+    double sampleRate = 44100.0, rampDurationSeconds = 0.02;
+    int rampLengthSamples = 0, rampSamplesRemaining = 0;
+
+    JUCE_LEAK_DETECTOR (FilterBank)
+};
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,233 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class FilterBankTest : public UnitTest
+{
+public:
+    FilterBankTest()
+        : UnitTest ("Filter Bank", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Split bands match cascaded IIR filters");
+        {
+            runSplitTest<float>  (1e-5);
+            runSplitTest<double> (1e-10);
+        }
+
+        beginTest ("Summed bands match cascaded IIR filters");
+        {
+            runSumTest<float>  (1e-5);
+            runSumTest<double> (1e-10);
+        }
+
+        beginTest ("Coefficient ramps reach their target");
+        {
+            runRampTest<float>  (1e-5);
+            runRampTest<double> (1e-10);
+        }
+    }
+
+private:
+    //==============================================================================
+    static constexpr double sampleRate = 44100.0;
+    static constexpr size_t numSamples = 500;
+
+    template <typename SampleType>
+    using Sections = ReferenceCountedArray<IIR::Coefficients<SampleType>>;
+
+    template <typename SampleType>
+    static Sections<SampleType> makeBand (size_t bandIndex, size_t numBands)
+    {
+        auto frequency = static_cast<SampleType> (100.0 * std::pow (150.0, (double) (bandIndex + 1) / (double) (numBands + 1)));
+
+        if (bandIndex % 3 == 0)
+            return FilterDesign<SampleType>::designIIRLowpassHighOrderButterworthMethod (frequency, sampleRate, 5);
+
+        if (bandIndex % 3 == 1)
+            return FilterDesign<SampleType>::designIIRHighpassHighOrderButterworthMethod (frequency, sampleRate, 4);
+
+        Sections<SampleType> sections;
+        sections.add (IIR::Coefficients<SampleType>::makePeakFilter (sampleRate, frequency, (SampleType) 0.7, (SampleType) 2));
+        return sections;
+    }
+
+    template <typename SampleType>
+    static void fillRandom (Random& random, AudioBuffer<SampleType>& buffer)
+    {
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (channel, i, static_cast<SampleType> (random.nextFloat() * 2.0f - 1.0f));
+    }
+
+    template <typename SampleType>
+    static void processReference (const Sections<SampleType>& sections, const SampleType* input,
+                                  SampleType* output, size_t n)
+    {
+        std::copy (input, input + n, output);
+
+        for (auto* section : sections)
+        {
+            IIR::Filter<SampleType> filter (section);
+            filter.reset();
+
+            for (size_t i = 0; i < n; ++i)
+                output[i] = filter.processSample (output[i]);
+        }
+    }
+
+    template <typename SampleType>
+    bool buffersAreSimilar (const SampleType* a, const SampleType* b, size_t n, double tolerance)
+    {
+        for (size_t i = 0; i < n; ++i)
+            if (std::abs (a[i] - b[i]) > tolerance)
+                return false;
+
+        return true;
+    }
+
+    //==============================================================================
+    template <typename SampleType>
+    void runSplitTest (double tolerance)
+    {
+        Random random (3928);
+
+        for (auto numChannels : { 1, 2, 3 })
+        {
+            for (auto numBands : { 1, 3, 5, 8 })
+            {
+                FilterBank<SampleType> bank ((size_t) numBands, 3);
+                bank.setCoefficientRampDuration (0.0);
+                bank.prepare ({ sampleRate, (uint32) numSamples, (uint32) numChannels });
+
+                for (int band = 0; band < numBands; ++band)
+                    bank.setBand ((size_t) band, makeBand<SampleType> ((size_t) band, (size_t) numBands));
+
+                AudioBuffer<SampleType> input (numChannels, (int) numSamples), output (numChannels * numBands, (int) numSamples);
+                fillRandom (random, input);
+
+                bank.processBands (AudioBlock<const SampleType> (input), AudioBlock<SampleType> (output));
+
+                HeapBlock<SampleType> reference (numSamples);
+
+                for (int band = 0; band < numBands; ++band)
+                {
+                    for (int channel = 0; channel < numChannels; ++channel)
+                    {
+                        processReference (makeBand<SampleType> ((size_t) band, (size_t) numBands),
+                                          input.getReadPointer (channel), reference.get(), numSamples);
+
+                        expect (buffersAreSimilar (output.getReadPointer (band * numChannels + channel),
+                                                   reference.get(), numSamples, tolerance));
+                    }
+                }
+            }
+        }
+    }
+
+    template <typename SampleType>
+    void runSumTest (double tolerance)
+    {
+        Random random (1234);
+        constexpr int numChannels = 2, numBands = 6;
+
+        FilterBank<SampleType> bank (numBands, 3);
+        bank.prepare ({ sampleRate, (uint32) numSamples, (uint32) numChannels });
+        bank.setCoefficientRampDuration (0.0);
+
+        for (int band = 0; band < numBands; ++band)
+            bank.setBand ((size_t) band, makeBand<SampleType> ((size_t) band, numBands));
+
+        AudioBuffer<SampleType> buffer (numChannels, (int) numSamples), input;
+        fillRandom (random, buffer);
+        input.makeCopyOf (buffer);
+
+        AudioBlock<SampleType> block (buffer);
+        bank.process (ProcessContextReplacing<SampleType> (block));
+
+        HeapBlock<SampleType> reference (numSamples), sum (numSamples);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            std::fill (sum.get(), sum.get() + numSamples, SampleType (0));
+
+            for (int band = 0; band < numBands; ++band)
+            {
+                processReference (makeBand<SampleType> ((size_t) band, numBands),
+                                  input.getReadPointer (channel), reference.get(), numSamples);
+
+                for (size_t i = 0; i < numSamples; ++i)
+                    sum[i] += reference[i];
+            }
+
+            expect (buffersAreSimilar (buffer.getReadPointer (channel), sum.get(), numSamples, tolerance));
+        }
+    }
+
+    template <typename SampleType>
+    void runRampTest (double tolerance)
+    {
+        Random random (5678);
+
+        FilterBank<SampleType> bank (2, 1);
+        bank.prepare ({ sampleRate, (uint32) numSamples, 1 });
+        bank.setCoefficientRampDuration (0.005);
+
+        auto target = IIR::Coefficients<SampleType>::makeLowPass (sampleRate, (SampleType) 1000);
+        bank.setSection (0, 0, *target);
+        bank.setSection (1, 0, *target);
+
+        // process silence until the ramp is over, which keeps the state cleared
+        AudioBuffer<SampleType> silence (1, (int) numSamples), output (2, (int) numSamples);
+        silence.clear();
+        bank.processBands (AudioBlock<const SampleType> (silence), AudioBlock<SampleType> (output));
+
+        expect (output.getMagnitude (0, (int) numSamples) == SampleType (0));
+
+        AudioBuffer<SampleType> input (1, (int) numSamples);
+        fillRandom (random, input);
+        bank.processBands (AudioBlock<const SampleType> (input), AudioBlock<SampleType> (output));
+
+        Sections<SampleType> sections;
+        sections.add (target);
+
+        HeapBlock<SampleType> reference (numSamples);
+        processReference (sections, input.getReadPointer (0), reference.get(), numSamples);
+
+        expect (buffersAreSimilar (output.getReadPointer (0), reference.get(), numSamples, tolerance));
+        expect (buffersAreSimilar (output.getReadPointer (1), reference.get(), numSamples, tolerance));
+    }
+};
+
+static FilterBankTest filterBankTest;
+
+} // namespace dsp
+} // namespace juce
@@ -30,11 +30,7 @@ namespace dsp
 
 template <typename NumericType>
 IIR::Coefficients<NumericType>::Coefficients()
-    : coefficients ({ NumericType(),
-                      NumericType(),
-                      NumericType(),
-                      NumericType(),
-                      NumericType() })
+    : Coefficients (0, 0, 0, 1, 0, 0)
 {
 }
 
@@ -42,100 +38,71 @@ template <typename NumericType>
 IIR::Coefficients<NumericType>::Coefficients (NumericType b0, NumericType b1,
                                               NumericType a0, NumericType a1)
 {
-    jassert (a0 != 0);
-
-    coefficients.clear();
-
-    auto a0inv = static_cast<NumericType> (1) / a0;
-
-    coefficients.add (b0 * a0inv,
-                      b1 * a0inv,
-                      a1 * a0inv);
+    assignImpl (std::array<NumericType, 4> { { b0, b1, a0, a1 } });
 }
 
 template <typename NumericType>
 IIR::Coefficients<NumericType>::Coefficients (NumericType b0, NumericType b1, NumericType b2,
                                               NumericType a0, NumericType a1, NumericType a2)
 {
-    jassert (a0 != 0);
-
-    coefficients.clear();
-
-    auto a0inv = static_cast<NumericType> (1) / a0;
-
-    coefficients.add (b0 * a0inv,
-                      b1 * a0inv,
-                      b2 * a0inv,
-                      a1 * a0inv,
-                      a2 * a0inv);
+    assignImpl (std::array<NumericType, 6> { { b0, b1, b2, a0, a1, a2 } });
 }
 
 template <typename NumericType>
 IIR::Coefficients<NumericType>::Coefficients (NumericType b0, NumericType b1, NumericType b2, NumericType b3,
                                               NumericType a0, NumericType a1, NumericType a2, NumericType a3)
 {
-    jassert (a0 != 0);
-
-    coefficients.clear();
-
-    auto a0inv = static_cast<NumericType> (1) / a0;
-
-    coefficients.add (b0 * a0inv,
-                      b1 * a0inv,
-                      b2 * a0inv,
-                      b3 * a0inv,
-                      a1 * a0inv,
-                      a2 * a0inv,
-                      a3 * a0inv);
+    assignImpl (std::array<NumericType, 8> { { b0, b1, b2, b3, a0, a1, a2, a3 } });
 }
 
+//==============================================================================
 template <typename NumericType>
-typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeFirstOrderLowPass (double sampleRate,
-                                                                                                    NumericType frequency)
+std::array<NumericType, 4> IIR::ArrayCoefficients<NumericType>::makeFirstOrderLowPass (double sampleRate,
+                                                                                       NumericType frequency)
 {
     jassert (sampleRate > 0.0);
     jassert (frequency > 0 && frequency <= static_cast<float> (sampleRate * 0.5));
 
     auto n = std::tan (MathConstants<NumericType>::pi * frequency / static_cast<NumericType> (sampleRate));
 
-    return *new Coefficients (n, n, n + 1, n - 1);
+    return { { n, n, n + 1, n - 1 } };
 }
 
 template <typename NumericType>
-typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeFirstOrderHighPass (double sampleRate,
-                                                                                                     NumericType frequency)
+std::array<NumericType, 4> IIR::ArrayCoefficients<NumericType>::makeFirstOrderHighPass (double sampleRate,
+                                                                                        NumericType frequency)
 {
     jassert (sampleRate > 0.0);
     jassert (frequency > 0 && frequency <= static_cast<float> (sampleRate * 0.5));
 
     auto n = std::tan (MathConstants<NumericType>::pi * frequency / static_cast<NumericType> (sampleRate));
 
-    return *new Coefficients (1, -1, n + 1, n - 1);
+    return { { 1, -1, n + 1, n - 1 } };
 }
 
 template <typename NumericType>
-typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeFirstOrderAllPass (double sampleRate,
-                                                                                                    NumericType frequency)
+std::array<NumericType, 4> IIR::ArrayCoefficients<NumericType>::makeFirstOrderAllPass (double sampleRate,
+                                                                                       NumericType frequency)
 {
     jassert (sampleRate > 0.0);
     jassert (frequency > 0 && frequency <= static_cast<float> (sampleRate * 0.5));
 
     auto n = std::tan (MathConstants<NumericType>::pi * frequency / static_cast<NumericType> (sampleRate));
 
-    return *new Coefficients (n - 1, n + 1, n + 1, n - 1);
+    return { { n - 1, n + 1, n + 1, n - 1 } };
 }
 
 template <typename NumericType>
-typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeLowPass (double sampleRate,
-                                                                                          NumericType frequency)
+std::array<NumericType, 6> IIR::ArrayCoefficients<NumericType>::makeLowPass (double sampleRate,
+                                                                             NumericType frequency)
 {
     return makeLowPass (sampleRate, frequency, inverseRootTwo);
 }
 
 template <typename NumericType>
-typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeLowPass (double sampleRate,
-                                                                                          NumericType frequency,
-                                                                                          NumericType Q)
+std::array<NumericType, 6> IIR::ArrayCoefficients<NumericType>::makeLowPass (double sampleRate,
+                                                                             NumericType frequency,
+                                                                             NumericType Q)
 {
     jassert (sampleRate > 0.0);
     jassert (frequency > 0 && frequency <= static_cast<float> (sampleRate * 0.5));
@@ -146,22 +113,22 @@ typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::mak
     auto invQ = 1 / Q;
     auto c1 = 1 / (1 + invQ * n + nSquared);
 
-    return *new Coefficients (c1, c1 * 2, c1,
-                              1, c1 * 2 * (1 - nSquared),
-                              c1 * (1 - invQ * n + nSquared));
+    return { { c1, c1 * 2, c1,
+               1, c1 * 2 * (1 - nSquared),
+               c1 * (1 - invQ * n + nSquared) } };
 }
 
 template <typename NumericType>
-typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeHighPass (double sampleRate,
-                                                                                           NumericType frequency)
+std::array<NumericType, 6> IIR::ArrayCoefficients<NumericType>::makeHighPass (double sampleRate,
+                                                                              NumericType frequency)
 {
     return makeHighPass (sampleRate, frequency, inverseRootTwo);
 }
 
 template <typename NumericType>
-typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeHighPass (double sampleRate,
-                                                                                           NumericType frequency,
-                                                                                           NumericType Q)
+std::array<NumericType, 6> IIR::ArrayCoefficients<NumericType>::makeHighPass (double sampleRate,
+                                                                              NumericType frequency,
+                                                                              NumericType Q)
 {
     jassert (sampleRate > 0.0);
     jassert (frequency > 0 && frequency <= static_cast<float> (sampleRate * 0.5));
@@ -172,22 +139,22 @@ typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::mak
     auto invQ = 1 / Q;
     auto c1 = 1 / (1 + invQ * n + nSquared);
 
-    return *new Coefficients (c1, c1 * -2, c1,
-                              1, c1 * 2 * (nSquared - 1),
-                              c1 * (1 - invQ * n + nSquared));
+    return { { c1, c1 * -2, c1,
+               1, c1 * 2 * (nSquared - 1),
+               c1 * (1 - invQ * n + nSquared) } };
 }
 
 template <typename NumericType>
-typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeBandPass (double sampleRate,
-                                                                                           NumericType frequency)
+std::array<NumericType, 6> IIR::ArrayCoefficients<NumericType>::makeBandPass (double sampleRate,
+                                                                              NumericType frequency)
 {
     return makeBandPass (sampleRate, frequency, inverseRootTwo);
 }
 
 template <typename NumericType>
-typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeBandPass (double sampleRate,
-                                                                                           NumericType frequency,
-                                                                                           NumericType Q)
+std::array<NumericType, 6> IIR::ArrayCoefficients<NumericType>::makeBandPass (double sampleRate,
+                                                                              NumericType frequency,
+                                                                              NumericType Q)
 {
     jassert (sampleRate > 0.0);
     jassert (frequency > 0 && frequency <= static_cast<float> (sampleRate * 0.5));
@@ -198,23 +165,23 @@ typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::mak
     auto invQ = 1 / Q;
     auto c1 = 1 / (1 + invQ * n + nSquared);
 
-    return *new Coefficients (c1 * n * invQ, 0,
-                             -c1 * n * invQ, 1,
-                              c1 * 2 * (1 - nSquared),
-                              c1 * (1 - invQ * n + nSquared));
+    return { { c1 * n * invQ, 0,
+              -c1 * n * invQ, 1,
+               c1 * 2 * (1 - nSquared),
+               c1 * (1 - invQ * n + nSquared) } };
 }
 
 template <typename NumericType>
-typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeNotch (double sampleRate,
-                                                                                        NumericType frequency)
+std::array<NumericType, 6> IIR::ArrayCoefficients<NumericType>::makeNotch (double sampleRate,
+                                                                           NumericType frequency)
 {
     return makeNotch (sampleRate, frequency, inverseRootTwo);
 }
 
 template <typename NumericType>
-typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeNotch (double sampleRate,
-                                                                                        NumericType frequency,
-                                                                                        NumericType Q)
+std::array<NumericType, 6> IIR::ArrayCoefficients<NumericType>::makeNotch (double sampleRate,
+                                                                           NumericType frequency,
+                                                                           NumericType Q)
 {
     jassert (sampleRate > 0.0);
     jassert (frequency > 0 && frequency <= static_cast<float> (sampleRate * 0.5));
@@ -227,20 +194,20 @@ typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::mak
     auto b0 = c1 * (1 + nSquared);
     auto b1 = 2 * c1 * (1 - nSquared);
 
-    return *new Coefficients (b0, b1, b0, 1, b1, c1 * (1 - n * invQ + nSquared));
+    return { { b0, b1, b0, 1, b1, c1 * (1 - n * invQ + nSquared) } };
 }
 
 template <typename NumericType>
-typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeAllPass (double sampleRate,
-                                                                                          NumericType frequency)
+std::array<NumericType, 6> IIR::ArrayCoefficients<NumericType>::makeAllPass (double sampleRate,
+                                                                             NumericType frequency)
 {
     return makeAllPass (sampleRate, frequency, inverseRootTwo);
 }
 
 template <typename NumericType>
-typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeAllPass (double sampleRate,
-                                                                                          NumericType frequency,
-                                                                                          NumericType Q)
+std::array<NumericType, 6> IIR::ArrayCoefficients<NumericType>::makeAllPass (double sampleRate,
+                                                                             NumericType frequency,
+                                                                             NumericType Q)
 {
     jassert (sampleRate > 0);
     jassert (frequency > 0 && frequency <= sampleRate * 0.5);
@@ -253,14 +220,14 @@ typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::mak
     auto b0 = c1 * (1 - n * invQ + nSquared);
     auto b1 = c1 * 2 * (1 - nSquared);
 
-    return *new Coefficients (b0, b1, 1, 1, b1, b0);
+    return { { b0, b1, 1, 1, b1, b0 } };
 }
 
 template <typename NumericType>
-typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeLowShelf (double sampleRate,
-                                                                                           NumericType cutOffFrequency,
-                                                                                           NumericType Q,
-                                                                                           NumericType gainFactor)
+std::array<NumericType, 6> IIR::ArrayCoefficients<NumericType>::makeLowShelf (double sampleRate,
+                                                                              NumericType cutOffFrequency,
+                                                                              NumericType Q,
+                                                                              NumericType gainFactor)
 {
     jassert (sampleRate > 0.0);
     jassert (cutOffFrequency > 0.0 && cutOffFrequency <= sampleRate * 0.5);
@@ -274,19 +241,19 @@ typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::mak
     auto beta = std::sin (omega) * std::sqrt (A) / Q;
     auto aminus1TimesCoso = aminus1 * coso;
 
-    return *new Coefficients (A * (aplus1 - aminus1TimesCoso + beta),
-                              A * 2 * (aminus1 - aplus1 * coso),
-                              A * (aplus1 - aminus1TimesCoso - beta),
-                              aplus1 + aminus1TimesCoso + beta,
-                              -2 * (aminus1 + aplus1 * coso),
-                              aplus1 + aminus1TimesCoso - beta);
+    return { { A * (aplus1 - aminus1TimesCoso + beta),
+               A * 2 * (aminus1 - aplus1 * coso),
+               A * (aplus1 - aminus1TimesCoso - beta),
+               aplus1 + aminus1TimesCoso + beta,
+               -2 * (aminus1 + aplus1 * coso),
+               aplus1 + aminus1TimesCoso - beta } };
 }
 
 template <typename NumericType>
-typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeHighShelf (double sampleRate,
-                                                                                            NumericType cutOffFrequency,
-                                                                                            NumericType Q,
-                                                                                            NumericType gainFactor)
+std::array<NumericType, 6> IIR::ArrayCoefficients<NumericType>::makeHighShelf (double sampleRate,
+                                                                               NumericType cutOffFrequency,
+                                                                               NumericType Q,
+                                                                               NumericType gainFactor)
 {
     jassert (sampleRate > 0);
     jassert (cutOffFrequency > 0 && cutOffFrequency <= static_cast<NumericType> (sampleRate * 0.5));
@@ -300,19 +267,19 @@ typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::mak
     auto beta = std::sin (omega) * std::sqrt (A) / Q;
     auto aminus1TimesCoso = aminus1 * coso;
 
-    return *new Coefficients (A * (aplus1 + aminus1TimesCoso + beta),
-                              A * -2 * (aminus1 + aplus1 * coso),
-                              A * (aplus1 + aminus1TimesCoso - beta),
-                              aplus1 - aminus1TimesCoso + beta,
-                              2 * (aminus1 - aplus1 * coso),
-                              aplus1 - aminus1TimesCoso - beta);
+    return { { A * (aplus1 + aminus1TimesCoso + beta),
+               A * -2 * (aminus1 + aplus1 * coso),
+               A * (aplus1 + aminus1TimesCoso - beta),
+               aplus1 - aminus1TimesCoso + beta,
+               2 * (aminus1 - aplus1 * coso),
+               aplus1 - aminus1TimesCoso - beta } };
 }
 
 template <typename NumericType>
-typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makePeakFilter (double sampleRate,
-                                                                                             NumericType frequency,
-                                                                                             NumericType Q,
-                                                                                             NumericType gainFactor)
+std::array<NumericType, 6> IIR::ArrayCoefficients<NumericType>::makePeakFilter (double sampleRate,
+                                                                                NumericType frequency,
+                                                                                NumericType Q,
+                                                                                NumericType gainFactor)
 {
     jassert (sampleRate > 0);
     jassert (frequency > 0 && frequency <= static_cast<NumericType> (sampleRate * 0.5));
@@ -326,10 +293,134 @@ typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::mak
     auto alphaTimesA = alpha * A;
     auto alphaOverA = alpha / A;
 
-    return *new Coefficients (1 + alphaTimesA, c2,
-                              1 - alphaTimesA,
-                              1 + alphaOverA, c2,
-                              1 - alphaOverA);
+    return { { 1 + alphaTimesA, c2,
+               1 - alphaTimesA,
+               1 + alphaOverA, c2,
+               1 - alphaOverA } };
+}
+
+//==============================================================================
+template <typename NumericType>
+typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeFirstOrderLowPass (double sampleRate,
+                                                                                                    NumericType frequency)
+{
+    return *new Coefficients (ArrayCoefficients<NumericType>::makeFirstOrderLowPass (sampleRate, frequency));
+}
+
+template <typename NumericType>
+typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeFirstOrderHighPass (double sampleRate,
+                                                                                                     NumericType frequency)
+{
+    return *new Coefficients (ArrayCoefficients<NumericType>::makeFirstOrderHighPass (sampleRate, frequency));
+}
+
+template <typename NumericType>
+typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeFirstOrderAllPass (double sampleRate,
+                                                                                                    NumericType frequency)
+{
+    return *new Coefficients (ArrayCoefficients<NumericType>::makeFirstOrderAllPass (sampleRate, frequency));
+}
+
+template <typename NumericType>
+typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeLowPass (double sampleRate,
+                                                                                          NumericType frequency)
+{
+    return *new Coefficients (ArrayCoefficients<NumericType>::makeLowPass (sampleRate, frequency));
+}
+
+template <typename NumericType>
+typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeLowPass (double sampleRate,
+                                                                                          NumericType frequency,
+                                                                                          NumericType Q)
+{
+    return *new Coefficients (ArrayCoefficients<NumericType>::makeLowPass (sampleRate, frequency, Q));
+}
+
+template <typename NumericType>
+typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeHighPass (double sampleRate,
+                                                                                           NumericType frequency)
+{
+    return *new Coefficients (ArrayCoefficients<NumericType>::makeHighPass (sampleRate, frequency));
+}
+
+template <typename NumericType>
+typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeHighPass (double sampleRate,
+                                                                                           NumericType frequency,
+                                                                                           NumericType Q)
+{
+    return *new Coefficients (ArrayCoefficients<NumericType>::makeHighPass (sampleRate, frequency, Q));
+}
+
+template <typename NumericType>
+typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeBandPass (double sampleRate,
+                                                                                           NumericType frequency)
+{
+    return *new Coefficients (ArrayCoefficients<NumericType>::makeBandPass (sampleRate, frequency));
+}
+
+template <typename NumericType>
+typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeBandPass (double sampleRate,
+                                                                                           NumericType frequency,
+                                                                                           NumericType Q)
+{
+    return *new Coefficients (ArrayCoefficients<NumericType>::makeBandPass (sampleRate, frequency, Q));
+}
+
+template <typename NumericType>
+typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeNotch (double sampleRate,
+                                                                                        NumericType frequency)
+{
+    return *new Coefficients (ArrayCoefficients<NumericType>::makeNotch (sampleRate, frequency));
+}
+
+template <typename NumericType>
+typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeNotch (double sampleRate,
+                                                                                        NumericType frequency,
+                                                                                        NumericType Q)
+{
+    return *new Coefficients (ArrayCoefficients<NumericType>::makeNotch (sampleRate, frequency, Q));
+}
+
+template <typename NumericType>
+typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeAllPass (double sampleRate,
+                                                                                          NumericType frequency)
+{
+    return *new Coefficients (ArrayCoefficients<NumericType>::makeAllPass (sampleRate, frequency));
+}
+
+template <typename NumericType>
+typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeAllPass (double sampleRate,
+                                                                                          NumericType frequency,
+                                                                                          NumericType Q)
+{
+    return *new Coefficients (ArrayCoefficients<NumericType>::makeAllPass (sampleRate, frequency, Q));
+}
+
+template <typename NumericType>
+typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeLowShelf (double sampleRate,
+                                                                                           NumericType cutOffFrequency,
+                                                                                           NumericType Q,
+                                                                                           NumericType gainFactor)
+{
+    return *new Coefficients (ArrayCoefficients<NumericType>::makeLowShelf (sampleRate, cutOffFrequency, Q, gainFactor));
+}
+
+template <typename NumericType>
+typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeHighShelf (double sampleRate,
+                                                                                            NumericType cutOffFrequency,
+                                                                                            NumericType Q,
+                                                                                            NumericType gainFactor)
+{
+    return *new Coefficients (ArrayCoefficients<NumericType>::makeHighShelf (sampleRate, cutOffFrequency, Q, gainFactor));
+}
+
+template <typename NumericType>
+typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makePeakFilter (double sampleRate,
+                                                                                             NumericType frequency,
+                                                                                             NumericType Q,
+                                                                                             NumericType gainFactor)
+{
+    return *new Coefficients (ArrayCoefficients<NumericType>::makePeakFilter (sampleRate, frequency, Q, gainFactor));
 }
 
 template <typename NumericType>
@@ -473,6 +564,9 @@ void IIR::Coefficients<NumericType>::getPhaseForFrequencyArray (double* frequenc
     }
 }
 
+template struct IIR::ArrayCoefficients<float>;
+template struct IIR::ArrayCoefficients<double>;
+
 template struct IIR::Coefficients<float>;
 template struct IIR::Coefficients<double>;
 
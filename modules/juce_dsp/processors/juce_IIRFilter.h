@@ -84,6 +84,10 @@ namespace IIR
 
             If you change the order of the coefficients then you must call reset after
             modifying them.
+
+            To change the coefficients on the audio thread without allocating any memory,
+            assign the result of one of the ArrayCoefficients functions to the existing
+            object, rather than replacing it with a new one.
         */
         CoefficientsPtr coefficients;
 
@@ -150,6 +154,197 @@ namespace IIR
     };
 
 
+    //==============================================================================
+    /** A set of functions returning the raw coefficients of the usual IIR filter
+        designs as std::arrays, without allocating any memory.
+
+        The coefficients are ordered as b0, b1, ..., a0, a1, ..., like the arguments
+        of the Coefficients constructors. They can be assigned to an existing
+        Coefficients object, which can be done on the audio thread when the filter
+        parameters are modulated, since it doesn't allocate any memory:
+
+        @code
+        *filter.coefficients = IIR::ArrayCoefficients<float>::makeLowPass (sampleRate, cutoff, q);
+        @endcode
+
+        @see Coefficients, CoefficientsTable
+
+        @tags{DSP}
+    */
+    template <typename NumericType>
+    struct ArrayCoefficients
+    {
+        //==============================================================================
+        /** Returns the raw coefficients for a first order low-pass filter. */
+        static std::array<NumericType, 4> makeFirstOrderLowPass (double sampleRate, NumericType frequency);
+
+        /** Returns the raw coefficients for a first order high-pass filter. */
+        static std::array<NumericType, 4> makeFirstOrderHighPass (double sampleRate, NumericType frequency);
+
+        /** Returns the raw coefficients for a first order all-pass filter. */
+        static std::array<NumericType, 4> makeFirstOrderAllPass (double sampleRate, NumericType frequency);
+
+        //==============================================================================
+        /** Returns the raw coefficients for a low-pass filter. */
+        static std::array<NumericType, 6> makeLowPass (double sampleRate, NumericType frequency);
+
+        /** Returns the raw coefficients for a low-pass filter with variable Q. */
+        static std::array<NumericType, 6> makeLowPass (double sampleRate, NumericType frequency, NumericType Q);
+
+        //==============================================================================
+        /** Returns the raw coefficients for a high-pass filter. */
+        static std::array<NumericType, 6> makeHighPass (double sampleRate, NumericType frequency);
+
+        /** Returns the raw coefficients for a high-pass filter with variable Q. */
+        static std::array<NumericType, 6> makeHighPass (double sampleRate, NumericType frequency, NumericType Q);
+
+        //==============================================================================
+        /** Returns the raw coefficients for a band-pass filter. */
+        static std::array<NumericType, 6> makeBandPass (double sampleRate, NumericType frequency);
+
+        /** Returns the raw coefficients for a band-pass filter with variable Q. */
+        static std::array<NumericType, 6> makeBandPass (double sampleRate, NumericType frequency, NumericType Q);
+
+        //==============================================================================
+        /** Returns the raw coefficients for a notch filter. */
+        static std::array<NumericType, 6> makeNotch (double sampleRate, NumericType frequency);
+
+        /** Returns the raw coefficients for a notch filter with variable Q. */
+        static std::array<NumericType, 6> makeNotch (double sampleRate, NumericType frequency, NumericType Q);
+
+        //==============================================================================
+        /** Returns the raw coefficients for an all-pass filter. */
+        static std::array<NumericType, 6> makeAllPass (double sampleRate, NumericType frequency);
+
+        /** Returns the raw coefficients for an all-pass filter with variable Q. */
+        static std::array<NumericType, 6> makeAllPass (double sampleRate, NumericType frequency, NumericType Q);
+
+        //==============================================================================
+        /** Returns the raw coefficients for a low-pass shelf filter with variable Q and gain.
+
+            The gain is a scale factor that the low frequencies are multiplied by, so values
+            greater than 1.0 will boost the low frequencies, values less than 1.0 will
+            attenuate them.
+        */
+        static std::array<NumericType, 6> makeLowShelf (double sampleRate, NumericType cutOffFrequency,
+                                                        NumericType Q, NumericType gainFactor);
+
+        /** Returns the raw coefficients for a high-pass shelf filter with variable Q and gain.
+
+            The gain is a scale factor that the high frequencies are multiplied by, so values
+            greater than 1.0 will boost the high frequencies, values less than 1.0 will
+            attenuate them.
+        */
+        static std::array<NumericType, 6> makeHighShelf (double sampleRate, NumericType cutOffFrequency,
+                                                         NumericType Q, NumericType gainFactor);
+
+        /** Returns the raw coefficients for a peak filter centred around a
+            given frequency, with a variable Q and gain.
+
+            The gain is a scale factor that the centre frequencies are multiplied by, so
+            values greater than 1.0 will boost the centre frequencies, values less than
+            1.0 will attenuate them.
+        */
+        static std::array<NumericType, 6> makePeakFilter (double sampleRate, NumericType centreFrequency,
+                                                          NumericType Q, NumericType gainFactor);
+
+    private:
+        // Unfortunately, std::sqrt is not marked as constexpr just yet in all compilers
+        static constexpr NumericType inverseRootTwo = static_cast<NumericType> (0.70710678118654752440L);
+    };
+
+    //==============================================================================
+    /**
+        A table of precomputed filter coefficients, covering a range of frequencies
+        spaced logarithmically, which can be used to modulate the frequency of a filter
+        at audio rate without calling the trigonometric functions of the filter designs
+        for every change.
+
+        The coefficients are interpolated linearly between the points of the table.
+        The set of stable first and second order filters is convex, so the interpolated
+        coefficients of stable designs are always stable too. The accuracy of the
+        frequency response depends on the number of points: 32 points per octave give
+        errors of less than 0.2 dB for the usual designs.
+
+        @code
+        table.prepare (sampleRate, 20.0f, 20000.0f, 320, [] (double rate, float frequency)
+        {
+            return IIR::ArrayCoefficients<float>::makeLowPass (rate, frequency, 2.0f);
+        });
+
+        // then on the audio thread
+        *filter.coefficients = table.getCoefficients (cutoff);
+        @endcode
+
+        @see ArrayCoefficients
+
+        @tags{DSP}
+    */
+    template <typename NumericType, size_t NumCoefficients = 6>
+    class CoefficientsTable
+    {
+    public:
+        //==============================================================================
+        /** Fills the table using a function returning the raw coefficients for a given
+            sample rate and frequency, such as one of the ArrayCoefficients functions.
+
+            This allocates some memory, so it shouldn't be called on the audio thread.
+        */
+        template <typename DesignFunction>
+        void prepare (double sampleRate, NumericType minFrequency, NumericType maxFrequency,
+                      size_t numPoints, DesignFunction&& design)
+        {
+            jassert (minFrequency > 0 && minFrequency < maxFrequency && numPoints >= 2);
+
+            minimum = minFrequency;
+            maximum = maxFrequency;
+            logMinimum = std::log (minFrequency);
+            pointsPerLogUnit = static_cast<NumericType> (numPoints - 1) / (std::log (maxFrequency) - logMinimum);
+
+            table.resize (numPoints);
+
+            for (size_t i = 0; i < numPoints; ++i)
+            {
+                auto frequency = std::exp (logMinimum + static_cast<NumericType> (i) / pointsPerLogUnit);
+                std::array<NumericType, NumCoefficients> values = design (sampleRate, jmin (frequency, maxFrequency));
+
+                // The coefficients are normalised, so that a0 is always 1 after the interpolation
+                auto a0inv = static_cast<NumericType> (1) / values[NumCoefficients / 2];
+
+                for (auto& value : values)
+                    value *= a0inv;
+
+                table[i] = values;
+            }
+        }
+
+        /** Returns the interpolated raw coefficients for a given frequency, which is
+            limited to the range of the table. This doesn't allocate any memory.
+        */
+        std::array<NumericType, NumCoefficients> getCoefficients (NumericType frequency) const noexcept
+        {
+            jassert (table.size() >= 2);
+
+            auto position = (std::log (jlimit (minimum, maximum, frequency)) - logMinimum) * pointsPerLogUnit;
+            auto index = jmin (static_cast<size_t> (position), table.size() - 2);
+            auto proportion = position - static_cast<NumericType> (index);
+
+            auto& first  = table[index];
+            auto& second = table[index + 1];
+            std::array<NumericType, NumCoefficients> result;
+
+            for (size_t i = 0; i < NumCoefficients; ++i)
+                result[i] = first[i] + proportion * (second[i] - first[i]);
+
+            return result;
+        }
+
+    private:
+        //==============================================================================
+        std::vector<std::array<NumericType, NumCoefficients>> table;
+        NumericType minimum = 0, maximum = 0, logMinimum = 0, pointsPerLogUnit = 0;
+    };
+
     //==============================================================================
     /** A set of coefficients for use in an Filter object.
         @see IIR::Filter
@@ -175,11 +370,28 @@ namespace IIR
         Coefficients (NumericType b0, NumericType b1, NumericType b2, NumericType b3,
                       NumericType a0, NumericType a1, NumericType a2, NumericType a3);
 
+        /** Constructs an object from an array of raw coefficients, ordered as b0, b1, ...,
+            a0, a1, ..., such as the ones returned by the ArrayCoefficients functions.
+        */
+        template <size_t Num>
+        explicit Coefficients (const std::array<NumericType, Num>& values)    { assignImpl (values); }
+
         Coefficients (const Coefficients&) = default;
         Coefficients (Coefficients&&) = default;
         Coefficients& operator= (const Coefficients&) = default;
         Coefficients& operator= (Coefficients&&) = default;
 
+        /** Replaces the coefficients with an array of raw coefficients, ordered as b0, b1, ...,
+            a0, a1, ..., such as the ones returned by the ArrayCoefficients functions.
+
+            The objects created with the constructors or the static functions of this
+            class have room for filters up to the third order, so assigning coefficients
+            of these orders doesn't allocate any memory, and can be done on the audio
+            thread to modulate the parameters of a filter.
+        */
+        template <size_t Num>
+        Coefficients& operator= (const std::array<NumericType, Num>& values)  { return assignImpl (values); }
+
         /** The Coefficients structure is ref-counted, so this is a handy type that can be used
             as a pointer to one.
         */
@@ -298,8 +510,26 @@ namespace IIR
         Array<NumericType> coefficients;
 
     private:
-        // Unfortunately, std::sqrt is not marked as constexpr just yet in all compilers
-        static constexpr NumericType inverseRootTwo = static_cast<NumericType> (0.70710678118654752440L);
+        template <size_t Num>
+        Coefficients& assignImpl (const std::array<NumericType, Num>& values)
+        {
+            static_assert (Num % 2 == 0, "The number of coefficients must be even");
+
+            constexpr auto a0Index = Num / 2;
+            auto a0 = values[a0Index];
+            jassert (a0 != 0);
+
+            auto a0inv = static_cast<NumericType> (1) / a0;
+
+            coefficients.clearQuick();
+            coefficients.ensureStorageAllocated ((int) jmax (Num - 1, static_cast<size_t> (7)));
+
+            for (size_t i = 0; i < Num; ++i)
+                if (i != a0Index)
+                    coefficients.add (values[i] * a0inv);
+
+            return *this;
+        }
     };
 
 } // namespace IIR
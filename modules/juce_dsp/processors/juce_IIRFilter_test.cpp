@@ -0,0 +1,158 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class IIRFilterTest : public UnitTest
+{
+public:
+    IIRFilterTest()
+        : UnitTest ("IIR Filter", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("ArrayCoefficients match the Coefficients functions");
+        {
+            checkArrayCoefficients<float>();
+            checkArrayCoefficients<double>();
+        }
+
+        beginTest ("Assigning ArrayCoefficients doesn't allocate");
+        {
+            using ArrayCoefficients = IIR::ArrayCoefficients<float>;
+
+            IIR::Filter<float> filter (IIR::Coefficients<float>::makeFirstOrderLowPass (44100.0, 1000.0f));
+            auto* storage = filter.coefficients->getRawCoefficients();
+
+            *filter.coefficients = ArrayCoefficients::makeLowPass (44100.0, 2000.0f, 0.5f);
+            expect (filter.coefficients->getRawCoefficients() == storage);
+            expectEquals ((int) filter.coefficients->getFilterOrder(), 2);
+
+            *filter.coefficients = ArrayCoefficients::makePeakFilter (44100.0, 500.0f, 2.0f, 0.5f);
+            expect (filter.coefficients->getRawCoefficients() == storage);
+
+            *filter.coefficients = std::array<float, 8> { { 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f } };
+            expect (filter.coefficients->getRawCoefficients() == storage);
+            expectEquals ((int) filter.coefficients->getFilterOrder(), 3);
+
+            *filter.coefficients = ArrayCoefficients::makeFirstOrderHighPass (44100.0, 100.0f);
+            expect (filter.coefficients->getRawCoefficients() == storage);
+            expectEquals ((int) filter.coefficients->getFilterOrder(), 1);
+
+            // the filter adapts its state to the new order
+            filter.prepare ({ 44100.0, 16, 1 });
+            *filter.coefficients = ArrayCoefficients::makeLowPass (44100.0, 2000.0f);
+
+            for (int i = 0; i < 16; ++i)
+                filter.processSample (1.0f);
+
+            expect (filter.coefficients->getRawCoefficients() == storage);
+        }
+
+        beginTest ("CoefficientsTable interpolates the filter designs");
+        {
+            checkTable ([] (double rate, float frequency) { return IIR::ArrayCoefficients<float>::makeLowPass (rate, frequency, 2.0f); });
+            checkTable ([] (double rate, float frequency) { return IIR::ArrayCoefficients<float>::makeHighPass (rate, frequency); });
+            checkTable ([] (double rate, float frequency) { return IIR::ArrayCoefficients<float>::makePeakFilter (rate, frequency, 1.0f, 4.0f); });
+            checkTable ([] (double rate, float frequency) { return IIR::ArrayCoefficients<float>::makeFirstOrderLowPass (rate, frequency); });
+        }
+    }
+
+private:
+    template <typename NumericType>
+    void checkArrayCoefficients()
+    {
+        using Coefficients      = IIR::Coefficients<NumericType>;
+        using ArrayCoefficients = IIR::ArrayCoefficients<NumericType>;
+
+        constexpr auto sampleRate = 48000.0;
+        const auto frequency = static_cast<NumericType> (1234.5);
+        const auto Q = static_cast<NumericType> (3);
+        const auto gain = static_cast<NumericType> (0.25);
+
+        expectCoefficientsEqual (*Coefficients::makeFirstOrderLowPass  (sampleRate, frequency), ArrayCoefficients::makeFirstOrderLowPass  (sampleRate, frequency));
+        expectCoefficientsEqual (*Coefficients::makeFirstOrderHighPass (sampleRate, frequency), ArrayCoefficients::makeFirstOrderHighPass (sampleRate, frequency));
+        expectCoefficientsEqual (*Coefficients::makeFirstOrderAllPass  (sampleRate, frequency), ArrayCoefficients::makeFirstOrderAllPass  (sampleRate, frequency));
+        expectCoefficientsEqual (*Coefficients::makeLowPass    (sampleRate, frequency, Q), ArrayCoefficients::makeLowPass    (sampleRate, frequency, Q));
+        expectCoefficientsEqual (*Coefficients::makeHighPass   (sampleRate, frequency, Q), ArrayCoefficients::makeHighPass   (sampleRate, frequency, Q));
+        expectCoefficientsEqual (*Coefficients::makeBandPass   (sampleRate, frequency, Q), ArrayCoefficients::makeBandPass   (sampleRate, frequency, Q));
+        expectCoefficientsEqual (*Coefficients::makeNotch      (sampleRate, frequency, Q), ArrayCoefficients::makeNotch      (sampleRate, frequency, Q));
+        expectCoefficientsEqual (*Coefficients::makeAllPass    (sampleRate, frequency, Q), ArrayCoefficients::makeAllPass    (sampleRate, frequency, Q));
+        expectCoefficientsEqual (*Coefficients::makeLowShelf   (sampleRate, frequency, Q, gain), ArrayCoefficients::makeLowShelf   (sampleRate, frequency, Q, gain));
+        expectCoefficientsEqual (*Coefficients::makeHighShelf  (sampleRate, frequency, Q, gain), ArrayCoefficients::makeHighShelf  (sampleRate, frequency, Q, gain));
+        expectCoefficientsEqual (*Coefficients::makePeakFilter (sampleRate, frequency, Q, gain), ArrayCoefficients::makePeakFilter (sampleRate, frequency, Q, gain));
+    }
+
+    template <typename NumericType, size_t Num>
+    void expectCoefficientsEqual (const IIR::Coefficients<NumericType>& expected, const std::array<NumericType, Num>& values)
+    {
+        IIR::Coefficients<NumericType> assigned;
+        assigned = values;
+
+        expectEquals (assigned.coefficients.size(), expected.coefficients.size());
+
+        for (int i = 0; i < expected.coefficients.size(); ++i)
+            expectEquals (assigned.coefficients[i], expected.coefficients[i]);
+    }
+
+    template <typename DesignFunction>
+    void checkTable (DesignFunction&& design)
+    {
+        constexpr auto sampleRate = 44100.0;
+
+        IIR::CoefficientsTable<float, std::tuple_size<decltype (design (sampleRate, 1.0f))>::value> table;
+        table.prepare (sampleRate, 20.0f, 20000.0f, 320, design);
+
+        IIR::Coefficients<float> exact, interpolated;
+        auto maxErrordB = 0.0;
+
+        for (auto frequency = 20.0f; frequency <= 20000.0f; frequency *= 1.0137f)
+        {
+            exact = design (sampleRate, frequency);
+            interpolated = table.getCoefficients (frequency);
+
+            for (auto testFrequency = 10.0; testFrequency < sampleRate * 0.5; testFrequency *= 1.25)
+            {
+                auto error = Decibels::gainToDecibels (interpolated.getMagnitudeForFrequency (testFrequency, sampleRate), -200.0)
+                           - Decibels::gainToDecibels (exact.getMagnitudeForFrequency (testFrequency, sampleRate), -200.0);
+
+                // the errors in the deep stopband of the filters are irrelevant
+                if (exact.getMagnitudeForFrequency (testFrequency, sampleRate) > 1.0e-3)
+                    maxErrordB = jmax (maxErrordB, std::abs (error));
+            }
+        }
+
+        expect (maxErrordB < 0.2, "Maximum error " + String (maxErrordB) + " dB");
+    }
+};
+
+static IIRFilterTest iirFilterTest;
+
+} // namespace dsp
+} // namespace juce
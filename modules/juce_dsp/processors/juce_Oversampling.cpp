@@ -28,6 +28,113 @@ namespace juce
 namespace dsp
 {
 
+namespace OversamplingHelpers
+{
+   #if JUCE_USE_SIMD
+    template <typename SampleType>
+    using Vector = SIMDRegister<SampleType>;
+   #else
+    template <typename SampleType>
+    using Vector = SampleType;
+   #endif
+
+    template <typename SampleType>
+    static inline Vector<SampleType> load (const SampleType* source) noexcept
+    {
+       #if JUCE_USE_SIMD
+        return Vector<SampleType>::fromRawArray (source);
+       #else
+        return *source;
+       #endif
+    }
+
+    template <typename SampleType>
+    static inline void store (SampleType* dest, Vector<SampleType> value) noexcept
+    {
+       #if JUCE_USE_SIMD
+        value.copyToRawArray (dest);
+       #else
+        *dest = value;
+       #endif
+    }
+
+    template <typename SampleType>
+    static inline Vector<SampleType> broadcast (SampleType value) noexcept
+    {
+       #if JUCE_USE_SIMD
+        return Vector<SampleType>::expand (value);
+       #else
+        return value;
+       #endif
+    }
+
+    //==============================================================================
+    /*  A block of memory divided into slots, each of which holds one sample of every
+        channel. The channels are padded to a whole number of SIMD registers, so that
+        all the channels of a slot can be processed with aligned vector operations.
+    */
+    template <typename SampleType>
+    struct LaneBuffer
+    {
+        static constexpr size_t laneWidth = sizeof (Vector<SampleType>) / sizeof (SampleType);
+
+        void setSize (size_t numChannels, size_t newNumSlots)
+        {
+            numGroups = (numChannels + laneWidth - 1) / laneWidth;
+            stride = numGroups * laneWidth;
+            numSlots = newNumSlots;
+
+            memory.malloc (numSlots * stride * sizeof (SampleType) + sizeof (Vector<SampleType>));
+            data = snapPointerToAlignment (reinterpret_cast<SampleType*> (memory.getData()), sizeof (Vector<SampleType>));
+            clear();
+        }
+
+        void clear() noexcept
+        {
+            std::fill (data, data + numSlots * stride, SampleType (0));
+        }
+
+        void snapToZero() noexcept
+        {
+            for (size_t i = 0; i < numSlots * stride; ++i)
+                util::snapToZero (data[i]);
+        }
+
+        SampleType* getSlot (size_t slot) const noexcept    { return data + slot * stride; }
+
+        void interleave (const AudioBlock<const SampleType>& block, size_t startSample, size_t numSamples) noexcept
+        {
+            jassert (numSamples <= numSlots);
+
+            for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+            {
+                auto* source = block.getChannelPointer (channel) + startSample;
+
+                for (size_t i = 0; i < numSamples; ++i)
+                    data[i * stride + channel] = source[i];
+            }
+        }
+
+        void deinterleave (const AudioBlock<SampleType>& block, size_t startSample, size_t numSamples) const noexcept
+        {
+            jassert (numSamples <= numSlots);
+
+            for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+            {
+                auto* dest = block.getChannelPointer (channel) + startSample;
+
+                for (size_t i = 0; i < numSamples; ++i)
+                    dest[i] = data[i * stride + channel];
+            }
+        }
+
+        HeapBlock<char> memory;
+        SampleType* data = nullptr;
+        size_t numGroups = 0, stride = 0, numSlots = 0;
+    };
+}
+
+//==============================================================================
 /** Abstract class for the provided oversampling stages used internally in
     the Oversampling class.
 */
@@ -62,6 +169,9 @@ struct Oversampling<SampleType>::OversamplingStage
 
     AudioBuffer<SampleType> buffer;
     size_t numChannels, factor;
+
+    float transitionWidthUp = 0, stopbandUp = 0,
+          transitionWidthDown = 0, stopbandDown = 0;
 };
 
 
@@ -103,6 +213,92 @@ struct OversamplingDummy   : public Oversampling<SampleType>::OversamplingStage
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OversamplingDummy)
 };
 
+//==============================================================================
+/** Base class for the oversampling stages which process all the channels at once.
+
+    The samples are copied in small chunks into interleaved buffers, where each SIMD
+    register holds the same sample of several channels, so the filters of all the
+    channels are run together. The derived classes only have to process the chunks.
+*/
+template <typename SampleType>
+struct OversamplingMultichannelStage  : public Oversampling<SampleType>::OversamplingStage
+{
+    using ParentType = typename Oversampling<SampleType>::OversamplingStage;
+    using Lanes = OversamplingHelpers::LaneBuffer<SampleType>;
+
+    OversamplingMultichannelStage (size_t numChans, size_t newFactor)
+        : ParentType (numChans, newFactor),
+          chunkSize (jmax ((size_t) 1, (size_t) 256 / newFactor))
+    {
+        lowRateLanes .setSize (this->numChannels, chunkSize);
+        highRateLanes.setSize (this->numChannels, chunkSize * this->factor);
+    }
+
+    //==============================================================================
+    void processSamplesUp (const AudioBlock<const SampleType>& inputBlock) override
+    {
+        jassert (inputBlock.getNumChannels() <= static_cast<size_t> (ParentType::buffer.getNumChannels()));
+        jassert (inputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
+
+        auto numSamples = inputBlock.getNumSamples();
+        auto outputBlock = AudioBlock<SampleType> (ParentType::buffer).getSubsetChannelBlock (0, inputBlock.getNumChannels());
+
+        for (size_t start = 0; start < numSamples; start += chunkSize)
+        {
+            auto num = jmin (chunkSize, numSamples - start);
+
+            lowRateLanes.interleave (inputBlock, start, num);
+            processChunkUp (num);
+            highRateLanes.deinterleave (outputBlock, start * this->factor, num * this->factor);
+        }
+
+       #if JUCE_SNAP_TO_ZERO
+        snapToZero (true);
+       #endif
+    }
+
+    void processSamplesDown (AudioBlock<SampleType>& outputBlock) override
+    {
+        jassert (outputBlock.getNumChannels() <= static_cast<size_t> (ParentType::buffer.getNumChannels()));
+        jassert (outputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
+
+        auto numSamples = outputBlock.getNumSamples();
+        auto inputBlock = AudioBlock<const SampleType> (ParentType::buffer).getSubsetChannelBlock (0, outputBlock.getNumChannels());
+
+        for (size_t start = 0; start < numSamples; start += chunkSize)
+        {
+            auto num = jmin (chunkSize, numSamples - start);
+
+            highRateLanes.interleave (inputBlock, start * this->factor, num * this->factor);
+            processChunkDown (num);
+            lowRateLanes.deinterleave (outputBlock, start, num);
+        }
+
+       #if JUCE_SNAP_TO_ZERO
+        snapToZero (false);
+       #endif
+    }
+
+    //==============================================================================
+    /** Fills the first (numSamples * factor) slots of highRateLanes from the first
+        numSamples slots of lowRateLanes.
+    */
+    virtual void processChunkUp (size_t numSamples) noexcept = 0;
+
+    /** Fills the first numSamples slots of lowRateLanes from the first
+        (numSamples * factor) slots of highRateLanes.
+    */
+    virtual void processChunkDown (size_t numSamples) noexcept = 0;
+
+    virtual void snapToZero (bool /*snapUpProcessing*/) noexcept {}
+
+    //==============================================================================
+    static constexpr size_t laneWidth = Lanes::laneWidth;
+
+    const size_t chunkSize;
+    Lanes lowRateLanes, highRateLanes;
+};
+
 //==============================================================================
 /** Oversampling stage class performing 2 times oversampling using the Filter
     Design FIR Equiripple method. The resulting filter is linear phase,
@@ -110,9 +306,10 @@ struct OversamplingDummy   : public Oversampling<SampleType>::OversamplingStage
     leading to specific processing optimizations.
 */
 template <typename SampleType>
-struct Oversampling2TimesEquirippleFIR  : public Oversampling<SampleType>::OversamplingStage
+struct Oversampling2TimesEquirippleFIR  : public OversamplingMultichannelStage<SampleType>
 {
-    using ParentType = typename Oversampling<SampleType>::OversamplingStage;
+    using ParentType = OversamplingMultichannelStage<SampleType>;
+    using Vector = OversamplingHelpers::Vector<SampleType>;
 
     Oversampling2TimesEquirippleFIR (size_t numChans,
                                      SampleType normalisedTransitionWidthUp,
@@ -124,17 +321,13 @@ struct Oversampling2TimesEquirippleFIR  : public Oversampling<SampleType>::Overs
         coefficientsUp   = *FilterDesign<SampleType>::designFIRLowpassHalfBandEquirippleMethod (normalisedTransitionWidthUp,   stopbandAmplitudedBUp);
         coefficientsDown = *FilterDesign<SampleType>::designFIRLowpassHalfBandEquirippleMethod (normalisedTransitionWidthDown, stopbandAmplitudedBDown);
 
-        auto N = coefficientsUp.getFilterOrder() + 1;
-        stateUp.setSize (static_cast<int> (this->numChannels), static_cast<int> (N));
-
-        N = coefficientsDown.getFilterOrder() + 1;
-        auto Ndiv2 = N / 2;
-        auto Ndiv4 = Ndiv2 / 2;
-
-        stateDown.setSize  (static_cast<int> (this->numChannels), static_cast<int> (N));
-        stateDown2.setSize (static_cast<int> (this->numChannels), static_cast<int> (Ndiv4 + 1));
+        // The even samples of the input are stored twice, so that the last (N + 1) / 2
+        // of them can always be read from consecutive slots
+        historyUp  .setSize (this->numChannels, coefficientsUp  .getFilterOrder() + 2);
+        historyDown.setSize (this->numChannels, coefficientsDown.getFilterOrder() + 2);
 
-        position.resize (static_cast<int> (this->numChannels));
+        // The odd samples only go through the centre tap, so they just need a delay
+        oddDelayDown.setSize (this->numChannels, (coefficientsDown.getFilterOrder() + 2) / 4);
     }
 
     //==============================================================================
@@ -147,109 +340,113 @@ struct Oversampling2TimesEquirippleFIR  : public Oversampling<SampleType>::Overs
     {
         ParentType::reset();
 
-        stateUp.clear();
-        stateDown.clear();
-        stateDown2.clear();
+        historyUp.clear();
+        historyDown.clear();
+        oddDelayDown.clear();
 
-        position.fill (0);
+        positionUp = positionDown = oddPositionDown = 0;
     }
 
-    void processSamplesUp (const AudioBlock<const SampleType>& inputBlock) override
+    void processChunkUp (size_t numSamples) noexcept override
     {
-        jassert (inputBlock.getNumChannels() <= static_cast<size_t> (ParentType::buffer.getNumChannels()));
-        jassert (inputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
+        using namespace OversamplingHelpers;
 
-        // Initialization
         auto fir = coefficientsUp.getRawCoefficients();
         auto N = coefficientsUp.getFilterOrder() + 1;
         auto Ndiv2 = N / 2;
-        auto numSamples = inputBlock.getNumSamples();
+        auto historySize = Ndiv2 + 1;
+        auto centreTap = fir[Ndiv2];
+        auto stride = this->lowRateLanes.stride;
+        size_t position = 0;
 
-        // Processing
-        for (size_t channel = 0; channel < inputBlock.getNumChannels(); ++channel)
+        for (size_t offset = 0; offset < stride; offset += ParentType::laneWidth)
         {
-            auto bufferSamples = ParentType::buffer.getWritePointer (static_cast<int> (channel));
-            auto buf = stateUp.getWritePointer (static_cast<int> (channel));
-            auto samples = inputBlock.getChannelPointer (channel);
+            position = positionUp;
 
             for (size_t i = 0; i < numSamples; ++i)
             {
-                // Input
-                buf[N - 1] = 2 * samples[i];
+                auto input = load (this->lowRateLanes.getSlot (i) + offset) * static_cast<SampleType> (2);
+                store (historyUp.getSlot (position) + offset, input);
+                store (historyUp.getSlot (position + historySize) + offset, input);
+
+                // The window holds the last samples, from the oldest to the newest one
+                auto window = historyUp.getSlot (position + 1) + offset;
 
                 // Convolution
-                auto out = static_cast<SampleType> (0.0);
+                auto out = broadcast (static_cast<SampleType> (0));
 
                 for (size_t k = 0; k < Ndiv2; k += 2)
-                    out += (buf[k] + buf[N - k - 1]) * fir[k];
+                    out = out + (load (window + (k / 2) * stride) + load (window + (historySize - 1 - k / 2) * stride)) * fir[k];
 
                 // Outputs
-                bufferSamples[i << 1] = out;
-                bufferSamples[(i << 1) + 1] = buf[Ndiv2 + 1] * fir[Ndiv2];
+                store (this->highRateLanes.getSlot (i << 1) + offset, out);
+                store (this->highRateLanes.getSlot ((i << 1) + 1) + offset,
+                       load (window + ((Ndiv2 + 1) / 2) * stride) * centreTap);
 
-                // Shift data
-                for (size_t k = 0; k < N - 2; k += 2)
-                    buf[k] = buf[k + 2];
+                if (++position == historySize)
+                    position = 0;
             }
         }
+
+        positionUp = position;
     }
 
-    void processSamplesDown (AudioBlock<SampleType>& outputBlock) override
+    void processChunkDown (size_t numSamples) noexcept override
     {
-        jassert (outputBlock.getNumChannels() <= static_cast<size_t> (ParentType::buffer.getNumChannels()));
-        jassert (outputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
+        using namespace OversamplingHelpers;
 
-        // Initialization
         auto fir = coefficientsDown.getRawCoefficients();
         auto N = coefficientsDown.getFilterOrder() + 1;
         auto Ndiv2 = N / 2;
-        auto Ndiv4 = Ndiv2 / 2;
-        auto numSamples = outputBlock.getNumSamples();
+        auto historySize = Ndiv2 + 1;
+        auto oddDelaySize = oddDelayDown.numSlots;
+        auto centreTap = fir[Ndiv2];
+        auto stride = this->lowRateLanes.stride;
+        size_t position = 0, oddPosition = 0;
 
-        // Processing
-        for (size_t channel = 0; channel < outputBlock.getNumChannels(); ++channel)
+        for (size_t offset = 0; offset < stride; offset += ParentType::laneWidth)
         {
-            auto bufferSamples = ParentType::buffer.getWritePointer (static_cast<int> (channel));
-            auto buf = stateDown.getWritePointer (static_cast<int> (channel));
-            auto buf2 = stateDown2.getWritePointer (static_cast<int> (channel));
-            auto samples = outputBlock.getChannelPointer (channel);
-            auto pos = position.getUnchecked (static_cast<int> (channel));
+            position = positionDown;
+            oddPosition = oddPositionDown;
 
             for (size_t i = 0; i < numSamples; ++i)
             {
-                // Input
-                buf[N - 1] = bufferSamples[i << 1];
+                auto input = load (this->highRateLanes.getSlot (i << 1) + offset);
+                store (historyDown.getSlot (position) + offset, input);
+                store (historyDown.getSlot (position + historySize) + offset, input);
+
+                auto window = historyDown.getSlot (position + 1) + offset;
 
                 // Convolution
-                auto out = static_cast<SampleType> (0.0);
+                auto out = broadcast (static_cast<SampleType> (0));
 
                 for (size_t k = 0; k < Ndiv2; k += 2)
-                    out += (buf[k] + buf[N - k - 1]) * fir[k];
+                    out = out + (load (window + (k / 2) * stride) + load (window + (historySize - 1 - k / 2) * stride)) * fir[k];
 
                 // Output
-                out += buf2[pos] * fir[Ndiv2];
-                buf2[pos] = bufferSamples[(i << 1) + 1];
+                auto oddSlot = oddDelayDown.getSlot (oddPosition) + offset;
+                out = out + load (oddSlot) * centreTap;
+                store (oddSlot, load (this->highRateLanes.getSlot ((i << 1) + 1) + offset));
 
-                samples[i] = out;
+                store (this->lowRateLanes.getSlot (i) + offset, out);
 
-                // Shift data
-                for (size_t k = 0; k < N - 2; ++k)
-                    buf[k] = buf[k + 2];
+                if (++position == historySize)
+                    position = 0;
 
-                // Circular buffer
-                pos = (pos == 0 ? Ndiv4 : pos - 1);
+                if (++oddPosition == oddDelaySize)
+                    oddPosition = 0;
             }
-
-            position.setUnchecked (static_cast<int> (channel), pos);
         }
 
+        positionDown = position;
+        oddPositionDown = oddPosition;
     }
 
 private:
     //==============================================================================
     FIR::Coefficients<SampleType> coefficientsUp, coefficientsDown;
-    AudioBuffer<SampleType> stateUp, stateDown, stateDown2;
-    Array<size_t> position;
+    typename ParentType::Lanes historyUp, historyDown, oddDelayDown;
+    size_t positionUp = 0, positionDown = 0, oddPositionDown = 0;
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Oversampling2TimesEquirippleFIR)
@@ -262,9 +459,10 @@ private:
     phase, and provided with a method to get the exact resulting latency.
 */
 template <typename SampleType>
-struct Oversampling2TimesPolyphaseIIR  : public Oversampling<SampleType>::OversamplingStage
+struct Oversampling2TimesPolyphaseIIR  : public OversamplingMultichannelStage<SampleType>
 {
-    using ParentType = typename Oversampling<SampleType>::OversamplingStage;
+    using ParentType = OversamplingMultichannelStage<SampleType>;
+    using Vector = OversamplingHelpers::Vector<SampleType>;
 
     Oversampling2TimesPolyphaseIIR (size_t numChans,
                                     SampleType normalisedTransitionWidthUp,
@@ -282,20 +480,20 @@ struct Oversampling2TimesPolyphaseIIR  : public Oversampling<SampleType>::Oversa
         latency += static_cast<SampleType> (-(coeffsDown.getPhaseForFrequency (0.0001, 1.0)) / (0.0001 * MathConstants<double>::twoPi));
 
         for (auto i = 0; i < structureUp.directPath.size(); ++i)
-            coefficientsUp.add (structureUp.directPath.getObjectPointer (i)->coefficients[0]);
+            coefficientsUp.push_back (structureUp.directPath.getObjectPointer (i)->coefficients[0]);
 
         for (auto i = 1; i < structureUp.delayedPath.size(); ++i)
-            coefficientsUp.add (structureUp.delayedPath.getObjectPointer (i)->coefficients[0]);
+            coefficientsUp.push_back (structureUp.delayedPath.getObjectPointer (i)->coefficients[0]);
 
         for (auto i = 0; i < structureDown.directPath.size(); ++i)
-            coefficientsDown.add (structureDown.directPath.getObjectPointer (i)->coefficients[0]);
+            coefficientsDown.push_back (structureDown.directPath.getObjectPointer (i)->coefficients[0]);
 
         for (auto i = 1; i < structureDown.delayedPath.size(); ++i)
-            coefficientsDown.add (structureDown.delayedPath.getObjectPointer (i)->coefficients[0]);
+            coefficientsDown.push_back (structureDown.delayedPath.getObjectPointer (i)->coefficients[0]);
 
-        v1Up.setSize   (static_cast<int> (this->numChannels), coefficientsUp.size());
-        v1Down.setSize (static_cast<int> (this->numChannels), coefficientsDown.size());
-        delayDown.resize (static_cast<int> (this->numChannels));
+        v1Up     .setSize (this->numChannels, coefficientsUp.size());
+        v1Down   .setSize (this->numChannels, coefficientsDown.size());
+        delayDown.setSize (this->numChannels, 1);
     }
 
     //==============================================================================
@@ -309,152 +507,110 @@ struct Oversampling2TimesPolyphaseIIR  : public Oversampling<SampleType>::Oversa
         ParentType::reset();
         v1Up.clear();
         v1Down.clear();
-        delayDown.fill (0);
+        delayDown.clear();
     }
 
-    void processSamplesUp (const AudioBlock<const SampleType>& inputBlock) override
+    void processChunkUp (size_t numSamples) noexcept override
     {
-        jassert (inputBlock.getNumChannels() <= static_cast<size_t> (ParentType::buffer.getNumChannels()));
-        jassert (inputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
+        using namespace OversamplingHelpers;
 
         // Initialization
-        auto coeffs = coefficientsUp.getRawDataPointer();
+        auto coeffs = coefficientsUp.data();
         auto numStages = coefficientsUp.size();
         auto delayedStages = numStages / 2;
         auto directStages = numStages - delayedStages;
-        auto numSamples = inputBlock.getNumSamples();
+        auto stride = this->lowRateLanes.stride;
 
         // Processing
-        for (size_t channel = 0; channel < inputBlock.getNumChannels(); ++channel)
+        for (size_t offset = 0; offset < stride; offset += ParentType::laneWidth)
         {
-            auto bufferSamples = ParentType::buffer.getWritePointer (static_cast<int> (channel));
-            auto lv1 = v1Up.getWritePointer (static_cast<int> (channel));
-            auto samples = inputBlock.getChannelPointer (channel);
+            auto lv1 = v1Up.getSlot (0) + offset;
 
             for (size_t i = 0; i < numSamples; ++i)
             {
                 // Direct path cascaded allpass filters
-                auto input = samples[i];
+                auto samples = load (this->lowRateLanes.getSlot (i) + offset);
+                auto input = samples;
 
-                for (auto n = 0; n < directStages; ++n)
-                {
-                    auto alpha = coeffs[n];
-                    auto output = alpha * input + lv1[n];
-                    lv1[n] = input - alpha * output;
-                    input = output;
-                }
+                for (size_t n = 0; n < directStages; ++n)
+                    input = processAllpass (input, coeffs[n], lv1 + n * stride);
 
                 // Output
-                bufferSamples[i << 1] = input;
+                store (this->highRateLanes.getSlot (i << 1) + offset, input);
 
                 // Delayed path cascaded allpass filters
-                input = samples[i];
+                input = samples;
 
                 for (auto n = directStages; n < numStages; ++n)
-                {
-                    auto alpha = coeffs[n];
-                    auto output = alpha * input + lv1[n];
-                    lv1[n] = input - alpha * output;
-                    input = output;
-                }
+                    input = processAllpass (input, coeffs[n], lv1 + n * stride);
 
                 // Output
-                bufferSamples[(i << 1) + 1] = input;
+                store (this->highRateLanes.getSlot ((i << 1) + 1) + offset, input);
             }
         }
-
-       #if JUCE_SNAP_TO_ZERO
-        snapToZero (true);
-       #endif
     }
 
-    void processSamplesDown (AudioBlock<SampleType>& outputBlock) override
+    void processChunkDown (size_t numSamples) noexcept override
     {
-        jassert (outputBlock.getNumChannels() <= static_cast<size_t> (ParentType::buffer.getNumChannels()));
-        jassert (outputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
+        using namespace OversamplingHelpers;
 
         // Initialization
-        auto coeffs = coefficientsDown.getRawDataPointer();
+        auto coeffs = coefficientsDown.data();
         auto numStages = coefficientsDown.size();
         auto delayedStages = numStages / 2;
         auto directStages = numStages - delayedStages;
-        auto numSamples = outputBlock.getNumSamples();
+        auto stride = this->lowRateLanes.stride;
 
         // Processing
-        for (size_t channel = 0; channel < outputBlock.getNumChannels(); ++channel)
+        for (size_t offset = 0; offset < stride; offset += ParentType::laneWidth)
         {
-            auto bufferSamples = ParentType::buffer.getWritePointer (static_cast<int> (channel));
-            auto lv1 = v1Down.getWritePointer (static_cast<int> (channel));
-            auto samples = outputBlock.getChannelPointer (channel);
-            auto delay = delayDown.getUnchecked (static_cast<int> (channel));
+            auto lv1 = v1Down.getSlot (0) + offset;
+            auto delay = load (delayDown.getSlot (0) + offset);
 
             for (size_t i = 0; i < numSamples; ++i)
             {
                 // Direct path cascaded allpass filters
-                auto input = bufferSamples[i << 1];
+                auto input = load (this->highRateLanes.getSlot (i << 1) + offset);
 
-                for (auto n = 0; n < directStages; ++n)
-                {
-                    auto alpha = coeffs[n];
-                    auto output = alpha * input + lv1[n];
-                    lv1[n] = input - alpha * output;
-                    input = output;
-                }
+                for (size_t n = 0; n < directStages; ++n)
+                    input = processAllpass (input, coeffs[n], lv1 + n * stride);
 
                 auto directOut = input;
 
                 // Delayed path cascaded allpass filters
-                input = bufferSamples[(i << 1) + 1];
+                input = load (this->highRateLanes.getSlot ((i << 1) + 1) + offset);
 
                 for (auto n = directStages; n < numStages; ++n)
-                {
-                    auto alpha = coeffs[n];
-                    auto output = alpha * input + lv1[n];
-                    lv1[n] = input - alpha * output;
-                    input = output;
-                }
+                    input = processAllpass (input, coeffs[n], lv1 + n * stride);
 
                 // Output
-                samples[i] = (delay + directOut) * static_cast<SampleType> (0.5);
+                store (this->lowRateLanes.getSlot (i) + offset, (delay + directOut) * static_cast<SampleType> (0.5));
                 delay = input;
             }
 
-            delayDown.setUnchecked (static_cast<int> (channel), delay);
+            store (delayDown.getSlot (0) + offset, delay);
         }
-
-       #if JUCE_SNAP_TO_ZERO
-        snapToZero (false);
-       #endif
     }
 
-    void snapToZero (bool snapUpProcessing)
+    void snapToZero (bool snapUpProcessing) noexcept override
     {
         if (snapUpProcessing)
-        {
-            for (auto channel = 0; channel < ParentType::buffer.getNumChannels(); ++channel)
-            {
-                auto lv1 = v1Up.getWritePointer (channel);
-                auto numStages = coefficientsUp.size();
-
-                for (auto n = 0; n < numStages; ++n)
-                    util::snapToZero (lv1[n]);
-            }
-        }
+            v1Up.snapToZero();
         else
-        {
-            for (auto channel = 0; channel < ParentType::buffer.getNumChannels(); ++channel)
-            {
-                auto lv1 = v1Down.getWritePointer (channel);
-                auto numStages = coefficientsDown.size();
-
-                for (auto n = 0; n < numStages; ++n)
-                    util::snapToZero (lv1[n]);
-            }
-        }
+            v1Down.snapToZero();
     }
 
 private:
     //==============================================================================
+    static forcedinline Vector processAllpass (Vector input, SampleType alpha, SampleType* state) noexcept
+    {
+        using namespace OversamplingHelpers;
+
+        auto output = input * alpha + load (state);
+        store (state, input - output * alpha);
+        return output;
+    }
+
     /** This function calculates the equivalent high order IIR filter of a given
         polyphase cascaded allpass filters structure.
     */
@@ -517,17 +673,208 @@ private:
     }
 
     //==============================================================================
-    Array<SampleType> coefficientsUp, coefficientsDown;
+    std::vector<SampleType> coefficientsUp, coefficientsDown;
     SampleType latency;
 
-    AudioBuffer<SampleType> v1Up, v1Down;
-    Array<SampleType> delayDown;
+    typename ParentType::Lanes v1Up, v1Down, delayDown;
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Oversampling2TimesPolyphaseIIR)
 };
 
 
+//==============================================================================
+/** Oversampling stage class performing 2 ^ n times oversampling in a single step,
+    using linear phase FIR filters designed with the Kaiser window method.
+
+    The upsampling filter is split into one polyphase branch per output phase, so
+    the zeros inserted between the input samples are never multiplied, and the
+    downsampling filter is only calculated for the samples which are kept.
+*/
+template <typename SampleType>
+struct OversamplingPolyphaseFIR  : public OversamplingMultichannelStage<SampleType>
+{
+    using ParentType = OversamplingMultichannelStage<SampleType>;
+    using Vector = OversamplingHelpers::Vector<SampleType>;
+
+    OversamplingPolyphaseFIR (size_t numChans, size_t newFactor,
+                              SampleType normalisedTransitionWidthUp,
+                              SampleType stopbandAmplitudedBUp,
+                              SampleType normalisedTransitionWidthDown,
+                              SampleType stopbandAmplitudedBDown)
+        : ParentType (numChans, newFactor)
+    {
+        // The factor must be a power of two
+        jassert (isPowerOfTwo (newFactor) && newFactor >= 2);
+
+        auto up   = designFilter (newFactor, normalisedTransitionWidthUp,   stopbandAmplitudedBUp);
+        auto down = designFilter (newFactor, normalisedTransitionWidthDown, stopbandAmplitudedBDown);
+
+        orderUp   = up  ->getFilterOrder();
+        orderDown = down->getFilterOrder();
+
+        // Each polyphase branch of the upsampling filter is stored in reverse order, so it
+        // can be applied to the input history from the oldest to the newest sample. The
+        // gain makes up for the energy lost by inserting the zeros.
+        auto numTaps = orderUp + 1;
+        tapsPerPhase = (numTaps + this->factor - 1) / this->factor;
+        phasesUp.assign (tapsPerPhase * this->factor, SampleType (0));
+
+        for (size_t i = 0; i < numTaps; ++i)
+        {
+            auto phase = i % this->factor, tap = i / this->factor;
+            phasesUp[phase * tapsPerPhase + (tapsPerPhase - 1 - tap)] = up->getRawCoefficients()[i] * static_cast<SampleType> (this->factor);
+        }
+
+        numTaps = orderDown + 1;
+        coefficientsDown.resize (numTaps);
+
+        for (size_t i = 0; i < numTaps; ++i)
+            coefficientsDown[i] = down->getRawCoefficients()[numTaps - 1 - i];
+
+        historyUp  .setSize (this->numChannels, 2 * tapsPerPhase);
+        historyDown.setSize (this->numChannels, 2 * numTaps);
+    }
+
+    //==============================================================================
+    SampleType getLatencyInSamples() const override
+    {
+        return static_cast<SampleType> (orderUp + orderDown) * 0.5f;
+    }
+
+    void reset() override
+    {
+        ParentType::reset();
+
+        historyUp.clear();
+        historyDown.clear();
+        positionUp = positionDown = 0;
+    }
+
+    void processChunkUp (size_t numSamples) noexcept override
+    {
+        using namespace OversamplingHelpers;
+
+        auto stride = this->lowRateLanes.stride;
+        auto numPhases = this->factor;
+        size_t position = 0;
+
+        for (size_t offset = 0; offset < stride; offset += ParentType::laneWidth)
+        {
+            position = positionUp;
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                auto input = load (this->lowRateLanes.getSlot (i) + offset);
+                store (historyUp.getSlot (position) + offset, input);
+                store (historyUp.getSlot (position + tapsPerPhase) + offset, input);
+
+                auto window = historyUp.getSlot (position + 1) + offset;
+
+                for (size_t phase = 0; phase < numPhases; ++phase)
+                {
+                    auto* taps = phasesUp.data() + phase * tapsPerPhase;
+                    auto out = broadcast (static_cast<SampleType> (0));
+
+                    for (size_t k = 0; k < tapsPerPhase; ++k)
+                        out = out + load (window + k * stride) * taps[k];
+
+                    store (this->highRateLanes.getSlot (i * numPhases + phase) + offset, out);
+                }
+
+                if (++position == tapsPerPhase)
+                    position = 0;
+            }
+        }
+
+        positionUp = position;
+    }
+
+    void processChunkDown (size_t numSamples) noexcept override
+    {
+        using namespace OversamplingHelpers;
+
+        auto stride = this->lowRateLanes.stride;
+        auto numPhases = this->factor;
+        auto numTaps = coefficientsDown.size();
+        auto* taps = coefficientsDown.data();
+        size_t position = 0;
+
+        for (size_t offset = 0; offset < stride; offset += ParentType::laneWidth)
+        {
+            position = positionDown;
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                for (size_t phase = 0; phase < numPhases; ++phase)
+                {
+                    auto input = load (this->highRateLanes.getSlot (i * numPhases + phase) + offset);
+                    store (historyDown.getSlot (position) + offset, input);
+                    store (historyDown.getSlot (position + numTaps) + offset, input);
+
+                    // Only the first sample of each group of "numPhases" samples is kept
+                    if (phase == 0)
+                    {
+                        auto window = historyDown.getSlot (position + 1) + offset;
+                        auto out = broadcast (static_cast<SampleType> (0));
+
+                        for (size_t k = 0; k < numTaps; ++k)
+                            out = out + load (window + k * stride) * taps[k];
+
+                        store (this->lowRateLanes.getSlot (i) + offset, out);
+                    }
+
+                    if (++position == numTaps)
+                        position = 0;
+                }
+            }
+        }
+
+        positionDown = position;
+    }
+
+private:
+    //==============================================================================
+    /** Designs a low-pass filter with its cutoff at the original Nyquist frequency, in
+        the same way as FilterDesign::designFIRLowpassKaiserMethod, but rounding the
+        order up to an even number so that the latency is an integer, and normalising
+        the gain at DC.
+    */
+    static typename FIR::Coefficients<SampleType>::Ptr designFilter (size_t factor, SampleType normalisedTransitionWidth,
+                                                                     SampleType amplitudedB)
+    {
+        jassert (normalisedTransitionWidth > 0 && normalisedTransitionWidth <= 0.5);
+        jassert (amplitudedB >= -100 && amplitudedB <= -21);
+
+        auto attenuation = -static_cast<double> (amplitudedB);
+        auto beta = attenuation > 50 ? 0.1102 * (attenuation - 8.7)
+                                     : 0.5842 * std::pow (attenuation - 21, 0.4) + 0.07886 * (attenuation - 21);
+
+        auto order = static_cast<size_t> (std::ceil ((attenuation - 7.95) / (2.285 * normalisedTransitionWidth * MathConstants<double>::twoPi)));
+        order += (order & 1);
+
+        auto result = FilterDesign<SampleType>::designFIRLowpassWindowMethod (static_cast<SampleType> (0.5), static_cast<double> (factor), order,
+                                                                              WindowingFunction<SampleType>::kaiser, static_cast<SampleType> (beta));
+
+        auto* c = result->getRawCoefficients();
+        auto gain = std::accumulate (c, c + order + 1, SampleType (0));
+        FloatVectorOperations::multiply (c, SampleType (1) / gain, static_cast<int> (order + 1));
+
+        return result;
+    }
+
+    //==============================================================================
+    std::vector<SampleType> phasesUp, coefficientsDown;
+    size_t orderUp = 0, orderDown = 0, tapsPerPhase = 0;
+
+    typename ParentType::Lanes historyUp, historyDown;
+    size_t positionUp = 0, positionDown = 0;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OversamplingPolyphaseFIR)
+};
+
+
 //==============================================================================
 template <typename SampleType>
 Oversampling<SampleType>::Oversampling (size_t newNumChannels)
@@ -544,12 +891,23 @@ Oversampling<SampleType>::Oversampling (size_t newNumChannels, size_t newFactor,
                                         bool useIntegerLatency)
     : numChannels (newNumChannels), shouldUseIntegerLatency (useIntegerLatency)
 {
-    jassert (isPositiveAndBelow (newFactor, 5) && numChannels > 0);
+    jassert (isPositiveAndBelow (newFactor, 6) && numChannels > 0);
 
     if (newFactor == 0)
     {
         addDummyOversamplingStage();
     }
+    else if (newType == FilterType::filterPolyphaseFIR)
+    {
+        auto stageFactor = (size_t) 1 << newFactor;
+
+        auto twUp   = (isMaximumQuality ? 0.10f : 0.12f) / (float) stageFactor;
+        auto twDown = (isMaximumQuality ? 0.12f : 0.15f) / (float) stageFactor;
+
+        addPolyphaseFIROversamplingStage (stageFactor,
+                                          twUp,   isMaximumQuality ? -90.0f : -70.0f,
+                                          twDown, isMaximumQuality ? -75.0f : -60.0f);
+    }
     else if (newType == FilterType::filterHalfBandPolyphaseIIR)
     {
         for (size_t n = 0; n < newFactor; ++n)
@@ -606,6 +964,13 @@ void Oversampling<SampleType>::addOversamplingStage (FilterType type,
                                                      float normalisedTransitionWidthDown,
                                                      float stopbandAmplitudedBDown)
 {
+    if (type == FilterType::filterPolyphaseFIR)
+    {
+        addPolyphaseFIROversamplingStage (2, normalisedTransitionWidthUp,   stopbandAmplitudedBUp,
+                                             normalisedTransitionWidthDown, stopbandAmplitudedBDown);
+        return;
+    }
+
     if (type == FilterType::filterHalfBandPolyphaseIIR)
     {
         stages.add (new Oversampling2TimesPolyphaseIIR<SampleType> (numChannels,
@@ -619,9 +984,41 @@ void Oversampling<SampleType>::addOversamplingStage (FilterType type,
                                                                      normalisedTransitionWidthDown, stopbandAmplitudedBDown));
     }
 
+    setStageSpecifications (*stages.getLast(), normalisedTransitionWidthUp,   stopbandAmplitudedBUp,
+                                               normalisedTransitionWidthDown, stopbandAmplitudedBDown);
     factorOversampling *= 2;
 }
 
+template <typename SampleType>
+void Oversampling<SampleType>::addPolyphaseFIROversamplingStage (size_t stageFactor,
+                                                                 float normalisedTransitionWidthUp,
+                                                                 float stopbandAmplitudedBUp,
+                                                                 float normalisedTransitionWidthDown,
+                                                                 float stopbandAmplitudedBDown)
+{
+    // The factor must be a power of two, and the overall factor can't be more than 32
+    jassert (isPowerOfTwo (stageFactor) && stageFactor >= 2 && factorOversampling * stageFactor <= 32);
+
+    stages.add (new OversamplingPolyphaseFIR<SampleType> (numChannels, stageFactor,
+                                                          normalisedTransitionWidthUp,   stopbandAmplitudedBUp,
+                                                          normalisedTransitionWidthDown, stopbandAmplitudedBDown));
+
+    setStageSpecifications (*stages.getLast(), normalisedTransitionWidthUp,   stopbandAmplitudedBUp,
+                                               normalisedTransitionWidthDown, stopbandAmplitudedBDown);
+    factorOversampling *= stageFactor;
+}
+
+template <typename SampleType>
+void Oversampling<SampleType>::setStageSpecifications (OversamplingStage& stage,
+                                                       float normalisedTransitionWidthUp,   float stopbandAmplitudedBUp,
+                                                       float normalisedTransitionWidthDown, float stopbandAmplitudedBDown)
+{
+    stage.transitionWidthUp   = normalisedTransitionWidthUp;
+    stage.stopbandUp          = stopbandAmplitudedBUp;
+    stage.transitionWidthDown = normalisedTransitionWidthDown;
+    stage.stopbandDown        = stopbandAmplitudedBDown;
+}
+
 template <typename SampleType>
 void Oversampling<SampleType>::clearOversamplingStages()
 {
@@ -664,6 +1061,39 @@ size_t Oversampling<SampleType>::getOversamplingFactor() const noexcept
     return factorOversampling;
 }
 
+template <typename SampleType>
+int Oversampling<SampleType>::getNumStages() const noexcept
+{
+    return stages.size();
+}
+
+template <typename SampleType>
+typename Oversampling<SampleType>::StageInfo Oversampling<SampleType>::getStageInfo (int stageIndex) const noexcept
+{
+    jassert (isPositiveAndBelow (stageIndex, stages.size()));
+
+    StageInfo info;
+    size_t order = 1;
+
+    for (int i = 0; i <= stageIndex && i < stages.size(); ++i)
+    {
+        auto* stage = stages.getUnchecked (i);
+        order *= stage->factor;
+
+        if (i == stageIndex)
+        {
+            info.factor                        = stage->factor;
+            info.latencyInSamples              = stage->getLatencyInSamples() / static_cast<SampleType> (order);
+            info.normalisedTransitionWidthUp   = stage->transitionWidthUp;
+            info.stopbandAmplitudedBUp         = stage->stopbandUp;
+            info.normalisedTransitionWidthDown = stage->transitionWidthDown;
+            info.stopbandAmplitudedBDown       = stage->stopbandDown;
+        }
+    }
+
+    return info;
+}
+
 //==============================================================================
 template <typename SampleType>
 void Oversampling<SampleType>::initProcessing (size_t maximumNumberOfSamplesBeforeOversampling)
@@ -32,9 +32,11 @@ namespace dsp
 /**
     A processor that performs multi-channel oversampling.
 
-    This class can be configured to do a factor of 2, 4, 8 or 16 times
-    oversampling, using multiple stages, with polyphase allpass IIR filters or FIR
-    filters, and latency compensation.
+    This class can be configured to do a factor of 2, 4, 8, 16 or 32 times
+    oversampling, using multiple stages of polyphase allpass IIR filters or
+    half-band FIR filters, or a single stage of polyphase FIR filters, and latency
+    compensation. All the channels are processed together, using SIMD registers
+    which hold the same sample of several channels.
 
     The principle of oversampling is to increase the sample rate of a given
     non-linear process to prevent it from creating aliasing. Oversampling works
@@ -45,7 +47,12 @@ namespace dsp
     Choose between FIR or IIR filtering depending on your needs in terms of
     latency and phase distortion. With FIR filters the phase is linear but the
     latency is maximised. With IIR filtering the phase is compromised around the
-    Nyquist frequency but the latency is minimised.
+    Nyquist frequency but the latency is minimised. The polyphase FIR filters
+    are also linear phase, and do the whole oversampling in one stage, which
+    avoids the accumulated transition bands of the multi-stage designs.
+
+    The latency and filtering specifications of each stage can be retrieved using
+    getStageInfo().
 
     @see FilterDesign.
 
@@ -60,6 +67,7 @@ public:
     {
         filterHalfBandFIREquiripple = 0,
         filterHalfBandPolyphaseIIR,
+        filterPolyphaseFIR,
         numFilterTypes
     };
 
@@ -78,7 +86,8 @@ public:
     /** Constructor.
 
         @param numChannels          the number of channels to process with this object
-        @param factor               the processing will perform 2 ^ factor times oversampling
+        @param factor               the processing will perform 2 ^ factor times oversampling,
+                                    with a factor between 0 and 5
         @param type                 the type of filter design employed for filtering during
                                     oversampling
         @param isMaxQuality         if the oversampling is done using the maximum quality, where
@@ -118,6 +127,36 @@ public:
     /** Returns the current oversampling factor. */
     size_t getOversamplingFactor() const noexcept;
 
+    //===============================================================================
+    /** Describes the filtering done by one of the oversampling stages.
+
+        The stopband amplitudes are the gains of the filters for the frequencies
+        above the original Nyquist frequency: for the upsampling filter, they set how
+        much the images created by the upsampling are attenuated, and for the
+        downsampling filter they set how much of the content created by the
+        oversampled processing is aliased back into the audible band.
+
+        @see getStageInfo
+    */
+    struct StageInfo
+    {
+        size_t factor = 1;                          /**< The oversampling factor of the stage. */
+        SampleType latencyInSamples = 0;            /**< The latency added by the stage, in samples at the original sample rate. */
+        float normalisedTransitionWidthUp = 0;      /**< The transition width of the upsampling filter, relative to the stage's output sample rate. */
+        float stopbandAmplitudedBUp = 0;            /**< The stopband gain of the upsampling filter in dB. */
+        float normalisedTransitionWidthDown = 0;    /**< The transition width of the downsampling filter, relative to the stage's input sample rate. */
+        float stopbandAmplitudedBDown = 0;          /**< The stopband gain of the downsampling filter in dB. */
+    };
+
+    /** Returns the number of oversampling stages, including any dummy ones. */
+    int getNumStages() const noexcept;
+
+    /** Returns the properties of one of the oversampling stages. The sum of the latencies
+        of all the stages is the value returned by getLatencyInSamples(), without any
+        integer latency compensation.
+    */
+    StageInfo getStageInfo (int stageIndex) const noexcept;
+
     //===============================================================================
     /** Must be called before any processing, to set the buffer sizes of the internal
         buffers of the oversampling processing.
@@ -171,6 +210,19 @@ public:
                                float normalisedTransitionWidthUp,   float stopbandAmplitudedBUp,
                                float normalisedTransitionWidthDown, float stopbandAmplitudedBDown);
 
+    /** Adds a new oversampling stage using polyphase FIR filters, multiplying the current
+        oversampling factor by the given factor, which must be a power of two.
+
+        The transition widths are relative to the oversampled sample rate of the stage,
+        so the width in terms of the original sample rate is multiplied by the factor.
+        The stopband amplitudes must be between -100 and -21 dB.
+
+        @see addOversamplingStage, clearOversamplingStages
+    */
+    void addPolyphaseFIROversamplingStage (size_t stageFactor,
+                                           float normalisedTransitionWidthUp,   float stopbandAmplitudedBUp,
+                                           float normalisedTransitionWidthDown, float stopbandAmplitudedBDown);
+
     /** Adds a new "dummy" oversampling stage, which does nothing to the signal. Using
         one can be useful if your application features a customisable oversampling factor
         and if you want to select the current one from an OwnedArray without changing
@@ -199,6 +251,7 @@ private:
     //===============================================================================
     void updateDelayLine();
     SampleType getUncompensatedLatency() const noexcept;
+    static void setStageSpecifications (OversamplingStage&, float, float, float, float);
 
     //===============================================================================
     OwnedArray<OversamplingStage> stages;
@@ -0,0 +1,264 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class OversamplingTest : public UnitTest
+{
+public:
+    OversamplingTest()
+        : UnitTest ("Oversampling", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Multichannel processing matches single channel processing");
+        {
+            for (auto type : { filterFIR, filterIIR, filterPolyphase })
+            {
+                for (size_t factor = 1; factor <= getMaximumFactor (type); ++factor)
+                {
+                    checkMultichannelProcessing<float>  (type, factor, 1.0e-6);
+                    checkMultichannelProcessing<double> (type, factor, 1.0e-12);
+                }
+            }
+        }
+
+        beginTest ("Round trip delays the input by the latency");
+        {
+            for (auto type : { filterFIR, filterIIR, filterPolyphase })
+            {
+                for (size_t factor = 1; factor <= getMaximumFactor (type); ++factor)
+                {
+                    checkRoundTrip<float>  (type, factor);
+                    checkRoundTrip<double> (type, factor);
+                }
+            }
+        }
+
+        beginTest ("Stage information");
+        {
+            for (auto type : { filterFIR, filterIIR, filterPolyphase })
+            {
+                for (size_t factor = 0; factor <= getMaximumFactor (type); ++factor)
+                {
+                    Oversampling<float> oversampling (2, factor, type);
+
+                    float latency = 0;
+                    size_t totalFactor = 1;
+
+                    for (int i = 0; i < oversampling.getNumStages(); ++i)
+                    {
+                        auto info = oversampling.getStageInfo (i);
+
+                        expect (info.latencyInSamples >= 0.0f);
+                        expect (factor == 0 || info.stopbandAmplitudedBUp < -40.0f);
+                        expect (factor == 0 || info.stopbandAmplitudedBDown < -40.0f);
+
+                        latency += info.latencyInSamples;
+                        totalFactor *= info.factor;
+                    }
+
+                    expectEquals ((int) totalFactor, 1 << factor);
+                    expectEquals ((int) oversampling.getOversamplingFactor(), 1 << factor);
+                    expectWithinAbsoluteError (latency, oversampling.getLatencyInSamples(), 1.0e-4f);
+                    expectEquals (oversampling.getNumStages(), (factor > 0 && type == filterPolyphase) ? 1 : jmax (1, (int) factor));
+                }
+            }
+        }
+
+        beginTest ("Polyphase FIR rejects the content above the original Nyquist frequency");
+        {
+            for (size_t factor = 1; factor <= 5; ++factor)
+            {
+                for (auto isMaxQuality : { false, true })
+                {
+                    Oversampling<float> oversampling (1, factor, filterPolyphase, isMaxQuality);
+                    auto attenuation = oversampling.getStageInfo (0).stopbandAmplitudedBDown;
+
+                    // a tone at 0.7 times the original sample rate, aliased to 0.3 by the downsampling
+                    expect (getDownsampledLevel (oversampling, 0.7) < Decibels::decibelsToGain (attenuation));
+
+                    // a tone in the passband should go through unchanged
+                    expectWithinAbsoluteError (getDownsampledLevel (oversampling, 0.1), 1.0f, 1.0e-2f);
+                }
+            }
+        }
+    }
+
+private:
+    static constexpr auto filterFIR       = Oversampling<float>::filterHalfBandFIREquiripple;
+    static constexpr auto filterIIR       = Oversampling<float>::filterHalfBandPolyphaseIIR;
+    static constexpr auto filterPolyphase = Oversampling<float>::filterPolyphaseFIR;
+
+    static size_t getMaximumFactor (Oversampling<float>::FilterType type) noexcept
+    {
+        return type == filterPolyphase ? 5 : 4;
+    }
+
+    template <typename SampleType>
+    static auto toType (Oversampling<float>::FilterType type) noexcept
+    {
+        return static_cast<typename Oversampling<SampleType>::FilterType> (type);
+    }
+
+    template <typename SampleType>
+    void checkMultichannelProcessing (Oversampling<float>::FilterType type, size_t factor, double tolerance)
+    {
+        constexpr size_t numChannels = 5;
+        constexpr size_t maxBlockSize = 300;
+
+        Oversampling<SampleType> multichannel (numChannels, factor, toType<SampleType> (type));
+        multichannel.initProcessing (maxBlockSize);
+
+        OwnedArray<Oversampling<SampleType>> singleChannels;
+
+        for (size_t i = 0; i < numChannels; ++i)
+        {
+            singleChannels.add (new Oversampling<SampleType> (1, factor, toType<SampleType> (type)));
+            singleChannels.getLast()->initProcessing (maxBlockSize);
+        }
+
+        auto random = getRandom();
+        AudioBuffer<SampleType> input ((int) numChannels, (int) maxBlockSize), output ((int) numChannels, (int) maxBlockSize);
+        AudioBuffer<SampleType> expected (1, (int) maxBlockSize);
+        auto maxError = 0.0;
+
+        for (int blockIndex = 0; blockIndex < 8; ++blockIndex)
+        {
+            auto numSamples = (size_t) random.nextInt ({ 1, (int) maxBlockSize + 1 });
+
+            for (int channel = 0; channel < (int) numChannels; ++channel)
+                for (int i = 0; i < (int) numSamples; ++i)
+                    input.setSample (channel, i, static_cast<SampleType> (random.nextFloat() * 2.0f - 1.0f));
+
+            AudioBlock<SampleType> outputBlock (output.getArrayOfWritePointers(), numChannels, numSamples);
+            AudioBlock<const SampleType> inputBlock (input.getArrayOfReadPointers(), numChannels, numSamples);
+
+            // the processing on the oversampled block makes sure the two directions are checked
+            auto oversampledBlock = multichannel.processSamplesUp (inputBlock);
+            oversampledBlock.multiplyBy (static_cast<SampleType> (0.5));
+            multichannel.processSamplesDown (outputBlock);
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                auto expectedBlock = AudioBlock<SampleType> (expected).getSubBlock (0, numSamples);
+                auto singleBlock = singleChannels[(int) channel]->processSamplesUp (inputBlock.getSingleChannelBlock (channel));
+                singleBlock.multiplyBy (static_cast<SampleType> (0.5));
+                singleChannels[(int) channel]->processSamplesDown (expectedBlock);
+
+                for (size_t i = 0; i < numSamples; ++i)
+                    maxError = jmax (maxError, (double) std::abs (expectedBlock.getSample (0, (int) i) - outputBlock.getSample ((int) channel, (int) i)));
+            }
+        }
+
+        expect (maxError <= tolerance, "Maximum error " + String (maxError) + " for type " + String ((int) type)
+                                         + " and factor " + String (1 << factor));
+    }
+
+    template <typename SampleType>
+    void checkRoundTrip (Oversampling<float>::FilterType type, size_t factor)
+    {
+        constexpr int numSamples = 2048;
+        constexpr int blockSize = 128;
+        constexpr auto frequency = 0.01;
+
+        Oversampling<SampleType> oversampling (2, factor, toType<SampleType> (type), true, true);
+        oversampling.initProcessing (blockSize);
+
+        auto latency = roundToInt (oversampling.getLatencyInSamples());
+        expectWithinAbsoluteError ((double) oversampling.getLatencyInSamples(), (double) latency, 1.0e-4);
+
+        AudioBuffer<SampleType> buffer (2, numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto value = static_cast<SampleType> (std::sin (MathConstants<double>::twoPi * frequency * i));
+            buffer.setSample (0, i, value);
+            buffer.setSample (1, i, -value);
+        }
+
+        AudioBuffer<SampleType> input (buffer);
+
+        for (int start = 0; start < numSamples; start += blockSize)
+        {
+            AudioBlock<SampleType> block (buffer.getArrayOfWritePointers(), 2, (size_t) start, (size_t) blockSize);
+            oversampling.processSamplesUp (block);
+            oversampling.processSamplesDown (block);
+        }
+
+        // the IIR filters aren't linear phase, so the delay is only approximately constant,
+        // and the passband ripples of the half-band filters add up with the number of stages
+        auto tolerance = type == filterPolyphase ? 2.0e-3 : (type == filterIIR ? 2.0e-2 : 1.0e-2);
+        auto maxError = 0.0;
+
+        for (int channel = 0; channel < 2; ++channel)
+            for (int i = numSamples / 2; i < numSamples; ++i)
+                maxError = jmax (maxError, (double) std::abs (buffer.getSample (channel, i) - input.getSample (channel, i - latency)));
+
+        expect (maxError < tolerance, "Maximum error " + String (maxError) + " for type " + String ((int) type)
+                                        + " and factor " + String (1 << factor));
+    }
+
+    static float getDownsampledLevel (Oversampling<float>& oversampling, double frequency)
+    {
+        constexpr int blockSize = 250;
+        constexpr int numBlocks = 16;
+
+        oversampling.initProcessing (blockSize);
+
+        auto oversamplingFactor = (double) oversampling.getOversamplingFactor();
+        AudioBuffer<float> buffer (1, blockSize);
+        AudioBlock<float> block (buffer);
+        double sumOfSquares = 0.0;
+        int time = 0;
+
+        for (int blockIndex = 0; blockIndex < numBlocks; ++blockIndex)
+        {
+            auto oversampledBlock = oversampling.processSamplesUp (block);
+
+            // replaces the upsampled signal with a tone at the oversampled rate
+            for (size_t i = 0; i < oversampledBlock.getNumSamples(); ++i, ++time)
+                oversampledBlock.setSample (0, (int) i, (float) std::sin (MathConstants<double>::twoPi * frequency * time / oversamplingFactor));
+
+            oversampling.processSamplesDown (block);
+
+            if (blockIndex >= numBlocks / 2)
+                for (size_t i = 0; i < block.getNumSamples(); ++i)
+                    sumOfSquares += square ((double) block.getSample (0, (int) i));
+        }
+
+        // returns the amplitude of the tone, using a whole number of periods of the aliased frequency
+        return (float) std::sqrt (2.0 * sumOfSquares / (blockSize * numBlocks / 2));
+    }
+};
+
+static OversamplingTest oversamplingTest;
+
+} // namespace dsp
+} // namespace juce
@@ -51,6 +51,31 @@ namespace detail
     {
         forEachInTuple (std::forward<Fn> (fn), std::forward<Tuple> (tuple), TupleIndexSequence<Tuple>{});
     }
+
+    // Processors with per-channel state are called with the channel index, and the
+    // others are called with the sample only
+    template <typename Processor, typename SampleType>
+    auto processSingleSample (Processor& processor, int channel, SampleType sample, int)
+        -> decltype (processor.processSample (channel, sample))
+    {
+        return processor.processSample (channel, sample);
+    }
+
+    template <typename Processor, typename SampleType>
+    auto processSingleSample (Processor& processor, int, SampleType sample, long)
+        -> decltype (processor.processSample (sample))
+    {
+        return processor.processSample (sample);
+    }
+
+    template <typename Processor>
+    auto snapToZeroIfAvailable (Processor& processor, int) -> decltype (processor.snapToZero())
+    {
+        processor.snapToZero();
+    }
+
+    template <typename Processor>
+    void snapToZeroIfAvailable (Processor&, long) {}
 }
 #endif
 
@@ -113,11 +138,96 @@ public:
         }, processors);
     }
 
-private:
+protected:
     std::tuple<Processors...> processors;
     std::array<bool, sizeof...(Processors)> bypassed { {} };
 };
 
+//==============================================================================
+/** A ProcessorChain which calls processSample() on all of its processors for
+    each sample, instead of calling process() on each of them in turn.
+
+    The calls to the processors are composed at compile time into a single loop
+    over the samples, so the samples are read and written once for the whole
+    chain, instead of once per processor, and the intermediate values stay in
+    registers.
+
+    Each processor must have either a processSample (int channel, SampleType)
+    function, like the TPT filters, or a processSample (SampleType) function.
+    The loop goes through all the channels of a sample before moving to the next
+    sample, so the processors which only take the sample must either be
+    stateless, like WaveShaper, or be used on mono signals, like IIR::Filter.
+    Gain and Bias advance their smoothed values when the channel 0 is processed.
+
+    Bypassed processors aren't called at all, so their smoothed values don't
+    move while they are bypassed.
+
+    @code
+    FusedProcessorChain<Gain<float>, WaveShaper<float>, Bias<float>, StateVariableTPTFilter<float>> chain;
+    @endcode
+
+    @see ProcessorChain
+
+    @tags{DSP}
+*/
+template <typename... Processors>
+class FusedProcessorChain  : public ProcessorChain<Processors...>
+{
+public:
+    /** Process `context` through all inner processors, one sample at a time. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        auto&& inputBlock  = context.getInputBlock();
+        auto&& outputBlock = context.getOutputBlock();
+
+        jassert (inputBlock.getNumChannels() == outputBlock.getNumChannels());
+        jassert (inputBlock.getNumSamples()  == outputBlock.getNumSamples());
+
+        if (context.isBypassed)
+        {
+            if (context.usesSeparateInputAndOutputBlocks())
+                outputBlock.copyFrom (inputBlock);
+
+            return;
+        }
+
+        auto numChannels = outputBlock.getNumChannels();
+        auto numSamples  = outputBlock.getNumSamples();
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                outputBlock.getChannelPointer (channel)[i]
+                    = processSampleFrom (std::integral_constant<size_t, 0>(), (int) channel,
+                                         inputBlock.getChannelPointer (channel)[i]);
+            }
+        }
+
+       #if JUCE_SNAP_TO_ZERO
+        detail::forEachInTuple ([] (auto& proc, size_t) noexcept { detail::snapToZeroIfAvailable (proc, 0); },
+                                this->processors);
+       #endif
+    }
+
+private:
+    template <typename SampleType>
+    SampleType processSampleFrom (std::integral_constant<size_t, sizeof... (Processors)>, int, SampleType sample) noexcept
+    {
+        return sample;
+    }
+
+    template <size_t Index, typename SampleType>
+    SampleType processSampleFrom (std::integral_constant<size_t, Index>, int channel, SampleType sample) noexcept
+    {
+        if (! this->bypassed[Index])
+            sample = detail::processSingleSample (std::get<Index> (this->processors), channel, sample, 0);
+
+        return processSampleFrom (std::integral_constant<size_t, Index + 1>(), channel, sample);
+    }
+};
+
 /** Non-member equivalent of ProcessorChain::get which avoids awkward
     member template syntax.
 */
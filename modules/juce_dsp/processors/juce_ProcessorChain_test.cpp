@@ -132,6 +132,133 @@ public:
             expect (get<0> (chain).bufferWasClear);
             expect (! get<1> (chain).bufferWasClear);
         }
+
+        beginTest ("FusedProcessorChain produces the same output as ProcessorChain");
+        {
+            using WaveShaperFunction = float (*) (float);
+            using Chain = ProcessorChain<Gain<float>, WaveShaper<float, WaveShaperFunction>, Bias<float>, StateVariableTPTFilter<float>>;
+            using Fused = FusedProcessorChain<Gain<float>, WaveShaper<float, WaveShaperFunction>, Bias<float>, StateVariableTPTFilter<float>>;
+
+            Chain chain;
+            Fused fused;
+
+            auto setUp = [] (auto& c)
+            {
+                c.prepare ({ 44100.0, 64, 2 });
+
+                get<0> (c).setRampDurationSeconds (0.001);
+                get<0> (c).setGainLinear (0.5f);
+                get<1> (c).functionToUse = [] (float x) { return std::tanh (x); };
+                get<2> (c).setBias (0.1f);
+                get<3> (c).setCutoffFrequency (2000.0f);
+                get<3> (c).setResonance (2.0f);
+
+                c.reset();
+                get<0> (c).setGainLinear (2.0f);
+            };
+
+            setUp (chain);
+            setUp (fused);
+
+            AudioBuffer<float> input (2, 64), expected (2, 64), output (2, 64);
+            auto random = getRandom();
+
+            auto checkBlock = [&] (bool useSeparateBlocks)
+            {
+                for (int ch = 0; ch < input.getNumChannels(); ++ch)
+                    for (int i = 0; i < input.getNumSamples(); ++i)
+                        input.setSample (ch, i, random.nextFloat() * 2.0f - 1.0f);
+
+                expected.makeCopyOf (input);
+                AudioBlock<float> expectedBlock (expected);
+                chain.process (ProcessContextReplacing<float> (expectedBlock));
+
+                AudioBlock<float> outputBlock (output);
+
+                if (useSeparateBlocks)
+                {
+                    AudioBlock<const float> inputBlock (input);
+                    fused.process (ProcessContextNonReplacing<float> (inputBlock, outputBlock));
+                }
+                else
+                {
+                    output.makeCopyOf (input);
+                    fused.process (ProcessContextReplacing<float> (outputBlock));
+                }
+
+                for (int ch = 0; ch < output.getNumChannels(); ++ch)
+                    for (int i = 0; i < output.getNumSamples(); ++i)
+                        expectWithinAbsoluteError (output.getSample (ch, i), expected.getSample (ch, i), 1.0e-5f);
+            };
+
+            checkBlock (false);
+            checkBlock (true);
+
+            setBypassed<2> (chain, true);
+            setBypassed<2> (fused, true);
+            checkBlock (false);
+            checkBlock (true);
+        }
+
+        beginTest ("A bypassed Gain in a FusedProcessorChain holds its ramp");
+        {
+            FusedProcessorChain<Gain<float>> fused, reference;
+            ProcessorChain<Gain<float>> chain;
+
+            auto setUp = [] (auto& c)
+            {
+                c.prepare ({ 44100.0, 64, 1 });
+
+                get<0> (c).setRampDurationSeconds (128.0 / 44100.0);
+                get<0> (c).setGainLinear (1.0f);
+                c.reset();
+                get<0> (c).setGainLinear (2.0f);
+            };
+
+            setUp (fused);
+            setUp (reference);
+            setUp (chain);
+
+            auto processOnes = [] (auto& c, int numSamples)
+            {
+                AudioBuffer<float> buffer (1, numSamples);
+
+                for (int i = 0; i < numSamples; ++i)
+                    buffer.setSample (0, i, 1.0f);
+
+                AudioBlock<float> block (buffer);
+                c.process (ProcessContextReplacing<float> (block));
+                return buffer;
+            };
+
+            processOnes (fused, 32);
+            processOnes (reference, 32);
+            processOnes (chain, 32);
+
+            setBypassed<0> (fused, true);
+            setBypassed<0> (chain, true);
+
+            auto bypassedOutput = processOnes (fused, 64);
+            processOnes (chain, 64);
+
+            for (int i = 0; i < bypassedOutput.getNumSamples(); ++i)
+                expectEquals (bypassedOutput.getSample (0, i), 1.0f);
+
+            setBypassed<0> (fused, false);
+            setBypassed<0> (chain, false);
+
+            auto fusedOutput = processOnes (fused, 32);
+            auto referenceOutput = processOnes (reference, 32);
+            auto chainOutput = processOnes (chain, 32);
+
+            // the fused chain carries on from where the ramp was when it was bypassed...
+            for (int i = 0; i < fusedOutput.getNumSamples(); ++i)
+                expectWithinAbsoluteError (fusedOutput.getSample (0, i), referenceOutput.getSample (0, i), 1.0e-6f);
+
+            // ...whereas ProcessorChain skips the ramp forward by the bypassed samples
+            expectWithinAbsoluteError (chainOutput.getSample (0, 0), 1.0f + 97.0f / 128.0f, 1.0e-4f);
+            expectWithinAbsoluteError (fusedOutput.getSample (0, 0), 1.0f + 33.0f / 128.0f, 1.0e-4f);
+        }
     }
 };
 
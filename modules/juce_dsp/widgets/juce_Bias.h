@@ -84,6 +84,7 @@ public:
     void reset() noexcept
     {
         bias.reset (sampleRate, rampDurationSeconds);
+        currentBias = bias.getCurrentValue();
     }
 
     //==============================================================================
@@ -94,6 +95,21 @@ public:
         return inputSample + bias.getNextValue();
     }
 
+    /** Returns the result of processing a single sample of one of the channels.
+
+        This is used by FusedProcessorChain, which processes all the channels of a
+        sample before moving to the next sample: the bias moves to its next value
+        when the channel 0 is processed.
+    */
+    template <typename SampleType>
+    SampleType processSample (int channel, SampleType inputSample) noexcept
+    {
+        if (channel == 0)
+            currentBias = bias.getNextValue();
+
+        return inputSample + currentBias;
+    }
+
     //==============================================================================
     /** Processes the input and output buffers supplied in the processing context. */
     template <typename ProcessContext>
@@ -144,6 +160,7 @@ public:
 private:
     //==============================================================================
     SmoothedValue<FloatType> bias;
+    FloatType currentBias = 0;
     double sampleRate = 0, rampDurationSeconds = 0;
 
     void updateRamp() noexcept
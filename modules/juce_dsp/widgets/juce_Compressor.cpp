@@ -102,6 +102,27 @@ SampleType Compressor<SampleType>::processSample (int channel, SampleType inputV
     return gain * inputValue;
 }
 
+template <typename SampleType>
+void Compressor<SampleType>::processVectorised (int channel, const SampleType* input,
+                                                SampleType* output, size_t numSamples) noexcept
+{
+    constexpr size_t chunkSize = 64;
+    SampleType gain[chunkSize];
+
+    for (size_t start = 0; start < numSamples; start += chunkSize)
+    {
+        auto num = jmin (chunkSize, numSamples - start);
+
+        for (size_t i = 0; i < num; ++i)
+            gain[i] = envelopeFilter.processSample (channel, input[start + i]) * thresholdInverse;
+
+        // below the threshold, the gain is raised to the power of one
+        FloatVectorOperations::max (gain, gain, static_cast<SampleType> (1.0), (int) num);
+        VectorMath::pow (gain, gain, ratioInverse - static_cast<SampleType> (1.0), (int) num);
+        FloatVectorOperations::multiply (output + start, input + start, gain, (int) num);
+    }
+}
+
 template <typename SampleType>
 void Compressor<SampleType>::update()
 {
@@ -55,6 +55,17 @@ public:
     /** Sets the release time in milliseconds of the compressor.*/
     void setRelease (SampleType newRelease);
 
+    /** Enables the calculation of the gain reduction on whole blocks with the
+        VectorMath functions, which is much faster than calling std::pow on each
+        sample. This is disabled by default, since the results are slightly different.
+
+        This only has an effect on the process() method, not on processSample().
+    */
+    void setUsingVectorisedMath (bool shouldUseVectorisedMath) noexcept     { useVectorisedMath = shouldUseVectorisedMath; }
+
+    /** Returns true if the gain reduction is calculated with the VectorMath functions. */
+    bool isUsingVectorisedMath() const noexcept                             { return useVectorisedMath; }
+
     //==============================================================================
     /** Initialises the processor. */
     void prepare (const ProcessSpec& spec);
@@ -86,8 +97,15 @@ public:
             auto* inputSamples  = inputBlock .getChannelPointer (channel);
             auto* outputSamples = outputBlock.getChannelPointer (channel);
 
-            for (size_t i = 0; i < numSamples; ++i)
-                outputSamples[i] = processSample ((int) channel, inputSamples[i]);
+            if (useVectorisedMath)
+            {
+                processVectorised ((int) channel, inputSamples, outputSamples, numSamples);
+            }
+            else
+            {
+                for (size_t i = 0; i < numSamples; ++i)
+                    outputSamples[i] = processSample ((int) channel, inputSamples[i]);
+            }
         }
     }
 
@@ -97,10 +115,12 @@ public:
 private:
     //==============================================================================
     void update();
+    void processVectorised (int channel, const SampleType* input, SampleType* output, size_t numSamples) noexcept;
 
     //==============================================================================
     SampleType threshold, thresholdInverse, ratioInverse;
     BallisticsFilter<SampleType> envelopeFilter;
+    bool useVectorisedMath = false;
 
     double sampleRate = 44100.0;
     SampleType thresholddB = 0.0, ratio = 1.0, attackTime = 1.0, releaseTime = 100.0;
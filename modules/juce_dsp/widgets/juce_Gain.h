@@ -81,6 +81,8 @@ public:
     {
         if (sampleRate > 0)
             gain.reset (sampleRate, rampDurationSeconds);
+
+        currentGain = gain.getCurrentValue();
     }
 
     //==============================================================================
@@ -91,6 +93,21 @@ public:
         return s * gain.getNextValue();
     }
 
+    /** Returns the result of processing a single sample of one of the channels.
+
+        This is used by FusedProcessorChain, which processes all the channels of a
+        sample before moving to the next sample: the gain moves to its next value
+        when the channel 0 is processed.
+    */
+    template <typename SampleType>
+    SampleType JUCE_VECTOR_CALLTYPE processSample (int channel, SampleType s) noexcept
+    {
+        if (channel == 0)
+            currentGain = gain.getNextValue();
+
+        return s * currentGain;
+    }
+
     /** Processes the input and output buffers supplied in the processing context. */
     template <typename ProcessContext>
     void process (const ProcessContext& context) noexcept
@@ -139,6 +156,7 @@ public:
 private:
     //==============================================================================
     SmoothedValue<FloatType> gain;
+    FloatType currentGain = 0;
     double sampleRate = 0, rampDurationSeconds = 0;
 };
 
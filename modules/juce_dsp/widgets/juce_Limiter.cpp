@@ -43,6 +43,13 @@ void Limiter<SampleType>::setRelease (SampleType newRelease)
     update();
 }
 
+template <typename SampleType>
+void Limiter<SampleType>::setUsingVectorisedMath (bool shouldUseVectorisedMath) noexcept
+{
+    firstStageCompressor.setUsingVectorisedMath (shouldUseVectorisedMath);
+    secondStageCompressor.setUsingVectorisedMath (shouldUseVectorisedMath);
+}
+
 //==============================================================================
 template <typename SampleType>
 void Limiter<SampleType>::prepare (const ProcessSpec& spec)
@@ -49,6 +49,16 @@ public:
     /** Sets the release time in milliseconds of the limiter.*/
     void setRelease (SampleType newRelease);
 
+    /** Enables the calculation of the gain reduction of both compressor stages
+        with the VectorMath functions.
+
+        @see Compressor::setUsingVectorisedMath
+    */
+    void setUsingVectorisedMath (bool shouldUseVectorisedMath) noexcept;
+
+    /** Returns true if the gain reduction is calculated with the VectorMath functions. */
+    bool isUsingVectorisedMath() const noexcept     { return firstStageCompressor.isUsingVectorisedMath(); }
+
     //==============================================================================
     /** Initialises the processor. */
     void prepare (const ProcessSpec& spec);
@@ -31,6 +31,12 @@ namespace dsp
 /**
     Applies waveshaping to audio samples as single samples or AudioBlocks.
 
+    If the function can also be called with a destination pointer, a source pointer
+    and a number of samples, like the function objects in VectorMath, then the
+    process() method gives it whole channels at once instead of single samples.
+
+    @see VectorMath::Tanh
+
     @tags{DSP}
 */
 template <typename FloatType, typename Function = FloatType (*) (FloatType)>
@@ -61,13 +67,39 @@ struct WaveShaper
         }
         else
         {
-            AudioBlock<FloatType>::process (context.getInputBlock(),
-                                            context.getOutputBlock(),
-                                            functionToUse);
+            processBlock (context.getInputBlock(), context.getOutputBlock(), IsBlockFunction<Function>());
         }
     }
 
     void reset() noexcept {}
+
+private:
+    //==============================================================================
+    template <typename Fn, typename = void>
+    struct IsBlockFunction : std::false_type {};
+
+    template <typename Fn>
+    struct IsBlockFunction<Fn, decltype (std::declval<const Fn&>() (std::declval<FloatType*>(),
+                                                                    std::declval<const FloatType*>(),
+                                                                    size_t()), void())>  : std::true_type {};
+
+    template <typename InputBlockType, typename OutputBlockType>
+    void processBlock (const InputBlockType& inputBlock, OutputBlockType& outputBlock, std::false_type) const noexcept
+    {
+        AudioBlock<FloatType>::process (inputBlock, outputBlock, functionToUse);
+    }
+
+    template <typename InputBlockType, typename OutputBlockType>
+    void processBlock (const InputBlockType& inputBlock, OutputBlockType& outputBlock, std::true_type) const noexcept
+    {
+        jassert (inputBlock.getNumChannels() == outputBlock.getNumChannels());
+        jassert (inputBlock.getNumSamples()  == outputBlock.getNumSamples());
+
+        for (size_t channel = 0; channel < outputBlock.getNumChannels(); ++channel)
+            functionToUse (outputBlock.getChannelPointer (channel),
+                           inputBlock.getChannelPointer (channel),
+                           outputBlock.getNumSamples());
+    }
 };
 
 //==============================================================================
@@ -0,0 +1,371 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+namespace WavetableOscillatorBankHelpers
+{
+    template <typename VectorType, typename SampleType>
+    static inline VectorType load (const SampleType* source) noexcept
+    {
+       #if JUCE_USE_SIMD
+        return VectorType::fromRawArray (source);
+       #else
+        return *source;
+       #endif
+    }
+
+    template <typename VectorType, typename SampleType>
+    static inline void store (SampleType* dest, VectorType value) noexcept
+    {
+       #if JUCE_USE_SIMD
+        value.copyToRawArray (dest);
+       #else
+        *dest = value;
+       #endif
+    }
+
+   #if JUCE_USE_SIMD
+    template <typename SampleType>
+    static inline SIMDRegister<SampleType> truncate (SIMDRegister<SampleType> value) noexcept
+    {
+        return SIMDRegister<SampleType>::truncate (value);
+    }
+
+    template <typename SampleType>
+    static inline SIMDRegister<SampleType> wrapPhase (SIMDRegister<SampleType> phase) noexcept
+    {
+        using Vector = SIMDRegister<SampleType>;
+
+        auto one = Vector::expand (static_cast<SampleType> (1));
+        phase = phase - (one & Vector::greaterThanOrEqual (phase, one));
+        return phase + (one & Vector::lessThan (phase, Vector::expand (static_cast<SampleType> (0))));
+    }
+   #endif
+
+    template <typename SampleType>
+    static inline SampleType truncate (SampleType value) noexcept
+    {
+        return std::trunc (value);
+    }
+
+    template <typename SampleType>
+    static inline SampleType wrapPhase (SampleType phase) noexcept
+    {
+        if (phase >= 1)  phase -= 1;
+        if (phase < 0)   phase += 1;
+
+        return phase;
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+WavetableOscillatorBank<SampleType>::WavetableOscillatorBank()
+{
+}
+
+//==============================================================================
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::setWaveform (const std::function<SampleType (SampleType)>& function,
+                                                       size_t newTableSize)
+{
+    std::vector<SampleType> cycle (newTableSize);
+
+    for (size_t i = 0; i < newTableSize; ++i)
+        cycle[i] = function (MathConstants<SampleType>::twoPi * static_cast<SampleType> (i) / static_cast<SampleType> (newTableSize)
+                               - MathConstants<SampleType>::pi);
+
+    setWaveform (cycle.data(), newTableSize);
+}
+
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::setWaveform (const SampleType* singleCycle, size_t newTableSize)
+{
+    // The table size must be a power of two, with room for a few harmonics!
+    jassert (isPowerOfTwo (newTableSize) && newTableSize >= 8);
+
+    int order = 0;
+
+    while (((size_t) 1 << order) < newTableSize)
+        ++order;
+
+    tableSize = newTableSize;
+    tableStride = tableSize + 2;
+    maxNumHarmonics = tableSize / 4;
+    numLevels = (size_t) order - 1;
+
+    FFT fft (order);
+    std::vector<float> spectrum (tableSize * 2, 0.0f), buffer (tableSize * 2);
+
+    for (size_t i = 0; i < tableSize; ++i)
+        spectrum[i] = static_cast<float> (singleCycle[i]);
+
+    fft.performRealOnlyForwardTransform (spectrum.data(), true);
+
+    // The last table only keeps the DC offset, for the frequencies above Nyquist
+    tables.assign ((numLevels + 1) * tableStride, SampleType (0));
+
+    for (size_t level = 0; level <= numLevels; ++level)
+    {
+        auto numHarmonics = level < numLevels ? maxNumHarmonics >> level : (size_t) 0;
+
+        std::fill (buffer.begin(), buffer.end(), 0.0f);
+        std::copy (spectrum.begin(), spectrum.begin() + (std::ptrdiff_t) ((numHarmonics + 1) * 2), buffer.begin());
+        fft.performRealOnlyInverseTransform (buffer.data());
+
+        auto* table = tables.data() + level * tableStride;
+
+        for (size_t i = 0; i < tableSize; ++i)
+            table[i] = static_cast<SampleType> (buffer[i]);
+
+        // the guard samples avoid wrapping the indexes of the interpolation
+        table[tableSize]     = table[0];
+        table[tableSize + 1] = table[1];
+    }
+
+    updateAllIncrements();
+}
+
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::setNumOscillators (size_t newNumOscillators)
+{
+    numOscillators = newNumOscillators;
+    numGroups = (numOscillators + laneWidth - 1) / laneWidth;
+
+    auto numLanes = numGroups * laneWidth;
+    auto totalSize = numLanes * 2 + laneWidth * 3;
+
+    laneMemory.malloc (totalSize * sizeof (SampleType) + sizeof (Vector));
+    phases = snapPointerToAlignment (reinterpret_cast<SampleType*> (laneMemory.getData()), sizeof (Vector));
+    increments = phases + numLanes;
+    std::fill (phases, phases + totalSize, SampleType (0));
+
+    frequencies.assign (numOscillators, SampleType (0));
+    laneTables.assign (numLanes, nullptr);
+
+    updateAllIncrements();
+}
+
+//==============================================================================
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::setFrequency (size_t oscillatorIndex, SampleType newFrequency) noexcept
+{
+    jassert (oscillatorIndex < numOscillators);
+
+    frequencies[oscillatorIndex] = newFrequency;
+    updateIncrement (oscillatorIndex);
+}
+
+template <typename SampleType>
+SampleType WavetableOscillatorBank<SampleType>::getFrequency (size_t oscillatorIndex) const noexcept
+{
+    jassert (oscillatorIndex < numOscillators);
+    return frequencies[oscillatorIndex];
+}
+
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::setPhase (size_t oscillatorIndex, SampleType newPhase) noexcept
+{
+    jassert (oscillatorIndex < numOscillators);
+    phases[oscillatorIndex] = newPhase - std::floor (newPhase);
+}
+
+template <typename SampleType>
+SampleType WavetableOscillatorBank<SampleType>::getPhase (size_t oscillatorIndex) const noexcept
+{
+    jassert (oscillatorIndex < numOscillators);
+    return phases[oscillatorIndex];
+}
+
+//==============================================================================
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::prepare (const ProcessSpec& spec) noexcept
+{
+    jassert (spec.sampleRate > 0);
+
+    sampleRate = spec.sampleRate;
+
+    updateAllIncrements();
+    reset();
+}
+
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::reset() noexcept
+{
+    if (phases != nullptr)
+        std::fill (phases, phases + numGroups * laneWidth, SampleType (0));
+}
+
+//==============================================================================
+template <typename SampleType>
+size_t WavetableOscillatorBank<SampleType>::getTableIndex (SampleType increment) const noexcept
+{
+    // The table with maxNumHarmonics >> index harmonics is free of aliasing as long as
+    // the highest harmonic stays below Nyquist, so index >= log2 (2 * maxNumHarmonics * increment)
+    auto x = static_cast<SampleType> (2 * maxNumHarmonics) * std::abs (increment);
+
+    if (x <= 1)
+        return 0;
+
+    int exponent = 0;
+    auto mantissa = std::frexp (x, &exponent);
+    auto index = (size_t) (mantissa > static_cast<SampleType> (0.5) ? exponent : exponent - 1);
+
+    return jmin (index, numLevels);
+}
+
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::updateIncrement (size_t oscillatorIndex) noexcept
+{
+    auto increment = static_cast<SampleType> (frequencies[oscillatorIndex] / sampleRate);
+
+    increments[oscillatorIndex] = jlimit (static_cast<SampleType> (-0.5), static_cast<SampleType> (0.5), increment);
+
+    if (! tables.empty())
+        laneTables[oscillatorIndex] = tables.data() + getTableIndex (increment) * tableStride;
+}
+
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::updateAllIncrements() noexcept
+{
+    for (size_t i = 0; i < numOscillators; ++i)
+        updateIncrement (i);
+
+    // the padding lanes read the first table, and never move
+    if (! tables.empty())
+        for (auto i = numOscillators; i < laneTables.size(); ++i)
+            laneTables[i] = tables.data();
+}
+
+//==============================================================================
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::process (const AudioBlock<SampleType>& outputBlock) noexcept
+{
+    processInternal<false> (outputBlock, nullptr);
+}
+
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::process (const AudioBlock<SampleType>& outputBlock,
+                                                   const AudioBlock<const SampleType>& frequencyBlock) noexcept
+{
+    jassert (frequencyBlock.getNumChannels() == numOscillators);
+    jassert (frequencyBlock.getNumSamples()  == outputBlock.getNumSamples());
+
+    processInternal<true> (outputBlock, &frequencyBlock);
+}
+
+template <typename SampleType>
+template <bool hasFrequencyBlock>
+void WavetableOscillatorBank<SampleType>::processInternal (const AudioBlock<SampleType>& outputBlock,
+                                                           const AudioBlock<const SampleType>* frequencyBlock) noexcept
+{
+    using namespace WavetableOscillatorBankHelpers;
+
+    // You must call setWaveform() before processing, and the block must have one channel per oscillator!
+    jassert (! tables.empty());
+    jassert (outputBlock.getNumChannels() == numOscillators);
+
+    if (tables.empty())
+    {
+        outputBlock.clear();
+        return;
+    }
+
+    auto numSamples = outputBlock.getNumSamples();
+    auto size = static_cast<SampleType> (tableSize);
+    auto* scratch = increments + numGroups * laneWidth;
+    auto* firstSamples  = scratch + laneWidth;
+    auto* secondSamples = firstSamples + laneWidth;
+
+    for (size_t group = 0; group < numGroups; ++group)
+    {
+        auto firstLane = group * laneWidth;
+        auto numLanes = jmin (laneWidth, numOscillators - firstLane);
+        auto* lanes = laneTables.data() + firstLane;
+
+        SampleType* outputs[laneWidth];
+        const SampleType* laneFrequencies[laneWidth];
+
+        for (size_t lane = 0; lane < numLanes; ++lane)
+        {
+            outputs[lane] = outputBlock.getChannelPointer (firstLane + lane);
+
+            if (hasFrequencyBlock)
+                laneFrequencies[lane] = frequencyBlock->getChannelPointer (firstLane + lane);
+        }
+
+        auto phase = load<Vector> (phases + firstLane);
+        auto increment = load<Vector> (increments + firstLane);
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            if (hasFrequencyBlock)
+            {
+                for (size_t lane = 0; lane < numLanes; ++lane)
+                    frequencies[firstLane + lane] = laneFrequencies[lane][i];
+
+                for (size_t lane = 0; lane < numLanes; ++lane)
+                    updateIncrement (firstLane + lane);
+
+                increment = load<Vector> (increments + firstLane);
+            }
+
+            auto position = phase * size;
+            auto index = truncate (position);
+            auto fraction = position - index;
+
+            store (scratch, index);
+
+            // there is no gather instruction in the SIMD registers, so the tables are read lane by lane
+            for (size_t lane = 0; lane < laneWidth; ++lane)
+            {
+                auto* sample = lanes[lane] + static_cast<size_t> (scratch[lane]);
+                firstSamples[lane]  = sample[0];
+                secondSamples[lane] = sample[1];
+            }
+
+            auto first = load<Vector> (firstSamples);
+            store (scratch, first + fraction * (load<Vector> (secondSamples) - first));
+
+            for (size_t lane = 0; lane < numLanes; ++lane)
+                outputs[lane][i] = scratch[lane];
+
+            phase = wrapPhase (phase + increment);
+        }
+
+        store (phases + firstLane, phase);
+    }
+}
+
+//==============================================================================
+template class WavetableOscillatorBank<float>;
+template class WavetableOscillatorBank<double>;
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,183 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    A bank of wavetable oscillators sharing the same waveform, which renders all
+    of its oscillators in a single pass, with one oscillator per SIMD lane.
+
+    The waveform is stored as a set of band-limited tables, one per octave, which
+    are built from a single cycle of the waveform using an FFT. Each oscillator
+    reads the table holding as many harmonics as possible without any of them
+    going above the Nyquist frequency, so the output is free of aliasing, at the
+    cost of up to an octave of missing harmonics near the top of the spectrum.
+    The samples are linearly interpolated, and the tables hold at most a quarter
+    of their size in harmonics so that the interpolation stays accurate.
+
+    Unlike Oscillator, the frequencies aren't smoothed: they can either be set for
+    each oscillator, and stay constant for the whole block, or they can be given
+    for every sample as a block with one channel per oscillator, which is the way
+    to modulate them at audio rate.
+
+    @code
+    WavetableOscillatorBank<float> bank;
+    bank.setWaveform ([] (float x) { return x / MathConstants<float>::pi; });
+    bank.setNumOscillators (numVoices);
+    bank.prepare (spec);
+
+    // then for each voice
+    bank.setFrequency (voiceIndex, frequency);
+
+    // and in the audio callback, with a block having one channel per voice
+    bank.process (voiceBlock);
+    @endcode
+
+    @see Oscillator
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class WavetableOscillatorBank
+{
+public:
+    //==============================================================================
+    /** Creates an oscillator bank without any oscillators. Call setWaveform() and
+        setNumOscillators() before using it.
+    */
+    WavetableOscillatorBank();
+
+    //==============================================================================
+    /** Builds the tables from a periodic function, over the same -pi..pi range as
+        the functions used by Oscillator.
+
+        The table size must be a power of two. This allocates some memory, so it
+        must not be called on the audio thread.
+    */
+    void setWaveform (const std::function<SampleType (SampleType)>& function, size_t tableSize = 2048);
+
+    /** Builds the tables from a single cycle of a waveform, made of a power of two
+        number of samples.
+
+        This allocates some memory, so it must not be called on the audio thread.
+    */
+    void setWaveform (const SampleType* singleCycle, size_t tableSize);
+
+    /** Returns the number of samples of each table. */
+    size_t getTableSize() const noexcept                 { return tableSize; }
+
+    /** Returns the number of band-limited tables, one per octave. */
+    size_t getNumTables() const noexcept                 { return numLevels; }
+
+    //==============================================================================
+    /** Sets the number of oscillators. The new oscillators start with a frequency
+        and a phase of zero.
+
+        This allocates some memory, so it must not be called on the audio thread.
+    */
+    void setNumOscillators (size_t newNumOscillators);
+
+    /** Returns the number of oscillators. */
+    size_t getNumOscillators() const noexcept            { return numOscillators; }
+
+    //==============================================================================
+    /** Sets the frequency of one of the oscillators, in Hz. */
+    void setFrequency (size_t oscillatorIndex, SampleType newFrequency) noexcept;
+
+    /** Returns the frequency of one of the oscillators, in Hz. */
+    SampleType getFrequency (size_t oscillatorIndex) const noexcept;
+
+    /** Sets the phase of one of the oscillators, as a proportion of a cycle between
+        0 and 1, which is useful to restart an oscillator when a note starts.
+    */
+    void setPhase (size_t oscillatorIndex, SampleType newPhase) noexcept;
+
+    /** Returns the phase of one of the oscillators, as a proportion of a cycle. */
+    SampleType getPhase (size_t oscillatorIndex) const noexcept;
+
+    //==============================================================================
+    /** Called before processing starts. Only the sample rate of the spec is used,
+        the number of oscillators is set with setNumOscillators().
+    */
+    void prepare (const ProcessSpec& spec) noexcept;
+
+    /** Resets the phases of all the oscillators. */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Renders the oscillators with constant frequencies, replacing the contents of
+        the block, which must have one channel per oscillator.
+    */
+    void process (const AudioBlock<SampleType>& outputBlock) noexcept;
+
+    /** Renders the oscillators with a frequency for each sample, in Hz, replacing the
+        contents of the output block.
+
+        Both blocks must have one channel per oscillator, and the same number of
+        samples. When this returns, the frequency of each oscillator is the last one
+        of its channel in the frequency block.
+    */
+    void process (const AudioBlock<SampleType>& outputBlock,
+                  const AudioBlock<const SampleType>& frequencyBlock) noexcept;
+
+private:
+    //==============================================================================
+   #if JUCE_USE_SIMD
+    using Vector = SIMDRegister<SampleType>;
+   #else
+    using Vector = SampleType;
+   #endif
+
+    static constexpr size_t laneWidth = sizeof (Vector) / sizeof (SampleType);
+
+    //==============================================================================
+    template <bool hasFrequencyBlock>
+    void processInternal (const AudioBlock<SampleType>&, const AudioBlock<const SampleType>*) noexcept;
+
+    void updateIncrement (size_t oscillatorIndex) noexcept;
+    void updateAllIncrements() noexcept;
+    size_t getTableIndex (SampleType increment) const noexcept;
+
+    //==============================================================================
+    std::vector<SampleType> tables;
+    size_t tableSize = 0, tableStride = 0, numLevels = 0, maxNumHarmonics = 0;
+
+    size_t numOscillators = 0, numGroups = 0;
+    HeapBlock<char> laneMemory;
+    SampleType* phases = nullptr;
+    SampleType* increments = nullptr;
+    std::vector<SampleType> frequencies;
+    std::vector<const SampleType*> laneTables;
+
+    double sampleRate = 44100.0;
+
+    JUCE_LEAK_DETECTOR (WavetableOscillatorBank)
+};
+
+} // namespace dsp
+} // namespace juce
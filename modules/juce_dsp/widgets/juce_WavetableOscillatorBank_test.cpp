@@ -0,0 +1,195 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class WavetableOscillatorBankTest : public UnitTest
+{
+public:
+    WavetableOscillatorBankTest()
+        : UnitTest ("WavetableOscillatorBank", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Sine waveform");
+        {
+            // the phases of the float version accumulate some rounding errors
+            checkSine<float>  (2.0e-4);
+            checkSine<double> (1.0e-5);
+        }
+
+        beginTest ("Output is band-limited");
+        {
+            constexpr int fftOrder = 12;
+            constexpr int fftSize = 1 << fftOrder;
+            constexpr double sampleRate = 48000.0;
+
+            WavetableOscillatorBank<float> bank;
+            bank.setWaveform ([] (float x) { return x / MathConstants<float>::pi; });
+            bank.setNumOscillators (1);
+            bank.prepare ({ sampleRate, (uint32) fftSize, 1 });
+
+            // frequencies falling exactly on FFT bins, whose harmonics above Nyquist would be aliased
+            for (auto bin : { 37, 150, 400, 1100 })
+            {
+                bank.reset();
+                bank.setFrequency (0, (float) (sampleRate * bin / fftSize));
+
+                HeapBlock<float> data ((size_t) fftSize * 2, true);
+                float* channels[] = { data.get() };
+                bank.process (AudioBlock<float> (channels, 1, (size_t) fftSize));
+
+                FFT fft (fftOrder);
+                fft.performFrequencyOnlyForwardTransform (data);
+
+                auto maxHarmonic = 0.0f, maxOther = 0.0f;
+
+                for (int i = 1; i <= fftSize / 2; ++i)
+                {
+                    if (i % bin == 0)
+                        maxHarmonic = jmax (maxHarmonic, data[i]);
+                    else
+                        maxOther = jmax (maxOther, data[i]);
+                }
+
+                expect (maxHarmonic > 0.0f);
+                expect (Decibels::gainToDecibels (maxOther / maxHarmonic) < -70.0f,
+                        "Aliasing at " + String (Decibels::gainToDecibels (maxOther / maxHarmonic)) + " dB for bin " + String (bin));
+            }
+        }
+
+        beginTest ("Frequencies above Nyquist are silent");
+        {
+            WavetableOscillatorBank<float> bank;
+            bank.setWaveform ([] (float x) { return x / MathConstants<float>::pi; }, 512);
+            bank.setNumOscillators (3);
+            bank.prepare ({ 44100.0, 256, 1 });
+            bank.setFrequency (0, 23000.0f);
+            bank.setFrequency (1, 30000.0f);
+            bank.setFrequency (2, -25000.0f);
+
+            AudioBuffer<float> buffer (3, 256);
+            bank.process (AudioBlock<float> (buffer));
+
+            // only the DC offset of the waveform is left
+            for (int channel = 0; channel < 3; ++channel)
+                expectLessThan (buffer.findMinMax (channel, 0, 256).getLength(), 1.0e-5f);
+        }
+
+        beginTest ("Frequency blocks");
+        {
+            constexpr size_t numOscillators = 11;
+            constexpr size_t numSamples = 300;
+
+            WavetableOscillatorBank<float> constantBank, modulatedBank;
+
+            for (auto* bank : { &constantBank, &modulatedBank })
+            {
+                bank->setWaveform ([] (float x) { return x > 0 ? 1.0f : -1.0f; }, 1024);
+                bank->setNumOscillators (numOscillators);
+                bank->prepare ({ 44100.0, (uint32) numSamples, 1 });
+            }
+
+            AudioBuffer<float> frequencies ((int) numOscillators, (int) numSamples);
+            AudioBuffer<float> expected ((int) numOscillators, (int) numSamples), output ((int) numOscillators, (int) numSamples);
+
+            for (size_t i = 0; i < numOscillators; ++i)
+            {
+                auto frequency = 55.0f * std::pow (1.6f, (float) i);
+                constantBank.setFrequency (i, frequency);
+                constantBank.setPhase (i, (float) i / (float) numOscillators);
+                modulatedBank.setPhase (i, (float) i / (float) numOscillators);
+
+                for (int sample = 0; sample < (int) numSamples; ++sample)
+                    frequencies.setSample ((int) i, sample, frequency);
+            }
+
+            // the constant bank renders its block in two parts
+            AudioBlock<float> expectedBlock (expected);
+            constantBank.process (expectedBlock.getSubBlock (0, 100));
+            constantBank.process (expectedBlock.getSubBlock (100));
+
+            modulatedBank.process (AudioBlock<float> (output), AudioBlock<const float> (frequencies));
+
+            for (int i = 0; i < (int) numOscillators; ++i)
+            {
+                for (int sample = 0; sample < (int) numSamples; ++sample)
+                    expectWithinAbsoluteError (output.getSample (i, sample), expected.getSample (i, sample), 1.0e-5f);
+
+                expectEquals (modulatedBank.getFrequency ((size_t) i), constantBank.getFrequency ((size_t) i));
+                expectWithinAbsoluteError (modulatedBank.getPhase ((size_t) i), constantBank.getPhase ((size_t) i), 1.0e-5f);
+            }
+        }
+    }
+
+private:
+    template <typename SampleType>
+    void checkSine (double tolerance)
+    {
+        constexpr size_t numOscillators = 5;
+        constexpr size_t numSamples = 1000;
+        constexpr double sampleRate = 44100.0;
+
+        WavetableOscillatorBank<SampleType> bank;
+        bank.setWaveform ([] (SampleType x) { return std::sin (x); });
+        bank.setNumOscillators (numOscillators);
+        bank.prepare ({ sampleRate, (uint32) numSamples, 1 });
+
+        for (size_t i = 0; i < numOscillators; ++i)
+        {
+            bank.setFrequency (i, static_cast<SampleType> (110.0 * (double) (i + 1) + 13.0));
+            bank.setPhase (i, static_cast<SampleType> (0.1 * (double) i));
+        }
+
+        AudioBuffer<SampleType> buffer ((int) numOscillators, (int) numSamples);
+        bank.process (AudioBlock<SampleType> (buffer));
+
+        auto maxError = 0.0;
+
+        for (size_t i = 0; i < numOscillators; ++i)
+        {
+            auto frequency = 110.0 * (double) (i + 1) + 13.0;
+
+            for (size_t sample = 0; sample < numSamples; ++sample)
+            {
+                // the phases are relative to the start of the -pi..pi range of the function
+                auto phase = 0.1 * (double) i + frequency * (double) sample / sampleRate;
+                auto expected = std::sin (MathConstants<double>::twoPi * phase - MathConstants<double>::pi);
+                maxError = jmax (maxError, std::abs (expected - (double) buffer.getSample ((int) i, (int) sample)));
+            }
+        }
+
+        expect (maxError < tolerance, "Maximum error " + String (maxError));
+    }
+};
+
+static WavetableOscillatorBankTest wavetableOscillatorBankTest;
+
+} // namespace dsp
+} // namespace juce